@@ -0,0 +1,83 @@
+//! Benchmark of the MPAGSCipher AesCtrCipher class
+#include "AesCtrCipher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// Report the throughput of a run, per thread used
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::size_t nThreads,
+                const std::chrono::duration<double>& elapsed)
+    {
+        const double rate{nBytes / elapsed.count() / 1.0e9};
+        std::cout << "  " << name << ": " << elapsed.count() << " s, " << rate
+                  << " GB/s, " << rate / nThreads << " GB/s per core\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the data in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 256};
+    const std::size_t nBytes{nMegabytes * 1000000};
+    const std::size_t nThreads{
+        std::max(1u, std::thread::hardware_concurrency())};
+
+    std::string data(nBytes, '\0');
+    for (std::size_t i{0}; i < nBytes; ++i) {
+        data[i] = static_cast<char>(i * 131 + i / 256);
+    }
+    std::cout << nBytes << " bytes, " << nThreads << " hardware threads\n";
+
+    using Implementation = AesCtrCipher::Implementation;
+    const std::pair<Implementation, std::string> implementations[]{
+        {Implementation::Bitsliced, "bitsliced"},
+        {Implementation::AESNI, "AES-NI   "}};
+    const std::pair<std::string, std::string> keys[]{
+        {"AES-128", "2b7e151628aed2a6abf7158809cf4f3c"},
+        {"AES-256", "603deb1015ca71be2b73aef0857d7781"
+                    "1f352c073b6108d72d9810a30914dff4"}};
+
+    // Run on one thread, and then on all of them if there is more than one
+    std::vector<std::size_t> threadCounts{1};
+    if (nThreads > 1) {
+        threadCounts.push_back(nThreads);
+    }
+
+    for (const auto& [keyName, key] : keys) {
+        const AesCtrCipher cipher{key + ",f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"};
+        std::string reference;
+        for (const auto& [implementation, name] : implementations) {
+            if (!AesCtrCipher::isSupported(implementation)) {
+                std::cout << "  " << keyName << " " << name
+                          << ": not supported\n";
+                continue;
+            }
+            for (const std::size_t maxThreads : threadCounts) {
+                const auto start = std::chrono::steady_clock::now();
+                const std::string result{
+                    cipher.applyCipherWith(data, implementation, maxThreads)};
+                const std::string threads{
+                    maxThreads == 1 ? ", 1 thread   " : ", all threads"};
+                report(keyName + " " + name + threads, nBytes, maxThreads,
+                       std::chrono::steady_clock::now() - start);
+
+                if (reference.empty()) {
+                    reference = result;
+                } else if (result != reference) {
+                    std::cerr << "[error] results differ" << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+//! Benchmark of the MPAGSCipher AsyncReader and AsyncWriter classes
+#include "AsyncFile.hpp"
+#include "TransformChar.hpp"
+
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " MB/s\n";
+    }
+
+    /// Make sure a file is on disk and not in the page cache, so that
+    /// reading it really goes to the device
+    void dropFromCache(const std::string& fileName)
+    {
+        const int fd{::open(fileName.c_str(), O_RDONLY)};
+        if (fd >= 0) {
+            ::fdatasync(fd);
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            ::close(fd);
+        }
+    }
+
+    /// Transliterate a buffer, as mpags-cipher does with its input
+    void transliterate(const char* data, const std::size_t n,
+                       std::string& out)
+    {
+        for (std::size_t i{0}; i < n; ++i) {
+            if (!std::isspace(static_cast<unsigned char>(data[i]))) {
+                out += transformChar(data[i]);
+            }
+        }
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the file in MB can be given as the first argument, and the
+    // directory to put it in (e.g. on an NVMe drive) as the second
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 256};
+    const std::string directory{(argc > 2) ? argv[2] : "."};
+    const std::size_t nBytes{nMegabytes * 1000000};
+    const std::string fileName{directory + "/benchAsyncFile.tmp"};
+    const std::size_t bufferSize{1 << 20};
+    const std::size_t queueDepth{8};
+
+    std::string text(nBytes, 'A');
+    std::size_t seed{12345};
+    for (auto& c : text) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        c = static_cast<char>('A' + (seed >> 33) % 26);
+    }
+    std::cout << nBytes << " bytes in " << fileName << ", " << bufferSize
+              << " byte buffers, queue depth " << queueDepth << "\n";
+
+    using Clock = std::chrono::steady_clock;
+
+    std::cout << "Writing:\n";
+    auto start = Clock::now();
+    {
+        std::ofstream file{fileName, std::ios::binary};
+        file << text;
+    }
+    dropFromCache(fileName);
+    report("ofstream", nBytes, Clock::now() - start);
+
+    for (const IoBackend backend : {IoBackend::Automatic, IoBackend::Threads}) {
+        start = Clock::now();
+        bool usedIoUring{false};
+        {
+            AsyncWriter writer{fileName, bufferSize, queueDepth, backend};
+            usedIoUring = writer.usesIoUring();
+            writer.write(text);
+            writer.close();
+        }
+        dropFromCache(fileName);
+        report(usedIoUring ? "io_uring" : "pwrite thread", nBytes,
+               Clock::now() - start);
+    }
+
+    std::cout << "Reading and transliterating:\n";
+    std::string streamed;
+    streamed.reserve(nBytes);
+    start = Clock::now();
+    {
+        std::ifstream file{fileName, std::ios::binary};
+        char c{'x'};
+        while (file >> c) {
+            streamed += transformChar(c);
+        }
+    }
+    report("ifstream >>", nBytes, Clock::now() - start);
+    dropFromCache(fileName);
+
+    start = Clock::now();
+    {
+        std::string read;
+        read.reserve(nBytes);
+        std::ifstream file{fileName, std::ios::binary};
+        std::string buffer(bufferSize, '\0');
+        while (file.read(&buffer[0], bufferSize) || file.gcount() > 0) {
+            transliterate(buffer.data(),
+                          static_cast<std::size_t>(file.gcount()), read);
+        }
+        if (read != streamed) {
+            std::cerr << "[error] ifstream::read gave a different result\n";
+            return 1;
+        }
+    }
+    report("ifstream::read", nBytes, Clock::now() - start);
+    dropFromCache(fileName);
+
+    for (const IoBackend backend : {IoBackend::Automatic, IoBackend::Threads}) {
+        std::string read;
+        read.reserve(nBytes);
+        start = Clock::now();
+        AsyncReader reader{fileName, bufferSize, queueDepth, backend};
+        const char* data{nullptr};
+        std::size_t n{0};
+        while (reader.next(data, n)) {
+            transliterate(data, n, read);
+        }
+        report(reader.usesIoUring() ? "io_uring" : "pread thread", nBytes,
+               Clock::now() - start);
+        dropFromCache(fileName);
+        if (read != streamed) {
+            std::cerr << "[error] AsyncReader gave a different result\n";
+            return 1;
+        }
+    }
+
+    std::remove(fileName.c_str());
+    return 0;
+}
@@ -0,0 +1,91 @@
+//! Benchmark of the MPAGSCipher BatchCipher functions
+#include "BatchCipher.hpp"
+#include "CipherFactory.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /// Report the throughput of a run, counting every key over the whole text
+    void report(const std::string& name, const std::size_t nLetters,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nLetters / elapsed.count() / 1.0e6 << " M letters/s\n";
+    }
+
+    /// Time one cipher a key at a time and with the batch functions
+    bool compare(const std::string& name, const CipherType type,
+                 const std::string& text, const std::vector<std::string>& keys)
+    {
+        const std::size_t nLetters{text.size() * keys.size()};
+        std::cout << name << ", " << keys.size() << " keys\n";
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::string> single;
+        for (const auto& key : keys) {
+            single.push_back(CipherFactory::makeCipher(type, key)->applyCipher(
+                text, CipherMode::Decrypt));
+        }
+        report("one cipher per key ", nLetters,
+               std::chrono::steady_clock::now() - start);
+
+        start = std::chrono::steady_clock::now();
+        const std::vector<std::string> batch{BatchCipher::applyCipher(
+            type, text, keys, CipherMode::Decrypt)};
+        report("batch outputs      ", nLetters,
+               std::chrono::steady_clock::now() - start);
+
+        start = std::chrono::steady_clock::now();
+        const std::vector<double> scores{BatchCipher::scoreKeys(
+            type, text, keys, CipherMode::Decrypt)};
+        report("batch scores       ", nLetters,
+               std::chrono::steady_clock::now() - start);
+
+        return single == batch && scores.size() == keys.size();
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the text in kB can be given as the first argument
+    const std::size_t nKilobytes{(argc > 1) ? std::stoul(argv[1]) : 256};
+    const std::size_t nBytes{nKilobytes * 1000};
+
+    std::string text(nBytes, 'A');
+    for (std::size_t i{0}; i < nBytes; ++i) {
+        text[i] = static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+    std::cout << nBytes << " letters, "
+              << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    // Every Caesar key, and a few hundred Vigenere and Playfair keys
+    std::vector<std::string> caesarKeys;
+    for (std::size_t key{0}; key < 26; ++key) {
+        caesarKeys.push_back(std::to_string(key));
+    }
+    std::vector<std::string> wordKeys;
+    for (std::size_t i{0}; i < 26 * 26; ++i) {
+        std::string key{static_cast<char>('A' + i / 26),
+                        static_cast<char>('A' + i % 26)};
+        key += "KEY";
+        wordKeys.push_back(key);
+    }
+
+    bool same{compare("Caesar", CipherType::Caesar, text, caesarKeys)};
+    same = compare("Vigenere", CipherType::Vigenere, text, wordKeys) && same;
+    same = compare("Playfair", CipherType::Playfair, text, wordKeys) && same;
+
+    if (!same) {
+        std::cerr << "[error] results differ" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
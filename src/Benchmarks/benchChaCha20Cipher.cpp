@@ -0,0 +1,67 @@
+//! Benchmark of the MPAGSCipher ChaCha20Cipher class
+#include "ChaCha20Cipher.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e9 << " GB/s\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the data in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 256};
+    const std::size_t nBytes{nMegabytes * 1000000};
+
+    std::string data(nBytes, '\0');
+    for (std::size_t i{0}; i < nBytes; ++i) {
+        data[i] = static_cast<char>(i * 131 + i / 256);
+    }
+    std::cout << nBytes << " bytes, " << std::thread::hardware_concurrency()
+              << " hardware threads\n";
+
+    const ChaCha20Cipher cipher{
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f,"
+        "000000000000004a00000000"};
+
+    using Implementation = ChaCha20Cipher::Implementation;
+    const std::pair<Implementation, std::string> implementations[]{
+        {Implementation::Scalar, "scalar"},
+        {Implementation::SSE2, "SSE2  "},
+        {Implementation::AVX2, "AVX2  "}};
+
+    std::string reference;
+    for (const auto& [implementation, name] : implementations) {
+        if (!ChaCha20Cipher::isSupported(implementation)) {
+            std::cout << "  " << name << ": not supported\n";
+            continue;
+        }
+        for (const std::size_t maxThreads : {std::size_t{1}, std::size_t{0}}) {
+            const auto start = std::chrono::steady_clock::now();
+            const std::string result{
+                cipher.applyCipherWith(data, implementation, maxThreads)};
+            report(name + (maxThreads == 1 ? ", 1 thread   " : ", all threads"),
+                   nBytes, std::chrono::steady_clock::now() - start);
+
+            if (reference.empty()) {
+                reference = result;
+            } else if (result != reference) {
+                std::cerr << "[error] results differ" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+//! Benchmark of the MPAGSCipher CipherSearch functions
+#include "CipherMode.hpp"
+#include "CipherSearch.hpp"
+#include "CipherType.hpp"
+#include "VigenereCipher.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " M letters/s\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the text in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 256};
+    const std::size_t nBytes{nMegabytes * 1000000};
+
+    std::string text(nBytes, 'A');
+    for (std::size_t i{0}; i < nBytes; ++i) {
+        text[i] = static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+    for (std::size_t pos{12345}; pos + 16 < nBytes; pos += 1000003) {
+        text.replace(pos, 14, "ATTACKATDAWNXX");
+    }
+    std::cout << nBytes << " letters, "
+              << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    const std::string key{"somewhatlongerkey"};
+    const std::string phrase{"ATTACKATDAWN"};
+    const VigenereCipher cipher{key};
+    const std::string cipherText{
+        cipher.applyCipher(text, CipherMode::Encrypt)};
+
+    // Decrypt everything and then search the plain text
+    auto start = std::chrono::steady_clock::now();
+    const std::string plainText{
+        cipher.applyCipher(cipherText, CipherMode::Decrypt)};
+    std::vector<std::size_t> decrypted;
+    for (std::size_t pos{plainText.find(phrase)}; pos != std::string::npos;
+         pos = plainText.find(phrase, pos + 1)) {
+        decrypted.push_back(pos);
+    }
+    report("decrypt then find   ", nBytes,
+           std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    const std::vector<std::size_t> searched{CipherSearch::findPhrase(
+        CipherType::Vigenere, key, cipherText, phrase)};
+    report("search cipher text  ", nBytes,
+           std::chrono::steady_clock::now() - start);
+
+    if (decrypted != searched) {
+        std::cerr << "[error] results differ" << std::endl;
+        return 1;
+    }
+    std::cout << "  " << searched.size() << " matches\n";
+
+    return 0;
+}
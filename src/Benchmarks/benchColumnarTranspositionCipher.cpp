@@ -0,0 +1,65 @@
+//! Benchmark of the MPAGSCipher ColumnarTranspositionCipher class
+#include "CipherMode.hpp"
+#include "ColumnarTranspositionCipher.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " MB/s\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the text in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 1000};
+    const std::size_t nBytes{nMegabytes * 1000000};
+
+    std::string text(nBytes, 'A');
+    for (std::size_t i{0}; i < nBytes; ++i) {
+        text[i] = static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+    std::cout << nBytes << " letters\n";
+
+    // Reference point: a plain copy into a freshly allocated buffer
+    auto start = std::chrono::steady_clock::now();
+    std::string copy(nBytes, ' ');
+    std::memcpy(copy.data(), text.data(), nBytes);
+    report("memcpy                      ", nBytes,
+           std::chrono::steady_clock::now() - start);
+
+    const std::vector<std::string> keys{"ZEBRAS", "TRANSPOSITIONCIPHER",
+                                        "ZEBRAS,TIGER"};
+    for (const auto& key : keys) {
+        const ColumnarTranspositionCipher cipher{key};
+
+        start = std::chrono::steady_clock::now();
+        const std::string cipherText{
+            cipher.applyCipher(text, CipherMode::Encrypt)};
+        report("encrypt " + key + std::string(20 - key.size(), ' '), nBytes,
+               std::chrono::steady_clock::now() - start);
+
+        start = std::chrono::steady_clock::now();
+        const std::string plainText{
+            cipher.applyCipher(cipherText, CipherMode::Decrypt)};
+        report("decrypt " + key + std::string(20 - key.size(), ' '), nBytes,
+               std::chrono::steady_clock::now() - start);
+
+        if (plainText != text) {
+            std::cerr << "[error] round trip failed" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
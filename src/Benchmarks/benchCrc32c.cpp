@@ -0,0 +1,50 @@
+//! Benchmark of the MPAGSCipher Crc32c functions
+#include "Crc32c.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " MB/s\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the data in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 64};
+    const std::size_t nBytes{nMegabytes * 1000000};
+
+    std::string data(nBytes, 'A');
+    std::size_t seed{12345};
+    for (auto& c : data) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        c = static_cast<char>('A' + (seed >> 33) % 26);
+    }
+    std::cout << nBytes << " bytes\n";
+
+    using Clock = std::chrono::steady_clock;
+
+    auto start = Clock::now();
+    const std::uint32_t software{
+        Crc32c::checksumSoftware(data.data(), data.size())};
+    report("slice-by-8", nBytes, Clock::now() - start);
+
+    start = Clock::now();
+    const std::uint32_t dispatched{Crc32c::checksum(data.data(), data.size())};
+    report("dispatched", nBytes, Clock::now() - start);
+
+    if (software != dispatched) {
+        std::cerr << "[error] checksums differ" << std::endl;
+        return 1;
+    }
+    return 0;
+}
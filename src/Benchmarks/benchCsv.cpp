@@ -0,0 +1,144 @@
+//! Benchmark of the MPAGSCipher Csv scanner and field encryption
+#include "CaesarCipher.hpp"
+#include "CipherChain.hpp"
+#include "CipherMode.hpp"
+#include "Csv.hpp"
+#include "VigenereCipher.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " MB/s\n";
+    }
+
+    /// Make a CSV export of people, with a quoted field in every record
+    std::string makeCsv(const std::size_t nBytes)
+    {
+        std::string text;
+        text.reserve(nBytes + 128);
+        std::size_t seed{12345};
+        const auto word = [&](const std::size_t length) {
+            for (std::size_t i{0}; i < length; ++i) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                text += static_cast<char>('a' + (seed >> 33) % 26);
+            }
+        };
+        for (std::size_t id{0}; text.size() < nBytes; ++id) {
+            text += std::to_string(id);
+            text += ',';
+            word(7);
+            text += ",\"";
+            word(9);
+            text += ", ";
+            word(6);
+            text += "\",";
+            text += std::to_string(seed % 100000);
+            text += ".00\n";
+        }
+        return text;
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the text in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 256};
+    const std::size_t blockSize{1 << 20};
+    const std::string text{makeCsv(nMegabytes * 1000000)};
+    const std::size_t nBytes{text.size()};
+    using Clock = std::chrono::steady_clock;
+
+    std::cout << nBytes << " bytes of CSV, " << blockSize
+              << " byte blocks\n";
+
+    // Copying the text is the fastest anything could go through it
+    std::string copy(nBytes, ' ');
+    auto start = Clock::now();
+    for (std::size_t i{0}; i < nBytes; i += blockSize) {
+        std::memcpy(&copy[i], text.data() + i,
+                    std::min(blockSize, nBytes - i));
+    }
+    report("memcpy", nBytes, Clock::now() - start);
+
+    std::vector<std::uint32_t> separators;
+    separators.reserve(blockSize);
+    std::size_t nSeparators{0};
+    start = Clock::now();
+    {
+        Csv::Scanner scanner;
+        for (std::size_t i{0}; i < nBytes; i += blockSize) {
+            separators.clear();
+            scanner.scan(text.data() + i, std::min(blockSize, nBytes - i),
+                         separators);
+            nSeparators += separators.size();
+        }
+    }
+    report("scan", nBytes, Clock::now() - start);
+
+    std::size_t nPortable{0};
+    start = Clock::now();
+    {
+        Csv::Scanner scanner;
+        for (std::size_t i{0}; i < nBytes; i += blockSize) {
+            separators.clear();
+            scanner.scanPortable(text.data() + i,
+                                 std::min(blockSize, nBytes - i), separators);
+            nPortable += separators.size();
+        }
+    }
+    report("scan (portable)", nBytes, Clock::now() - start);
+    if (nPortable != nSeparators) {
+        std::cout << "  ** the scanners found different separators\n";
+    }
+
+    // Encrypt the name and address of each record, a block at a time
+    const auto encrypt = [&](const std::string& name,
+                             std::vector<std::unique_ptr<Cipher>>& ciphers) {
+        CipherChain::collapse(ciphers, CipherMode::Encrypt);
+        Csv::Splitter splitter;
+        std::string block;
+        std::size_t nOut{0};
+        const auto start2 = Clock::now();
+        for (std::size_t i{0}; i < nBytes; i += blockSize) {
+            block.clear();
+            if (splitter.add(text.data() + i, std::min(blockSize, nBytes - i),
+                             block)) {
+                Csv::apply(block, ',', {false, true, true}, ciphers,
+                           CipherMode::Encrypt);
+                nOut += block.size();
+            }
+        }
+        block.clear();
+        if (splitter.finish(block)) {
+            Csv::apply(block, ',', {false, true, true}, ciphers,
+                       CipherMode::Encrypt);
+            nOut += block.size();
+        }
+        report(name, nBytes, Clock::now() - start2);
+        if (nOut != nBytes) {
+            std::cout << "  ** the output is a different size\n";
+        }
+    };
+
+    std::vector<std::unique_ptr<Cipher>> caesar;
+    caesar.push_back(std::make_unique<CaesarCipher>(3));
+    encrypt("split + encrypt fields 2,3 (caesar)", caesar);
+
+    std::vector<std::unique_ptr<Cipher>> vigenere;
+    vigenere.push_back(std::make_unique<VigenereCipher>("fields"));
+    encrypt("split + encrypt fields 2,3 (vigenere)", vigenere);
+
+    return 0;
+}
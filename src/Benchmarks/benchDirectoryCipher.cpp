@@ -0,0 +1,77 @@
+//! Benchmark of encrypting a directory tree with the MPAGSCipher DirectoryCipher
+#include "CaesarCipher.hpp"
+#include "CipherMode.hpp"
+#include "DirectoryCipher.hpp"
+#include "VigenereCipher.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char* argv[])
+{
+    // Number of small files can be given as the first argument, and the
+    // directory to build the tree in as the second
+    const std::size_t nSmall{(argc > 1) ? std::stoul(argv[1]) : 4000};
+    const fs::path directory{(argc > 2) ? argv[2] : "."};
+    const fs::path input{directory / "benchDirectoryCipher.in.tmp"};
+    const fs::path output{directory / "benchDirectoryCipher.out.tmp"};
+    using Clock = std::chrono::steady_clock;
+
+    // Many small files spread over a few levels of directories, and a few
+    // large ones, as in a typical source or document tree
+    fs::remove_all(input);
+    const std::string sentence{"The quick brown fox jumps over the lazy dog. "};
+    std::string small;
+    while (small.size() < 4096) {
+        small += sentence;
+    }
+    std::string large;
+    while (large.size() < (32 << 20)) {
+        large += sentence;
+    }
+    for (std::size_t i{0}; i < nSmall; ++i) {
+        const fs::path subdirectory{input / ("d" + std::to_string(i % 16)) /
+                                    ("e" + std::to_string(i % 7))};
+        fs::create_directories(subdirectory);
+        std::ofstream{subdirectory / ("f" + std::to_string(i) + ".txt")}
+            << small;
+    }
+    for (std::size_t i{0}; i < 3; ++i) {
+        std::ofstream{input / ("large" + std::to_string(i) + ".txt")} << large;
+    }
+
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<VigenereCipher>("directory"));
+    ciphers.push_back(std::make_unique<CaesarCipher>(7));
+
+    const std::size_t nHardware{std::thread::hardware_concurrency()};
+    for (const std::size_t nThreads : {std::size_t{1}, nHardware}) {
+        fs::remove_all(output);
+        const Clock::time_point start{Clock::now()};
+        const DirectoryCipher::Stats stats{DirectoryCipher::apply(
+            input.string(), output.string(), ciphers, CipherMode::Encrypt,
+            nThreads)};
+        const std::chrono::duration<double> elapsed{Clock::now() - start};
+
+        std::cout << stats.threads << " thread(s): " << stats.files
+                  << " files, " << stats.bytesIn / 1.0e6 << " MB in "
+                  << elapsed.count() << " s = "
+                  << stats.bytesIn / 1.0e6 / elapsed.count() << " MB/s, "
+                  << stats.files / elapsed.count() << " files/s ("
+                  << stats.tasks << " tasks, " << stats.steals
+                  << " stolen)\n";
+    }
+
+    fs::remove_all(input);
+    fs::remove_all(output);
+    return 0;
+}
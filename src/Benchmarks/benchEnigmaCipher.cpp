@@ -0,0 +1,101 @@
+//! Benchmark of the MPAGSCipher EnigmaCipher class
+#include "CipherMode.hpp"
+#include "EnigmaCipher.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+    /// Straightforward reference machine with rotors I II III, reflector B,
+    /// all rings and positions at A and no plugboard, stepped letter by letter
+    std::string naiveEnigma(const std::string& inputText)
+    {
+        const std::string wiring[3]{"EKMFLGDQVZNTOWYHXUSPAIBRCJ",
+                                    "AJDKSIRUXBLHWTMCQGZNPYFVOE",
+                                    "BDFHJLCPRTXVZNYEIWGAKMUSQO"};
+        const std::string reflector{"YRUHQSLDPXNGOKMIEBFZCWVJAT"};
+        const int notch[3]{'Q' - 'A', 'E' - 'A', 'V' - 'A'};
+
+        int position[3]{0, 0, 0};
+        std::string outputText(inputText.size(), ' ');
+        for (std::size_t i{0}; i < inputText.size(); ++i) {
+            if (position[1] == notch[1]) {
+                position[1] = (position[1] + 1) % 26;
+                position[0] = (position[0] + 1) % 26;
+            } else if (position[2] == notch[2]) {
+                position[1] = (position[1] + 1) % 26;
+            }
+            position[2] = (position[2] + 1) % 26;
+
+            int c{inputText[i] - 'A'};
+            for (int slot{2}; slot >= 0; --slot) {
+                c = (wiring[slot][(c + position[slot]) % 26] - 'A' + 26 -
+                     position[slot]) %
+                    26;
+            }
+            c = reflector[c] - 'A';
+            for (int slot{0}; slot < 3; ++slot) {
+                const char wired{
+                    static_cast<char>('A' + (c + position[slot]) % 26)};
+                c = (static_cast<int>(wiring[slot].find(wired)) + 26 -
+                     position[slot]) %
+                    26;
+            }
+            outputText[i] = static_cast<char>('A' + c);
+        }
+        return outputText;
+    }
+
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " M letters/s\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the text in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 64};
+    const std::size_t nBytes{nMegabytes * 1000000};
+
+    std::string text(nBytes, 'A');
+    for (std::size_t i{0}; i < nBytes; ++i) {
+        text[i] = static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+    std::cout << nBytes << " letters, "
+              << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    auto start = std::chrono::steady_clock::now();
+    const EnigmaCipher cipher{"I II III,B,AAA,AAA"};
+    const std::chrono::duration<double> setup{
+        std::chrono::steady_clock::now() - start};
+    std::cout << "  building the tables: " << setup.count() << " s\n";
+
+    start = std::chrono::steady_clock::now();
+    const std::string naive{naiveEnigma(text)};
+    report("naive stepping      ", nBytes,
+           std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    const std::string single{cipher.applyCipherAt(text, 0, 1)};
+    report("tables, 1 thread    ", nBytes,
+           std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    const std::string multi{cipher.applyCipher(text, CipherMode::Encrypt)};
+    report("tables, all threads ", nBytes,
+           std::chrono::steady_clock::now() - start);
+
+    if (naive != single || naive != multi) {
+        std::cerr << "[error] results differ" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
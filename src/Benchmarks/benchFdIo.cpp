@@ -0,0 +1,151 @@
+//! Benchmark of the MPAGSCipher FdReader and FdWriter classes on a pipe
+#include "FdIo.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cerr << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " MB/s\n";
+    }
+
+    /// Read a pipe until it is closed, throwing the data away
+    std::size_t drain(const int fd)
+    {
+        std::vector<char> buffer(1 << 20);
+        std::size_t total{0};
+        ssize_t n{0};
+        while ((n = ::read(fd, buffer.data(), buffer.size())) > 0) {
+            total += static_cast<std::size_t>(n);
+        }
+        return total;
+    }
+
+    /// Write all of a text into a pipe with plain write() calls
+    void fill(const int fd, const std::string& text)
+    {
+        std::size_t done{0};
+        while (done < text.size()) {
+            const ssize_t n{
+                ::write(fd, text.data() + done, text.size() - done)};
+            if (n <= 0) {
+                break;
+            }
+            done += static_cast<std::size_t>(n);
+        }
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the text in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 256};
+    const std::size_t nBytes{nMegabytes * 1000000};
+    const std::size_t pieceSize{1 << 16};
+
+    std::string text(nBytes, 'A');
+    std::size_t seed{12345};
+    for (auto& c : text) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        c = static_cast<char>('A' + (seed >> 33) % 26);
+    }
+
+    // The results go to stderr, since stdout is pointed at the pipes
+    using Clock = std::chrono::steady_clock;
+    const int savedStdin{::dup(STDIN_FILENO)};
+    const int savedStdout{::dup(STDOUT_FILENO)};
+    std::cerr << nBytes << " bytes through a pipe, written "
+              << pieceSize << " bytes at a time\n";
+
+    std::cerr << "Writing:\n";
+    for (int method{0}; method < 3; ++method) {
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            return 1;
+        }
+        ::dup2(fds[1], STDOUT_FILENO);
+        ::close(fds[1]);
+        std::size_t received{0};
+        std::thread consumer{[&]() { received = drain(fds[0]); }};
+
+        const auto start = Clock::now();
+        std::string name;
+        if (method == 0) {
+            name = "std::cout";
+            for (std::size_t i{0}; i < nBytes; i += pieceSize) {
+                std::cout << text.substr(i, pieceSize);
+            }
+            std::cout << std::flush;
+        } else {
+            FdWriter writer{STDOUT_FILENO, 1 << 20, method == 2};
+            name = writer.usesVmsplice() ? "FdWriter, vmsplice"
+                                         : "FdWriter, write";
+            for (std::size_t i{0}; i < nBytes; i += pieceSize) {
+                writer.write(text.data() + i,
+                             std::min(pieceSize, nBytes - i));
+            }
+            writer.flush();
+        }
+        ::dup2(savedStdout, STDOUT_FILENO);
+        consumer.join();
+        report(name, nBytes, Clock::now() - start);
+        ::close(fds[0]);
+        if (received != nBytes) {
+            std::cerr << "[error] " << name << " lost data\n";
+            return 1;
+        }
+    }
+
+    std::cerr << "Reading:\n";
+    for (int method{0}; method < 2; ++method) {
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            return 1;
+        }
+        ::dup2(fds[0], STDIN_FILENO);
+        ::close(fds[0]);
+        std::thread producer{[&]() {
+            fill(fds[1], text);
+            ::close(fds[1]);
+        }};
+
+        const auto start = Clock::now();
+        std::size_t received{0};
+        std::string name;
+        if (method == 0) {
+            name = "std::cin >>";
+            char c{'x'};
+            while (std::cin >> c) {
+                ++received;
+            }
+            std::cin.clear();
+        } else {
+            name = "FdReader";
+            FdReader reader{STDIN_FILENO};
+            const char* data{nullptr};
+            std::size_t n{0};
+            while (reader.next(data, n)) {
+                received += n;
+            }
+        }
+        producer.join();
+        report(name, nBytes, Clock::now() - start);
+        ::dup2(savedStdin, STDIN_FILENO);
+        if (received != nBytes) {
+            std::cerr << "[error] " << name << " lost data\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
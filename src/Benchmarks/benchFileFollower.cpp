@@ -0,0 +1,106 @@
+//! Benchmark of the latency of following a file with the MPAGSCipher FileFollower
+#include "CipherMode.hpp"
+#include "CipherStream.hpp"
+#include "FileFollower.hpp"
+#include "PlayfairCipher.hpp"
+#include "TransformChar.hpp"
+#include "VigenereCipher.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+int main(int argc, char* argv[])
+{
+    // Number of appends can be given as the first argument, and the
+    // directory to put the file in as the second
+    const std::size_t nAppends{(argc > 1) ? std::stoul(argv[1]) : 2000};
+    const std::string directory{(argc > 2) ? argv[2] : "."};
+    const std::string fileName{directory + "/benchFileFollower.log.tmp"};
+    const std::string line{"GET /index.html 200 the quick brown fox jumps\n"};
+    using Clock = std::chrono::steady_clock;
+
+    std::remove(fileName.c_str());
+    const int fd{::open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644)};
+    if (fd < 0) {
+        std::cerr << "cannot create " << fileName << "\n";
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<VigenereCipher>("logkey"));
+    ciphers.push_back(std::make_unique<PlayfairCipher>("playfair example"));
+    CipherStream stream{ciphers, CipherMode::Encrypt};
+
+    // The writer appends a line, and waits for it to have been encrypted
+    // before appending the next, so that each append is timed on its own
+    std::atomic<std::size_t> nDone{0};
+    std::atomic<Clock::rep> written{0};
+    std::vector<double> latencies;
+    latencies.reserve(nAppends);
+
+    FileFollower follower{fileName};
+    std::thread writer{[&]() {
+        for (std::size_t i{0}; i < nAppends; ++i) {
+            written = Clock::now().time_since_epoch().count();
+            if (::write(fd, line.data(), line.size()) < 0) {
+                break;
+            }
+            while (nDone.load() <= i) {
+                std::this_thread::yield();
+            }
+        }
+        ::close(fd);
+        std::remove(fileName.c_str());
+    }};
+
+    std::size_t nLetters{0};
+    std::size_t nBytes{0};
+    const char* data{nullptr};
+    std::size_t n{0};
+    while (follower.next(data, n)) {
+        std::string letters;
+        for (std::size_t i{0}; i < n; ++i) {
+            letters += transformChar(data[i]);
+        }
+        nLetters += stream.push(letters).size();
+        const Clock::time_point now{Clock::now()};
+        nBytes += n;
+        if (nBytes >= (nDone + 1) * line.size()) {
+            latencies.push_back(
+                std::chrono::duration<double, std::micro>(
+                    now - Clock::time_point{Clock::duration{written}})
+                    .count());
+            ++nDone;
+        }
+    }
+    nLetters += stream.finish().size();
+    writer.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    double total{0.0};
+    for (const double latency : latencies) {
+        total += latency;
+    }
+    std::cout << latencies.size() << " appends of " << line.size()
+              << " bytes, Vigenere + Playfair, " << nLetters
+              << " letters out\n";
+    if (!latencies.empty()) {
+        std::cout << "  latency from write to encrypted: mean "
+                  << total / latencies.size() << " us, median "
+                  << latencies[latencies.size() / 2] << " us, 99th percentile "
+                  << latencies[latencies.size() * 99 / 100] << " us, max "
+                  << latencies.back() << " us\n";
+    }
+    return 0;
+}
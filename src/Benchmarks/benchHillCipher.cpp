@@ -0,0 +1,80 @@
+//! Benchmark of the MPAGSCipher HillCipher class
+#include "CipherMode.hpp"
+#include "HillCipher.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Straightforward reference implementation, one block at a time
+    std::string naiveHill(const HillCipher::Matrix& matrix,
+                          const std::size_t size, const std::string& inputText)
+    {
+        std::string outputText(inputText.size(), 'X');
+        for (std::size_t block{0}; block < inputText.size(); block += size) {
+            for (std::size_t row{0}; row < size; ++row) {
+                std::size_t sum{0};
+                for (std::size_t j{0}; j < size; ++j) {
+                    sum += matrix[row * size + j] *
+                           static_cast<std::size_t>(inputText[block + j] - 'A');
+                    sum %= 26;
+                }
+                outputText[block + row] = static_cast<char>('A' + sum);
+            }
+        }
+        return outputText;
+    }
+
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " MB/s\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the text in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 16};
+
+    const std::vector<std::string> keys{"HILL", "GYBNQKURP",
+                                        "PACKMYBOXWITHFIVEDOZENLIQ"};
+    for (const auto& key : keys) {
+        const HillCipher cipher{key};
+        const std::size_t size{cipher.blockSize()};
+
+        // Fill the text with a whole number of blocks of varied letters
+        const std::size_t nBytes{(nMegabytes * 1000000 / size) * size};
+        std::string text(nBytes, 'A');
+        for (std::size_t i{0}; i < nBytes; ++i) {
+            text[i] = static_cast<char>('A' + (i * 7 + i / 26) % 26);
+        }
+
+        std::cout << size << "x" << size << " key, " << nBytes
+                  << " letters\n";
+
+        auto start = std::chrono::steady_clock::now();
+        const std::string naive{
+            naiveHill(cipher.encryptionMatrix(), size, text)};
+        report("naive per-block loop", nBytes,
+               std::chrono::steady_clock::now() - start);
+
+        start = std::chrono::steady_clock::now();
+        const std::string blocked{
+            cipher.applyCipher(text, CipherMode::Encrypt)};
+        report("blocked HillCipher  ", nBytes,
+               std::chrono::steady_clock::now() - start);
+
+        if (naive != blocked) {
+            std::cerr << "[error] results differ" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
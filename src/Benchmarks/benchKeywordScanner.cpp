@@ -0,0 +1,91 @@
+//! Benchmark of the MPAGSCipher KeywordScanner class
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+#include "KeywordScanner.hpp"
+#include "VigenereCipher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " M letters/s\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the text in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 16};
+    const std::size_t nBytes{nMegabytes * 1000000};
+
+    // Pseudo-random letters, and a few hundred keywords of 4 to 11 letters
+    std::string text(nBytes, 'A');
+    std::size_t seed{12345};
+    const auto nextLetter = [&seed]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<char>('A' + (seed >> 33) % 26);
+    };
+    for (auto& c : text) {
+        c = nextLetter();
+    }
+    std::vector<std::string> keywords(300);
+    for (std::size_t k{0}; k < keywords.size(); ++k) {
+        for (std::size_t i{0}; i < 4 + k % 8; ++i) {
+            keywords[k] += nextLetter();
+        }
+        text.replace((k * 7919 * 1013) % (nBytes - 16), keywords[k].size(),
+                     keywords[k]);
+    }
+    std::cout << nBytes << " letters, " << keywords.size() << " keywords, "
+              << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    const std::string key{"somewhatlongerkey"};
+    const VigenereCipher cipher{key};
+    const std::string cipherText{
+        cipher.applyCipher(text, CipherMode::Encrypt)};
+
+    // Decrypt everything and then look for each keyword in turn
+    auto start = std::chrono::steady_clock::now();
+    const std::string plainText{
+        cipher.applyCipher(cipherText, CipherMode::Decrypt)};
+    std::size_t nFound{0};
+    for (const auto& keyword : keywords) {
+        for (std::size_t pos{plainText.find(keyword)}; pos != std::string::npos;
+             pos = plainText.find(keyword, pos + 1)) {
+            ++nFound;
+        }
+    }
+    report("decrypt then find each", nBytes,
+           std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    KeywordScanner scanner{keywords, CipherType::Vigenere, key};
+    std::size_t nScanned{0};
+    const std::size_t pieceSize{1 << 16};
+    for (std::size_t begin{0}; begin < nBytes; begin += pieceSize) {
+        scanner.scan(cipherText.data() + begin,
+                     std::min(pieceSize, nBytes - begin),
+                     [&nScanned](const KeywordScanner::Match&) { ++nScanned; });
+    }
+    report("scan cipher text      ", nBytes,
+           std::chrono::steady_clock::now() - start);
+
+    if (nFound != nScanned) {
+        std::cerr << "[error] results differ" << std::endl;
+        return 1;
+    }
+    std::cout << "  " << nScanned << " matches, " << scanner.nStates()
+              << " states\n";
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+//! Benchmark of the MPAGSCipher LetterCompressor functions
+#include "LetterCompressor.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " M letters/s\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the text in MB can be given as the first argument
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 16};
+    const std::size_t nBytes{nMegabytes * 1000000};
+
+    // Text made of words picked pseudo-randomly from a small vocabulary,
+    // which is more like English than random letters are
+    const std::vector<std::string> words{
+        "THE",   "OF",    "AND",   "TO",     "IN",    "IS",    "THAT",
+        "IT",    "WAS",   "FOR",   "ON",     "ARE",   "WITH",  "THEY",
+        "BE",    "AT",    "ONE",   "HAVE",   "THIS",  "FROM",  "CIPHER",
+        "KEY",   "SECRET", "MESSAGE", "ENCRYPT", "LETTER", "ALPHABET",
+        "WORD",  "TEXT",  "PLAIN"};
+    std::string text;
+    text.reserve(nBytes + 16);
+    std::size_t seed{12345};
+    while (text.size() < nBytes) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        text += words[(seed >> 33) % words.size()];
+    }
+    text.resize(nBytes);
+    std::cout << nBytes << " letters\n";
+
+    using Clock = std::chrono::steady_clock;
+
+    auto start = Clock::now();
+    const std::string compressed{LetterCompressor::compress(text)};
+    report("compress", nBytes, Clock::now() - start);
+    std::cout << "  compressed to " << compressed.size() << " letters ("
+              << 100.0 * compressed.size() / nBytes << "%)\n";
+
+    start = Clock::now();
+    const std::string decompressed{
+        LetterCompressor::decompress(compressed, nBytes)};
+    report("decompress", nBytes, Clock::now() - start);
+
+    if (decompressed != text) {
+        std::cerr << "[error] round trip failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
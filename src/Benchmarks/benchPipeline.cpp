@@ -0,0 +1,148 @@
+//! Benchmark of the MPAGSCipher reader/cipher/writer Pipeline
+#include "AsyncFile.hpp"
+#include "CipherChain.hpp"
+#include "CipherMode.hpp"
+#include "Pipeline.hpp"
+#include "TransformChar.hpp"
+#include "VigenereCipher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace {
+    /// Report the throughput of a run
+    void report(const std::string& name, const std::size_t nBytes,
+                const std::chrono::duration<double>& elapsed)
+    {
+        std::cout << "  " << name << ": " << elapsed.count() << " s, "
+                  << nBytes / elapsed.count() / 1.0e6 << " MB/s\n";
+    }
+
+    /// Report how often the stages of a run waited for each other
+    void reportStalls(const Pipeline::Stats& stats)
+    {
+        std::cout << "    reader waited " << stats.toWorkers.pushStalls
+                  << " times, workers " << stats.toWorkers.popStalls << "/"
+                  << stats.toWriter.pushStalls << " times, writer "
+                  << stats.toWriter.popStalls << " times, mean queue "
+                  << stats.toWorkers.meanOccupancy() << "/"
+                  << stats.toWriter.meanOccupancy() << "\n";
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Size of the file in MB can be given as the first argument, and the
+    // directory to put it in as the second
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 256};
+    const std::string directory{(argc > 2) ? argv[2] : "."};
+    const std::size_t nBytes{nMegabytes * 1000000};
+    const std::string inputName{directory + "/benchPipeline.in.tmp"};
+    const std::string outputName{directory + "/benchPipeline.out.tmp"};
+    const std::size_t bufferSize{1 << 20};
+    const std::size_t queueDepth{4};
+
+    {
+        std::string text(nBytes, 'a');
+        std::size_t seed{12345};
+        for (auto& c : text) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const std::size_t r{(seed >> 33) % 32};
+            c = (r < 26) ? static_cast<char>('a' + r) : ' ';
+        }
+        std::ofstream file{inputName, std::ios::binary};
+        file << text;
+    }
+
+    std::array<std::string, 256> letters;
+    for (std::size_t c{0}; c < letters.size(); ++c) {
+        letters[c] = transformChar(static_cast<char>(c));
+    }
+    const VigenereCipher cipher{"PIPELINE"};
+
+    std::cout << nBytes << " bytes of text, Vigenere, " << bufferSize
+              << " byte blocks\n";
+    using Clock = std::chrono::steady_clock;
+
+    // Read everything, then encrypt everything, then write everything
+    auto start = Clock::now();
+    std::string expected;
+    {
+        std::ifstream in{inputName, std::ios::binary};
+        const std::string input{std::istreambuf_iterator<char>{in},
+                                std::istreambuf_iterator<char>{}};
+        std::string text;
+        text.reserve(input.size());
+        for (const char c : input) {
+            text += letters[static_cast<unsigned char>(c)];
+        }
+        expected = cipher.applyCipher(text, CipherMode::Encrypt);
+        std::ofstream out{outputName, std::ios::binary};
+        out << expected;
+    }
+    report("sequential", nBytes, Clock::now() - start);
+
+    const std::size_t maxWorkers{
+        std::max(std::thread::hardware_concurrency(), 1u)};
+    for (std::size_t nWorkers{1}; nWorkers <= maxWorkers; nWorkers *= 2) {
+        start = Clock::now();
+        Pipeline::Stats stats;
+        {
+            AsyncReader reader{inputName, bufferSize, queueDepth};
+            AsyncWriter writer{outputName, bufferSize, queueDepth};
+            std::uint64_t nLetters{0};
+            stats = Pipeline::run(
+                [&](Pipeline::Block& block) {
+                    const char* data{nullptr};
+                    std::size_t n{0};
+                    if (!reader.next(data, n)) {
+                        return false;
+                    }
+                    block.input.assign(data, n);
+                    block.offset = nLetters;
+                    for (const char c : block.input) {
+                        nLetters +=
+                            letters[static_cast<unsigned char>(c)].size();
+                    }
+                    return true;
+                },
+                [&](Pipeline::Block& block) {
+                    for (const char c : block.input) {
+                        block.output += letters[static_cast<unsigned char>(c)];
+                    }
+                    block.output = CipherChain::applyCipherAt(
+                        cipher, block.output, CipherMode::Encrypt,
+                        block.offset);
+                },
+                [&](const Pipeline::Block& block) {
+                    writer.write(block.output);
+                },
+                nWorkers, queueDepth);
+            writer.close();
+        }
+        report("pipeline, " + std::to_string(nWorkers) + " workers", nBytes,
+               Clock::now() - start);
+        reportStalls(stats);
+
+        std::ifstream out{outputName, std::ios::binary};
+        const std::string result{std::istreambuf_iterator<char>{out},
+                                 std::istreambuf_iterator<char>{}};
+        if (result != expected) {
+            std::cerr << "[error] pipeline gave a different result\n";
+            return 1;
+        }
+    }
+
+    std::remove(inputName.c_str());
+    std::remove(outputName.c_str());
+    return 0;
+}
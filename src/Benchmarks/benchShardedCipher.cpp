@@ -0,0 +1,69 @@
+//! Benchmark of encrypting one large file with the MPAGSCipher ShardedCipher
+#include "CipherMode.hpp"
+#include "EnigmaCipher.hpp"
+#include "ShardedCipher.hpp"
+#include "VigenereCipher.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    // Size of the file in MB can be given as the first argument, and the
+    // directory to put it in as the second
+    const std::size_t nMegabytes{(argc > 1) ? std::stoul(argv[1]) : 256};
+    const std::string directory{(argc > 2) ? argv[2] : "."};
+    const std::string inputFile{directory + "/benchShardedCipher.in.tmp"};
+    const std::string outputFile{directory + "/benchShardedCipher.out.tmp"};
+    using Clock = std::chrono::steady_clock;
+
+    {
+        const std::string sentence{
+            "The quick brown fox jumps over the lazy dog. "};
+        std::string block;
+        while (block.size() < (1 << 20)) {
+            block += sentence;
+        }
+        block.resize(1 << 20);
+        std::ofstream file{inputFile, std::ios::binary};
+        for (std::size_t i{0}; i < nMegabytes; ++i) {
+            file << block;
+        }
+    }
+
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<VigenereCipher>("shards"));
+
+    // Planning (counting the letters of each shard) is done by the parent
+    // alone, so time it on its own too
+    const Clock::time_point planStart{Clock::now()};
+    const std::size_t nShards{
+        ShardedCipher::plan(inputFile, std::thread::hardware_concurrency())
+            .size()};
+    const std::chrono::duration<double> planElapsed{Clock::now() - planStart};
+    std::cout << "plan of " << nShards << " shard(s): "
+              << nMegabytes / planElapsed.count() << " MB/s\n";
+
+    const std::size_t nHardware{std::thread::hardware_concurrency()};
+    for (const std::size_t nWorkers : {std::size_t{1}, nHardware}) {
+        const Clock::time_point start{Clock::now()};
+        const ShardedCipher::Stats stats{ShardedCipher::apply(
+            inputFile, outputFile, ciphers, CipherMode::Encrypt, nWorkers)};
+        const std::chrono::duration<double> elapsed{Clock::now() - start};
+
+        std::cout << stats.workers << " worker(s): " << stats.bytesIn / 1.0e6
+                  << " MB in " << elapsed.count() << " s = "
+                  << stats.bytesIn / 1.0e6 / elapsed.count() << " MB/s\n";
+    }
+
+    std::remove(inputFile.c_str());
+    std::remove(outputFile.c_str());
+    return 0;
+}
@@ -0,0 +1,583 @@
+#include "AesCtrCipher.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define MPAGSCIPHER_AESCTR_AESNI
+#endif
+
+namespace {
+    /// Number of bytes in each AES block
+    constexpr std::size_t blockSize{16};
+
+    /// Number of blocks handed to each thread at a time
+    constexpr std::size_t blocksPerChunk{4096};
+
+    /// Type definition for four AES states in bitsliced form
+    using Planes = AesCtrCipher::SlicedKey;
+
+    /**
+     * \struct Counter
+     * \brief The 128-bit counter block, as two halves in host byte order
+     */
+    struct Counter {
+        /// The most significant half
+        std::uint64_t hi;
+        /// The least significant half
+        std::uint64_t lo;
+    };
+
+    /**
+     * \brief Read a hexadecimal string into bytes
+     *
+     * \param hex the hexadecimal string
+     * \param bytes where to put the bytes
+     * \return false if the string is not hexadecimal or has an odd length
+     */
+    bool parseHex(const std::string& hex, std::vector<unsigned char>& bytes)
+    {
+        if (hex.size() % 2 != 0 ||
+            !std::all_of(std::begin(hex), std::end(hex),
+                         [](char c) { return std::isxdigit(c); })) {
+            return false;
+        }
+        bytes.clear();
+        for (std::size_t i{0}; i < hex.size(); i += 2) {
+            bytes.push_back(static_cast<unsigned char>(
+                std::stoul(hex.substr(i, 2), nullptr, 16)));
+        }
+        return true;
+    }
+
+    /**
+     * \brief Multiply two elements of GF(2^8) without branching on them
+     *
+     * \param a the first element
+     * \param b the second element
+     * \return the product, modulo x^8 + x^4 + x^3 + x + 1
+     */
+    unsigned int gfMultiply(unsigned int a, unsigned int b)
+    {
+        unsigned int product{0};
+        for (int i{0}; i < 8; ++i) {
+            product ^= a & (0u - (b & 1u));
+            const unsigned int overflow{0u - ((a >> 7) & 1u)};
+            a = ((a << 1) ^ (0x1bu & overflow)) & 0xffu;
+            b >>= 1;
+        }
+        return product;
+    }
+
+    /**
+     * \brief Apply the AES S-box to one byte, without a lookup table
+     *
+     * \param x the byte
+     * \return the substituted byte
+     */
+    unsigned char subByte(const unsigned int x)
+    {
+        // The multiplicative inverse is x^254
+        unsigned int inverse{1};
+        for (int i{0}; i < 7; ++i) {
+            inverse = gfMultiply(gfMultiply(inverse, inverse), x);
+        }
+        inverse = gfMultiply(inverse, inverse);
+
+        // Followed by the affine transformation
+        unsigned int result{inverse ^ 0x63u};
+        for (int shift{1}; shift < 5; ++shift) {
+            result ^= ((inverse << shift) | (inverse >> (8 - shift))) & 0xffu;
+        }
+        return static_cast<unsigned char>(result);
+    }
+
+    /**
+     * \brief Expand an AES key into the round keys
+     *
+     * \param key the key, of 16, 24 or 32 bytes
+     * \param roundKeys where to put the round keys
+     * \return the number of rounds
+     */
+    std::size_t expandKey(const std::vector<unsigned char>& key,
+                          AesCtrCipher::RoundKeys& roundKeys)
+    {
+        const std::size_t nKeyWords{key.size() / 4};
+        const std::size_t nRounds{nKeyWords + 6};
+        std::copy(std::begin(key), std::end(key), std::begin(roundKeys));
+
+        unsigned int roundConstant{1};
+        for (std::size_t i{nKeyWords}; i < 4 * (nRounds + 1); ++i) {
+            unsigned char word[4];
+            std::copy_n(&roundKeys[4 * (i - 1)], 4, word);
+            if (i % nKeyWords == 0) {
+                std::rotate(word, word + 1, word + 4);
+                std::transform(word, word + 4, word, subByte);
+                word[0] ^= static_cast<unsigned char>(roundConstant);
+                roundConstant = gfMultiply(roundConstant, 2);
+            } else if (nKeyWords > 6 && i % nKeyWords == 4) {
+                std::transform(word, word + 4, word, subByte);
+            }
+            for (std::size_t k{0}; k < 4; ++k) {
+                roundKeys[4 * i + k] = roundKeys[4 * (i - nKeyWords) + k] ^
+                                       word[k];
+            }
+        }
+        return nRounds;
+    }
+
+    /**
+     * \brief Find the counter block a number of blocks on from the initial one
+     *
+     * \param bytes the initial counter block
+     * \param offset the number of blocks
+     * \return the counter block
+     */
+    Counter loadCounter(const std::array<unsigned char, 16>& bytes,
+                        const std::uint64_t offset)
+    {
+        Counter counter{0, 0};
+        for (std::size_t i{0}; i < 8; ++i) {
+            counter.hi = (counter.hi << 8) | bytes[i];
+            counter.lo = (counter.lo << 8) | bytes[8 + i];
+        }
+        counter.lo += offset;
+        if (counter.lo < offset) {
+            ++counter.hi;
+        }
+        return counter;
+    }
+
+    /// Move the counter on to the next block
+    inline void increment(Counter& counter)
+    {
+        if (++counter.lo == 0) {
+            ++counter.hi;
+        }
+    }
+
+    /// Write the counter block out as big-endian bytes
+    void storeCounter(const Counter& counter, unsigned char* bytes)
+    {
+        for (std::size_t i{0}; i < 8; ++i) {
+            bytes[i] = static_cast<unsigned char>(counter.hi >> (56 - 8 * i));
+            bytes[8 + i] =
+                static_cast<unsigned char>(counter.lo >> (56 - 8 * i));
+        }
+    }
+
+    /**
+     * \brief Convert four blocks to bitsliced form
+     *
+     * Bit j of every byte goes into word j, at the position of the byte, so
+     * that each operation on the words acts on all 64 bytes at once.
+     *
+     * \param bytes the four blocks
+     * \return the bitsliced blocks
+     */
+    Planes slice(const unsigned char* bytes)
+    {
+        constexpr std::uint64_t lowBits{0x0101010101010101ULL};
+        constexpr std::uint64_t gather{0x0102040810204080ULL};
+
+        Planes planes{};
+        for (std::size_t group{0}; group < 8; ++group) {
+            std::uint64_t word{0};
+            for (std::size_t i{0}; i < 8; ++i) {
+                word |= static_cast<std::uint64_t>(bytes[8 * group + i])
+                        << (8 * i);
+            }
+            // The multiplication collects bit 0 of each of the eight bytes
+            // into the top byte
+            for (std::size_t j{0}; j < 8; ++j) {
+                planes[j] |= ((((word >> j) & lowBits) * gather) >> 56)
+                             << (8 * group);
+            }
+        }
+        return planes;
+    }
+
+    /**
+     * \brief Convert four blocks back from bitsliced form
+     *
+     * \param planes the bitsliced blocks
+     * \param bytes where to put the four blocks
+     */
+    void unslice(const Planes& planes, unsigned char* bytes)
+    {
+        constexpr std::uint64_t lowBits{0x0101010101010101ULL};
+        constexpr std::uint64_t diagonal{0x8040201008040201ULL};
+        constexpr std::uint64_t highBits{0x7f7f7f7f7f7f7f7fULL};
+
+        for (std::size_t group{0}; group < 8; ++group) {
+            std::uint64_t word{0};
+            for (std::size_t j{0}; j < 8; ++j) {
+                // Copy the eight bits into every byte, keep bit k in byte k,
+                // and then move that bit down to bit 0 without branching
+                const std::uint64_t bits{(planes[j] >> (8 * group)) & 0xffu};
+                const std::uint64_t spread{
+                    ((((bits * lowBits) & diagonal) + highBits) >> 7) &
+                    lowBits};
+                word |= spread << j;
+            }
+            for (std::size_t i{0}; i < 8; ++i) {
+                bytes[8 * group + i] =
+                    static_cast<unsigned char>(word >> (8 * i));
+            }
+        }
+    }
+
+    /**
+     * \brief Reduce a bitsliced polynomial product modulo the AES polynomial
+     *
+     * \param product the coefficients of x^0 to x^14
+     * \return the reduced element
+     */
+    Planes reduce(std::uint64_t (&product)[15])
+    {
+        // x^8 = x^4 + x^3 + x + 1
+        for (std::size_t k{14}; k >= 8; --k) {
+            product[k - 4] ^= product[k];
+            product[k - 5] ^= product[k];
+            product[k - 7] ^= product[k];
+            product[k - 8] ^= product[k];
+        }
+        Planes result;
+        std::copy_n(product, 8, std::begin(result));
+        return result;
+    }
+
+    /// Multiply 64 pairs of elements of GF(2^8) in bitsliced form
+    Planes multiply(const Planes& a, const Planes& b)
+    {
+        std::uint64_t product[15]{};
+        for (std::size_t i{0}; i < 8; ++i) {
+            for (std::size_t j{0}; j < 8; ++j) {
+                product[i + j] ^= a[i] & b[j];
+            }
+        }
+        return reduce(product);
+    }
+
+    /// Square 64 elements of GF(2^8) in bitsliced form
+    Planes square(const Planes& a)
+    {
+        // Squaring is linear in GF(2^8), so the cross terms vanish
+        std::uint64_t product[15]{};
+        for (std::size_t i{0}; i < 8; ++i) {
+            product[2 * i] = a[i];
+        }
+        return reduce(product);
+    }
+
+    /// Apply the S-box to all 64 bytes, by inversion and affine transform
+    void subBytes(Planes& state)
+    {
+        // x^254 by a short addition chain
+        const Planes x2{square(state)};
+        const Planes x3{multiply(x2, state)};
+        const Planes x12{square(square(x3))};
+        const Planes x15{multiply(x12, x3)};
+        const Planes x240{square(square(square(square(x15))))};
+        const Planes inverse{multiply(multiply(x240, x12), x2)};
+
+        for (std::size_t i{0}; i < 8; ++i) {
+            state[i] = inverse[i] ^ inverse[(i + 4) % 8] ^
+                       inverse[(i + 5) % 8] ^ inverse[(i + 6) % 8] ^
+                       inverse[(i + 7) % 8];
+        }
+
+        // Add the constant 0x63
+        state[0] = ~state[0];
+        state[1] = ~state[1];
+        state[5] = ~state[5];
+        state[6] = ~state[6];
+    }
+
+    /**
+     * \brief Rotate each 16-bit lane of a word right (towards bit 0)
+     *
+     * \param x the word
+     * \param shift the number of bits to rotate by, 1 to 15
+     * \return the rotated word
+     */
+    inline std::uint64_t rotateLanes(const std::uint64_t x, const int shift)
+    {
+        const std::uint64_t low{(0xffffULL >> shift) * 0x0001000100010001ULL};
+        return ((x >> shift) & low) | ((x << (16 - shift)) & ~low);
+    }
+
+    /// Shift the rows of all four blocks
+    void shiftRows(Planes& state)
+    {
+        // Byte 4c + r of each block holds row r of column c, so each row
+        // is a set of bits that is rotated by r columns (4r bits)
+        constexpr std::uint64_t row0{0x1111111111111111ULL};
+        for (std::uint64_t& plane : state) {
+            std::uint64_t shifted{plane & row0};
+            for (int row{1}; row < 4; ++row) {
+                shifted |= rotateLanes(plane, 4 * row) & (row0 << row);
+            }
+            plane = shifted;
+        }
+    }
+
+    /// Move row r + 1 of each column into row r
+    inline std::uint64_t nextRow(const std::uint64_t x)
+    {
+        return ((x >> 1) & 0x7777777777777777ULL) |
+               ((x << 3) & 0x8888888888888888ULL);
+    }
+
+    /// Mix the columns of all four blocks
+    void mixColumns(Planes& state)
+    {
+        // Each row becomes 2*a(r) + 3*a(r+1) + a(r+2) + a(r+3)
+        //                = 2*(a(r) + a(r+1)) + a(r+1) + a(r+2) + a(r+3)
+        Planes rest;
+        Planes sum;
+        for (std::size_t j{0}; j < 8; ++j) {
+            const std::uint64_t next{nextRow(state[j])};
+            const std::uint64_t second{nextRow(next)};
+            rest[j] = next ^ second ^ nextRow(second);
+            sum[j] = state[j] ^ next;
+        }
+
+        // Multiply by x, reducing by the AES polynomial
+        state[0] = sum[7] ^ rest[0];
+        state[1] = sum[0] ^ sum[7] ^ rest[1];
+        state[2] = sum[1] ^ rest[2];
+        state[3] = sum[2] ^ sum[7] ^ rest[3];
+        state[4] = sum[3] ^ sum[7] ^ rest[4];
+        state[5] = sum[4] ^ rest[5];
+        state[6] = sum[5] ^ rest[6];
+        state[7] = sum[6] ^ rest[7];
+    }
+
+    /// XOR a round key into all four blocks
+    inline void addRoundKey(Planes& state, const Planes& key)
+    {
+        for (std::size_t j{0}; j < 8; ++j) {
+            state[j] ^= key[j];
+        }
+    }
+
+    /**
+     * \brief XOR data with the key stream, using the bitsliced software AES
+     *
+     * \param slicedKeys the round keys in bitsliced form
+     * \param nRounds the number of rounds
+     * \param counter the counter block of the first block
+     * \param in the input data
+     * \param out the output buffer
+     * \param nBytes the number of bytes to process
+     */
+    void xorKeyStreamBitsliced(
+        const std::array<Planes, AesCtrCipher::maxRounds + 1>& slicedKeys,
+        const std::size_t nRounds, Counter counter, const unsigned char* in,
+        unsigned char* out, const std::size_t nBytes)
+    {
+        unsigned char keyStream[4 * blockSize];
+        for (std::size_t offset{0}; offset < nBytes;
+             offset += 4 * blockSize) {
+            for (std::size_t block{0}; block < 4; ++block) {
+                storeCounter(counter, keyStream + block * blockSize);
+                increment(counter);
+            }
+
+            Planes state{slice(keyStream)};
+            addRoundKey(state, slicedKeys[0]);
+            for (std::size_t round{1}; round <= nRounds; ++round) {
+                subBytes(state);
+                shiftRows(state);
+                if (round != nRounds) {
+                    mixColumns(state);
+                }
+                addRoundKey(state, slicedKeys[round]);
+            }
+            unslice(state, keyStream);
+
+            const std::size_t n{std::min(4 * blockSize, nBytes - offset)};
+            for (std::size_t i{0}; i < n; ++i) {
+                out[offset + i] = in[offset + i] ^ keyStream[i];
+            }
+        }
+    }
+
+#ifdef MPAGSCIPHER_AESCTR_AESNI
+    /// Make the counter block as a vector of big-endian bytes
+    __attribute__((target("aes"))) inline __m128i counterBlock(
+        const Counter& counter)
+    {
+        return _mm_set_epi64x(
+            static_cast<long long>(__builtin_bswap64(counter.lo)),
+            static_cast<long long>(__builtin_bswap64(counter.hi)));
+    }
+
+    /**
+     * \brief XOR data with the key stream, using the AES-NI instructions
+     *
+     * Eight independent blocks go through each round together, so the
+     * processor can have all of them in flight at once.
+     *
+     * \param roundKeys the round keys
+     * \param nRounds the number of rounds
+     * \param counter the counter block of the first block
+     * \param in the input data
+     * \param out the output buffer
+     * \param nBytes the number of bytes to process
+     */
+    __attribute__((target("aes"))) void xorKeyStreamAESNI(
+        const AesCtrCipher::RoundKeys& roundKeys, const std::size_t nRounds,
+        Counter counter, const unsigned char* in, unsigned char* out,
+        const std::size_t nBytes)
+    {
+        __m128i keys[AesCtrCipher::maxRounds + 1];
+        for (std::size_t round{0}; round <= nRounds; ++round) {
+            keys[round] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(&roundKeys[16 * round]));
+        }
+
+        std::size_t offset{0};
+        for (; offset + 8 * blockSize <= nBytes; offset += 8 * blockSize) {
+            __m128i x[8];
+            for (std::size_t k{0}; k < 8; ++k) {
+                x[k] = _mm_xor_si128(counterBlock(counter), keys[0]);
+                increment(counter);
+            }
+            for (std::size_t round{1}; round < nRounds; ++round) {
+                for (std::size_t k{0}; k < 8; ++k) {
+                    x[k] = _mm_aesenc_si128(x[k], keys[round]);
+                }
+            }
+            for (std::size_t k{0}; k < 8; ++k) {
+                x[k] = _mm_aesenclast_si128(x[k], keys[nRounds]);
+                const auto* source =
+                    reinterpret_cast<const __m128i*>(in + offset) + k;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset) + k,
+                                 _mm_xor_si128(_mm_loadu_si128(source), x[k]));
+            }
+        }
+
+        // Deal with whatever is left over one block at a time
+        for (; offset < nBytes; offset += blockSize) {
+            __m128i x{_mm_xor_si128(counterBlock(counter), keys[0])};
+            increment(counter);
+            for (std::size_t round{1}; round < nRounds; ++round) {
+                x = _mm_aesenc_si128(x, keys[round]);
+            }
+            x = _mm_aesenclast_si128(x, keys[nRounds]);
+
+            unsigned char keyStream[blockSize];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(keyStream), x);
+            const std::size_t n{std::min(blockSize, nBytes - offset)};
+            for (std::size_t i{0}; i < n; ++i) {
+                out[offset + i] = in[offset + i] ^ keyStream[i];
+            }
+        }
+    }
+#endif
+}    // namespace
+
+AesCtrCipher::AesCtrCipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void AesCtrCipher::setKey(const std::string& key)
+{
+    const std::size_t comma{key.find(',')};
+    if (comma == std::string::npos) {
+        throw InvalidKey{
+            "Key provided to AesCtrCipher must be of the form key,counter"};
+    }
+
+    std::vector<unsigned char> bytes;
+    if (!parseHex(key.substr(0, comma), bytes) ||
+        (bytes.size() != 16 && bytes.size() != 24 && bytes.size() != 32)) {
+        throw InvalidKey{
+            "Key provided to AesCtrCipher must start with 32, 48 or 64 hex "
+            "digits"};
+    }
+    nRounds_ = expandKey(bytes, roundKeys_);
+
+    // The bitsliced form holds four blocks, so repeat each round key
+    for (std::size_t round{0}; round <= nRounds_; ++round) {
+        unsigned char repeated[4 * blockSize];
+        for (std::size_t block{0}; block < 4; ++block) {
+            std::copy_n(&roundKeys_[blockSize * round], blockSize,
+                        repeated + block * blockSize);
+        }
+        slicedKeys_[round] = slice(repeated);
+    }
+
+    if (!parseHex(key.substr(comma + 1), bytes) || bytes.size() != 16) {
+        throw InvalidKey{
+            "Counter provided to AesCtrCipher must be 32 hex digits"};
+    }
+    std::copy(std::begin(bytes), std::end(bytes), std::begin(counter_));
+}
+
+std::string AesCtrCipher::applyCipher(const std::string& inputText,
+                                      const CipherMode /*cipherMode*/) const
+{
+    static const Implementation best{isSupported(Implementation::AESNI)
+                                         ? Implementation::AESNI
+                                         : Implementation::Bitsliced};
+    return this->applyCipherWith(inputText, best);
+}
+
+std::string AesCtrCipher::applyCipherWith(const std::string& inputText,
+                                          const Implementation implementation,
+                                          const std::size_t maxThreads) const
+{
+    const std::size_t nBytes{inputText.size()};
+    const std::size_t nBlocks{(nBytes + blockSize - 1) / blockSize};
+
+    std::string outputText(nBytes, '\0');
+    const auto* in = reinterpret_cast<const unsigned char*>(inputText.data());
+    auto* out = reinterpret_cast<unsigned char*>(outputText.data());
+
+    // Each chunk of blocks starts from its own counter block, so the chunks
+    // are independent of one another
+    parallelFor(
+        nBlocks, blocksPerChunk,
+        [&](std::size_t begin, std::size_t end) {
+            const std::size_t first{begin * blockSize};
+            const std::size_t last{std::min(end * blockSize, nBytes)};
+            const Counter counter{loadCounter(counter_, begin)};
+#ifdef MPAGSCIPHER_AESCTR_AESNI
+            if (implementation == Implementation::AESNI) {
+                xorKeyStreamAESNI(roundKeys_, nRounds_, counter, in + first,
+                                  out + first, last - first);
+                return;
+            }
+#else
+            static_cast<void>(implementation);
+#endif
+            xorKeyStreamBitsliced(slicedKeys_, nRounds_, counter, in + first,
+                                  out + first, last - first);
+        },
+        maxThreads);
+
+    return outputText;
+}
+
+bool AesCtrCipher::isSupported(const Implementation implementation)
+{
+    switch (implementation) {
+        case Implementation::Bitsliced:
+            return true;
+        case Implementation::AESNI:
+#ifdef MPAGSCIPHER_AESCTR_AESNI
+            return __builtin_cpu_supports("aes") != 0;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
@@ -0,0 +1,126 @@
+#ifndef MPAGSCIPHER_AESCTRCIPHER_HPP
+#define MPAGSCIPHER_AESCTRCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * \file AesCtrCipher.hpp
+ * \brief Contains the declaration of the AesCtrCipher class
+ */
+
+/**
+ * \class AesCtrCipher
+ * \brief Encrypt or decrypt data using AES in counter (CTR) mode
+ *
+ * Like the ChaCha20Cipher this works on arbitrary bytes rather than
+ * upper-case letters. The key gives the AES key (32, 48 or 64 hex digits for
+ * AES-128, AES-192 or AES-256) and the 128-bit initial counter block (32 hex
+ * digits), separated by a comma, e.g.
+ * "2b7e151628aed2a6abf7158809cf4f3c,f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff".
+ * The whole counter block is incremented as a big-endian number, as in
+ * NIST SP 800-38A.
+ *
+ * Each 16-byte block of key stream depends only on the key and its counter,
+ * so the data is split between threads by counter offset. Where the
+ * processor has the AES-NI instructions eight blocks are encrypted at a
+ * time with their rounds interleaved, so that the latency of each round
+ * instruction is hidden behind the other seven. Otherwise a bitsliced
+ * software implementation is used, which encrypts four blocks at a time
+ * with no table lookups or data-dependent branches, so its timing does not
+ * depend on the key or the data.
+ * Encryption and decryption are the same operation.
+ */
+class AesCtrCipher : public Cipher {
+  public:
+    /**
+     * \enum Implementation
+     * \brief The ways in which the blocks can be encrypted
+     */
+    enum class Implementation {
+        Bitsliced,    ///< Constant-time software, four blocks at a time
+        AESNI         ///< AES-NI instructions, eight blocks at a time
+    };
+
+    /**
+     * \brief Create a new AesCtrCipher with the given key
+     *
+     * \param key the AES key and the initial counter block
+     */
+    explicit AesCtrCipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the AES key and the initial counter block
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided data
+     *
+     * \param inputText the data to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input data
+     * \return the result of applying the cipher to the input data
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Apply the cipher using a particular implementation
+     *
+     * \param inputText the data to encrypt or decrypt
+     * \param implementation how to encrypt the counter blocks, which must be
+     *                       supported by this processor
+     * \param maxThreads the maximum number of threads to use, 0 means no limit
+     * \return the result of applying the cipher to the input data
+     */
+    std::string applyCipherWith(const std::string& inputText,
+                                const Implementation implementation,
+                                const std::size_t maxThreads = 0) const;
+
+    /**
+     * \brief Determine whether this processor supports an implementation
+     *
+     * \param implementation the implementation to check
+     * \return true if it can be used
+     */
+    static bool isSupported(const Implementation implementation);
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::AesCtr; }
+
+    /// The largest number of rounds (for AES-256)
+    static constexpr std::size_t maxRounds{14};
+
+    /// Type definition for the expanded key, as bytes
+    using RoundKeys = std::array<unsigned char, 16 * (maxRounds + 1)>;
+
+    /// Type definition for a round key in bitsliced form, one word per bit
+    using SlicedKey = std::array<std::uint64_t, 8>;
+
+  private:
+    /// The number of rounds, 10, 12 or 14
+    std::size_t nRounds_{0};
+
+    /// The round keys, as bytes
+    RoundKeys roundKeys_{};
+
+    /// The round keys in bitsliced form, repeated for four blocks
+    std::array<SlicedKey, maxRounds + 1> slicedKeys_{};
+
+    /// The initial counter block
+    std::array<unsigned char, 16> counter_{};
+};
+
+#endif    // MPAGSCIPHER_AESCTRCIPHER_HPP
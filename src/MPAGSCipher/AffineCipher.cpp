@@ -0,0 +1,109 @@
+#include "AffineCipher.hpp"
+#include "Alphabet.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Type definition for the table of modular inverses
+    using InverseTable = std::array<std::size_t, 26>;
+
+    /**
+     * \brief Build the table of inverses modulo 26 at compile time
+     *
+     * \return the table, with zero for numbers that have no inverse
+     */
+    constexpr InverseTable makeInverseTable()
+    {
+        InverseTable table{};
+        for (std::size_t a{0}; a < table.size(); ++a) {
+            for (std::size_t x{1}; x < table.size(); ++x) {
+                if ((a * x) % table.size() == 1) {
+                    table[a] = x;
+                    break;
+                }
+            }
+        }
+        return table;
+    }
+
+    /// The table of inverses modulo 26
+    constexpr InverseTable inverseTable{makeInverseTable()};
+
+    static_assert(inverseTable[3] == 9 && inverseTable[25] == 25,
+                  "the modular inverse table is incorrect");
+    static_assert(inverseTable[2] == 0 && inverseTable[13] == 0,
+                  "numbers sharing a factor with 26 must have no inverse");
+}    // namespace
+
+AffineCipher::AffineCipher(const std::size_t a, const std::size_t b)
+{
+    this->setKey(a, b);
+}
+
+AffineCipher::AffineCipher(const std::string& key)
+{
+    // Split the key into its numerical components, ignoring any separators
+    std::vector<std::string> values;
+    std::string value;
+    for (const char c : key + ',') {
+        if (std::isdigit(c)) {
+            value += c;
+        } else if (!value.empty()) {
+            values.push_back(value);
+            value.clear();
+        }
+    }
+
+    if (values.size() != 2) {
+        throw InvalidKey{
+            "Key provided to AffineCipher must be two integers of the form a,b"};
+    }
+
+    // Only the values modulo 26 matter, so just the last few digits are
+    // needed and the conversion can't overflow
+    std::array<std::size_t, 2> numbers{};
+    for (std::size_t i{0}; i < numbers.size(); ++i) {
+        const std::string& digits{values[i]};
+        const std::size_t nDigits{std::min<std::size_t>(digits.size(), 4)};
+        numbers[i] = std::stoul(digits.substr(digits.size() - nDigits));
+    }
+
+    this->setKey(numbers[0], numbers[1]);
+}
+
+void AffineCipher::setKey(const std::size_t a, const std::size_t b)
+{
+    a_ = a % Alphabet::size;
+    b_ = b % Alphabet::size;
+
+    // Check that the key can be inverted
+    if (modularInverse(a_) == 0) {
+        throw InvalidKey{
+            "Multiplier provided to AffineCipher must be coprime to 26"};
+    }
+
+    // Construct the cipher alphabet, E(x) = a*x + b, and use it for the
+    // lookup tables of the equivalent substitution
+    std::string cipherAlphabet(Alphabet::size, 'A');
+    for (std::size_t x{0}; x < Alphabet::size; ++x) {
+        cipherAlphabet[x] = Alphabet::alphabet[(a_ * x + b_) % Alphabet::size];
+    }
+    substitution_.setKey(cipherAlphabet);
+}
+
+std::size_t AffineCipher::modularInverse(const std::size_t a)
+{
+    return inverseTable[a % inverseTable.size()];
+}
+
+std::string AffineCipher::applyCipher(const std::string& inputText,
+                                      const CipherMode cipherMode) const
+{
+    // The substitution tables already hold both E(x) and its inverse
+    // D(y) = a^-1 * (y - b), so simply hand over to them
+    return substitution_.applyCipher(inputText, cipherMode);
+}
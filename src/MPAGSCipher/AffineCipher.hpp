@@ -0,0 +1,84 @@
+#ifndef MPAGSCIPHER_AFFINECIPHER_HPP
+#define MPAGSCIPHER_AFFINECIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+#include "SubstitutionCipher.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+/**
+ * \file AffineCipher.hpp
+ * \brief Contains the declaration of the AffineCipher class
+ */
+
+/**
+ * \class AffineCipher
+ * \brief Encrypt or decrypt text using the affine cipher with the given key
+ *
+ * Each letter, with index x in the alphabet, is encrypted as
+ * E(x) = (a*x + b) mod 26 and decrypted as D(y) = a^-1 * (y - b) mod 26,
+ * where a must be coprime to 26 so that the modular inverse a^-1 exists.
+ *
+ * The key is given as the two integers a and b separated by a comma, e.g. "5,8".
+ */
+class AffineCipher : public Cipher {
+  public:
+    /**
+     * \brief Create a new AffineCipher with the given key values
+     *
+     * \param a the multiplier, which must be coprime to 26
+     * \param b the shift
+     */
+    AffineCipher(const std::size_t a, const std::size_t b);
+
+    /**
+     * \brief Create a new AffineCipher, converting the given string into the key
+     *
+     * \param key the string, of the form "a,b", to convert into the key
+     */
+    explicit AffineCipher(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::Affine; }
+
+    /**
+     * \brief Find the inverse of a number modulo the size of the alphabet
+     *
+     * \param a the number to invert
+     * \return the modular inverse of a, or 0 if a is not coprime to 26
+     */
+    static std::size_t modularInverse(const std::size_t a);
+
+  private:
+    /// The multiplier
+    std::size_t a_{1};
+
+    /// The shift
+    std::size_t b_{0};
+
+    /// The equivalent substitution, which holds the lookup tables
+    SubstitutionCipher substitution_{""};
+
+    /// Check the key and fill the lookup tables
+    void setKey(const std::size_t a, const std::size_t b);
+};
+
+#endif    // MPAGSCIPHER_AFFINECIPHER_HPP
@@ -0,0 +1,622 @@
+#include "AsyncFile.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define MPAGSCIPHER_ASYNCFILE_IO_URING
+#endif
+
+/**
+ * \class IoQueue
+ * \brief A queue of reads and writes that complete in any order
+ */
+class IoQueue {
+  public:
+    /// The kinds of request
+    enum class Op { Read, Write };
+
+    virtual ~IoQueue() = default;
+
+    /**
+     * \brief Start a read or write
+     *
+     * \param op whether to read or write
+     * \param fd the file descriptor
+     * \param buffer the buffer to read into or write from
+     * \param n the number of bytes
+     * \param offset the offset in the file
+     * \param tag the value to identify the request by when it completes
+     */
+    virtual void submit(const Op op, const int fd, char* buffer,
+                        const std::size_t n, const std::uint64_t offset,
+                        const std::size_t tag) = 0;
+
+    /**
+     * \brief Wait for a request to complete
+     *
+     * \return the tag of the request, and the number of bytes transferred
+     *         or minus the error number
+     */
+    virtual std::pair<std::size_t, std::int64_t> wait() = 0;
+
+    /// Determine whether this is the io_uring queue
+    virtual bool isIoUring() const = 0;
+};
+
+namespace {
+    /// Read or write all of a buffer, carrying on after short transfers
+    std::int64_t transferAll(const IoQueue::Op op, const int fd, char* buffer,
+                             const std::size_t n, const std::uint64_t offset)
+    {
+        std::size_t done{0};
+        while (done < n) {
+            const off_t position{static_cast<off_t>(offset + done)};
+            const ssize_t result{
+                op == IoQueue::Op::Read
+                    ? ::pread(fd, buffer + done, n - done, position)
+                    : ::pwrite(fd, buffer + done, n - done, position)};
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return -errno;
+            }
+            if (result == 0) {
+                break;
+            }
+            done += static_cast<std::size_t>(result);
+        }
+        return static_cast<std::int64_t>(done);
+    }
+
+    /**
+     * \class ThreadQueue
+     * \brief An IoQueue that does each request with pread/pwrite on a background thread
+     */
+    class ThreadQueue : public IoQueue {
+      public:
+        ThreadQueue() : worker_{[this]() { this->run(); }} {}
+
+        ~ThreadQueue() override
+        {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                stopping_ = true;
+            }
+            requestReady_.notify_one();
+            worker_.join();
+        }
+
+        void submit(const Op op, const int fd, char* buffer,
+                    const std::size_t n, const std::uint64_t offset,
+                    const std::size_t tag) override
+        {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                requests_.push_back(Request{op, fd, buffer, n, offset, tag});
+            }
+            requestReady_.notify_one();
+        }
+
+        std::pair<std::size_t, std::int64_t> wait() override
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            completionReady_.wait(lock,
+                                  [this]() { return !completions_.empty(); });
+            const auto completion = completions_.front();
+            completions_.pop_front();
+            return completion;
+        }
+
+        bool isIoUring() const override { return false; }
+
+      private:
+        struct Request {
+            Op op;
+            int fd;
+            char* buffer;
+            std::size_t n;
+            std::uint64_t offset;
+            std::size_t tag;
+        };
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            while (true) {
+                requestReady_.wait(lock, [this]() {
+                    return stopping_ || !requests_.empty();
+                });
+                if (requests_.empty()) {
+                    return;
+                }
+                const Request request{requests_.front()};
+                requests_.pop_front();
+
+                lock.unlock();
+                const std::int64_t result{
+                    transferAll(request.op, request.fd, request.buffer,
+                                request.n, request.offset)};
+                lock.lock();
+
+                completions_.emplace_back(request.tag, result);
+                completionReady_.notify_one();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable requestReady_;
+        std::condition_variable completionReady_;
+        std::deque<Request> requests_;
+        std::deque<std::pair<std::size_t, std::int64_t>> completions_;
+        bool stopping_{false};
+        std::thread worker_;
+    };
+
+#ifdef MPAGSCIPHER_ASYNCFILE_IO_URING
+    /**
+     * \class IoUringQueue
+     * \brief An IoQueue that uses io_uring, set up directly with its system calls
+     *
+     * The submission and completion rings are shared with the kernel, so
+     * each request is queued by writing an entry and moving the tail of the
+     * submission ring on, and each completion is collected by reading an
+     * entry and moving the head of the completion ring on. The only system
+     * calls are one to hand over each submission, and one to wait whenever
+     * there is no completion ready.
+     */
+    class IoUringQueue : public IoQueue {
+      public:
+        explicit IoUringQueue(const std::size_t depth)
+        {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            const long fd{::syscall(__NR_io_uring_setup,
+                                    static_cast<unsigned>(depth), &params)};
+            if (fd < 0) {
+                throw std::system_error{errno, std::generic_category(),
+                                        "failed to set up io_uring"};
+            }
+            ringFd_ = static_cast<int>(fd);
+
+            sqRingSize_ = params.sq_off.array +
+                          params.sq_entries * sizeof(unsigned);
+            cqRingSize_ = params.cq_off.cqes +
+                          params.cq_entries * sizeof(io_uring_cqe);
+            const bool singleMap{(params.features & IORING_FEAT_SINGLE_MMAP) !=
+                                 0};
+            if (singleMap) {
+                sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+            }
+            sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+
+            sqRing_ = this->map(sqRingSize_, IORING_OFF_SQ_RING);
+            cqRing_ = singleMap ? sqRing_
+                                : this->map(cqRingSize_, IORING_OFF_CQ_RING);
+            sqes_ = static_cast<io_uring_sqe*>(
+                this->map(sqesSize_, IORING_OFF_SQES));
+
+            char* sq{static_cast<char*>(sqRing_)};
+            sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sqMask_ =
+                *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+            char* cq{static_cast<char*>(cqRing_)};
+            cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cqMask_ =
+                *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        }
+
+        ~IoUringQueue() override { this->release(); }
+
+        void submit(const Op op, const int fd, char* buffer,
+                    const std::size_t n, const std::uint64_t offset,
+                    const std::size_t tag) override
+        {
+            // Only this thread writes the tail, so it can be read plainly
+            const unsigned tail{*sqTail_};
+            const unsigned index{tail & sqMask_};
+            io_uring_sqe& sqe{sqes_[index]};
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = (op == Op::Read) ? IORING_OP_READ : IORING_OP_WRITE;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<std::uint64_t>(buffer);
+            sqe.len = static_cast<std::uint32_t>(n);
+            sqe.off = offset;
+            sqe.user_data = tag;
+            sqArray_[index] = index;
+            __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+
+            while (::syscall(__NR_io_uring_enter, ringFd_, 1, 0, 0, nullptr,
+                             0) < 0) {
+                if (errno != EINTR && errno != EAGAIN) {
+                    throw std::system_error{errno, std::generic_category(),
+                                            "failed to submit to io_uring"};
+                }
+            }
+        }
+
+        std::pair<std::size_t, std::int64_t> wait() override
+        {
+            while (true) {
+                const unsigned head{*cqHead_};
+                if (head != __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+                    const io_uring_cqe& cqe{cqes_[head & cqMask_]};
+                    const std::pair<std::size_t, std::int64_t> completion{
+                        static_cast<std::size_t>(cqe.user_data), cqe.res};
+                    __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+                    return completion;
+                }
+                if (::syscall(__NR_io_uring_enter, ringFd_, 0, 1,
+                              IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+                    errno != EINTR) {
+                    throw std::system_error{errno, std::generic_category(),
+                                            "failed to wait for io_uring"};
+                }
+            }
+        }
+
+        bool isIoUring() const override { return true; }
+
+      private:
+        void release()
+        {
+            if (sqes_) {
+                ::munmap(sqes_, sqesSize_);
+            }
+            if (cqRing_ && cqRing_ != sqRing_) {
+                ::munmap(cqRing_, cqRingSize_);
+            }
+            if (sqRing_) {
+                ::munmap(sqRing_, sqRingSize_);
+            }
+            if (ringFd_ >= 0) {
+                ::close(ringFd_);
+            }
+        }
+
+        void* map(const std::size_t size, const off_t offset)
+        {
+            void* mapping{::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE, ringFd_, offset)};
+            if (mapping == MAP_FAILED) {
+                // The destructor is not run if the constructor throws
+                const int error{errno};
+                this->release();
+                throw std::system_error{error, std::generic_category(),
+                                        "failed to map io_uring"};
+            }
+            return mapping;
+        }
+
+        int ringFd_{-1};
+        void* sqRing_{nullptr};
+        void* cqRing_{nullptr};
+        io_uring_sqe* sqes_{nullptr};
+        std::size_t sqRingSize_{0};
+        std::size_t cqRingSize_{0};
+        std::size_t sqesSize_{0};
+        unsigned* sqTail_{nullptr};
+        unsigned sqMask_{0};
+        unsigned* sqArray_{nullptr};
+        unsigned* cqHead_{nullptr};
+        unsigned* cqTail_{nullptr};
+        unsigned cqMask_{0};
+        io_uring_cqe* cqes_{nullptr};
+    };
+#endif
+
+    /// Make the queue for a backend, falling back to threads if need be
+    std::unique_ptr<IoQueue> makeQueue(const IoBackend backend,
+                                       const std::size_t depth)
+    {
+        if (backend == IoBackend::Threads) {
+            return std::make_unique<ThreadQueue>();
+        }
+#ifdef MPAGSCIPHER_ASYNCFILE_IO_URING
+        try {
+            return std::make_unique<IoUringQueue>(depth);
+        } catch (const std::system_error&) {
+            if (backend == IoBackend::IoUring) {
+                throw;
+            }
+        }
+#else
+        (void)depth;
+        if (backend == IoBackend::IoUring) {
+            throw std::system_error{ENOSYS, std::generic_category(),
+                                    "io_uring is not available"};
+        }
+#endif
+        return std::make_unique<ThreadQueue>();
+    }
+
+    void checkSizes(const std::size_t bufferSize, const std::size_t queueDepth)
+    {
+        if (bufferSize == 0 || queueDepth == 0) {
+            throw std::invalid_argument{
+                "I/O buffer size and queue depth must not be 0"};
+        }
+        // A single io_uring request is limited to 32-bit lengths
+        if (bufferSize > (std::size_t{1} << 30) || queueDepth > 4096) {
+            throw std::invalid_argument{
+                "I/O buffer size or queue depth is too large"};
+        }
+    }
+
+    std::system_error ioError(const std::int64_t result,
+                              const std::string& what)
+    {
+        return std::system_error{static_cast<int>(-result),
+                                 std::generic_category(), what};
+    }
+}    // namespace
+
+AsyncReader::AsyncReader(const std::string& fileName,
+                         const std::size_t bufferSize,
+                         const std::size_t queueDepth, const IoBackend backend)
+    : bufferSize_{bufferSize}
+{
+    checkSizes(bufferSize, queueDepth);
+
+    fd_ = ::open(fileName.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        throw std::system_error{errno, std::generic_category(),
+                                "failed to open '" + fileName + "'"};
+    }
+    struct stat status {};
+    if (::fstat(fd_, &status) != 0) {
+        const int error{errno};
+        ::close(fd_);
+        throw std::system_error{error, std::generic_category(),
+                                "failed to stat '" + fileName + "'"};
+    }
+    fileSize_ = static_cast<std::uint64_t>(status.st_size);
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    try {
+        queue_ = makeQueue(backend, queueDepth);
+    } catch (...) {
+        ::close(fd_);
+        throw;
+    }
+
+    // Only as many buffers as the file needs
+    const std::uint64_t nNeeded{(fileSize_ + bufferSize - 1) / bufferSize};
+    const std::size_t nBuffers{static_cast<std::size_t>(std::min<std::uint64_t>(
+        queueDepth, std::max<std::uint64_t>(nNeeded, 1)))};
+    buffers_.resize(nBuffers * bufferSize);
+    results_.assign(nBuffers, -1);
+    for (std::size_t buffer{0}; buffer < nBuffers; ++buffer) {
+        this->submit(buffer);
+    }
+}
+
+AsyncReader::~AsyncReader()
+{
+    // The buffers must not be freed while the kernel may still write to them
+    try {
+        while (!reads_.empty()) {
+            const auto completion = queue_->wait();
+            const auto isDone = [&](const Read& read) {
+                return read.buffer == completion.first;
+            };
+            reads_.erase(
+                std::find_if(std::begin(reads_), std::end(reads_), isDone));
+        }
+    } catch (...) {
+    }
+    ::close(fd_);
+}
+
+void AsyncReader::submit(const std::size_t buffer)
+{
+    if (nextOffset_ >= fileSize_) {
+        return;
+    }
+    const std::size_t length{static_cast<std::size_t>(
+        std::min<std::uint64_t>(bufferSize_, fileSize_ - nextOffset_))};
+    results_[buffer] = -1;
+    queue_->submit(IoQueue::Op::Read, fd_, &buffers_[buffer * bufferSize_],
+                   length, nextOffset_, buffer);
+    reads_.push_back(Read{buffer, nextOffset_, length});
+    nextOffset_ += length;
+}
+
+bool AsyncReader::next(const char*& data, std::size_t& n)
+{
+    // The caller has finished with the last buffer, so reuse it
+    if (holding_) {
+        holding_ = false;
+        this->submit(heldBuffer_);
+    }
+    if (reads_.empty()) {
+        return false;
+    }
+
+    // Wait for the earliest read, collecting any others that finish first
+    const Read read{reads_.front()};
+    while (results_[read.buffer] < 0) {
+        const auto completion = queue_->wait();
+        if (completion.second < 0) {
+            throw ioError(completion.second, "failed to read file");
+        }
+        results_[completion.first] = completion.second;
+    }
+    reads_.pop_front();
+
+    // A short read (e.g. from a signal) is finished off synchronously
+    char* buffer{&buffers_[read.buffer * bufferSize_]};
+    std::size_t got{static_cast<std::size_t>(results_[read.buffer])};
+    if (got < read.length) {
+        const std::int64_t rest{transferAll(IoQueue::Op::Read, fd_,
+                                            buffer + got, read.length - got,
+                                            read.offset + got)};
+        if (rest < 0) {
+            throw ioError(rest, "failed to read file");
+        }
+        got += static_cast<std::size_t>(rest);
+    }
+
+    data = buffer;
+    n = got;
+    heldBuffer_ = read.buffer;
+    holding_ = true;
+    return true;
+}
+
+bool AsyncReader::usesIoUring() const
+{
+    return queue_->isIoUring();
+}
+
+AsyncWriter::AsyncWriter(const std::string& fileName,
+                         const std::size_t bufferSize,
+                         const std::size_t queueDepth, const IoBackend backend)
+    : bufferSize_{bufferSize}
+{
+    checkSizes(bufferSize, queueDepth);
+
+    fd_ = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd_ < 0) {
+        throw std::system_error{errno, std::generic_category(),
+                                "failed to create '" + fileName + "'"};
+    }
+    try {
+        queue_ = makeQueue(backend, queueDepth);
+    } catch (...) {
+        ::close(fd_);
+        throw;
+    }
+
+    // One buffer is filled while the others are being written
+    const std::size_t nBuffers{queueDepth + 1};
+    buffers_.resize(nBuffers * bufferSize);
+    offsets_.assign(nBuffers, 0);
+    lengths_.assign(nBuffers, 0);
+    for (std::size_t buffer{nBuffers - 1}; buffer > 0; --buffer) {
+        free_.push_back(buffer);
+    }
+}
+
+AsyncWriter::~AsyncWriter()
+{
+    try {
+        this->close();
+    } catch (...) {
+    }
+}
+
+void AsyncWriter::write(const char* data, std::size_t n)
+{
+    while (n > 0) {
+        const std::size_t count{std::min(n, bufferSize_ - filled_)};
+        std::memcpy(&buffers_[current_ * bufferSize_ + filled_], data, count);
+        filled_ += count;
+        data += count;
+        n -= count;
+        if (filled_ == bufferSize_) {
+            this->submitCurrent();
+        }
+    }
+}
+
+void AsyncWriter::submitCurrent()
+{
+    offsets_[current_] = nextOffset_;
+    lengths_[current_] = filled_;
+    queue_->submit(IoQueue::Op::Write, fd_, &buffers_[current_ * bufferSize_],
+                   filled_, nextOffset_, current_);
+    ++inFlight_;
+    nextOffset_ += filled_;
+
+    if (free_.empty()) {
+        this->waitForOne();
+    }
+    current_ = free_.back();
+    free_.pop_back();
+    filled_ = 0;
+}
+
+void AsyncWriter::waitForOne()
+{
+    const auto completion = queue_->wait();
+    --inFlight_;
+    const std::size_t buffer{completion.first};
+    free_.push_back(buffer);
+    if (completion.second < 0) {
+        throw ioError(completion.second, "failed to write file");
+    }
+
+    // A short write is finished off synchronously
+    const std::size_t written{static_cast<std::size_t>(completion.second)};
+    if (written < lengths_[buffer]) {
+        const std::int64_t rest{transferAll(
+            IoQueue::Op::Write, fd_, &buffers_[buffer * bufferSize_] + written,
+            lengths_[buffer] - written, offsets_[buffer] + written)};
+        if (rest < 0) {
+            throw ioError(rest, "failed to write file");
+        }
+    }
+}
+
+void AsyncWriter::close()
+{
+    if (fd_ < 0) {
+        return;
+    }
+    const int fd{fd_};
+    try {
+        if (filled_ > 0) {
+            this->submitCurrent();
+        }
+        while (inFlight_ > 0) {
+            this->waitForOne();
+        }
+    } catch (...) {
+        // Wait for the rest before the buffers can go
+        while (inFlight_ > 0) {
+            try {
+                this->waitForOne();
+            } catch (...) {
+            }
+        }
+        fd_ = -1;
+        ::close(fd);
+        throw;
+    }
+    fd_ = -1;
+    if (::close(fd) != 0) {
+        throw std::system_error{errno, std::generic_category(),
+                                "failed to close file"};
+    }
+}
+
+bool AsyncWriter::usesIoUring() const
+{
+    return queue_->isIoUring();
+}
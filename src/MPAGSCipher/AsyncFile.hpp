@@ -0,0 +1,242 @@
+#ifndef MPAGSCIPHER_ASYNCFILE_HPP
+#define MPAGSCIPHER_ASYNCFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \file AsyncFile.hpp
+ * \brief Contains the declarations of the AsyncReader and AsyncWriter classes
+ */
+
+/**
+ * \enum IoBackend
+ * \brief Defines the ways that AsyncReader and AsyncWriter can do their I/O
+ */
+enum class IoBackend {
+    Automatic,    ///< io_uring if the kernel allows it, otherwise Threads
+    IoUring,      ///< Linux io_uring, driven directly through its system calls
+    Threads       ///< pread/pwrite on a background thread
+};
+
+class IoQueue;
+
+/**
+ * \class AsyncReader
+ * \brief Reads a file from start to finish with several large reads in flight at once
+ *
+ * The file is read into a fixed set of buffers, each of which is handed
+ * back to be read into again as soon as the caller has finished with it,
+ * so the caller can process one buffer while the reads of the next ones
+ * are still going on.
+ */
+class AsyncReader {
+  public:
+    /**
+     * \brief Open a file and start reading it
+     *
+     * \param fileName the name of the file
+     * \param bufferSize the size of each read
+     * \param queueDepth the number of reads to keep in flight
+     * \param backend how to do the reads
+     * \throw std::system_error if the file cannot be opened, or io_uring
+     *        was asked for and cannot be used
+     * \throw std::invalid_argument if the buffer size or depth is zero
+     */
+    AsyncReader(const std::string& fileName, const std::size_t bufferSize,
+                const std::size_t queueDepth,
+                const IoBackend backend = IoBackend::Automatic);
+
+    /// Wait for any reads still in flight and close the file
+    ~AsyncReader();
+
+    /// The reader cannot be copied
+    AsyncReader(const AsyncReader& rhs) = delete;
+    /// The reader cannot be moved
+    AsyncReader(AsyncReader&& rhs) = delete;
+    /// The reader cannot be copy assigned
+    AsyncReader& operator=(const AsyncReader& rhs) = delete;
+    /// The reader cannot be move assigned
+    AsyncReader& operator=(AsyncReader&& rhs) = delete;
+
+    /**
+     * \brief Get the next piece of the file
+     *
+     * The piece stays valid until the next call, when its buffer is reused.
+     *
+     * \param data set to the start of the piece
+     * \param n set to the number of bytes in the piece
+     * \return false once the whole file has been read
+     * \throw std::system_error if a read fails
+     */
+    bool next(const char*& data, std::size_t& n);
+
+    /**
+     * \brief Determine whether io_uring is being used
+     *
+     * \return true for io_uring, false for the thread fallback
+     */
+    bool usesIoUring() const;
+
+  private:
+    /// A read that has been submitted
+    struct Read {
+        /// The index of the buffer it reads into
+        std::size_t buffer;
+        /// The offset in the file
+        std::uint64_t offset;
+        /// The number of bytes asked for
+        std::size_t length;
+    };
+
+    /// Start reading the next part of the file into a buffer
+    void submit(const std::size_t buffer);
+
+    /// The file descriptor
+    int fd_{-1};
+
+    /// The size of the file
+    std::uint64_t fileSize_{0};
+
+    /// The size of each buffer
+    std::size_t bufferSize_;
+
+    /// The buffers, one after another
+    std::vector<char> buffers_;
+
+    /// The number of bytes read into each buffer, once its read is done
+    std::vector<std::int64_t> results_;
+
+    /// The reads that are in flight, in order of their offset
+    std::deque<Read> reads_;
+
+    /// The offset of the next read to submit
+    std::uint64_t nextOffset_{0};
+
+    /// The buffer handed out by the last call to next(), if any
+    std::size_t heldBuffer_{0};
+
+    /// Whether a buffer is held
+    bool holding_{false};
+
+    /// The queue the reads are submitted to
+    std::unique_ptr<IoQueue> queue_;
+};
+
+/**
+ * \class AsyncWriter
+ * \brief Writes a file from start to finish with several large writes in flight at once
+ *
+ * What is written is gathered into a buffer, which is submitted as soon as
+ * it is full while the next one is filled, so the caller only waits when
+ * every buffer is still being written.
+ */
+class AsyncWriter {
+  public:
+    /**
+     * \brief Create (or truncate) a file to write
+     *
+     * \param fileName the name of the file
+     * \param bufferSize the size of each write
+     * \param queueDepth the number of writes to keep in flight
+     * \param backend how to do the writes
+     * \throw std::system_error if the file cannot be created, or io_uring
+     *        was asked for and cannot be used
+     * \throw std::invalid_argument if the buffer size or depth is zero
+     */
+    AsyncWriter(const std::string& fileName, const std::size_t bufferSize,
+                const std::size_t queueDepth,
+                const IoBackend backend = IoBackend::Automatic);
+
+    /// Close the file if close() has not been called, ignoring any errors
+    ~AsyncWriter();
+
+    /// The writer cannot be copied
+    AsyncWriter(const AsyncWriter& rhs) = delete;
+    /// The writer cannot be moved
+    AsyncWriter(AsyncWriter&& rhs) = delete;
+    /// The writer cannot be copy assigned
+    AsyncWriter& operator=(const AsyncWriter& rhs) = delete;
+    /// The writer cannot be move assigned
+    AsyncWriter& operator=(AsyncWriter&& rhs) = delete;
+
+    /**
+     * \brief Append data to the file
+     *
+     * \param data the data
+     * \param n the number of bytes
+     * \throw std::system_error if an earlier write has failed
+     */
+    void write(const char* data, std::size_t n);
+
+    /**
+     * \brief Append a string to the file
+     *
+     * \param text the string
+     * \throw std::system_error if an earlier write has failed
+     */
+    void write(const std::string& text)
+    {
+        this->write(text.data(), text.size());
+    }
+
+    /**
+     * \brief Write out anything that is left and close the file
+     *
+     * \throw std::system_error if a write fails
+     */
+    void close();
+
+    /**
+     * \brief Determine whether io_uring is being used
+     *
+     * \return true for io_uring, false for the thread fallback
+     */
+    bool usesIoUring() const;
+
+  private:
+    /// Submit the buffer being filled, and get another one to fill
+    void submitCurrent();
+
+    /// Wait for one write to finish, and make its buffer free
+    void waitForOne();
+
+    /// The file descriptor
+    int fd_{-1};
+
+    /// The size of each buffer
+    std::size_t bufferSize_;
+
+    /// The buffers, one after another
+    std::vector<char> buffers_;
+
+    /// The offset of the write from each buffer
+    std::vector<std::uint64_t> offsets_;
+
+    /// The length of the write from each buffer
+    std::vector<std::size_t> lengths_;
+
+    /// The buffers that are not being written
+    std::vector<std::size_t> free_;
+
+    /// The buffer being filled
+    std::size_t current_{0};
+
+    /// The number of bytes in the buffer being filled
+    std::size_t filled_{0};
+
+    /// The number of writes in flight
+    std::size_t inFlight_{0};
+
+    /// The offset of the next write
+    std::uint64_t nextOffset_{0};
+
+    /// The queue the writes are submitted to
+    std::unique_ptr<IoQueue> queue_;
+};
+
+#endif    // MPAGSCIPHER_ASYNCFILE_HPP
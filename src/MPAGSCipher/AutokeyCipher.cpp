@@ -0,0 +1,78 @@
+#include "AutokeyCipher.hpp"
+#include "ShiftKernel.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace {
+    /// Number of letters handed to each thread at a time when encrypting
+    constexpr std::size_t lettersPerTask{1 << 18};
+}    // namespace
+
+AutokeyCipher::AutokeyCipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void AutokeyCipher::setKey(const std::string& key)
+{
+    // Store the original key
+    primer_ = key;
+
+    // Make sure the key is upper case
+    std::transform(std::begin(primer_), std::end(primer_),
+                   std::begin(primer_), ::toupper);
+
+    // Remove non-alphabet characters
+    primer_.erase(std::remove_if(std::begin(primer_), std::end(primer_),
+                                 [](char c) { return !std::isalpha(c); }),
+                  std::end(primer_));
+
+    // Check that the key is not now empty
+    if (primer_.empty()) {
+        throw InvalidKey{"Key provided to AutokeyCipher is empty"};
+    }
+}
+
+std::string AutokeyCipher::applyCipher(const std::string& inputText,
+                                       const CipherMode cipherMode) const
+{
+    const std::size_t length{inputText.size()};
+    const std::size_t primerLength{primer_.size()};
+    std::string outputText(length, ' ');
+    const char* in{inputText.data()};
+    char* out{outputText.data()};
+
+    // The start of the text is always shifted by the primer
+    const std::size_t head{std::min(primerLength, length)};
+    ShiftKernel::applyKeyStream(in, primer_.data(), out, head, cipherMode);
+
+    if (cipherMode == CipherMode::Encrypt) {
+        // The rest of the key stream is the plaintext, which we already have,
+        // so the text can be split into independent chunks, each shifted by
+        // the stretch of plaintext lying primerLength letters before it
+        parallelFor(length - head, lettersPerTask,
+                    [&](std::size_t begin, std::size_t end) {
+                        const std::size_t offset{head + begin};
+                        ShiftKernel::applyKeyStream(
+                            in + offset, in + offset - primerLength,
+                            out + offset, end - begin, cipherMode);
+                    });
+    } else {
+        // The rest of the key stream is the plaintext that is being
+        // recovered, so work forward one primer-length block at a time,
+        // each shifted back by the block of plaintext recovered just before
+        for (std::size_t offset{head}; offset < length;
+             offset += primerLength) {
+            const std::size_t blockLength{
+                std::min(primerLength, length - offset)};
+            ShiftKernel::applyKeyStream(in + offset,
+                                        out + offset - primerLength,
+                                        out + offset, blockLength, cipherMode);
+        }
+    }
+
+    return outputText;
+}
@@ -0,0 +1,63 @@
+#ifndef MPAGSCIPHER_AUTOKEYCIPHER_HPP
+#define MPAGSCIPHER_AUTOKEYCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <string>
+
+/**
+ * \file AutokeyCipher.hpp
+ * \brief Contains the declaration of the AutokeyCipher class
+ */
+
+/**
+ * \class AutokeyCipher
+ * \brief Encrypt or decrypt text using the autokey variant of the Vigenere cipher
+ *
+ * The key is a keyword (the primer) which starts the key stream, after
+ * which the key stream continues with the plaintext itself, so that e.g. the
+ * key "QUEENLY" applied to "ATTACKATDAWN" uses the key stream
+ * "QUEENLYATTAC".
+ * The text must consist of upper-case letters only.
+ */
+class AutokeyCipher : public Cipher {
+  public:
+    /**
+     * \brief Create a new AutokeyCipher with the given key
+     *
+     * \param key the key to use in the cipher
+     */
+    explicit AutokeyCipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the key to use in the cipher
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::Autokey; }
+
+  private:
+    /// The primer that starts the key stream
+    std::string primer_{""};
+};
+
+#endif    // MPAGSCIPHER_AUTOKEYCIPHER_HPP
@@ -0,0 +1,386 @@
+#include "BatchCipher.hpp"
+#include "CaesarCipher.hpp"
+#include "PlayfairCipher.hpp"
+#include "PolybiusGrid.hpp"
+#include "ShiftKernel.hpp"
+#include "ThreadPool.hpp"
+#include "VigenereCipher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// The number of letters in the alphabet
+    constexpr std::size_t nLetters{26};
+
+    /// The number of keys handed to each thread at a time
+    constexpr std::size_t keysPerTask{8};
+
+    /// The number of characters of text each block of keys works on at a time
+    constexpr std::size_t lettersPerChunk{1 << 14};
+
+    /// The number of characters handed to each thread at a time when counting
+    constexpr std::size_t lettersPerTask{1 << 20};
+
+    /// The number of possible Playfair digraphs
+    constexpr std::size_t nDigraphs{PolybiusGrid::nCells * PolybiusGrid::nCells};
+
+    /// The relative frequency of each letter in English text, in percent
+    constexpr std::array<double, nLetters> englishFrequencies{
+        8.167, 1.492, 2.782, 4.253, 12.702, 2.228, 2.015, 6.094, 6.966,
+        0.153, 0.772, 4.025, 2.406, 6.749,  7.507, 1.929, 0.095, 5.987,
+        6.327, 9.056, 2.758, 0.978, 2.360,  0.150, 1.974, 0.074};
+
+    /// Type definition for a Playfair lookup table indexed by the letters of
+    /// each digraph, rather than by their cells in a keyed grid
+    using LetterTable = std::array<char, 2 * nDigraphs>;
+
+    /**
+     * \brief Get a grid with no key, used to number the letters 0-24
+     *
+     * \return the grid, which is created on first use since it depends on
+     *         the alphabet
+     */
+    const PolybiusGrid& plainGrid()
+    {
+        static const PolybiusGrid grid{""};
+        return grid;
+    }
+
+    /**
+     * \brief Find the shift (as a letter) for each position of each key
+     *
+     * \param type the cipher type, either Caesar or Vigenere
+     * \param keys the keys
+     * \return the letters of each key, as used by ShiftKernel
+     */
+    std::vector<std::string> shiftKeys(const CipherType type,
+                                       const std::vector<std::string>& keys)
+    {
+        std::vector<std::string> shifts;
+        shifts.reserve(keys.size());
+        for (const auto& key : keys) {
+            if (type == CipherType::Caesar) {
+                const CaesarCipher cipher{key};
+                shifts.emplace_back(1, static_cast<char>('A' + cipher.key()));
+            } else {
+                shifts.push_back(VigenereCipher::normaliseKey(key));
+            }
+        }
+        return shifts;
+    }
+
+    /**
+     * \brief Make the Playfair lookup table for a key, indexed by letter
+     *
+     * \param key the key
+     * \param cipherMode whether to make the encryption or decryption table
+     * \return the two output letters for each pair of letters, numbered as
+     *         in plainGrid()
+     */
+    LetterTable letterTable(const std::string& key,
+                            const CipherMode cipherMode)
+    {
+        const PlayfairCipher cipher{key};
+        const PolybiusGrid& grid{cipher.grid()};
+        const PolybiusGrid::DigraphTable& table{
+            cipher.digraphTable(cipherMode)};
+
+        LetterTable letters{};
+        for (std::size_t first{0}; first < PolybiusGrid::nCells; ++first) {
+            const std::size_t keyedFirst{grid.cell(plainGrid().letter(first))};
+            for (std::size_t second{0}; second < PolybiusGrid::nCells;
+                 ++second) {
+                const std::size_t keyedSecond{
+                    grid.cell(plainGrid().letter(second))};
+                const std::size_t from{
+                    2 * (PolybiusGrid::nCells * keyedFirst + keyedSecond)};
+                const std::size_t to{
+                    2 * (PolybiusGrid::nCells * first + second)};
+                letters[to] = table[from];
+                letters[to + 1] = table[from + 1];
+            }
+        }
+        return letters;
+    }
+
+    /**
+     * \brief Number each digraph of some prepared Playfair text
+     *
+     * \param prepared the text, as returned by PlayfairCipher::prepareText
+     * \return the index of each digraph into a LetterTable, halved
+     */
+    std::vector<std::uint16_t> digraphIndices(const std::string& prepared)
+    {
+        std::vector<std::uint16_t> indices(prepared.size() / 2);
+        for (std::size_t i{0}; i < indices.size(); ++i) {
+            indices[i] = static_cast<std::uint16_t>(
+                PolybiusGrid::nCells * plainGrid().cell(prepared[2 * i]) +
+                plainGrid().cell(prepared[2 * i + 1]));
+        }
+        return indices;
+    }
+
+    /**
+     * \brief Count the letters at each position of a repeating key
+     *
+     * \param text the text
+     * \param period the length of the key
+     * \return the number of times each letter appears at each position
+     */
+    std::vector<BatchCipher::Histogram> countByPosition(
+        const std::string& text, const std::size_t period)
+    {
+        std::vector<BatchCipher::Histogram> counts(period,
+                                                   BatchCipher::Histogram{});
+        std::mutex countsMutex;
+        parallelFor(
+            text.size(), lettersPerTask,
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<BatchCipher::Histogram> local(
+                    period, BatchCipher::Histogram{});
+                std::size_t position{begin % period};
+                for (std::size_t i{begin}; i < end; ++i) {
+                    const char c{text[i]};
+                    if (c >= 'A' && c <= 'Z') {
+                        ++local[position][c - 'A'];
+                    }
+                    if (++position == period) {
+                        position = 0;
+                    }
+                }
+                std::lock_guard<std::mutex> lock{countsMutex};
+                for (std::size_t p{0}; p < period; ++p) {
+                    for (std::size_t l{0}; l < nLetters; ++l) {
+                        counts[p][l] += local[p][l];
+                    }
+                }
+            });
+        return counts;
+    }
+
+    /**
+     * \brief Apply the Caesar or Vigenere cipher with each key
+     */
+    std::vector<std::string> applyShifts(const std::string& inputText,
+                                         const std::vector<std::string>& shifts,
+                                         const CipherMode cipherMode)
+    {
+        const std::size_t n{inputText.size()};
+        std::vector<std::string> outputs(shifts.size());
+
+        parallelFor(shifts.size(), keysPerTask, [&](std::size_t begin,
+                                                    std::size_t end) {
+            // Repeat each key far enough to cover a chunk of the text
+            // starting from any position in the key
+            std::vector<std::string> keyStreams;
+            for (std::size_t k{begin}; k < end; ++k) {
+                const std::string& key{shifts[k]};
+                std::string keyStream;
+                keyStream.reserve(lettersPerChunk + 2 * key.size());
+                while (keyStream.size() < lettersPerChunk + key.size()) {
+                    keyStream += key;
+                }
+                keyStreams.push_back(std::move(keyStream));
+                outputs[k].resize(n);
+            }
+
+            // Apply every key in the block to each chunk while it is in cache
+            for (std::size_t offset{0}; offset < n; offset += lettersPerChunk) {
+                const std::size_t length{std::min(lettersPerChunk, n - offset)};
+                for (std::size_t k{begin}; k < end; ++k) {
+                    ShiftKernel::applyKeyStream(
+                        inputText.data() + offset,
+                        keyStreams[k - begin].data() +
+                            offset % shifts[k].size(),
+                        outputs[k].data() + offset, length, cipherMode);
+                }
+            }
+        });
+
+        return outputs;
+    }
+
+    /**
+     * \brief Apply the Playfair cipher with each key
+     */
+    std::vector<std::string> applyPlayfair(const std::string& inputText,
+                                           const std::vector<std::string>& keys,
+                                           const CipherMode cipherMode)
+    {
+        const std::vector<std::uint16_t> indices{
+            digraphIndices(PlayfairCipher::prepareText(inputText))};
+        const std::size_t n{indices.size()};
+        std::vector<std::string> outputs(keys.size());
+
+        parallelFor(keys.size(), keysPerTask, [&](std::size_t begin,
+                                                  std::size_t end) {
+            std::vector<LetterTable> tables;
+            for (std::size_t k{begin}; k < end; ++k) {
+                tables.push_back(letterTable(keys[k], cipherMode));
+                outputs[k].resize(2 * n);
+            }
+
+            constexpr std::size_t digraphsPerChunk{lettersPerChunk / 2};
+            for (std::size_t offset{0}; offset < n;
+                 offset += digraphsPerChunk) {
+                const std::size_t last{std::min(offset + digraphsPerChunk, n)};
+                for (std::size_t k{begin}; k < end; ++k) {
+                    const LetterTable& table{tables[k - begin]};
+                    char* out{outputs[k].data()};
+                    for (std::size_t i{offset}; i < last; ++i) {
+                        const std::size_t index{2 * std::size_t{indices[i]}};
+                        out[2 * i] = table[index];
+                        out[2 * i + 1] = table[index + 1];
+                    }
+                }
+            }
+        });
+
+        return outputs;
+    }
+
+    /**
+     * \brief Score the result of the Caesar or Vigenere cipher with each key
+     */
+    std::vector<double> scoreShifts(const std::string& inputText,
+                                    const std::vector<std::string>& shifts,
+                                    const CipherMode cipherMode)
+    {
+        // Count the letters at each position for every length of key
+        std::set<std::size_t> periods;
+        for (const auto& key : shifts) {
+            periods.insert(key.size());
+        }
+        std::vector<std::vector<BatchCipher::Histogram>> countsByPeriod(
+            *periods.rbegin() + 1);
+        for (const std::size_t period : periods) {
+            countsByPeriod[period] = countByPosition(inputText, period);
+        }
+
+        // Shifting every letter at a position of the key just rotates the
+        // counts for that position
+        std::vector<double> scores(shifts.size());
+        for (std::size_t k{0}; k < shifts.size(); ++k) {
+            const std::string& key{shifts[k]};
+            const auto& counts = countsByPeriod[key.size()];
+            BatchCipher::Histogram result{};
+            for (std::size_t p{0}; p < key.size(); ++p) {
+                const std::size_t shift{
+                    (cipherMode == CipherMode::Encrypt)
+                        ? static_cast<std::size_t>(key[p] - 'A')
+                        : nLetters - static_cast<std::size_t>(key[p] - 'A')};
+                for (std::size_t l{0}; l < nLetters; ++l) {
+                    result[(l + shift) % nLetters] += counts[p][l];
+                }
+            }
+            scores[k] = BatchCipher::chiSquared(result);
+        }
+        return scores;
+    }
+
+    /**
+     * \brief Score the result of the Playfair cipher with each key
+     */
+    std::vector<double> scorePlayfair(const std::string& inputText,
+                                      const std::vector<std::string>& keys,
+                                      const CipherMode cipherMode)
+    {
+        // Count the digraphs, which only depends on the text
+        std::array<std::uint64_t, nDigraphs> digraphCounts{};
+        for (const std::uint16_t index :
+             digraphIndices(PlayfairCipher::prepareText(inputText))) {
+            ++digraphCounts[index];
+        }
+
+        // Each digraph gives the same two letters wherever it appears
+        std::vector<double> scores(keys.size());
+        parallelFor(keys.size(), keysPerTask, [&](std::size_t begin,
+                                                  std::size_t end) {
+            for (std::size_t k{begin}; k < end; ++k) {
+                const LetterTable table{letterTable(keys[k], cipherMode)};
+                BatchCipher::Histogram result{};
+                for (std::size_t d{0}; d < nDigraphs; ++d) {
+                    result[table[2 * d] - 'A'] += digraphCounts[d];
+                    result[table[2 * d + 1] - 'A'] += digraphCounts[d];
+                }
+                scores[k] = BatchCipher::chiSquared(result);
+            }
+        });
+        return scores;
+    }
+}    // namespace
+
+namespace BatchCipher {
+    bool isSupported(const CipherType type)
+    {
+        return type == CipherType::Caesar || type == CipherType::Vigenere ||
+               type == CipherType::Playfair;
+    }
+
+    std::vector<std::string> applyCipher(const CipherType type,
+                                         const std::string& inputText,
+                                         const std::vector<std::string>& keys,
+                                         const CipherMode cipherMode)
+    {
+        if (!isSupported(type)) {
+            throw std::invalid_argument{
+                "BatchCipher does not support this type of cipher"};
+        }
+        if (type == CipherType::Playfair) {
+            return applyPlayfair(inputText, keys, cipherMode);
+        }
+        return applyShifts(inputText, shiftKeys(type, keys), cipherMode);
+    }
+
+    std::vector<double> scoreKeys(const CipherType type,
+                                  const std::string& inputText,
+                                  const std::vector<std::string>& keys,
+                                  const CipherMode cipherMode)
+    {
+        if (!isSupported(type)) {
+            throw std::invalid_argument{
+                "BatchCipher does not support this type of cipher"};
+        }
+        if (keys.empty()) {
+            return {};
+        }
+        if (type == CipherType::Playfair) {
+            return scorePlayfair(inputText, keys, cipherMode);
+        }
+        return scoreShifts(inputText, shiftKeys(type, keys), cipherMode);
+    }
+
+    Histogram countLetters(const std::string& text)
+    {
+        return countByPosition(text, 1).front();
+    }
+
+    double chiSquared(const Histogram& counts)
+    {
+        std::uint64_t total{0};
+        for (const std::uint64_t count : counts) {
+            total += count;
+        }
+        if (total == 0) {
+            return 0.0;
+        }
+
+        double statistic{0.0};
+        for (std::size_t l{0}; l < nLetters; ++l) {
+            const double expected{static_cast<double>(total) *
+                                  englishFrequencies[l] / 100.0};
+            const double difference{static_cast<double>(counts[l]) - expected};
+            statistic += difference * difference / expected;
+        }
+        return statistic;
+    }
+}    // namespace BatchCipher
@@ -0,0 +1,98 @@
+#ifndef MPAGSCIPHER_BATCHCIPHER_HPP
+#define MPAGSCIPHER_BATCHCIPHER_HPP
+
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \file BatchCipher.hpp
+ * \brief Contains the declarations of the functions for applying a cipher to one text under many keys
+ */
+
+/**
+ * \namespace BatchCipher
+ * \brief Namespace to group functions that try many keys of one cipher on the same text
+ *
+ * This is what is needed for cryptanalysis (trying every key to see which
+ * gives the most English-like result) and for generating test vectors.
+ * Rather than constructing a Cipher for each key and passing over the whole
+ * text each time, the work that does not depend on the key is done once,
+ * and the keys are shared out between threads in blocks, each of which
+ * streams through the text a cache-sized chunk at a time.
+ *
+ * The Caesar, Vigenere and Playfair ciphers are supported. The text is
+ * expected to have been transliterated into upper-case letters already.
+ */
+namespace BatchCipher {
+    /// Type definition for the number of times each letter appears
+    using Histogram = std::array<std::uint64_t, 26>;
+
+    /**
+     * \brief Determine whether a type of cipher can be used in a batch
+     *
+     * \param type the cipher type
+     * \return true if the cipher is supported
+     */
+    bool isSupported(const CipherType type);
+
+    /**
+     * \brief Apply a cipher to the same text with each of the given keys
+     *
+     * \param type the cipher type
+     * \param inputText the text to encrypt or decrypt
+     * \param keys the keys to use, in the form the cipher expects
+     * \param cipherMode whether to encrypt or decrypt the text
+     * \return the result for each key, in the same order as the keys
+     * \throw std::invalid_argument if the cipher is not supported
+     * \throw InvalidKey if any of the keys is invalid
+     */
+    std::vector<std::string> applyCipher(const CipherType type,
+                                         const std::string& inputText,
+                                         const std::vector<std::string>& keys,
+                                         const CipherMode cipherMode);
+
+    /**
+     * \brief Score how English-like the result of each key would be
+     *
+     * The score is chiSquared() of the letter counts of the result, which
+     * are worked out from counts taken over the input text, so the results
+     * themselves are never built and the cost per key does not depend on
+     * the length of the text.
+     *
+     * \param type the cipher type
+     * \param inputText the text to encrypt or decrypt
+     * \param keys the keys to use, in the form the cipher expects
+     * \param cipherMode whether to encrypt or decrypt the text
+     * \return the score for each key, in the same order as the keys, where
+     *         lower means more like English
+     * \throw std::invalid_argument if the cipher is not supported
+     * \throw InvalidKey if any of the keys is invalid
+     */
+    std::vector<double> scoreKeys(const CipherType type,
+                                  const std::string& inputText,
+                                  const std::vector<std::string>& keys,
+                                  const CipherMode cipherMode);
+
+    /**
+     * \brief Count the letters in a text
+     *
+     * \param text the text
+     * \return the number of times each upper-case letter appears
+     */
+    Histogram countLetters(const std::string& text);
+
+    /**
+     * \brief Compare letter counts with those expected for English
+     *
+     * \param counts the number of times each letter appears
+     * \return the chi-squared statistic, or 0 if there are no letters
+     */
+    double chiSquared(const Histogram& counts);
+}    // namespace BatchCipher
+
+#endif    // MPAGSCIPHER_BATCHCIPHER_HPP
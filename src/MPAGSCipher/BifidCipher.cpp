@@ -0,0 +1,115 @@
+#include "BifidCipher.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace {
+    /// Number of letters handed to each thread at a time
+    constexpr std::size_t lettersPerTask{1 << 17};
+
+    /**
+     * \brief Encrypt a single letter of a block
+     *
+     * The coordinate sequence is the rows of the letters in the block followed
+     * by their columns, and encrypted letter k is found at the row and column
+     * given by elements 2k and 2k+1 of the sequence.
+     *
+     * \param grid the grid
+     * \param block the start of the block
+     * \param blockLength the number of letters in the block
+     * \param k the position of the letter in the block
+     * \return the encrypted letter
+     */
+    char encryptLetter(const PolybiusGrid& grid, const char* block,
+                       const std::size_t blockLength, const std::size_t k)
+    {
+        auto coordinate = [&](const std::size_t t) {
+            return (t < blockLength)
+                       ? grid.cell(block[t]) / PolybiusGrid::size
+                       : grid.cell(block[t - blockLength]) % PolybiusGrid::size;
+        };
+        return grid.letter(coordinate(2 * k), coordinate(2 * k + 1));
+    }
+
+    /**
+     * \brief Decrypt a single letter of a block
+     *
+     * The coordinate sequence is the row and column of each letter in the
+     * block in turn, and decrypted letter k is found at the row and column
+     * given by elements k and k + blockLength of the sequence.
+     *
+     * \param grid the grid
+     * \param block the start of the block
+     * \param blockLength the number of letters in the block
+     * \param k the position of the letter in the block
+     * \return the decrypted letter
+     */
+    char decryptLetter(const PolybiusGrid& grid, const char* block,
+                       const std::size_t blockLength, const std::size_t k)
+    {
+        auto coordinate = [&](const std::size_t t) {
+            const std::size_t cell{grid.cell(block[t / 2])};
+            return (t % 2 == 0) ? cell / PolybiusGrid::size
+                                : cell % PolybiusGrid::size;
+        };
+        return grid.letter(coordinate(k), coordinate(k + blockLength));
+    }
+}    // namespace
+
+BifidCipher::BifidCipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void BifidCipher::setKey(const std::string& key)
+{
+    // Split off the period, if there is one
+    const std::size_t comma{key.find(',')};
+    grid_.setKey(key.substr(0, comma));
+
+    period_ = 0;
+    if (comma != std::string::npos) {
+        const std::string period{key.substr(comma + 1)};
+        if (period.empty() || period.size() > 9 ||
+            !std::all_of(std::begin(period), std::end(period),
+                         [](char c) { return std::isdigit(c); })) {
+            throw InvalidKey{
+                "Period provided to BifidCipher must be a non-negative integer"};
+        }
+        period_ = std::stoul(period);
+    }
+}
+
+std::string BifidCipher::applyCipher(const std::string& inputText,
+                                     const CipherMode cipherMode) const
+{
+    // Remove anything that isn't in the grid
+    std::string text{inputText};
+    text.erase(std::remove_if(std::begin(text), std::end(text),
+                              [this](char c) {
+                                  return grid_.cell(c) == PolybiusGrid::noCell;
+                              }),
+               std::end(text));
+
+    const std::size_t length{text.size()};
+    const std::size_t period{(period_ == 0) ? length : period_};
+    std::string outputText(length, ' ');
+    const char* in{text.data()};
+    char* out{outputText.data()};
+
+    auto body = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i) {
+            // Find the block holding this letter
+            const std::size_t start{(i / period) * period};
+            const std::size_t n{std::min(period, length - start)};
+            out[i] = (cipherMode == CipherMode::Encrypt)
+                         ? encryptLetter(grid_, in + start, n, i - start)
+                         : decryptLetter(grid_, in + start, n, i - start);
+        }
+    };
+    parallelFor(length, lettersPerTask, body);
+
+    return outputText;
+}
@@ -0,0 +1,72 @@
+#ifndef MPAGSCIPHER_BIFIDCIPHER_HPP
+#define MPAGSCIPHER_BIFIDCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+#include "PolybiusGrid.hpp"
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \file BifidCipher.hpp
+ * \brief Contains the declaration of the BifidCipher class
+ */
+
+/**
+ * \class BifidCipher
+ * \brief Encrypt or decrypt text using the Bifid cipher with the given key
+ *
+ * The key is a keyword used to fill a PolybiusGrid, optionally followed by a
+ * comma and the period, e.g. "playfair,5".
+ * The text is split into blocks of that many letters (or taken as a single
+ * block if no period is given). The row numbers of the letters in each block
+ * are written out followed by their column numbers, and this sequence is read
+ * back in pairs as the coordinates of the encrypted letters.
+ * Each letter of the output depends only on two coordinates in the sequence,
+ * which are looked up directly, so the text can be split across threads at
+ * any point.
+ */
+class BifidCipher : public Cipher {
+  public:
+    /**
+     * \brief Create a new BifidCipher with the given key
+     *
+     * \param key the key to use in the cipher
+     */
+    explicit BifidCipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the key to use in the cipher
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::Bifid; }
+
+  private:
+    /// The grid generated from the keyword
+    PolybiusGrid grid_{""};
+
+    /// The number of letters in each block, 0 for a single block
+    std::size_t period_{0};
+};
+
+#endif    // MPAGSCIPHER_BIFIDCIPHER_HPP
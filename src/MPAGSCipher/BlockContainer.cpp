@@ -0,0 +1,381 @@
+#include "BlockContainer.hpp"
+#include "CipherChain.hpp"
+#include "CipherMode.hpp"
+#include "Crc32c.hpp"
+#include "LetterCompressor.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    const std::string headerMagic{"MPAGSCT1"};
+    const std::string footerMagic{"MPAGSIDX"};
+
+    /// The size of the footer, and of each entry in the index
+    constexpr std::uint64_t footerSize{24};
+    constexpr std::uint64_t indexEntrySize{36};
+
+    /// The values of the compression byte in the header
+    constexpr char noCompression{0};
+    constexpr char letterCompression{1};
+
+    /// The last type that can appear in a container header
+    constexpr std::uint8_t lastCipherType{
+        static_cast<std::uint8_t>(CipherType::AesCtr)};
+
+    void putUint64(std::string& out, const std::uint64_t value)
+    {
+        for (std::size_t i{0}; i < 8; ++i) {
+            out += static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+    }
+
+    void putUint32(std::string& out, const std::uint32_t value)
+    {
+        for (std::size_t i{0}; i < 4; ++i) {
+            out += static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+    }
+
+    std::uint32_t getUint32(const char* in)
+    {
+        std::uint32_t value{0};
+        for (std::size_t i{0}; i < 4; ++i) {
+            const unsigned char byte{static_cast<unsigned char>(in[i])};
+            value |= static_cast<std::uint32_t>(byte) << (8 * i);
+        }
+        return value;
+    }
+
+    std::uint64_t getUint64(const char* in)
+    {
+        std::uint64_t value{0};
+        for (std::size_t i{0}; i < 8; ++i) {
+            const unsigned char byte{static_cast<unsigned char>(in[i])};
+            value |= static_cast<std::uint64_t>(byte) << (8 * i);
+        }
+        return value;
+    }
+
+    std::string readBytes(std::istream& in, const std::uint64_t offset,
+                          const std::uint64_t n)
+    {
+        std::string bytes(n, '\0');
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(&bytes[0], static_cast<std::streamsize>(n));
+        if (static_cast<std::uint64_t>(in.gcount()) != n) {
+            throw InvalidContainer{"container is truncated"};
+        }
+        return bytes;
+    }
+
+    /// Apply each cipher in turn to a text
+    std::string applyChain(const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                           std::string text, const CipherMode cipherMode)
+    {
+        for (const auto& cipher : ciphers) {
+            text = cipher->applyCipher(text, cipherMode);
+        }
+        return text;
+    }
+
+    /// Decompress a block, checking that it gives back the right length
+    std::string decompressBlock(const std::string& text,
+                                const BlockContainer::Block& block)
+    {
+        std::string plainText;
+        try {
+            plainText = LetterCompressor::decompress(
+                text, static_cast<std::size_t>(block.plainLength));
+        } catch (const std::invalid_argument&) {
+        }
+        if (plainText.size() != block.plainLength) {
+            throw InvalidContainer{"block at offset " +
+                                   std::to_string(block.plainOffset) +
+                                   " does not decompress"};
+        }
+        return plainText;
+    }
+
+    /// Compute the checksum of a block of cipher text
+    std::uint32_t checksum(const std::string& text)
+    {
+        return Crc32c::checksum(text.data(), text.size());
+    }
+}    // namespace
+
+namespace BlockContainer {
+    std::uint64_t keyFingerprint(const std::vector<CipherType>& types,
+                                 const std::vector<std::string>& keys)
+    {
+        std::uint64_t hash{0xcbf29ce484222325};
+        const auto addByte = [&hash](const unsigned char byte) {
+            hash ^= byte;
+            hash *= 0x100000001b3;
+        };
+
+        // Include the length of each key so that keys cannot run together
+        for (std::size_t i{0}; i < types.size(); ++i) {
+            addByte(static_cast<unsigned char>(types[i]));
+            const std::string key{i < keys.size() ? keys[i] : ""};
+            for (std::size_t j{0}; j < 8; ++j) {
+                addByte(static_cast<unsigned char>(key.size() >> (8 * j)));
+            }
+            for (const char c : key) {
+                addByte(static_cast<unsigned char>(c));
+            }
+        }
+        return hash;
+    }
+
+    std::string encode(const std::string& plainText,
+                       const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                       const std::vector<CipherType>& types,
+                       const std::vector<std::string>& keys,
+                       const std::size_t blockSize, const bool compress)
+    {
+        if (blockSize == 0) {
+            throw std::invalid_argument{"container block size must not be 0"};
+        }
+        if (types.size() != keys.size() || types.size() > 255) {
+            throw std::invalid_argument{
+                "container needs one key for each of at most 255 ciphers"};
+        }
+        if (std::any_of(std::begin(types), std::end(types),
+                        CipherChain::operatesOnBytes)) {
+            throw std::invalid_argument{
+                "container cannot hold text encrypted with chacha20 or aesctr"};
+        }
+        if (compress && !std::all_of(std::begin(types), std::end(types),
+                                     CipherChain::isReversible)) {
+            throw std::invalid_argument{
+                "compressed text cannot be encrypted with playfair, hill, "
+                "bifid or foursquare"};
+        }
+
+        // Compress and encrypt each block as a message of its own, taking
+        // its checksum while it is still in cache
+        const std::size_t nBlocks{(plainText.size() + blockSize - 1) /
+                                  blockSize};
+        std::vector<std::string> blockTexts(nBlocks);
+        std::vector<std::uint32_t> checksums(nBlocks);
+        parallelFor(nBlocks, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                std::string text{plainText.substr(i * blockSize, blockSize)};
+                if (compress) {
+                    text = LetterCompressor::compress(text);
+                }
+                blockTexts[i] =
+                    applyChain(ciphers, std::move(text), CipherMode::Encrypt);
+                checksums[i] = checksum(blockTexts[i]);
+            }
+        });
+
+        std::string container{headerMagic};
+        container += static_cast<char>(types.size());
+        for (const CipherType type : types) {
+            container += static_cast<char>(type);
+        }
+        putUint64(container, keyFingerprint(types, keys));
+        putUint64(container, blockSize);
+        container += compress ? letterCompression : noCompression;
+
+        std::string index;
+        for (std::size_t i{0}; i < nBlocks; ++i) {
+            const std::size_t plainOffset{i * blockSize};
+            putUint64(index, plainOffset);
+            putUint64(index,
+                      std::min(blockSize, plainText.size() - plainOffset));
+            putUint64(index, container.size());
+            putUint64(index, blockTexts[i].size());
+            putUint32(index, checksums[i]);
+            container += blockTexts[i];
+        }
+
+        const std::uint64_t indexOffset{container.size()};
+        container += index;
+        putUint64(container, nBlocks);
+        putUint64(container, indexOffset);
+        container += footerMagic;
+        return container;
+    }
+
+    Reader::Reader(std::istream& in) : in_{in}
+    {
+        in_.seekg(0, std::ios::end);
+        const std::streamoff endPosition{in_.tellg()};
+        if (endPosition < 0) {
+            throw InvalidContainer{"container cannot be seeked"};
+        }
+        const std::uint64_t size{static_cast<std::uint64_t>(endPosition)};
+
+        // The footer says where to find the index
+        const std::uint64_t minHeaderSize{headerMagic.size() + 1 + 17};
+        if (size < minHeaderSize + footerSize) {
+            throw InvalidContainer{"container is truncated"};
+        }
+        const std::string footer{readBytes(in_, size - footerSize, footerSize)};
+        if (footer.compare(16, 8, footerMagic) != 0) {
+            throw InvalidContainer{"container has no index"};
+        }
+        const std::uint64_t nBlocks{getUint64(footer.data())};
+        const std::uint64_t indexOffset{getUint64(footer.data() + 8)};
+        if (nBlocks > size / indexEntrySize ||
+            indexOffset != size - footerSize - nBlocks * indexEntrySize) {
+            throw InvalidContainer{"container index is the wrong size"};
+        }
+
+        // Read the header, whose size depends on the number of ciphers
+        std::string header{readBytes(in_, 0, headerMagic.size() + 1)};
+        if (header.compare(0, headerMagic.size(), headerMagic) != 0) {
+            throw InvalidContainer{"not a container"};
+        }
+        const std::uint64_t nCiphers{
+            static_cast<unsigned char>(header[headerMagic.size()])};
+        const std::uint64_t headerSize{minHeaderSize + nCiphers};
+        if (headerSize > indexOffset) {
+            throw InvalidContainer{"container header is truncated"};
+        }
+        header = readBytes(in_, headerMagic.size() + 1, nCiphers + 17);
+        for (std::size_t i{0}; i < nCiphers; ++i) {
+            const std::uint8_t type{static_cast<std::uint8_t>(header[i])};
+            if (type > lastCipherType) {
+                throw InvalidContainer{"container has an unknown cipher type"};
+            }
+            cipherTypes_.push_back(static_cast<CipherType>(type));
+        }
+        keyFingerprint_ = getUint64(header.data() + nCiphers);
+        const char compression{header[nCiphers + 16]};
+        if (compression != noCompression && compression != letterCompression) {
+            throw InvalidContainer{"container has an unknown compression"};
+        }
+        compressed_ = (compression == letterCompression);
+
+        // Check that the blocks follow on from each other, in both the
+        // plain text and the container
+        const std::string index{
+            readBytes(in_, indexOffset, nBlocks * indexEntrySize)};
+        blocks_.reserve(nBlocks);
+        std::uint64_t plainEnd{0};
+        std::uint64_t cipherEnd{headerSize};
+        for (std::uint64_t i{0}; i < nBlocks; ++i) {
+            const char* entry{index.data() + i * indexEntrySize};
+            const Block block{getUint64(entry), getUint64(entry + 8),
+                              getUint64(entry + 16), getUint64(entry + 24),
+                              getUint32(entry + 32)};
+            if (block.plainOffset != plainEnd ||
+                block.cipherOffset != cipherEnd ||
+                block.cipherLength > indexOffset - cipherEnd) {
+                throw InvalidContainer{"container index is inconsistent"};
+            }
+            plainEnd += block.plainLength;
+            cipherEnd += block.cipherLength;
+            blocks_.push_back(block);
+        }
+        if (cipherEnd != indexOffset) {
+            throw InvalidContainer{"container index is inconsistent"};
+        }
+    }
+
+    std::uint64_t Reader::plainSize() const
+    {
+        return blocks_.empty()
+                   ? 0
+                   : blocks_.back().plainOffset + blocks_.back().plainLength;
+    }
+
+    std::string Reader::decode(
+        const std::vector<std::unique_ptr<Cipher>>& ciphers)
+    {
+        return this->decodeBlocks(ciphers, 0, blocks_.size());
+    }
+
+    std::string Reader::decode(
+        const std::vector<std::unique_ptr<Cipher>>& ciphers,
+        const std::uint64_t start, const std::uint64_t length)
+    {
+        const std::uint64_t size{this->plainSize()};
+        if (start >= size || length == 0) {
+            return "";
+        }
+        const std::uint64_t end{start + std::min(length, size - start)};
+
+        // Find the blocks that the range covers
+        const auto startsAfter = [](const std::uint64_t offset,
+                                    const Block& block) {
+            return offset < block.plainOffset;
+        };
+        const auto first = std::upper_bound(std::begin(blocks_),
+                                            std::end(blocks_), start,
+                                            startsAfter) -
+                           1;
+        const auto last = std::upper_bound(first, std::end(blocks_), end - 1,
+                                           startsAfter);
+
+        const std::string plainText{this->decodeBlocks(
+            ciphers, static_cast<std::size_t>(first - std::begin(blocks_)),
+            static_cast<std::size_t>(last - std::begin(blocks_)))};
+        const std::uint64_t skip{start - first->plainOffset};
+        return skip < plainText.size() ? plainText.substr(skip, end - start)
+                                       : "";
+    }
+
+    std::string Reader::decodeBlocks(
+        const std::vector<std::unique_ptr<Cipher>>& ciphers,
+        const std::size_t first, const std::size_t last)
+    {
+        if (first == last) {
+            return "";
+        }
+
+        // Read them all at once, as they are next to each other
+        const std::uint64_t readBegin{blocks_[first].cipherOffset};
+        const std::uint64_t readEnd{blocks_[last - 1].cipherOffset +
+                                    blocks_[last - 1].cipherLength};
+        const std::string bytes{
+            readBytes(in_, readBegin, readEnd - readBegin)};
+
+        // Check each block just before decrypting it, so that the check
+        // does not need a pass of its own
+        std::vector<std::string> blockTexts(last - first);
+        std::vector<char> corrupt(last - first, false);
+        parallelFor(last - first, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                const Block& block{blocks_[first + i]};
+                const std::string cipherText{bytes.substr(
+                    block.cipherOffset - readBegin, block.cipherLength)};
+                if (checksum(cipherText) != block.checksum) {
+                    corrupt[i] = true;
+                    continue;
+                }
+                blockTexts[i] =
+                    applyChain(ciphers, cipherText, CipherMode::Decrypt);
+                if (compressed_) {
+                    blockTexts[i] = decompressBlock(blockTexts[i], block);
+                }
+            }
+        });
+        const auto firstCorrupt =
+            std::find(std::begin(corrupt), std::end(corrupt), true);
+        if (firstCorrupt != std::end(corrupt)) {
+            throw CorruptBlock{
+                first + static_cast<std::size_t>(firstCorrupt -
+                                                 std::begin(corrupt))};
+        }
+
+        std::string plainText;
+        for (const std::string& text : blockTexts) {
+            plainText += text;
+        }
+        return plainText;
+    }
+}    // namespace BlockContainer
@@ -0,0 +1,263 @@
+#ifndef MPAGSCIPHER_BLOCKCONTAINER_HPP
+#define MPAGSCIPHER_BLOCKCONTAINER_HPP
+
+#include "Cipher.hpp"
+#include "CipherType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * \file BlockContainer.hpp
+ * \brief Contains the declarations of the functions and classes for reading and writing block-indexed containers
+ */
+
+/**
+ * \class InvalidContainer
+ * \brief Thrown when a container is malformed or cannot be read
+ */
+class InvalidContainer : public std::runtime_error {
+  public:
+    InvalidContainer(const std::string& msg) : std::runtime_error{msg} {}
+};
+
+/**
+ * \class CorruptBlock
+ * \brief Thrown when a block of a container does not match its checksum
+ */
+class CorruptBlock : public InvalidContainer {
+  public:
+    CorruptBlock(const std::size_t block)
+        : InvalidContainer{"block " + std::to_string(block) +
+                           " does not match its checksum"},
+          block_{block}
+    {
+    }
+
+    /// Get the index of the corrupt block
+    std::size_t block() const { return block_; }
+
+  private:
+    /// The index of the corrupt block
+    std::size_t block_;
+};
+
+/**
+ * \namespace BlockContainer
+ * \brief Namespace to group the functions and classes for the block-indexed container format
+ *
+ * A container holds encrypted text split into fixed-size blocks, each of
+ * which was encrypted on its own as if it were a whole message, so any block
+ * can be decrypted without the others - even with ciphers like Playfair or
+ * the transposition ciphers, whose output depends on the whole text. The
+ * blocks are decrypted in parallel, and reading a range of the text only
+ * reads and decrypts the blocks that it covers.
+ *
+ * All integers are unsigned and stored little-endian. The layout is
+ *
+ * - header: the magic "MPAGSCT1", the number of ciphers (1 byte), the
+ *   CipherType of each cipher in the order they were applied (1 byte each),
+ *   the key fingerprint (8 bytes), the block size in letters (8 bytes) and
+ *   the compression (1 byte, 0 for none or 1 for LetterCompressor)
+ * - the encrypted blocks, one after another
+ * - index: for each block, the offset and length of its plain text within
+ *   the whole plain text, then the offset and length of its cipher text
+ *   within the container (8 bytes each), then the CRC32C of its cipher
+ *   text (4 bytes)
+ * - footer: the number of blocks (8 bytes), the offset of the index
+ *   (8 bytes) and the magic "MPAGSIDX"
+ *
+ * The footer has a fixed size, so a reader finds the index by reading the
+ * end of the container first. With compression, each block is compressed
+ * before it is encrypted, and only reversible ciphers can be used (see
+ * CipherChain::isReversible()). The checksums are taken as each block is
+ * encrypted and checked as each block is decrypted, so that corruption is
+ * caught without a separate pass. The ciphers that operate on bytes are not
+ * supported, as starting each block from the beginning of their key stream
+ * would reuse it.
+ */
+namespace BlockContainer {
+    /// The default number of letters of plain text in each block
+    constexpr std::size_t defaultBlockSize{1 << 20};
+
+    /**
+     * \struct Block
+     * \brief The index entry for one block
+     */
+    struct Block {
+        /// The offset of the block's plain text within the whole plain text
+        std::uint64_t plainOffset;
+        /// The number of letters of plain text in the block
+        std::uint64_t plainLength;
+        /// The offset of the block's cipher text within the container
+        std::uint64_t cipherOffset;
+        /// The number of letters of cipher text in the block
+        std::uint64_t cipherLength;
+        /// The CRC32C of the block's cipher text
+        std::uint32_t checksum;
+    };
+
+    /**
+     * \brief Work out the fingerprint of a chain of ciphers and their keys
+     *
+     * This is the 64-bit FNV-1a hash of the cipher types and keys, which is
+     * enough to catch decrypting with the wrong key but is not meant to
+     * hide anything about the key.
+     *
+     * \param types the type of each cipher, in the order they are applied
+     * \param keys the key of each cipher
+     * \return the fingerprint
+     */
+    std::uint64_t keyFingerprint(const std::vector<CipherType>& types,
+                                 const std::vector<std::string>& keys);
+
+    /**
+     * \brief Encrypt a text into a container
+     *
+     * \param plainText the text to encrypt
+     * \param ciphers the ciphers to encrypt each block with, in the order
+     *                they are to be applied
+     * \param types the type of each cipher given on the command line, to be
+     *              recorded in the header
+     * \param keys the key of each cipher given on the command line
+     * \param blockSize the number of letters of plain text in each block
+     * \param compress whether to compress each block before encrypting it
+     * \return the container
+     * \throw std::invalid_argument if the block size is zero, the types and
+     *        keys differ in number, any of the ciphers operates on bytes, or
+     *        compression is asked for and any of the ciphers is not
+     *        reversible
+     */
+    std::string encode(const std::string& plainText,
+                       const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                       const std::vector<CipherType>& types,
+                       const std::vector<std::string>& keys,
+                       const std::size_t blockSize = defaultBlockSize,
+                       const bool compress = false);
+
+    /**
+     * \class Reader
+     * \brief Reads the header and index of a container and decrypts its blocks
+     */
+    class Reader {
+      public:
+        /**
+         * \brief Read the header and index of a container
+         *
+         * \param in the stream holding the container, which must be seekable
+         *           and must outlive the Reader
+         * \throw InvalidContainer if the container is malformed
+         */
+        explicit Reader(std::istream& in);
+
+        /**
+         * \brief Get the types of the ciphers the container was encrypted with
+         *
+         * \return the type of each cipher, in the order they were applied
+         */
+        const std::vector<CipherType>& cipherTypes() const
+        {
+            return cipherTypes_;
+        }
+
+        /**
+         * \brief Get the fingerprint of the ciphers and keys used
+         *
+         * \return the fingerprint, as given by BlockContainer::keyFingerprint()
+         */
+        std::uint64_t keyFingerprint() const { return keyFingerprint_; }
+
+        /**
+         * \brief Determine whether the blocks were compressed before encryption
+         *
+         * \return true if the blocks are decompressed after decryption
+         */
+        bool compressed() const { return compressed_; }
+
+        /**
+         * \brief Get the index entry for each block
+         *
+         * \return the blocks, in order
+         */
+        const std::vector<Block>& blocks() const { return blocks_; }
+
+        /**
+         * \brief Get the length of the whole plain text
+         *
+         * \return the number of letters of plain text
+         */
+        std::uint64_t plainSize() const;
+
+        /**
+         * \brief Decrypt the whole text
+         *
+         * With Playfair this includes any padding letters added to each block.
+         *
+         * \param ciphers the ciphers to decrypt each block with, in the
+         *                order they are to be applied
+         * \return the plain text
+         * \throw CorruptBlock if a block does not match its checksum, for
+         *        the first such block
+         * \throw InvalidContainer if a block cannot be read
+         */
+        std::string decode(const std::vector<std::unique_ptr<Cipher>>& ciphers);
+
+        /**
+         * \brief Decrypt part of the text, reading only the blocks it covers
+         *
+         * With Playfair the decrypted text of a block is not the same length
+         * as the original (the padding letters stay), so the range is only
+         * approximate.
+         *
+         * \param ciphers the ciphers to decrypt each block with, in the
+         *                order they are to be applied
+         * \param start the offset of the first letter of plain text to decrypt
+         * \param length the number of letters to decrypt, which is cut short
+         *               at the end of the text
+         * \return the plain text in the range
+         * \throw CorruptBlock if a block does not match its checksum, for
+         *        the first such block
+         * \throw InvalidContainer if a block cannot be read
+         */
+        std::string decode(const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                           const std::uint64_t start,
+                           const std::uint64_t length);
+
+      private:
+        /**
+         * \brief Read and decrypt a run of blocks
+         *
+         * \param ciphers the ciphers to decrypt each block with
+         * \param first the index of the first block
+         * \param last the index one past the last block
+         * \return the plain text of the blocks, one after another
+         * \throw CorruptBlock if a block does not match its checksum
+         * \throw InvalidContainer if a block cannot be read
+         */
+        std::string decodeBlocks(
+            const std::vector<std::unique_ptr<Cipher>>& ciphers,
+            const std::size_t first, const std::size_t last);
+
+        /// The stream holding the container
+        std::istream& in_;
+
+        /// The types of the ciphers, in the order they were applied
+        std::vector<CipherType> cipherTypes_;
+
+        /// The fingerprint of the ciphers and keys
+        std::uint64_t keyFingerprint_{0};
+
+        /// Whether the blocks were compressed before encryption
+        bool compressed_{false};
+
+        /// The index entry for each block
+        std::vector<Block> blocks_;
+    };
+}    // namespace BlockContainer
+
+#endif    // MPAGSCIPHER_BLOCKCONTAINER_HPP
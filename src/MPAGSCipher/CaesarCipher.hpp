@@ -51,6 +51,13 @@ class CaesarCipher : public Cipher {
      */
     CipherType type() const override { return CipherType::Caesar; }
 
+    /**
+     * \brief Get the key
+     *
+     * \return the shift applied when encrypting, from 0 to 25
+     */
+    std::size_t key() const { return key_; }
+
   private:
     /// The cipher key, essentially a constant shift to be applied
     std::size_t key_{0};
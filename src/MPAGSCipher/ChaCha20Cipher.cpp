@@ -0,0 +1,471 @@
+#include "ChaCha20Cipher.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define MPAGSCIPHER_CHACHA20_SIMD
+#endif
+
+namespace {
+    /// Type definition for the state of the ChaCha20 block function
+    using State = std::array<std::uint32_t, 16>;
+
+    /// Number of bytes of key stream produced by each block
+    constexpr std::size_t blockSize{64};
+
+    /// Number of blocks handed to each thread at a time
+    constexpr std::size_t blocksPerChunk{1024};
+
+    /**
+     * \brief Read a hexadecimal string into little-endian 32-bit words
+     *
+     * \param hex the hexadecimal string, 8 digits per word
+     * \param words where to put the words
+     * \param nWords the number of words expected
+     * \return false if the string is the wrong length or not hexadecimal
+     */
+    bool parseHex(const std::string& hex, std::uint32_t* words,
+                  const std::size_t nWords)
+    {
+        if (hex.size() != 8 * nWords ||
+            !std::all_of(std::begin(hex), std::end(hex),
+                         [](char c) { return std::isxdigit(c); })) {
+            return false;
+        }
+        for (std::size_t i{0}; i < nWords; ++i) {
+            std::uint32_t word{0};
+            for (std::size_t byte{0}; byte < 4; ++byte) {
+                const std::uint32_t value{static_cast<std::uint32_t>(
+                    std::stoul(hex.substr(8 * i + 2 * byte, 2), nullptr, 16))};
+                word |= value << (8 * byte);
+            }
+            words[i] = word;
+        }
+        return true;
+    }
+
+    /// Rotate a word left by n bits
+    inline std::uint32_t rotl(const std::uint32_t x, const int n)
+    {
+        return (x << n) | (x >> (32 - n));
+    }
+
+    /// The ChaCha quarter round on four words of the state
+    inline void quarterRound(std::uint32_t& a, std::uint32_t& b,
+                             std::uint32_t& c, std::uint32_t& d)
+    {
+        a += b;
+        d = rotl(d ^ a, 16);
+        c += d;
+        b = rotl(b ^ c, 12);
+        a += b;
+        d = rotl(d ^ a, 8);
+        c += d;
+        b = rotl(b ^ c, 7);
+    }
+
+    /**
+     * \brief XOR data with the key stream, one block at a time
+     *
+     * \param state the initial state
+     * \param counter the block counter of the first block
+     * \param in the input data
+     * \param out the output buffer
+     * \param nBytes the number of bytes to process (the last block may be
+     *               partial)
+     */
+    void xorKeyStreamScalar(const State& state, std::uint32_t counter,
+                            const unsigned char* in, unsigned char* out,
+                            const std::size_t nBytes)
+    {
+        for (std::size_t offset{0}; offset < nBytes;
+             offset += blockSize, ++counter) {
+            State initial{state};
+            initial[12] = counter;
+            State x{initial};
+            for (int i{0}; i < 10; ++i) {
+                quarterRound(x[0], x[4], x[8], x[12]);
+                quarterRound(x[1], x[5], x[9], x[13]);
+                quarterRound(x[2], x[6], x[10], x[14]);
+                quarterRound(x[3], x[7], x[11], x[15]);
+                quarterRound(x[0], x[5], x[10], x[15]);
+                quarterRound(x[1], x[6], x[11], x[12]);
+                quarterRound(x[2], x[7], x[8], x[13]);
+                quarterRound(x[3], x[4], x[9], x[14]);
+            }
+
+            const std::size_t n{std::min(blockSize, nBytes - offset)};
+            for (std::size_t i{0}; i < n; ++i) {
+                const std::uint32_t word{x[i / 4] + initial[i / 4]};
+                const auto keyByte =
+                    static_cast<unsigned char>(word >> (8 * (i % 4)));
+                out[offset + i] = in[offset + i] ^ keyByte;
+            }
+        }
+    }
+
+#ifdef MPAGSCIPHER_CHACHA20_SIMD
+    /// Rotate each 32-bit lane left by N bits
+    template <int N>
+    inline __m128i rotl(const __m128i x)
+    {
+        return _mm_or_si128(_mm_slli_epi32(x, N), _mm_srli_epi32(x, 32 - N));
+    }
+
+    /// The ChaCha quarter round on four blocks at once
+    inline void quarterRound(__m128i& a, __m128i& b, __m128i& c, __m128i& d)
+    {
+        a = _mm_add_epi32(a, b);
+        d = rotl<16>(_mm_xor_si128(d, a));
+        c = _mm_add_epi32(c, d);
+        b = rotl<12>(_mm_xor_si128(b, c));
+        a = _mm_add_epi32(a, b);
+        d = rotl<8>(_mm_xor_si128(d, a));
+        c = _mm_add_epi32(c, d);
+        b = rotl<7>(_mm_xor_si128(b, c));
+    }
+
+    /**
+     * \brief XOR 256 bytes of data with the key stream from four blocks
+     *
+     * Each vector holds the same word of the state for four consecutive
+     * blocks, so the rounds need no shuffling; the words are only
+     * transposed back into block order at the end.
+     *
+     * \param state the initial state
+     * \param counter the block counter of the first block
+     * \param in the input data
+     * \param out the output buffer
+     */
+    void xorFourBlocksSSE2(const State& state, const std::uint32_t counter,
+                           const unsigned char* in, unsigned char* out)
+    {
+        __m128i initial[16];
+        for (std::size_t w{0}; w < 16; ++w) {
+            initial[w] = _mm_set1_epi32(static_cast<int>(state[w]));
+        }
+        initial[12] = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(counter)),
+                                    _mm_setr_epi32(0, 1, 2, 3));
+
+        __m128i x[16];
+        std::copy(initial, initial + 16, x);
+        for (int i{0}; i < 10; ++i) {
+            quarterRound(x[0], x[4], x[8], x[12]);
+            quarterRound(x[1], x[5], x[9], x[13]);
+            quarterRound(x[2], x[6], x[10], x[14]);
+            quarterRound(x[3], x[7], x[11], x[15]);
+            quarterRound(x[0], x[5], x[10], x[15]);
+            quarterRound(x[1], x[6], x[11], x[12]);
+            quarterRound(x[2], x[7], x[8], x[13]);
+            quarterRound(x[3], x[4], x[9], x[14]);
+        }
+
+        for (std::size_t group{0}; group < 4; ++group) {
+            const __m128i* w{x + 4 * group};
+            const __m128i* w0{initial + 4 * group};
+            const __m128i a{_mm_add_epi32(w[0], w0[0])};
+            const __m128i b{_mm_add_epi32(w[1], w0[1])};
+            const __m128i c{_mm_add_epi32(w[2], w0[2])};
+            const __m128i d{_mm_add_epi32(w[3], w0[3])};
+
+            // Transpose the 4x4 words so that each vector is one block
+            const __m128i ab0{_mm_unpacklo_epi32(a, b)};
+            const __m128i cd0{_mm_unpacklo_epi32(c, d)};
+            const __m128i ab1{_mm_unpackhi_epi32(a, b)};
+            const __m128i cd1{_mm_unpackhi_epi32(c, d)};
+            const __m128i blocks[4]{
+                _mm_unpacklo_epi64(ab0, cd0), _mm_unpackhi_epi64(ab0, cd0),
+                _mm_unpacklo_epi64(ab1, cd1), _mm_unpackhi_epi64(ab1, cd1)};
+
+            for (std::size_t block{0}; block < 4; ++block) {
+                const std::size_t offset{block * blockSize + 16 * group};
+                const __m128i data{_mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(in + offset))};
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset),
+                                 _mm_xor_si128(data, blocks[block]));
+            }
+        }
+    }
+
+    /// Rotate each 32-bit lane left by N bits
+    template <int N>
+    __attribute__((target("avx2"))) inline __m256i rotl(const __m256i x)
+    {
+        // Whole-byte rotations are a single shuffle
+        if constexpr (N == 16) {
+            return _mm256_shuffle_epi8(
+                x, _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14,
+                                    15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11,
+                                    8, 9, 14, 15, 12, 13));
+        } else if constexpr (N == 8) {
+            return _mm256_shuffle_epi8(
+                x, _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15,
+                                    12, 13, 14, 3, 0, 1, 2, 7, 4, 5, 6, 11, 8,
+                                    9, 10, 15, 12, 13, 14));
+        } else {
+            return _mm256_or_si256(_mm256_slli_epi32(x, N),
+                                   _mm256_srli_epi32(x, 32 - N));
+        }
+    }
+
+    /// The ChaCha quarter round on eight blocks at once
+    __attribute__((target("avx2"))) inline void quarterRound(__m256i& a,
+                                                             __m256i& b,
+                                                             __m256i& c,
+                                                             __m256i& d)
+    {
+        a = _mm256_add_epi32(a, b);
+        d = rotl<16>(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi32(c, d);
+        b = rotl<12>(_mm256_xor_si256(b, c));
+        a = _mm256_add_epi32(a, b);
+        d = rotl<8>(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi32(c, d);
+        b = rotl<7>(_mm256_xor_si256(b, c));
+    }
+
+    /**
+     * \brief XOR 512 bytes of data with the key stream from eight blocks
+     *
+     * As for the SSE2 version, but with eight blocks per vector. The 4x4
+     * transpose works within each 128-bit half, so it leaves block k in the
+     * low half and block k+4 in the high half, which are then paired up
+     * with the neighbouring group of words to give 32 bytes of one block.
+     *
+     * \param state the initial state
+     * \param counter the block counter of the first block
+     * \param in the input data
+     * \param out the output buffer
+     */
+    __attribute__((target("avx2"))) void xorEightBlocksAVX2(
+        const State& state, const std::uint32_t counter,
+        const unsigned char* in, unsigned char* out)
+    {
+        __m256i initial[16];
+        for (std::size_t w{0}; w < 16; ++w) {
+            initial[w] = _mm256_set1_epi32(static_cast<int>(state[w]));
+        }
+        initial[12] =
+            _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(counter)),
+                             _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+        __m256i x[16];
+        std::copy(initial, initial + 16, x);
+        for (int i{0}; i < 10; ++i) {
+            quarterRound(x[0], x[4], x[8], x[12]);
+            quarterRound(x[1], x[5], x[9], x[13]);
+            quarterRound(x[2], x[6], x[10], x[14]);
+            quarterRound(x[3], x[7], x[11], x[15]);
+            quarterRound(x[0], x[5], x[10], x[15]);
+            quarterRound(x[1], x[6], x[11], x[12]);
+            quarterRound(x[2], x[7], x[8], x[13]);
+            quarterRound(x[3], x[4], x[9], x[14]);
+        }
+
+        __m256i blocks[4][4];
+        for (std::size_t group{0}; group < 4; ++group) {
+            const __m256i* w{x + 4 * group};
+            const __m256i* w0{initial + 4 * group};
+            const __m256i a{_mm256_add_epi32(w[0], w0[0])};
+            const __m256i b{_mm256_add_epi32(w[1], w0[1])};
+            const __m256i c{_mm256_add_epi32(w[2], w0[2])};
+            const __m256i d{_mm256_add_epi32(w[3], w0[3])};
+
+            const __m256i ab0{_mm256_unpacklo_epi32(a, b)};
+            const __m256i cd0{_mm256_unpacklo_epi32(c, d)};
+            const __m256i ab1{_mm256_unpackhi_epi32(a, b)};
+            const __m256i cd1{_mm256_unpackhi_epi32(c, d)};
+            blocks[group][0] = _mm256_unpacklo_epi64(ab0, cd0);
+            blocks[group][1] = _mm256_unpackhi_epi64(ab0, cd0);
+            blocks[group][2] = _mm256_unpacklo_epi64(ab1, cd1);
+            blocks[group][3] = _mm256_unpackhi_epi64(ab1, cd1);
+        }
+
+        for (std::size_t block{0}; block < 4; ++block) {
+            for (std::size_t half{0}; half < 2; ++half) {
+                const __m256i lo{blocks[2 * half][block]};
+                const __m256i hi{blocks[2 * half + 1][block]};
+                const __m256i keyStream[2]{
+                    _mm256_permute2x128_si256(lo, hi, 0x20),
+                    _mm256_permute2x128_si256(lo, hi, 0x31)};
+
+                for (std::size_t k{0}; k < 2; ++k) {
+                    const std::size_t offset{(block + 4 * k) * blockSize +
+                                             32 * half};
+                    const __m256i data{_mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(in + offset))};
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(out + offset),
+                        _mm256_xor_si256(data, keyStream[k]));
+                }
+            }
+        }
+    }
+#endif
+
+    /**
+     * \brief XOR data with the key stream using the given implementation
+     *
+     * \param implementation how to generate the key stream
+     * \param state the initial state
+     * \param counter the block counter of the first block
+     * \param in the input data
+     * \param out the output buffer
+     * \param nBytes the number of bytes to process
+     */
+    void xorKeyStream(const ChaCha20Cipher::Implementation implementation,
+                      const State& state, std::uint32_t counter,
+                      const unsigned char* in, unsigned char* out,
+                      const std::size_t nBytes)
+    {
+        std::size_t offset{0};
+#ifdef MPAGSCIPHER_CHACHA20_SIMD
+        if (implementation == ChaCha20Cipher::Implementation::AVX2) {
+            for (; offset + 8 * blockSize <= nBytes;
+                 offset += 8 * blockSize, counter += 8) {
+                xorEightBlocksAVX2(state, counter, in + offset, out + offset);
+            }
+        }
+        if (implementation != ChaCha20Cipher::Implementation::Scalar) {
+            for (; offset + 4 * blockSize <= nBytes;
+                 offset += 4 * blockSize, counter += 4) {
+                xorFourBlocksSSE2(state, counter, in + offset, out + offset);
+            }
+        }
+#else
+        static_cast<void>(implementation);
+#endif
+        xorKeyStreamScalar(state, counter, in + offset, out + offset,
+                           nBytes - offset);
+    }
+
+    /**
+     * \brief Find the fastest implementation supported by this processor
+     *
+     * \return the implementation
+     */
+    ChaCha20Cipher::Implementation bestImplementation()
+    {
+        static const ChaCha20Cipher::Implementation best{
+            ChaCha20Cipher::isSupported(ChaCha20Cipher::Implementation::AVX2)
+                ? ChaCha20Cipher::Implementation::AVX2
+            : ChaCha20Cipher::isSupported(
+                  ChaCha20Cipher::Implementation::SSE2)
+                ? ChaCha20Cipher::Implementation::SSE2
+                : ChaCha20Cipher::Implementation::Scalar};
+        return best;
+    }
+}    // namespace
+
+ChaCha20Cipher::ChaCha20Cipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void ChaCha20Cipher::setKey(const std::string& key)
+{
+    // Split the key into its fields
+    const std::size_t firstComma{key.find(',')};
+    const std::size_t secondComma{
+        firstComma == std::string::npos ? firstComma
+                                        : key.find(',', firstComma + 1)};
+    if (firstComma == std::string::npos) {
+        throw InvalidKey{
+            "Key provided to ChaCha20Cipher must be of the form "
+            "key,nonce[,counter]"};
+    }
+
+    // The constants "expand 32-byte k"
+    state_[0] = 0x61707865;
+    state_[1] = 0x3320646e;
+    state_[2] = 0x79622d32;
+    state_[3] = 0x6b206574;
+
+    if (!parseHex(key.substr(0, firstComma), &state_[4], 8)) {
+        throw InvalidKey{
+            "Key provided to ChaCha20Cipher must start with 64 hex digits"};
+    }
+    const std::string nonce{
+        key.substr(firstComma + 1, secondComma - firstComma - 1)};
+    if (!parseHex(nonce, &state_[13], 3)) {
+        throw InvalidKey{
+            "Nonce provided to ChaCha20Cipher must be 24 hex digits"};
+    }
+
+    state_[12] = 0;
+    if (secondComma != std::string::npos) {
+        const std::string counter{key.substr(secondComma + 1)};
+        if (counter.empty() || counter.size() > 10 ||
+            !std::all_of(std::begin(counter), std::end(counter),
+                         [](char c) { return std::isdigit(c); }) ||
+            std::stoull(counter) > 0xFFFFFFFF) {
+            throw InvalidKey{
+                "Counter provided to ChaCha20Cipher must be a 32-bit "
+                "unsigned integer"};
+        }
+        state_[12] = static_cast<std::uint32_t>(std::stoull(counter));
+    }
+}
+
+std::string ChaCha20Cipher::applyCipher(const std::string& inputText,
+                                        const CipherMode /*cipherMode*/) const
+{
+    return this->applyCipherWith(inputText, bestImplementation());
+}
+
+std::string ChaCha20Cipher::applyCipherWith(
+    const std::string& inputText, const Implementation implementation,
+    const std::size_t maxThreads) const
+{
+    const std::size_t nBytes{inputText.size()};
+    const std::size_t nBlocks{(nBytes + blockSize - 1) / blockSize};
+    if (nBlocks > (std::size_t{1} << 32) - state_[12]) {
+        throw std::length_error{
+            "ChaCha20Cipher cannot process this much data without reusing "
+            "the key stream"};
+    }
+
+    std::string outputText(nBytes, '\0');
+    const auto* in = reinterpret_cast<const unsigned char*>(inputText.data());
+    auto* out = reinterpret_cast<unsigned char*>(outputText.data());
+
+    // Each chunk of blocks starts from its own counter value, so the chunks
+    // are independent of one another
+    parallelFor(
+        nBlocks, blocksPerChunk,
+        [&](std::size_t begin, std::size_t end) {
+            const std::size_t first{begin * blockSize};
+            const std::size_t last{std::min(end * blockSize, nBytes)};
+            xorKeyStream(implementation, state_,
+                         state_[12] + static_cast<std::uint32_t>(begin),
+                         in + first, out + first, last - first);
+        },
+        maxThreads);
+
+    return outputText;
+}
+
+bool ChaCha20Cipher::isSupported(const Implementation implementation)
+{
+    switch (implementation) {
+        case Implementation::Scalar:
+            return true;
+#ifdef MPAGSCIPHER_CHACHA20_SIMD
+        case Implementation::SSE2:
+            // Always available on x86-64
+            return true;
+        case Implementation::AVX2:
+            return __builtin_cpu_supports("avx2") != 0;
+#else
+        case Implementation::SSE2:
+        case Implementation::AVX2:
+            return false;
+#endif
+    }
+    return false;
+}
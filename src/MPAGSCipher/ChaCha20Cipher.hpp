@@ -0,0 +1,107 @@
+#ifndef MPAGSCIPHER_CHACHA20CIPHER_HPP
+#define MPAGSCIPHER_CHACHA20CIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * \file ChaCha20Cipher.hpp
+ * \brief Contains the declaration of the ChaCha20Cipher class
+ */
+
+/**
+ * \class ChaCha20Cipher
+ * \brief Encrypt or decrypt data using the ChaCha20 stream cipher (RFC 8439)
+ *
+ * Unlike the classical ciphers this works on arbitrary bytes rather than
+ * upper-case letters, so the text should not be transliterated first.
+ * The key gives the 256-bit key and the 96-bit nonce in hexadecimal,
+ * separated by a comma, optionally followed by the initial block counter
+ * (0 if not given), e.g.
+ * "000102...1e1f,000000000000004a00000000,1".
+ *
+ * Each 64-byte block of key stream depends only on the key, the nonce and
+ * the block counter, so the text is split between threads by block, and
+ * within each thread 4 (SSE2) or 8 (AVX2) blocks are generated at once.
+ * Encryption and decryption are the same operation.
+ */
+class ChaCha20Cipher : public Cipher {
+  public:
+    /**
+     * \enum Implementation
+     * \brief The ways in which the key stream can be generated
+     */
+    enum class Implementation {
+        Scalar,    ///< One block at a time
+        SSE2,      ///< Four blocks at a time with SSE2
+        AVX2       ///< Eight blocks at a time with AVX2
+    };
+
+    /**
+     * \brief Create a new ChaCha20Cipher with the given key
+     *
+     * \param key the key, nonce and (optionally) initial counter
+     */
+    explicit ChaCha20Cipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the key, nonce and (optionally) initial counter
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided data
+     *
+     * \param inputText the data to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input data
+     * \return the result of applying the cipher to the input data
+     * \throw std::length_error if the data would need the 32-bit block
+     *        counter to wrap around
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Apply the cipher using a particular implementation
+     *
+     * \param inputText the data to encrypt or decrypt
+     * \param implementation how to generate the key stream, which must be
+     *                       supported by this processor
+     * \param maxThreads the maximum number of threads to use, 0 means no limit
+     * \return the result of applying the cipher to the input data
+     * \throw std::length_error if the data would need the 32-bit block
+     *        counter to wrap around
+     */
+    std::string applyCipherWith(const std::string& inputText,
+                                const Implementation implementation,
+                                const std::size_t maxThreads = 0) const;
+
+    /**
+     * \brief Determine whether this processor supports an implementation
+     *
+     * \param implementation the implementation to check
+     * \return true if it can be used
+     */
+    static bool isSupported(const Implementation implementation);
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::ChaCha20; }
+
+  private:
+    /// The initial state: constants, key, block counter and nonce
+    std::array<std::uint32_t, 16> state_{};
+};
+
+#endif    // MPAGSCIPHER_CHACHA20CIPHER_HPP
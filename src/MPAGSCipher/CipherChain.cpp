@@ -0,0 +1,121 @@
+#include "CipherChain.hpp"
+#include "Alphabet.hpp"
+#include "EnigmaCipher.hpp"
+#include "SubstitutionCipher.hpp"
+#include "VigenereCipher.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+bool CipherChain::isMonoalphabetic(const CipherType type)
+{
+    switch (type) {
+        case CipherType::Caesar:
+        case CipherType::Substitution:
+        case CipherType::Affine:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool CipherChain::operatesOnBytes(const CipherType type)
+{
+    switch (type) {
+        case CipherType::ChaCha20:
+        case CipherType::AesCtr:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool CipherChain::isSeekable(const CipherType type)
+{
+    switch (type) {
+        case CipherType::Vigenere:
+        case CipherType::Enigma:
+            return true;
+        default:
+            return isMonoalphabetic(type);
+    }
+}
+
+bool CipherChain::isReversible(const CipherType type)
+{
+    switch (type) {
+        case CipherType::Vigenere:
+        case CipherType::ColumnarTransposition:
+        case CipherType::RailFence:
+        case CipherType::Enigma:
+        case CipherType::Autokey:
+        case CipherType::RunningKey:
+            return true;
+        default:
+            return isMonoalphabetic(type);
+    }
+}
+
+std::string CipherChain::applyCipherAt(const Cipher& cipher,
+                                       const std::string& inputText,
+                                       const CipherMode cipherMode,
+                                       const std::size_t offset)
+{
+    switch (cipher.type()) {
+        case CipherType::Vigenere:
+            return static_cast<const VigenereCipher&>(cipher).applyCipherAt(
+                inputText, cipherMode, offset);
+        case CipherType::Enigma:
+            // Enigma is its own inverse, so the mode makes no difference
+            return static_cast<const EnigmaCipher&>(cipher).applyCipherAt(
+                inputText, offset);
+        default:
+            break;
+    }
+
+    // Simple substitutions don't depend on the position at all
+    if (!isMonoalphabetic(cipher.type())) {
+        throw std::invalid_argument{
+            "cipher cannot start part way into a text"};
+    }
+    return cipher.applyCipher(inputText, cipherMode);
+}
+
+void CipherChain::collapse(std::vector<std::unique_ptr<Cipher>>& ciphers,
+                           const CipherMode cipherMode)
+{
+    std::vector<std::unique_ptr<Cipher>> collapsed;
+    collapsed.reserve(ciphers.size());
+
+    for (std::size_t i{0}; i < ciphers.size();) {
+        // Anything other than a simple substitution is left untouched
+        if (!isMonoalphabetic(ciphers[i]->type())) {
+            collapsed.push_back(std::move(ciphers[i]));
+            ++i;
+            continue;
+        }
+
+        // Push the alphabet through the whole run of substitutions
+        // to find the image of each letter
+        std::string image{Alphabet::alphabet};
+        for (; i < ciphers.size() && isMonoalphabetic(ciphers[i]->type());
+             ++i) {
+            image = ciphers[i]->applyCipher(image, cipherMode);
+        }
+
+        // The replacement will be applied in the same mode as the originals,
+        // so when decrypting its key must be the inverse permutation
+        std::string key{image};
+        if (cipherMode == CipherMode::Decrypt) {
+            for (std::size_t j{0}; j < Alphabet::size; ++j) {
+                key[Alphabet::alphabet.find(image[j])] = Alphabet::alphabet[j];
+            }
+        }
+
+        collapsed.push_back(std::make_unique<SubstitutionCipher>(key));
+    }
+
+    ciphers.swap(collapsed);
+}
@@ -0,0 +1,104 @@
+#ifndef MPAGSCIPHER_CIPHERCHAIN_HPP
+#define MPAGSCIPHER_CIPHERCHAIN_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \file CipherChain.hpp
+ * \brief Contains the declarations of the functions for manipulating a chain of Cipher objects
+ */
+
+/**
+ * \namespace CipherChain
+ * \brief Namespace to group functions that operate on a sequence of ciphers applied one after another
+ */
+namespace CipherChain {
+    /**
+     * \brief Determine whether a type of cipher is a simple (monoalphabetic) substitution
+     *
+     * Such ciphers map each letter onto another letter regardless of its
+     * position in the text, so can be described by a single permutation.
+     *
+     * \param type the cipher type
+     * \return true if the cipher is a simple substitution
+     */
+    bool isMonoalphabetic(const CipherType type);
+
+    /**
+     * \brief Determine whether a type of cipher operates on arbitrary bytes
+     *
+     * Such ciphers (e.g. ChaCha20 and AES) must be given the input data as it is,
+     * rather than after it has been transliterated into upper-case letters,
+     * and so cannot be combined with the classical ciphers.
+     *
+     * \param type the cipher type
+     * \return true if the cipher operates on bytes
+     */
+    bool operatesOnBytes(const CipherType type);
+
+    /**
+     * \brief Determine whether a type of cipher can start part way into a text
+     *
+     * For such ciphers (e.g. Caesar, Vigenere and Enigma) the output at each
+     * position only depends on the input at that position and the position
+     * itself, so any piece of a text can be processed without the rest of it.
+     *
+     * \param type the cipher type
+     * \return true if the cipher can start part way into a text
+     */
+    bool isSeekable(const CipherType type);
+
+    /**
+     * \brief Determine whether a type of cipher gives back exactly the letters it encrypted
+     *
+     * Some ciphers lose information: Playfair inserts padding letters and
+     * merges I and J, Bifid and Four-square merge I and J, and Hill pads
+     * the text to a multiple of its block size. Text that must come back
+     * exactly (e.g. compressed text) can only use the others.
+     *
+     * \param type the cipher type
+     * \return true if decrypting any text of upper-case letters that the
+     *         cipher encrypted gives back the same text
+     */
+    bool isReversible(const CipherType type);
+
+    /**
+     * \brief Apply a cipher to a piece of text that starts part way into a message
+     *
+     * \param cipher the cipher, which must be of a type for which isSeekable()
+     *               is true
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \param offset the number of characters of the message that come before
+     *               the text
+     * \return the result of applying the cipher to the input text
+     * \throw std::invalid_argument if the cipher cannot start part way into
+     *        a text
+     */
+    std::string applyCipherAt(const Cipher& cipher,
+                              const std::string& inputText,
+                              const CipherMode cipherMode,
+                              const std::size_t offset);
+
+    /**
+     * \brief Collapse each run of consecutive monoalphabetic ciphers into a single SubstitutionCipher
+     *
+     * The combined permutation is found by pushing the alphabet through the
+     * run of ciphers, so the collapsed chain gives identical results while
+     * only making a single pass over the text for each run.
+     *
+     * \param ciphers the ciphers, in the order in which they will be applied
+     * \param cipherMode the mode in which the ciphers will be applied
+     */
+    void collapse(std::vector<std::unique_ptr<Cipher>>& ciphers,
+                  const CipherMode cipherMode);
+}    // namespace CipherChain
+
+#endif    // MPAGSCIPHER_CIPHERCHAIN_HPP
@@ -1,8 +1,20 @@
 #include "CipherFactory.hpp"
+#include "AesCtrCipher.hpp"
+#include "AffineCipher.hpp"
+#include "AutokeyCipher.hpp"
+#include "BifidCipher.hpp"
 #include "CaesarCipher.hpp"
+#include "ChaCha20Cipher.hpp"
 #include "Cipher.hpp"
 #include "CipherType.hpp"
+#include "ColumnarTranspositionCipher.hpp"
+#include "EnigmaCipher.hpp"
+#include "FourSquareCipher.hpp"
+#include "HillCipher.hpp"
 #include "PlayfairCipher.hpp"
+#include "RailFenceCipher.hpp"
+#include "RunningKeyCipher.hpp"
+#include "SubstitutionCipher.hpp"
 #include "VigenereCipher.hpp"
 
 #include <memory>
@@ -20,6 +32,42 @@ std::unique_ptr<Cipher> CipherFactory::makeCipher(const CipherType type,
 
         case CipherType::Vigenere:
             return std::make_unique<VigenereCipher>(key);
+
+        case CipherType::Substitution:
+            return std::make_unique<SubstitutionCipher>(key);
+
+        case CipherType::Affine:
+            return std::make_unique<AffineCipher>(key);
+
+        case CipherType::Hill:
+            return std::make_unique<HillCipher>(key);
+
+        case CipherType::ColumnarTransposition:
+            return std::make_unique<ColumnarTranspositionCipher>(key);
+
+        case CipherType::RailFence:
+            return std::make_unique<RailFenceCipher>(key);
+
+        case CipherType::Enigma:
+            return std::make_unique<EnigmaCipher>(key);
+
+        case CipherType::Bifid:
+            return std::make_unique<BifidCipher>(key);
+
+        case CipherType::FourSquare:
+            return std::make_unique<FourSquareCipher>(key);
+
+        case CipherType::Autokey:
+            return std::make_unique<AutokeyCipher>(key);
+
+        case CipherType::RunningKey:
+            return std::make_unique<RunningKeyCipher>(key);
+
+        case CipherType::ChaCha20:
+            return std::make_unique<ChaCha20Cipher>(key);
+
+        case CipherType::AesCtr:
+            return std::make_unique<AesCtrCipher>(key);
     }
 
     // Just in case we drop out of the switch (shouldn't be possible but gcc seems to think it is)
@@ -0,0 +1,236 @@
+#include "CipherSearch.hpp"
+#include "CaesarCipher.hpp"
+#include "CipherMode.hpp"
+#include "ShiftKernel.hpp"
+#include "ThreadPool.hpp"
+#include "VigenereCipher.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define MPAGSCIPHER_CIPHERSEARCH_AVX2
+#endif
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Number of offsets handed to each thread at a time
+    constexpr std::size_t offsetsPerTask{1 << 20};
+
+    /**
+     * \brief Check whether a needle occurs at an offset
+     *
+     * \param text the text, which must extend at least the length of the
+     *             needle beyond the offset
+     * \param offset the offset in the text
+     * \param needle the needle
+     * \return true if it matches
+     */
+    bool matchesAt(const char* text, const std::size_t offset,
+                   const std::string& needle)
+    {
+        return std::memcmp(text + offset, needle.data(), needle.size()) == 0;
+    }
+
+    /**
+     * \brief Check a range of offsets one at a time
+     *
+     * \param text the text to search
+     * \param needles the needles, one for each alignment
+     * \param begin the first offset to check
+     * \param end one past the last offset to check
+     * \param matches the vector to add the offsets of any matches to
+     */
+    void findScalar(const std::string& text,
+                    const std::vector<std::string>& needles,
+                    const std::size_t begin, const std::size_t end,
+                    std::vector<std::size_t>& matches)
+    {
+        const std::size_t period{needles.size()};
+        std::size_t alignment{begin % period};
+        for (std::size_t offset{begin}; offset < end; ++offset) {
+            if (matchesAt(text.data(), offset, needles[alignment])) {
+                matches.push_back(offset);
+            }
+            if (++alignment == period) {
+                alignment = 0;
+            }
+        }
+    }
+
+#ifdef MPAGSCIPHER_CIPHERSEARCH_AVX2
+    /**
+     * \brief Check a range of offsets 32 at a time
+     *
+     * The first and last letters of the needle for each alignment are laid
+     * out in order, repeated to one vector beyond the number of needles, so
+     * that the letters expected at 32 consecutive offsets can be loaded in
+     * one go whatever the alignment of the first. A whole block is then
+     * rejected with two comparisons, however many needles there are, and
+     * only offsets where both letters agree are checked in full.
+     *
+     * \param text the text to search
+     * \param needles the needles, one for each alignment
+     * \param firsts the first letter of the needle for each alignment
+     * \param lasts the last letter of the needle for each alignment
+     * \param begin the first offset to check
+     * \param end one past the last offset to check
+     * \param matches the vector to add the offsets of any matches to
+     */
+    __attribute__((target("avx2"))) void findAVX2(
+        const std::string& text, const std::vector<std::string>& needles,
+        const std::string& firsts, const std::string& lasts,
+        const std::size_t begin, const std::size_t end,
+        std::vector<std::size_t>& matches)
+    {
+        const std::size_t period{needles.size()};
+        const std::size_t lastLetter{needles.front().size() - 1};
+        const char* data{text.data()};
+
+        std::size_t offset{begin};
+        std::size_t alignment{begin % period};
+        for (; offset + 32 <= end; offset += 32) {
+            const __m256i first{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data + offset))};
+            const __m256i last{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data + offset + lastLetter))};
+            const __m256i wantFirst{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(firsts.data() + alignment))};
+            const __m256i wantLast{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(lasts.data() + alignment))};
+
+            unsigned int candidates{
+                static_cast<unsigned int>(_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(first, wantFirst),
+                                     _mm256_cmpeq_epi8(last, wantLast))))};
+            while (candidates != 0) {
+                const std::size_t bit{
+                    static_cast<std::size_t>(__builtin_ctz(candidates))};
+                if (matchesAt(data, offset + bit,
+                              needles[(alignment + bit) % period])) {
+                    matches.push_back(offset + bit);
+                }
+                candidates &= candidates - 1;
+            }
+
+            alignment = (alignment + 32) % period;
+        }
+
+        // Deal with whatever is left over
+        findScalar(text, needles, offset, end, matches);
+    }
+#endif
+}    // namespace
+
+namespace CipherSearch {
+    bool isSupported(const CipherType type)
+    {
+        return type == CipherType::Caesar || type == CipherType::Vigenere;
+    }
+
+    std::string shiftKey(const CipherType type, const std::string& key)
+    {
+        if (!isSupported(type)) {
+            throw std::invalid_argument{
+                "CipherSearch does not support this type of cipher"};
+        }
+        if (type == CipherType::Caesar) {
+            return std::string(
+                1, static_cast<char>('A' + CaesarCipher{key}.key()));
+        }
+        return VigenereCipher::normaliseKey(key);
+    }
+
+    std::vector<std::string> encryptPhrase(const CipherType type,
+                                           const std::string& key,
+                                           const std::string& phrase)
+    {
+        const std::string keyLetters{shiftKey(type, key)};
+        const std::size_t period{keyLetters.size()};
+
+        // Repeat the key far enough to encrypt the phrase from any position
+        std::string keyStream;
+        while (keyStream.size() < period + phrase.size()) {
+            keyStream += keyLetters;
+        }
+
+        std::vector<std::string> encrypted(period, phrase);
+        for (std::size_t i{0}; i < period; ++i) {
+            ShiftKernel::applyKeyStream(phrase.data(), keyStream.data() + i,
+                                        &encrypted[i][0], phrase.size(),
+                                        CipherMode::Encrypt);
+        }
+        return encrypted;
+    }
+
+    std::vector<std::size_t> findAligned(
+        const std::string& text, const std::vector<std::string>& needles,
+        const std::size_t maxThreads)
+    {
+        if (needles.empty() || needles.front().empty()) {
+            throw std::invalid_argument{"CipherSearch needs a non-empty needle"};
+        }
+        const std::size_t length{needles.front().size()};
+        for (const auto& needle : needles) {
+            if (needle.size() != length) {
+                throw std::invalid_argument{
+                    "CipherSearch needles must all be the same length"};
+            }
+        }
+        if (text.size() < length) {
+            return {};
+        }
+
+        // Lay out the letters to compare first for each alignment
+        const std::size_t period{needles.size()};
+        std::string firsts(period + 32, ' ');
+        std::string lasts(period + 32, ' ');
+        for (std::size_t i{0}; i < firsts.size(); ++i) {
+            firsts[i] = needles[i % period].front();
+            lasts[i] = needles[i % period].back();
+        }
+
+        // Each chunk of offsets collects its own matches, which are then
+        // joined in order
+        const std::size_t nOffsets{text.size() - length + 1};
+        std::vector<std::vector<std::size_t>> chunkMatches(
+            (nOffsets + offsetsPerTask - 1) / offsetsPerTask);
+        parallelFor(
+            nOffsets, offsetsPerTask,
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<std::size_t>& matches{
+                    chunkMatches[begin / offsetsPerTask]};
+#ifdef MPAGSCIPHER_CIPHERSEARCH_AVX2
+                static const bool haveAVX2{
+                    __builtin_cpu_supports("avx2") != 0};
+                if (haveAVX2) {
+                    findAVX2(text, needles, firsts, lasts, begin, end,
+                             matches);
+                    return;
+                }
+#endif
+                findScalar(text, needles, begin, end, matches);
+            },
+            maxThreads);
+
+        std::vector<std::size_t> matches;
+        for (const auto& chunk : chunkMatches) {
+            matches.insert(std::end(matches), std::begin(chunk),
+                           std::end(chunk));
+        }
+        return matches;
+    }
+
+    std::vector<std::size_t> findPhrase(const CipherType type,
+                                        const std::string& key,
+                                        const std::string& cipherText,
+                                        const std::string& phrase)
+    {
+        if (phrase.empty()) {
+            throw std::invalid_argument{"CipherSearch needs a non-empty phrase"};
+        }
+        return findAligned(cipherText, encryptPhrase(type, key, phrase));
+    }
+}    // namespace CipherSearch
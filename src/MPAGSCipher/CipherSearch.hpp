@@ -0,0 +1,105 @@
+#ifndef MPAGSCIPHER_CIPHERSEARCH_HPP
+#define MPAGSCIPHER_CIPHERSEARCH_HPP
+
+#include "CipherType.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * \file CipherSearch.hpp
+ * \brief Contains the declarations of the functions for searching encrypted text
+ */
+
+/**
+ * \namespace CipherSearch
+ * \brief Namespace to group functions that find a phrase in encrypted text without decrypting it
+ *
+ * With the Caesar and Vigenere ciphers a letter is always encrypted the same
+ * way at the same position in the key, so a phrase that starts at position
+ * p of the plain text appears in the cipher text as the phrase encrypted
+ * starting from letter p % L of the key, where L is the length of the key
+ * (1 for Caesar). Encrypting the phrase once for each of the L alignments
+ * and searching for those instead means the text never has to be decrypted.
+ */
+namespace CipherSearch {
+    /**
+     * \brief Determine whether text encrypted with a type of cipher can be searched
+     *
+     * \param type the cipher type
+     * \return true if the cipher is supported
+     */
+    bool isSupported(const CipherType type);
+
+    /**
+     * \brief Find how far each position of a key shifts the text
+     *
+     * \param type the cipher type
+     * \param key the key, in the form the cipher expects
+     * \return the letter each position of the key shifts by ('A' for no
+     *         shift), one letter for Caesar and the key length for Vigenere
+     * \throw std::invalid_argument if the cipher is not supported
+     * \throw InvalidKey if the key is invalid
+     */
+    std::string shiftKey(const CipherType type, const std::string& key);
+
+    /**
+     * \brief Encrypt a phrase for each alignment with the key
+     *
+     * \param type the cipher type
+     * \param key the key, in the form the cipher expects
+     * \param phrase the plain text phrase
+     * \return the encrypted phrase as it would appear at offsets 0 to L-1
+     *         (and every offset that is the same modulo L)
+     * \throw std::invalid_argument if the cipher is not supported
+     * \throw InvalidKey if the key is invalid
+     */
+    std::vector<std::string> encryptPhrase(const CipherType type,
+                                           const std::string& key,
+                                           const std::string& phrase);
+
+    /**
+     * \brief Find where each of a set of periodically aligned needles occurs
+     *
+     * Needle i only counts as a match at offsets that are equal to i modulo
+     * the number of needles, so only one needle is relevant at each offset.
+     * The text is split between threads, each of which checks the offsets in
+     * its own chunk but may read up to the length of a needle beyond it, so
+     * that matches that straddle the chunks are still found. On x86-64
+     * processors that support it, 32 offsets are checked at once using AVX2,
+     * comparing the first and last letters of the relevant needle at each
+     * offset before checking the rest.
+     *
+     * \param text the text to search
+     * \param needles the needles, all of the same non-zero length
+     * \param maxThreads the maximum number of threads to use, 0 means no limit
+     * \return the offsets of every match, in increasing order (matches may
+     *         overlap)
+     * \throw std::invalid_argument if there are no needles, or they are
+     *        empty or differ in length
+     */
+    std::vector<std::size_t> findAligned(
+        const std::string& text, const std::vector<std::string>& needles,
+        const std::size_t maxThreads = 0);
+
+    /**
+     * \brief Find a plain text phrase in encrypted text
+     *
+     * \param type the cipher type
+     * \param key the key the text was encrypted with
+     * \param cipherText the encrypted text
+     * \param phrase the plain text phrase to look for
+     * \return the offsets at which the phrase appears once decrypted, in
+     *         increasing order
+     * \throw std::invalid_argument if the cipher is not supported or the
+     *        phrase is empty
+     * \throw InvalidKey if the key is invalid
+     */
+    std::vector<std::size_t> findPhrase(const CipherType type,
+                                        const std::string& key,
+                                        const std::string& cipherText,
+                                        const std::string& phrase);
+}    // namespace CipherSearch
+
+#endif    // MPAGSCIPHER_CIPHERSEARCH_HPP
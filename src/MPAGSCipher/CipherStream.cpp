@@ -0,0 +1,96 @@
+#include "CipherStream.hpp"
+#include "CipherChain.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+CipherStream::CipherStream(const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                           const CipherMode cipherMode)
+    : ciphers_{ciphers},
+      cipherMode_{cipherMode},
+      offsets_(ciphers.size(), 0),
+      pending_(ciphers.size())
+{
+    if (!std::all_of(ciphers.begin(), ciphers.end(), [](const auto& cipher) {
+            return CipherStream::isSupported(cipher->type());
+        })) {
+        throw std::invalid_argument{
+            "only ciphers that can start part way into a text, and "
+            "playfair, can be streamed"};
+    }
+}
+
+bool CipherStream::isSupported(const CipherType type)
+{
+    return CipherChain::isSeekable(type) || type == CipherType::Playfair;
+}
+
+std::string CipherStream::push(const std::string& text)
+{
+    std::string output{text};
+    for (std::size_t stage{0}; stage < ciphers_.size(); ++stage) {
+        output = this->applyStage(stage, output);
+    }
+    return output;
+}
+
+std::string CipherStream::finish()
+{
+    // Whatever a cipher gives back now still has to go through the rest of
+    // the chain before that cipher's own held back letters do
+    std::string output;
+    for (std::size_t stage{0}; stage < ciphers_.size(); ++stage) {
+        output = this->applyStage(stage, output);
+        if (!pending_[stage].empty()) {
+            output += ciphers_[stage]->applyCipher(pending_[stage],
+                                                   cipherMode_);
+            pending_[stage].clear();
+        }
+    }
+    return output;
+}
+
+std::string CipherStream::applyStage(const std::size_t stage,
+                                     const std::string& text)
+{
+    const Cipher& cipher{*ciphers_[stage]};
+    if (cipher.type() != CipherType::Playfair) {
+        std::string output{CipherChain::applyCipherAt(cipher, text,
+                                                      cipherMode_,
+                                                      offsets_[stage])};
+        offsets_[stage] += text.size();
+        return output;
+    }
+
+    // Playfair merges J into I and drops anything else not in its grid
+    std::string& pending{pending_[stage]};
+    for (const char c : text) {
+        if (c >= 'A' && c <= 'Z') {
+            pending += (c == 'J') ? 'I' : c;
+        }
+    }
+
+    // Pair the letters as PlayfairCipher::prepareText() would - a repeated
+    // letter is paired with an inserted X (or Q) and also starts the next
+    // pair - and hold back a letter at the end with nothing to pair with yet
+    std::string digraphs;
+    digraphs.reserve(pending.size() + pending.size() / 8 + 2);
+    std::size_t paired{0};
+    while (paired + 1 < pending.size()) {
+        const char first{pending[paired]};
+        if (first != pending[paired + 1]) {
+            digraphs += first;
+            digraphs += pending[paired + 1];
+            paired += 2;
+        } else {
+            digraphs += first;
+            digraphs += (first == 'X') ? 'Q' : 'X';
+            paired += 1;
+        }
+    }
+    pending.erase(0, paired);
+    return cipher.applyCipher(digraphs, cipherMode_);
+}
@@ -0,0 +1,86 @@
+#ifndef MPAGSCIPHER_CIPHERSTREAM_HPP
+#define MPAGSCIPHER_CIPHERSTREAM_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \file CipherStream.hpp
+ * \brief Contains the declaration of the CipherStream class
+ */
+
+/**
+ * \class CipherStream
+ * \brief Applies a chain of ciphers to a text that arrives a piece at a time
+ *
+ * The output of all the pieces put together is the same as applying the
+ * chain to the whole text at once, but each piece is dealt with as soon as
+ * it arrives. Each cipher that can start part way into a text (e.g. Caesar,
+ * Vigenere and Enigma) carries on from the number of letters it has already
+ * been given, so its key keeps its phase from one piece to the next.
+ * Playfair works on pairs of letters, so a letter at the end of a piece
+ * whose pair is not known yet is held back until the next piece arrives
+ * (or the text ends, when it is padded as usual).
+ */
+class CipherStream {
+  public:
+    /**
+     * \brief Start a stream through a chain of ciphers
+     *
+     * \param ciphers the ciphers, in the order they are to be applied, which
+     *                must outlive the stream
+     * \param cipherMode whether to encrypt or decrypt
+     * \throw std::invalid_argument if any of the ciphers cannot be streamed
+     */
+    CipherStream(const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                 const CipherMode cipherMode);
+
+    /**
+     * \brief Determine whether a type of cipher can be streamed
+     *
+     * \param type the cipher type
+     * \return true for the ciphers that can start part way into a text
+     *         (see CipherChain::isSeekable()) and Playfair
+     */
+    static bool isSupported(const CipherType type);
+
+    /**
+     * \brief Apply the chain to the next piece of the text
+     *
+     * \param text the next piece of the text (in upper-case letters)
+     * \return the output that is ready, which may be less than was put in
+     *         if some letters are being held back
+     */
+    std::string push(const std::string& text);
+
+    /**
+     * \brief End the text, giving back anything that was held back
+     *
+     * \return the rest of the output
+     */
+    std::string finish();
+
+  private:
+    /// Apply one cipher of the chain to the next piece of its input
+    std::string applyStage(const std::size_t stage, const std::string& text);
+
+    /// The ciphers, in the order they are applied
+    const std::vector<std::unique_ptr<Cipher>>& ciphers_;
+
+    /// Whether to encrypt or decrypt
+    CipherMode cipherMode_;
+
+    /// The number of letters each cipher has been given so far
+    std::vector<std::size_t> offsets_;
+
+    /// The letters each (Playfair) cipher is holding back
+    std::vector<std::string> pending_;
+};
+
+#endif    // MPAGSCIPHER_CIPHERSTREAM_HPP
@@ -10,11 +10,26 @@
 /**
  * \enum CipherType
  * \brief Defines the ciphers that can be used
+ *
+ * The values are stored in block-indexed containers, so new ciphers must
+ * only ever be added at the end.
  */
 enum class CipherType {
-    Caesar,      ///< The Caesar cipher
-    Playfair,    ///< The Playfair cipher
-    Vigenere     ///< The Vigenere cipher
+    Caesar,                   ///< The Caesar cipher
+    Playfair,                 ///< The Playfair cipher
+    Vigenere,                 ///< The Vigenere cipher
+    Substitution,             ///< A general monoalphabetic substitution cipher
+    Affine,                   ///< The affine cipher
+    Hill,                     ///< The Hill cipher
+    ColumnarTransposition,    ///< The (single or double) columnar transposition cipher
+    RailFence,                ///< The rail fence cipher
+    Enigma,                   ///< The three-rotor Enigma machine
+    Bifid,                    ///< The Bifid cipher
+    FourSquare,               ///< The Four-square cipher
+    Autokey,                  ///< The autokey cipher
+    RunningKey,               ///< The running key cipher
+    ChaCha20,                 ///< The ChaCha20 stream cipher (operates on bytes)
+    AesCtr                    ///< AES in counter mode (operates on bytes)
 };
 
 class InvalidKey : public std::invalid_argument {
@@ -0,0 +1,135 @@
+#include "ColumnarTranspositionCipher.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Approximate number of bytes of text in each tile of rows, sized to sit in L1
+    constexpr std::size_t tileBytes{16 * 1024};
+
+    /// Number of tiles handed to each thread at a time
+    constexpr std::size_t tilesPerTask{64};
+}    // namespace
+
+ColumnarTranspositionCipher::ColumnarTranspositionCipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void ColumnarTranspositionCipher::setKey(const std::string& key)
+{
+    // Split the key into keywords at the commas
+    std::vector<std::string> keywords{""};
+    for (const char c : key) {
+        if (c == ',') {
+            keywords.emplace_back();
+        } else if (std::isalpha(c)) {
+            keywords.back() += static_cast<char>(std::toupper(c));
+        }
+    }
+
+    if (keywords.size() > 2) {
+        throw InvalidKey{
+            "Key provided to ColumnarTranspositionCipher has more than two keywords"};
+    }
+
+    columnOrders_.clear();
+    for (const auto& keyword : keywords) {
+        if (keyword.empty()) {
+            throw InvalidKey{
+                "Key provided to ColumnarTranspositionCipher has an empty keyword"};
+        }
+
+        // Columns are read in the alphabetical order of their keyword letters,
+        // with ties broken from left to right
+        ColumnOrder order(keyword.size());
+        std::iota(std::begin(order), std::end(order), 0);
+        std::stable_sort(std::begin(order), std::end(order),
+                         [&keyword](std::size_t lhs, std::size_t rhs) {
+                             return keyword[lhs] < keyword[rhs];
+                         });
+        columnOrders_.push_back(order);
+    }
+}
+
+std::string ColumnarTranspositionCipher::applyCipher(
+    const std::string& inputText, const CipherMode cipherMode) const
+{
+    // Apply each transposition in turn, in reverse order when decrypting
+    if (cipherMode == CipherMode::Encrypt) {
+        std::string outputText{
+            transpose(inputText, columnOrders_.front(), cipherMode)};
+        for (auto iter = columnOrders_.begin() + 1;
+             iter != columnOrders_.end(); ++iter) {
+            outputText = transpose(outputText, *iter, cipherMode);
+        }
+        return outputText;
+    } else {
+        std::string outputText{
+            transpose(inputText, columnOrders_.back(), cipherMode)};
+        for (auto iter = columnOrders_.rbegin() + 1;
+             iter != columnOrders_.rend(); ++iter) {
+            outputText = transpose(outputText, *iter, cipherMode);
+        }
+        return outputText;
+    }
+}
+
+std::string ColumnarTranspositionCipher::transpose(
+    const std::string& inputText, const ColumnOrder& columnOrder,
+    const CipherMode cipherMode)
+{
+    const std::size_t nColumns{columnOrder.size()};
+    const std::size_t length{inputText.size()};
+    const std::size_t nRows{(length + nColumns - 1) / nColumns};
+
+    // Find the length of each column (only the last row can be incomplete)
+    // and the offset of each column in the ciphertext
+    std::vector<std::size_t> columnLength(nColumns);
+    for (std::size_t column{0}; column < nColumns; ++column) {
+        columnLength[column] = length / nColumns +
+                               ((column < length % nColumns) ? 1 : 0);
+    }
+    std::vector<std::size_t> columnStart(nColumns);
+    std::size_t offset{0};
+    for (const std::size_t column : columnOrder) {
+        columnStart[column] = offset;
+        offset += columnLength[column];
+    }
+
+    // The transposition is done in tiles of rows, which are small enough for
+    // the strided accesses within the grid to stay in cache, while the
+    // accesses to each column in the ciphertext are contiguous.
+    // Tiles are independent, so they are shared out between threads.
+    std::string outputText(length, ' ');
+    const char* in{inputText.data()};
+    char* out{outputText.data()};
+    const std::size_t tileRows{std::max<std::size_t>(tileBytes / nColumns, 1)};
+    const std::size_t nTiles{(nRows + tileRows - 1) / tileRows};
+
+    parallelFor(nTiles, tilesPerTask, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t tile{begin}; tile < end; ++tile) {
+            const std::size_t firstRow{tile * tileRows};
+            for (std::size_t column{0}; column < nColumns; ++column) {
+                const std::size_t lastRow{
+                    std::min(firstRow + tileRows, columnLength[column])};
+                const std::size_t start{columnStart[column]};
+                if (cipherMode == CipherMode::Encrypt) {
+                    for (std::size_t row{firstRow}; row < lastRow; ++row) {
+                        out[start + row] = in[row * nColumns + column];
+                    }
+                } else {
+                    for (std::size_t row{firstRow}; row < lastRow; ++row) {
+                        out[row * nColumns + column] = in[start + row];
+                    }
+                }
+            }
+        }
+    });
+
+    return outputText;
+}
@@ -0,0 +1,85 @@
+#ifndef MPAGSCIPHER_COLUMNARTRANSPOSITIONCIPHER_HPP
+#define MPAGSCIPHER_COLUMNARTRANSPOSITIONCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * \file ColumnarTranspositionCipher.hpp
+ * \brief Contains the declaration of the ColumnarTranspositionCipher class
+ */
+
+/**
+ * \class ColumnarTranspositionCipher
+ * \brief Encrypt or decrypt text using the columnar transposition cipher with the given key
+ *
+ * The text is written row by row into a grid with one column per letter of
+ * the keyword (the last row may be incomplete), then read off column by
+ * column, taking the columns in the alphabetical order of their keyword
+ * letters (repeated letters are taken from left to right).
+ *
+ * Two keywords separated by a comma, e.g. "ZEBRAS,TIGER", give a double
+ * transposition, with the second keyword applied to the result of the first.
+ */
+class ColumnarTranspositionCipher : public Cipher {
+  public:
+    /**
+     * \brief Create a new ColumnarTranspositionCipher with the given key
+     *
+     * \param key the key to use in the cipher
+     */
+    explicit ColumnarTranspositionCipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the key to use in the cipher
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override
+    {
+        return CipherType::ColumnarTransposition;
+    }
+
+  private:
+    /// Type definition for the order in which the columns are read
+    using ColumnOrder = std::vector<std::size_t>;
+
+    /// The order in which the columns are read, one entry per keyword
+    std::vector<ColumnOrder> columnOrders_;
+
+    /**
+     * \brief Apply a single transposition
+     *
+     * \param inputText the text to transpose
+     * \param columnOrder the order in which the columns are read
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the transposed text
+     */
+    static std::string transpose(const std::string& inputText,
+                                 const ColumnOrder& columnOrder,
+                                 const CipherMode cipherMode);
+};
+
+#endif    // MPAGSCIPHER_COLUMNARTRANSPOSITIONCIPHER_HPP
@@ -0,0 +1,116 @@
+#include "Crc32c.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define MPAGSCIPHER_CRC32C_SSE42
+#endif
+
+namespace {
+    /// Type definition for the slice-by-8 lookup tables
+    using Tables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+    /**
+     * \brief Build the slice-by-8 lookup tables
+     *
+     * Table 0 is the usual byte-at-a-time table, and table k gives the
+     * effect of a byte followed by k zero bytes.
+     *
+     * \return the tables
+     */
+    Tables makeTables()
+    {
+        Tables tables;
+        for (std::uint32_t i{0}; i < 256; ++i) {
+            std::uint32_t crc{i};
+            for (std::size_t bit{0}; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78 : 0);
+            }
+            tables[0][i] = crc;
+        }
+        for (std::size_t k{1}; k < 8; ++k) {
+            for (std::size_t i{0}; i < 256; ++i) {
+                const std::uint32_t previous{tables[k - 1][i]};
+                tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xff];
+            }
+        }
+        return tables;
+    }
+
+    /// Read 4 bytes as a little-endian integer
+    std::uint32_t load32(const unsigned char* p)
+    {
+        return static_cast<std::uint32_t>(p[0]) |
+               static_cast<std::uint32_t>(p[1]) << 8 |
+               static_cast<std::uint32_t>(p[2]) << 16 |
+               static_cast<std::uint32_t>(p[3]) << 24;
+    }
+
+#ifdef MPAGSCIPHER_CRC32C_SSE42
+    /**
+     * \brief Compute the checksum 8 bytes at a time with the crc32 instruction
+     *
+     * \param data the data
+     * \param n the number of bytes of data
+     * \param crc the checksum of the data that comes before
+     * \return the checksum of the data
+     */
+    __attribute__((target("sse4.2"))) std::uint32_t checksumSSE42(
+        const char* data, const std::size_t n, const std::uint32_t crc)
+    {
+        std::uint64_t state{~crc};
+        std::size_t i{0};
+        for (; i + 8 <= n; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            state = _mm_crc32_u64(state, word);
+        }
+        std::uint32_t state32{static_cast<std::uint32_t>(state)};
+        for (; i < n; ++i) {
+            const unsigned char byte{static_cast<unsigned char>(data[i])};
+            state32 = _mm_crc32_u8(state32, byte);
+        }
+        return ~state32;
+    }
+#endif
+}    // namespace
+
+namespace Crc32c {
+    std::uint32_t checksum(const char* data, const std::size_t n,
+                           const std::uint32_t crc)
+    {
+#ifdef MPAGSCIPHER_CRC32C_SSE42
+        static const bool haveSSE42{__builtin_cpu_supports("sse4.2") != 0};
+        if (haveSSE42) {
+            return checksumSSE42(data, n, crc);
+        }
+#endif
+        return checksumSoftware(data, n, crc);
+    }
+
+    std::uint32_t checksumSoftware(const char* data, const std::size_t n,
+                                   const std::uint32_t crc)
+    {
+        static const Tables tables{makeTables()};
+        const unsigned char* p{reinterpret_cast<const unsigned char*>(data)};
+
+        std::uint32_t state{~crc};
+        std::size_t i{0};
+        for (; i + 8 <= n; i += 8) {
+            const std::uint32_t low{load32(p + i) ^ state};
+            const std::uint32_t high{load32(p + i + 4)};
+            state = tables[7][low & 0xff] ^ tables[6][(low >> 8) & 0xff] ^
+                    tables[5][(low >> 16) & 0xff] ^ tables[4][low >> 24] ^
+                    tables[3][high & 0xff] ^ tables[2][(high >> 8) & 0xff] ^
+                    tables[1][(high >> 16) & 0xff] ^ tables[0][high >> 24];
+        }
+        for (; i < n; ++i) {
+            state = (state >> 8) ^ tables[0][(state ^ p[i]) & 0xff];
+        }
+        return ~state;
+    }
+}    // namespace Crc32c
@@ -0,0 +1,49 @@
+#ifndef MPAGSCIPHER_CRC32C_HPP
+#define MPAGSCIPHER_CRC32C_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \file Crc32c.hpp
+ * \brief Contains the declarations of the functions for computing CRC32C checksums
+ */
+
+/**
+ * \namespace Crc32c
+ * \brief Namespace to group the functions that compute the CRC32C (Castagnoli) checksum
+ *
+ * This is the CRC used by iSCSI and ext4, with the reflected polynomial
+ * 0x82F63B78, and is the one the SSE4.2 crc32 instruction computes.
+ */
+namespace Crc32c {
+    /**
+     * \brief Compute the checksum of some data, or extend an earlier one
+     *
+     * On x86-64 processors that support it, 8 bytes are processed per
+     * instruction using SSE4.2, otherwise checksumSoftware() is used.
+     *
+     * \param data the data
+     * \param n the number of bytes of data
+     * \param crc the checksum of the data that comes before, 0 to start afresh
+     * \return the checksum of the data (following on from crc)
+     */
+    std::uint32_t checksum(const char* data, const std::size_t n,
+                           const std::uint32_t crc = 0);
+
+    /**
+     * \brief Compute the checksum of some data without any special instructions
+     *
+     * This uses the slice-by-8 method, which looks up each of 8 bytes in its
+     * own table and combines the results, so processes 8 bytes per step.
+     *
+     * \param data the data
+     * \param n the number of bytes of data
+     * \param crc the checksum of the data that comes before, 0 to start afresh
+     * \return the checksum of the data (following on from crc)
+     */
+    std::uint32_t checksumSoftware(const char* data, const std::size_t n,
+                                   const std::uint32_t crc = 0);
+}    // namespace Crc32c
+
+#endif    // MPAGSCIPHER_CRC32C_HPP
@@ -0,0 +1,380 @@
+#include "Csv.hpp"
+#include "Alphabet.hpp"
+#include "CipherChain.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define MPAGSCIPHER_CSV_X86
+#endif
+
+namespace {
+    /// Where the delimiters, quotes and newlines are in 64 bytes of text
+    struct Masks {
+        /// Bit i is set if byte i is the delimiter
+        std::uint64_t delimiters{0};
+        /// Bit i is set if byte i is a quote
+        std::uint64_t quotes{0};
+        /// Bit i is set if byte i is a newline
+        std::uint64_t newlines{0};
+    };
+
+    /// Make the masks for 64 bytes a byte at a time
+    Masks masksPortable(const char* chunk, const char delimiter)
+    {
+        Masks masks;
+        for (std::size_t i{0}; i < 64; ++i) {
+            const std::uint64_t bit{std::uint64_t{1} << i};
+            masks.delimiters |= (chunk[i] == delimiter) ? bit : 0;
+            masks.quotes |= (chunk[i] == '"') ? bit : 0;
+            masks.newlines |= (chunk[i] == '\n') ? bit : 0;
+        }
+        return masks;
+    }
+
+    /**
+     * \brief Set every bit from each set bit up to (but not including) the next one
+     *
+     * Bit i of the result is the XOR of bits 0 to i, so given the quotes it
+     * marks each opening quote and everything up to its closing quote.
+     *
+     * \param bits the bits
+     * \return the prefix XOR of the bits
+     */
+    std::uint64_t prefixXor(std::uint64_t bits)
+    {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    /**
+     * \brief Add the separators in 64 bytes of text that are outside quotes
+     *
+     * \param masks the masks for the 64 bytes
+     * \param base the offset of the 64 bytes in the piece being scanned
+     * \param inQuotes all ones if the bytes start inside quotes, otherwise
+     *                 0, and set in the same way for where they end
+     * \param separators has the offset of each separator appended
+     */
+    inline void addSeparators(const Masks& masks, const std::size_t base,
+                              std::uint64_t& inQuotes,
+                              std::vector<std::uint32_t>& separators)
+    {
+        const std::uint64_t quoted{prefixXor(masks.quotes) ^ inQuotes};
+        std::uint64_t bits{(masks.delimiters | masks.newlines) & ~quoted};
+        inQuotes = 0 - (quoted >> 63);
+        while (bits != 0) {
+            separators.push_back(
+                static_cast<std::uint32_t>(base + __builtin_ctzll(bits)));
+            bits &= bits - 1;
+        }
+    }
+
+    /// Add the separators in the last (less than 64) bytes of a piece
+    void scanTail(const char* data, const std::size_t n, const std::size_t i,
+                  const char delimiter, std::uint64_t& inQuotes,
+                  std::vector<std::uint32_t>& separators)
+    {
+        if (i == n) {
+            return;
+        }
+        // The padding never matches, as the delimiter cannot be a NUL
+        char chunk[64] = {};
+        std::memcpy(chunk, data + i, n - i);
+        addSeparators(masksPortable(chunk, delimiter), i, inQuotes,
+                      separators);
+    }
+
+    /// Check that a piece is small enough for its offsets to fit in 32 bits
+    void checkSize(const std::size_t n)
+    {
+        if (n > UINT32_MAX) {
+            throw std::invalid_argument{
+                "Csv::Scanner cannot scan 4 GiB or more at once"};
+        }
+    }
+
+#ifdef MPAGSCIPHER_CSV_X86
+    /// Make a mask of the bytes of 16 that equal a character, using SSE2
+    std::uint64_t matchSSE2(const __m128i bytes, const __m128i c)
+    {
+        return static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, c)));
+    }
+
+    /**
+     * \brief Add the separators in a piece of text, making the masks 16 bytes at a time with SSE2
+     *
+     * \param data the start of the piece
+     * \param n the number of bytes in the piece
+     * \param delimiter the character that separates the fields
+     * \param inQuotes whether the piece starts inside quotes, set to
+     *                 whether it ends inside them
+     * \param separators has the offset of each separator appended
+     */
+    void scanSSE2(const char* data, const std::size_t n, const char delimiter,
+                  std::uint64_t& inQuotes,
+                  std::vector<std::uint32_t>& separators)
+    {
+        const __m128i delimiters{_mm_set1_epi8(delimiter)};
+        const __m128i quotes{_mm_set1_epi8('"')};
+        const __m128i newlines{_mm_set1_epi8('\n')};
+        std::size_t i{0};
+        for (; i + 64 <= n; i += 64) {
+            Masks masks;
+            for (std::size_t k{0}; k < 4; ++k) {
+                const __m128i bytes{_mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + i + 16 * k))};
+                masks.delimiters |= matchSSE2(bytes, delimiters) << (16 * k);
+                masks.quotes |= matchSSE2(bytes, quotes) << (16 * k);
+                masks.newlines |= matchSSE2(bytes, newlines) << (16 * k);
+            }
+            addSeparators(masks, i, inQuotes, separators);
+        }
+        scanTail(data, n, i, delimiter, inQuotes, separators);
+    }
+
+    /// Make a mask of the bytes of 32 that equal a character, using AVX2
+    __attribute__((target("avx2"))) std::uint64_t matchAVX2(
+        const __m256i bytes, const __m256i c)
+    {
+        return static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, c)));
+    }
+
+    /**
+     * \brief Add the separators in a piece of text, making the masks 32 bytes at a time with AVX2
+     *
+     * \param data the start of the piece
+     * \param n the number of bytes in the piece
+     * \param delimiter the character that separates the fields
+     * \param inQuotes whether the piece starts inside quotes, set to
+     *                 whether it ends inside them
+     * \param separators has the offset of each separator appended
+     */
+    __attribute__((target("avx2"))) void scanAVX2(
+        const char* data, const std::size_t n, const char delimiter,
+        std::uint64_t& inQuotes, std::vector<std::uint32_t>& separators)
+    {
+        const __m256i delimiters{_mm256_set1_epi8(delimiter)};
+        const __m256i quotes{_mm256_set1_epi8('"')};
+        const __m256i newlines{_mm256_set1_epi8('\n')};
+        std::size_t i{0};
+        for (; i + 64 <= n; i += 64) {
+            const __m256i low{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data + i))};
+            const __m256i high{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data + i + 32))};
+            Masks masks;
+            masks.delimiters = matchAVX2(low, delimiters) |
+                               matchAVX2(high, delimiters) << 32;
+            masks.quotes =
+                matchAVX2(low, quotes) | matchAVX2(high, quotes) << 32;
+            masks.newlines =
+                matchAVX2(low, newlines) | matchAVX2(high, newlines) << 32;
+            addSeparators(masks, i, inQuotes, separators);
+        }
+        scanTail(data, n, i, delimiter, inQuotes, separators);
+    }
+#endif
+
+    /// Determine whether a character is an (ASCII) letter
+    bool isLetter(const char c)
+    {
+        return static_cast<unsigned char>((c | 0x20) - 'a') < 26;
+    }
+
+    /**
+     * \brief Encrypt/decrypt the letters of a field in place through a table
+     *
+     * \param field the start of the field
+     * \param n the number of bytes in the field
+     * \param substitution what each letter of the alphabet becomes
+     */
+    void substituteField(char* field, const std::size_t n,
+                         const std::string& substitution)
+    {
+        for (std::size_t i{0}; i < n; ++i) {
+            if (isLetter(field[i])) {
+                const std::size_t letter{
+                    static_cast<std::size_t>((field[i] | 0x20) - 'a')};
+                field[i] =
+                    static_cast<char>(substitution[letter] | (field[i] & 0x20));
+            }
+        }
+    }
+
+    /**
+     * \brief Encrypt/decrypt the letters of a field in place
+     *
+     * \param field the start of the field
+     * \param n the number of bytes in the field
+     * \param ciphers the ciphers, in the order they are to be applied
+     * \param cipherMode whether to encrypt or decrypt
+     * \param letters a buffer to gather the letters in
+     * \throw std::invalid_argument if a cipher changes the number of letters
+     */
+    void applyField(char* field, const std::size_t n,
+                    const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                    const CipherMode cipherMode, std::string& letters)
+    {
+        letters.clear();
+        for (std::size_t i{0}; i < n; ++i) {
+            if (isLetter(field[i])) {
+                letters += static_cast<char>(field[i] & ~0x20);
+            }
+        }
+        if (letters.empty()) {
+            return;
+        }
+
+        std::string text{letters};
+        for (const auto& cipher : ciphers) {
+            text = cipher->applyCipher(text, cipherMode);
+        }
+        if (text.size() != letters.size()) {
+            throw std::invalid_argument{
+                "the ciphers must not change the number of letters in a "
+                "CSV field"};
+        }
+
+        // Put each letter back where it came from, in the same case
+        std::size_t k{0};
+        for (std::size_t i{0}; i < n; ++i) {
+            if (isLetter(field[i])) {
+                field[i] = static_cast<char>(text[k++] | (field[i] & 0x20));
+            }
+        }
+    }
+}    // namespace
+
+Csv::Scanner::Scanner(const char delimiter) : delimiter_{delimiter}
+{
+    if (delimiter == '"' || delimiter == '\n' || delimiter == '\r' ||
+        delimiter == '\0') {
+        throw std::invalid_argument{
+            "the CSV delimiter cannot be a quote, newline, carriage return "
+            "or NUL"};
+    }
+}
+
+void Csv::Scanner::scan(const char* data, const std::size_t n,
+                        std::vector<std::uint32_t>& separators)
+{
+    checkSize(n);
+#ifdef MPAGSCIPHER_CSV_X86
+    static const bool haveAVX2{__builtin_cpu_supports("avx2") != 0};
+    if (haveAVX2) {
+        scanAVX2(data, n, delimiter_, inQuotes_, separators);
+    } else {
+        scanSSE2(data, n, delimiter_, inQuotes_, separators);
+    }
+#else
+    this->scanPortable(data, n, separators);
+#endif
+}
+
+void Csv::Scanner::scanPortable(const char* data, const std::size_t n,
+                                std::vector<std::uint32_t>& separators)
+{
+    checkSize(n);
+    std::size_t i{0};
+    for (; i + 64 <= n; i += 64) {
+        addSeparators(masksPortable(data + i, delimiter_), i, inQuotes_,
+                      separators);
+    }
+    scanTail(data, n, i, delimiter_, inQuotes_, separators);
+}
+
+Csv::Splitter::Splitter(const char delimiter) : scanner_{delimiter} {}
+
+bool Csv::Splitter::add(const char* data, const std::size_t n,
+                        std::string& block)
+{
+    // Find the end of the last record that is complete, which is the last
+    // newline outside quotes
+    separators_.clear();
+    scanner_.scan(data, n, separators_);
+    std::size_t complete{0};
+    for (auto it = separators_.rbegin(); it != separators_.rend(); ++it) {
+        if (data[*it] == '\n') {
+            complete = *it + 1;
+            break;
+        }
+    }
+    if (complete == 0) {
+        partial_.append(data, n);
+        return false;
+    }
+
+    block += partial_;
+    block.append(data, complete);
+    partial_.assign(data + complete, n - complete);
+    return true;
+}
+
+bool Csv::Splitter::finish(std::string& block)
+{
+    if (partial_.empty()) {
+        return false;
+    }
+    block += partial_;
+    partial_.clear();
+    return true;
+}
+
+void Csv::apply(std::string& block, const char delimiter,
+                const std::vector<bool>& columns,
+                const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                const CipherMode cipherMode)
+{
+    Scanner scanner{delimiter};
+    std::vector<std::uint32_t> separators;
+    scanner.scan(block.data(), block.size(), separators);
+    separators.push_back(static_cast<std::uint32_t>(block.size()));
+
+    // A chain of simple substitutions encrypts each letter the same way
+    // wherever it is, so the letters can be looked up where they are rather
+    // than each field being gathered up and passed through the ciphers
+    std::string substitution;
+    if (std::all_of(ciphers.begin(), ciphers.end(), [](const auto& cipher) {
+            return CipherChain::isMonoalphabetic(cipher->type());
+        })) {
+        substitution = Alphabet::alphabet;
+        for (const auto& cipher : ciphers) {
+            substitution = cipher->applyCipher(substitution, cipherMode);
+        }
+    }
+
+    std::string letters;
+    std::size_t column{0};
+    std::size_t start{0};
+    for (const std::size_t end : separators) {
+        if (column < columns.size() && columns[column]) {
+            if (!substitution.empty()) {
+                substituteField(&block[start], end - start, substitution);
+            } else {
+                applyField(&block[start], end - start, ciphers, cipherMode,
+                           letters);
+            }
+        }
+        if (end < block.size() && block[end] == '\n') {
+            column = 0;
+        } else {
+            ++column;
+        }
+        start = end + 1;
+    }
+}
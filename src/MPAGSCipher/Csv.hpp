@@ -0,0 +1,168 @@
+#ifndef MPAGSCIPHER_CSV_HPP
+#define MPAGSCIPHER_CSV_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \file Csv.hpp
+ * \brief Contains the declarations of the functions and classes for encrypting selected fields of CSV/TSV text
+ */
+
+/**
+ * \namespace Csv
+ * \brief Namespace to group the functions and classes for encrypting chosen columns of delimited text
+ *
+ * Each record of the text is a line, and its fields are separated by a
+ * delimiter (a comma for CSV or a tab for TSV). A field may be quoted with
+ * double quotes, in which case it can contain delimiters and newlines, and
+ * a doubled quote stands for a quote within it. Only the letters of the
+ * chosen fields are encrypted, in place and keeping their case, so that
+ * everything else (digits, punctuation, quotes and the other fields) is
+ * left exactly as it was and the text is still valid CSV.
+ */
+namespace Csv {
+    /**
+     * \class Scanner
+     * \brief Finds the delimiters and newlines of delimited text that are not inside quotes
+     *
+     * The text is looked at 64 bytes at a time. Comparing the bytes with the
+     * delimiter, the quote and the newline gives a 64-bit mask of where each
+     * is, and a prefix XOR of the quote mask then marks every byte that is
+     * inside quotes, so quoted fields cost no more than any others. The masks
+     * are made with AVX2 on x86-64 processors that support it, otherwise with
+     * SSE2 (or without any special instructions on other processors).
+     */
+    class Scanner {
+      public:
+        /**
+         * \brief Create a scanner for text with the given delimiter
+         *
+         * \param delimiter the character that separates the fields
+         * \throw std::invalid_argument if the delimiter is a quote, a
+         *        newline, a carriage return or a NUL
+         */
+        explicit Scanner(const char delimiter = ',');
+
+        /**
+         * \brief Find the separators in the next piece of the text
+         *
+         * Whether the piece starts inside quotes is carried on from the
+         * pieces scanned before it.
+         *
+         * \param data the start of the piece
+         * \param n the number of bytes in the piece
+         * \param separators has the offset (from the start of the piece) of
+         *                   each delimiter and newline outside quotes appended
+         * \throw std::invalid_argument if the piece is 4 GiB or larger
+         */
+        void scan(const char* data, const std::size_t n,
+                  std::vector<std::uint32_t>& separators);
+
+        /**
+         * \brief Find the separators without any special instructions
+         *
+         * This gives exactly the same result as scan(), and is there to
+         * check it against.
+         *
+         * \param data the start of the piece
+         * \param n the number of bytes in the piece
+         * \param separators has the offset of each separator appended
+         * \throw std::invalid_argument if the piece is 4 GiB or larger
+         */
+        void scanPortable(const char* data, const std::size_t n,
+                          std::vector<std::uint32_t>& separators);
+
+        /**
+         * \brief Determine whether the text scanned so far ends inside quotes
+         *
+         * \return true if a quoted field has been opened but not closed
+         */
+        bool inQuotes() const { return inQuotes_ != 0; }
+
+      private:
+        /// The character that separates the fields
+        char delimiter_;
+
+        /// All ones if the text scanned so far ends inside quotes, else 0
+        std::uint64_t inQuotes_{0};
+    };
+
+    /**
+     * \class Splitter
+     * \brief Splits a stream of delimited text into blocks that hold only whole records
+     *
+     * Like Records::Splitter, except that a newline inside a quoted field
+     * does not end the record.
+     */
+    class Splitter {
+      public:
+        /**
+         * \brief Create a splitter for text with the given delimiter
+         *
+         * \param delimiter the character that separates the fields
+         * \throw std::invalid_argument if the delimiter cannot be used
+         */
+        explicit Splitter(const char delimiter = ',');
+
+        /**
+         * \brief Add a piece of input
+         *
+         * \param data the start of the piece
+         * \param n the number of bytes in the piece
+         * \param block has the whole records that are now complete appended
+         * \return true if any records were appended
+         */
+        bool add(const char* data, const std::size_t n, std::string& block);
+
+        /**
+         * \brief Take the last record, once the input has ended
+         *
+         * \param block has the record held back (if any) appended
+         * \return true if there was a record held back
+         */
+        bool finish(std::string& block);
+
+      private:
+        /// The scanner, which follows the quotes across the whole stream
+        Scanner scanner_;
+
+        /// The separators found in the piece being added
+        std::vector<std::uint32_t> separators_;
+
+        /// The start of a record whose newline has not been seen yet
+        std::string partial_;
+    };
+
+    /**
+     * \brief Encrypt/decrypt the letters of the chosen fields of a block of records, in place
+     *
+     * Each field is a message of its own, so every cipher starts again from
+     * the beginning of its key in each field. The ciphers must give back as
+     * many letters as they are given (as the ones for which
+     * CipherChain::isReversible() is true do).
+     * A chain of simple substitutions (e.g. Caesar) is applied through a
+     * table to the letters where they are.
+     *
+     * \param block the records, starting outside quotes
+     * \param delimiter the character that separates the fields
+     * \param columns whether to encrypt each field of a record, by its
+     *                (zero-based) position in the record
+     * \param ciphers the ciphers, in the order they are to be applied
+     * \param cipherMode whether to encrypt or decrypt
+     * \throw std::invalid_argument if the delimiter cannot be used, or a
+     *        cipher changes the number of letters in a field
+     */
+    void apply(std::string& block, const char delimiter,
+               const std::vector<bool>& columns,
+               const std::vector<std::unique_ptr<Cipher>>& ciphers,
+               const CipherMode cipherMode);
+}    // namespace Csv
+
+#endif    // MPAGSCIPHER_CSV_HPP
@@ -0,0 +1,308 @@
+#include "DirectoryCipher.hpp"
+#include "CipherChain.hpp"
+#include "MappedFile.hpp"
+#include "TransformChar.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+    /**
+     * \class OutputFile
+     * \brief A file being written, which is closed when it goes out of scope
+     */
+    class OutputFile {
+      public:
+        /// Create (or truncate) the file
+        explicit OutputFile(const fs::path& path) : name_{path.string()}
+        {
+            fd_ = ::open(name_.c_str(),
+                         O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd_ < 0) {
+                throw std::system_error{errno, std::generic_category(),
+                                        "failed to create '" + name_ + "'"};
+            }
+        }
+
+        /// Close the file
+        ~OutputFile() { ::close(fd_); }
+
+        /// The file cannot be copied
+        OutputFile(const OutputFile& rhs) = delete;
+        /// The file cannot be moved
+        OutputFile(OutputFile&& rhs) = delete;
+        /// The file cannot be copy assigned
+        OutputFile& operator=(const OutputFile& rhs) = delete;
+        /// The file cannot be move assigned
+        OutputFile& operator=(OutputFile&& rhs) = delete;
+
+        /// Set the size of the file, so that its parts can be written in any order
+        void resize(const std::uint64_t size)
+        {
+            if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+                throw std::system_error{errno, std::generic_category(),
+                                        "failed to resize '" + name_ + "'"};
+            }
+        }
+
+        /// Write some text at an offset in the file
+        void writeAt(const std::string& text, std::uint64_t offset)
+        {
+            const char* data{text.data()};
+            std::size_t n{text.size()};
+            while (n > 0) {
+                const ssize_t result{
+                    ::pwrite(fd_, data, n, static_cast<off_t>(offset))};
+                if (result < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error{errno, std::generic_category(),
+                                            "failed to write '" + name_ + "'"};
+                }
+                data += result;
+                n -= static_cast<std::size_t>(result);
+                offset += static_cast<std::uint64_t>(result);
+            }
+        }
+
+      private:
+        /// The name of the file
+        std::string name_;
+
+        /// The file descriptor
+        int fd_{-1};
+    };
+
+    /// Type definition for a list of files to read and the files to write
+    using FileList = std::vector<std::pair<fs::path, fs::path>>;
+
+    /**
+     * \struct Job
+     * \brief What is shared between the tasks that encrypt a tree
+     */
+    struct Job {
+        /// Set up a job
+        Job(const std::vector<std::unique_ptr<Cipher>>& jobCiphers,
+            const CipherMode jobCipherMode, const std::size_t jobChunkSize,
+            WorkStealingPool& jobPool)
+            : ciphers{jobCiphers},
+              cipherMode{jobCipherMode},
+              chunkSize{jobChunkSize},
+              pool{jobPool}
+        {
+            splittable = std::all_of(
+                ciphers.begin(), ciphers.end(), [](const auto& cipher) {
+                    return CipherChain::isSeekable(cipher->type());
+                });
+            for (std::size_t c{0}; c < letters.size(); ++c) {
+                letters[c] = transformChar(static_cast<char>(c));
+                lengths[c] = letters[c].size();
+            }
+        }
+
+        /// The ciphers, in the order they are applied
+        const std::vector<std::unique_ptr<Cipher>>& ciphers;
+        /// Whether to encrypt or decrypt
+        CipherMode cipherMode;
+        /// The number of bytes of small files per task and of each chunk
+        std::size_t chunkSize;
+        /// Whether a file can be split into chunks (every cipher is seekable)
+        bool splittable{false};
+        /// The transliteration of each character
+        std::array<std::string, 256> letters;
+        /// The number of letters each character becomes
+        std::array<std::size_t, 256> lengths;
+        /// The pool running the tasks
+        WorkStealingPool& pool;
+        /// The number of files encrypted
+        std::atomic<std::size_t> files{0};
+        /// The number of directories mirrored
+        std::atomic<std::size_t> directories{0};
+        /// The number of bytes read
+        std::atomic<std::uint64_t> bytesIn{0};
+        /// The number of bytes written
+        std::atomic<std::uint64_t> bytesOut{0};
+    };
+
+    /// Transliterate a piece of a file
+    std::string transliterate(const Job& job, const char* data,
+                              const std::size_t n)
+    {
+        std::string text;
+        text.reserve(n);
+        for (std::size_t i{0}; i < n; ++i) {
+            text += job.letters[static_cast<unsigned char>(data[i])];
+        }
+        return text;
+    }
+
+    /// Encrypt each of a list of files as a whole
+    void encryptFiles(Job& job, const FileList& files)
+    {
+        for (const auto& [from, to] : files) {
+            const MappedFile input{from.string()};
+            std::string text{transliterate(job, input.data(), input.size())};
+            for (const auto& cipher : job.ciphers) {
+                text = cipher->applyCipher(text, job.cipherMode);
+            }
+            text += '\n';
+
+            OutputFile output{to};
+            output.writeAt(text, 0);
+            ++job.files;
+            job.bytesIn += input.size();
+            job.bytesOut += text.size();
+        }
+    }
+
+    /// Encrypt a large file as chunks, each of which is a task of its own
+    void encryptLargeFile(Job& job, const fs::path& from, const fs::path& to)
+    {
+        // Find where each chunk starts in the text by counting its letters,
+        // so that the chunks can be encrypted and written in any order
+        auto input = std::make_shared<const MappedFile>(from.string());
+        const std::size_t nChunks{(input->size() + job.chunkSize - 1) /
+                                  job.chunkSize};
+        std::vector<std::uint64_t> offsets(nChunks + 1, 0);
+        for (std::size_t chunk{0}; chunk < nChunks; ++chunk) {
+            const std::size_t begin{chunk * job.chunkSize};
+            const std::size_t end{
+                std::min(begin + job.chunkSize, input->size())};
+            std::uint64_t nLetters{0};
+            for (std::size_t i{begin}; i < end; ++i) {
+                nLetters +=
+                    job.lengths[static_cast<unsigned char>(input->data()[i])];
+            }
+            offsets[chunk + 1] = offsets[chunk] + nLetters;
+        }
+
+        auto output = std::make_shared<OutputFile>(to);
+        output->resize(offsets.back() + 1);
+        output->writeAt("\n", offsets.back());
+        ++job.files;
+        job.bytesIn += input->size();
+        job.bytesOut += offsets.back() + 1;
+
+        for (std::size_t chunk{0}; chunk < nChunks; ++chunk) {
+            const std::size_t begin{chunk * job.chunkSize};
+            const std::size_t end{
+                std::min(begin + job.chunkSize, input->size())};
+            const std::uint64_t offset{offsets[chunk]};
+            job.pool.spawn([&job, input, output, begin, end, offset]() {
+                std::string text{
+                    transliterate(job, input->data() + begin, end - begin)};
+                for (const auto& cipher : job.ciphers) {
+                    text = CipherChain::applyCipherAt(*cipher, text,
+                                                      job.cipherMode, offset);
+                }
+                output->writeAt(text, offset);
+            });
+        }
+    }
+
+    /// Mirror a directory, and spawn the tasks for everything in it
+    void walk(Job& job, const fs::path& from, const fs::path& to)
+    {
+        fs::create_directories(to);
+        ++job.directories;
+
+        FileList pack;
+        std::uint64_t packBytes{0};
+        for (const auto& entry : fs::directory_iterator{from}) {
+            // Symbolic links are not followed, so the walk cannot loop
+            const fs::file_status status{entry.symlink_status()};
+            const fs::path target{to / entry.path().filename()};
+            if (fs::is_directory(status)) {
+                job.pool.spawn([&job, source = entry.path(), target]() {
+                    walk(job, source, target);
+                });
+            } else if (fs::is_regular_file(status)) {
+                const std::uint64_t size{entry.file_size()};
+                if (size >= job.chunkSize) {
+                    job.pool.spawn([&job, source = entry.path(), target]() {
+                        if (job.splittable) {
+                            encryptLargeFile(job, source, target);
+                        } else {
+                            encryptFiles(job, {{source, target}});
+                        }
+                    });
+                    continue;
+                }
+
+                // Small files are packed together until there are enough
+                // of them to be worth a task
+                pack.emplace_back(entry.path(), target);
+                packBytes += size;
+                if (packBytes >= job.chunkSize) {
+                    job.pool.spawn([&job, files = std::move(pack)]() {
+                        encryptFiles(job, files);
+                    });
+                    pack.clear();
+                    packBytes = 0;
+                }
+            }
+        }
+        if (!pack.empty()) {
+            job.pool.spawn([&job, files = std::move(pack)]() {
+                encryptFiles(job, files);
+            });
+        }
+    }
+}    // namespace
+
+DirectoryCipher::Stats DirectoryCipher::apply(
+    const std::string& inputDirectory, const std::string& outputDirectory,
+    const std::vector<std::unique_ptr<Cipher>>& ciphers,
+    const CipherMode cipherMode, const std::size_t nThreads,
+    const std::size_t chunkSize)
+{
+    if (chunkSize == 0) {
+        throw std::invalid_argument{"DirectoryCipher chunk size must not be 0"};
+    }
+    if (!fs::is_directory(inputDirectory)) {
+        throw std::invalid_argument{"'" + inputDirectory +
+                                    "' is not a directory"};
+    }
+
+    // Writing into the tree being read would never finish
+    const fs::path from{fs::canonical(inputDirectory)};
+    const fs::path to{fs::weakly_canonical(outputDirectory)};
+    if (std::mismatch(from.begin(), from.end(), to.begin(), to.end()).first ==
+        from.end()) {
+        throw std::invalid_argument{
+            "the output directory cannot be inside the input directory"};
+    }
+
+    WorkStealingPool pool{nThreads};
+    Job job{ciphers, cipherMode, chunkSize, pool};
+    pool.spawn([&job, from, to]() { walk(job, from, to); });
+    const WorkStealingPool::Stats poolStats{pool.run()};
+
+    Stats stats;
+    stats.files = job.files;
+    stats.directories = job.directories;
+    stats.bytesIn = job.bytesIn;
+    stats.bytesOut = job.bytesOut;
+    stats.threads = poolStats.threads;
+    stats.tasks = poolStats.tasks;
+    stats.steals = poolStats.steals;
+    return stats;
+}
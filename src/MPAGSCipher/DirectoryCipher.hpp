@@ -0,0 +1,81 @@
+#ifndef MPAGSCIPHER_DIRECTORYCIPHER_HPP
+#define MPAGSCIPHER_DIRECTORYCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \file DirectoryCipher.hpp
+ * \brief Contains the declarations of the functions for encrypting a whole directory tree
+ */
+
+/**
+ * \namespace DirectoryCipher
+ * \brief Namespace to group the functions for encrypting every file in a directory tree at once
+ *
+ * The tree is mirrored into an output directory, with each regular file
+ * transliterated and encrypted (or decrypted) as mpags-cipher would do it
+ * on its own. Symbolic links and anything else that is not a regular file
+ * or a directory are skipped.
+ *
+ * All of it runs as tasks on a WorkStealingPool, so that the work stays
+ * spread evenly over the threads: each directory is listed by a task of its
+ * own, many small files are packed into each task so that there are not
+ * too many tiny ones, and a large file is split into chunks that are each
+ * a task (when every cipher can start part way into a text - otherwise it
+ * is one task on its own).
+ */
+namespace DirectoryCipher {
+    /**
+     * \struct Stats
+     * \brief What was done to a directory tree
+     */
+    struct Stats {
+        /// The number of files encrypted
+        std::size_t files{0};
+        /// The number of directories mirrored (including the top one)
+        std::size_t directories{0};
+        /// The number of bytes read
+        std::uint64_t bytesIn{0};
+        /// The number of bytes written
+        std::uint64_t bytesOut{0};
+        /// The number of threads that ran the tasks
+        std::size_t threads{0};
+        /// The number of tasks run
+        std::size_t tasks{0};
+        /// The number of tasks that were stolen from another thread
+        std::size_t steals{0};
+    };
+
+    /**
+     * \brief Encrypt/decrypt every file in a directory tree into a copy of the tree
+     *
+     * \param inputDirectory the top of the tree to read
+     * \param outputDirectory where to write the copy, which is created if
+     *                        need be, and must not be inside the input
+     * \param ciphers the ciphers, in the order they are to be applied
+     * \param cipherMode whether to encrypt or decrypt
+     * \param nThreads the number of threads to use, 0 means one per
+     *                 hardware thread
+     * \param chunkSize the number of bytes of small files packed into each
+     *                  task, and of each chunk of a large file
+     * \return what was done
+     * \throw std::invalid_argument if the input is not a directory, the
+     *        output is inside it, or the chunk size is 0
+     * \throw std::system_error if a file or directory cannot be read or
+     *        written
+     */
+    Stats apply(const std::string& inputDirectory,
+                const std::string& outputDirectory,
+                const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                const CipherMode cipherMode, const std::size_t nThreads = 0,
+                const std::size_t chunkSize = 4 << 20);
+}    // namespace DirectoryCipher
+
+#endif    // MPAGSCIPHER_DIRECTORYCIPHER_HPP
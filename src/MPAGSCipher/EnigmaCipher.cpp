@@ -0,0 +1,354 @@
+#include "EnigmaCipher.hpp"
+#include "Alphabet.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Number of letters handed to each thread at a time
+    constexpr std::size_t lettersPerTask{1 << 16};
+
+    /// The number of letters on each rotor
+    constexpr std::size_t nLetters{26};
+
+    /// The number of distinct rotor positions
+    constexpr std::size_t nStates{nLetters * nLetters * nLetters};
+
+    /**
+     * \struct WheelSpec
+     * \brief The wiring of a rotor or reflector and, for rotors, the turnover notches
+     */
+    struct WheelSpec {
+        /// The name of the wheel
+        const char* name;
+        /// The letter each of A-Z is wired to
+        const char* wiring;
+        /// The letters showing in the window when the next rotor is pushed on
+        const char* notches;
+    };
+
+    /// The rotors of the Enigma I and M3 machines
+    const std::array<WheelSpec, 8> rotorSpecs{{
+        {"I", "EKMFLGDQVZNTOWYHXUSPAIBRCJ", "Q"},
+        {"II", "AJDKSIRUXBLHWTMCQGZNPYFVOE", "E"},
+        {"III", "BDFHJLCPRTXVZNYEIWGAKMUSQO", "V"},
+        {"IV", "ESOVPZJAYQUIRHXLNFTGKDCMWB", "J"},
+        {"V", "VZBRGITYUPSDNHLXAWMJQOFECK", "Z"},
+        {"VI", "JPGVOUMFYQBENHZRDKASXLICTW", "ZM"},
+        {"VII", "NZJHGRCXMYSWBOUFAIVLPEKQDT", "ZM"},
+        {"VIII", "FKQHTLXOCBJSPDZRAMEWNIUYGV", "ZM"},
+    }};
+
+    /// The reflectors of the Enigma I and M3 machines
+    const std::array<WheelSpec, 2> reflectorSpecs{{
+        {"B", "YRUHQSLDPXNGOKMIEBFZCWVJAT", ""},
+        {"C", "FVPJIAOYEDRZXWGCTKUQSBNMHL", ""},
+    }};
+
+    /**
+     * \brief Look up a wheel by name
+     *
+     * \param specs the available wheels
+     * \param name the name to look for
+     * \return the wheel, or nullptr if there is no wheel with that name
+     */
+    template <std::size_t N>
+    const WheelSpec* findWheel(const std::array<WheelSpec, N>& specs,
+                               const std::string& name)
+    {
+        for (const auto& spec : specs) {
+            if (name == spec.name) {
+                return &spec;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * \brief Split a string into words separated by whitespace
+     *
+     * \param text the string to split
+     * \return the words
+     */
+    std::vector<std::string> splitWords(const std::string& text)
+    {
+        std::vector<std::string> words;
+        std::istringstream stream{text};
+        std::string word;
+        while (stream >> word) {
+            words.push_back(word);
+        }
+        return words;
+    }
+
+    /**
+     * \brief Convert a field of the key into exactly three letters
+     *
+     * \param field the field of the key, e.g. "AAA" or "A A A"
+     * \param what what the field describes, for the error message
+     * \return the letters, as numbers 0-25
+     */
+    std::array<std::size_t, 3> readLetterTriple(const std::string& field,
+                                                const std::string& what)
+    {
+        std::string letters;
+        for (const char c : field) {
+            if (!std::isspace(c)) {
+                letters += c;
+            }
+        }
+        if (letters.size() != 3 ||
+            !std::all_of(std::begin(letters), std::end(letters),
+                         [](char c) { return c >= 'A' && c <= 'Z'; })) {
+            throw InvalidKey{"Key provided to EnigmaCipher must give " + what +
+                             " as three letters"};
+        }
+        return {static_cast<std::size_t>(letters[0] - 'A'),
+                static_cast<std::size_t>(letters[1] - 'A'),
+                static_cast<std::size_t>(letters[2] - 'A')};
+    }
+
+    /**
+     * \struct Rotor
+     * \brief A rotor in one of the three slots of the machine
+     */
+    struct Rotor {
+        /// The wiring from right to left
+        std::array<std::size_t, nLetters> forward{};
+        /// The wiring from left to right
+        std::array<std::size_t, nLetters> backward{};
+        /// Whether each position is one at which the next rotor is pushed on
+        std::array<bool, nLetters> notch{};
+        /// The ring setting
+        std::size_t ring{0};
+
+        /// Pass a letter through the rotor from right to left
+        std::size_t in(const std::size_t c, const std::size_t position) const
+        {
+            const std::size_t shift{(position + nLetters - ring) % nLetters};
+            return (forward[(c + shift) % nLetters] + nLetters - shift) %
+                   nLetters;
+        }
+
+        /// Pass a letter through the rotor from left to right
+        std::size_t out(const std::size_t c, const std::size_t position) const
+        {
+            const std::size_t shift{(position + nLetters - ring) % nLetters};
+            return (backward[(c + shift) % nLetters] + nLetters - shift) %
+                   nLetters;
+        }
+    };
+}    // namespace
+
+EnigmaCipher::EnigmaCipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void EnigmaCipher::setKey(const std::string& key)
+{
+    // Split the (upper-cased) key into fields at the commas
+    std::vector<std::string> fields{""};
+    for (const char c : key) {
+        if (c == ',') {
+            fields.emplace_back();
+        } else {
+            fields.back() += static_cast<char>(std::toupper(c));
+        }
+    }
+    if (fields.size() != 4 && fields.size() != 5) {
+        throw InvalidKey{
+            "Key provided to EnigmaCipher must have the form 'rotors,reflector,rings,positions[,plugboard]'"};
+    }
+
+    // The rotors, from left to right
+    const std::vector<std::string> rotorNames{splitWords(fields[0])};
+    if (rotorNames.size() != 3) {
+        throw InvalidKey{"Key provided to EnigmaCipher must give three rotors"};
+    }
+    std::array<const WheelSpec*, 3> rotorWheels{};
+    for (std::size_t slot{0}; slot < 3; ++slot) {
+        rotorWheels[slot] = findWheel(rotorSpecs, rotorNames[slot]);
+        if (!rotorWheels[slot]) {
+            throw InvalidKey{"Key provided to EnigmaCipher has unknown rotor " +
+                             rotorNames[slot]};
+        }
+        for (std::size_t other{0}; other < slot; ++other) {
+            if (rotorWheels[other] == rotorWheels[slot]) {
+                throw InvalidKey{
+                    "Key provided to EnigmaCipher uses a rotor more than once"};
+            }
+        }
+    }
+
+    // The reflector
+    const std::vector<std::string> reflectorNames{splitWords(fields[1])};
+    const WheelSpec* reflectorWheel{
+        (reflectorNames.size() == 1)
+            ? findWheel(reflectorSpecs, reflectorNames.front())
+            : nullptr};
+    if (!reflectorWheel) {
+        throw InvalidKey{
+            "Key provided to EnigmaCipher must give the reflector as B or C"};
+    }
+
+    const std::array<std::size_t, 3> rings{
+        readLetterTriple(fields[2], "the ring settings")};
+    const std::array<std::size_t, 3> positions{
+        readLetterTriple(fields[3], "the rotor positions")};
+
+    // The plugboard swaps pairs of letters, leaving the rest alone
+    std::array<std::size_t, nLetters> plugboard{};
+    for (std::size_t i{0}; i < nLetters; ++i) {
+        plugboard[i] = i;
+    }
+    if (fields.size() == 5) {
+        for (const auto& pair : splitWords(fields[4])) {
+            if (pair.size() != 2 || pair[0] < 'A' || pair[0] > 'Z' ||
+                pair[1] < 'A' || pair[1] > 'Z' || pair[0] == pair[1]) {
+                throw InvalidKey{
+                    "Key provided to EnigmaCipher has invalid plugboard pair " +
+                    pair};
+            }
+            const std::size_t first{static_cast<std::size_t>(pair[0] - 'A')};
+            const std::size_t second{static_cast<std::size_t>(pair[1] - 'A')};
+            if (plugboard[first] != first || plugboard[second] != second) {
+                throw InvalidKey{
+                    "Key provided to EnigmaCipher plugs a letter more than once"};
+            }
+            plugboard[first] = second;
+            plugboard[second] = first;
+        }
+    }
+
+    // Wire up the machine
+    std::array<Rotor, 3> rotors{};
+    for (std::size_t slot{0}; slot < 3; ++slot) {
+        Rotor& rotor{rotors[slot]};
+        for (std::size_t i{0}; i < nLetters; ++i) {
+            const std::size_t wired{static_cast<std::size_t>(
+                rotorWheels[slot]->wiring[i] - 'A')};
+            rotor.forward[i] = wired;
+            rotor.backward[wired] = i;
+        }
+        for (const char* n{rotorWheels[slot]->notches}; *n; ++n) {
+            rotor.notch[static_cast<std::size_t>(*n - 'A')] = true;
+        }
+        rotor.ring = rings[slot];
+    }
+    std::array<std::size_t, nLetters> reflector{};
+    for (std::size_t i{0}; i < nLetters; ++i) {
+        reflector[i] =
+            static_cast<std::size_t>(reflectorWheel->wiring[i] - 'A');
+    }
+
+    // Step the machine from the starting positions until it comes back round
+    // to positions it has already been in, recording where that cycle starts
+    states_.clear();
+    std::vector<std::size_t> seenAt(nStates, nStates);
+    std::size_t left{positions[0]};
+    std::size_t middle{positions[1]};
+    std::size_t right{positions[2]};
+    while (true) {
+        const std::size_t state{(left * nLetters + middle) * nLetters +
+                                right};
+        if (seenAt[state] != nStates) {
+            cycleStart_ = seenAt[state];
+            break;
+        }
+        seenAt[state] = states_.size();
+        states_.push_back(static_cast<std::uint16_t>(state));
+
+        // The middle rotor steps both when the right rotor pushes it on and
+        // when it pushes on the left rotor itself (the double step)
+        if (rotors[1].notch[middle]) {
+            middle = (middle + 1) % nLetters;
+            left = (left + 1) % nLetters;
+        } else if (rotors[2].notch[right]) {
+            middle = (middle + 1) % nLetters;
+        }
+        right = (right + 1) % nLetters;
+    }
+
+    // Fill in the full permutation of the alphabet for each state
+    table_.assign(states_.size() * nLetters, 'A');
+    parallelFor(states_.size(), 256, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i) {
+            const std::size_t r{states_[i] % nLetters};
+            const std::size_t m{states_[i] / nLetters % nLetters};
+            const std::size_t l{states_[i] / (nLetters * nLetters)};
+            for (std::size_t c{0}; c < nLetters; ++c) {
+                std::size_t x{plugboard[c]};
+                x = rotors[2].in(x, r);
+                x = rotors[1].in(x, m);
+                x = rotors[0].in(x, l);
+                x = reflector[x];
+                x = rotors[0].out(x, l);
+                x = rotors[1].out(x, m);
+                x = rotors[2].out(x, r);
+                x = plugboard[x];
+                table_[i * nLetters + c] = Alphabet::alphabet[x];
+            }
+        }
+    });
+}
+
+std::size_t EnigmaCipher::stateIndex(const std::size_t offset) const
+{
+    if (offset < states_.size()) {
+        return offset;
+    }
+    const std::size_t cycleLength{states_.size() - cycleStart_};
+    return cycleStart_ + (offset - cycleStart_) % cycleLength;
+}
+
+std::string EnigmaCipher::rotorPositions(const std::size_t offset) const
+{
+    const std::size_t state{states_[this->stateIndex(offset)]};
+    const std::string result{Alphabet::alphabet[state / (nLetters * nLetters)],
+                             Alphabet::alphabet[state / nLetters % nLetters],
+                             Alphabet::alphabet[state % nLetters]};
+    return result;
+}
+
+std::string EnigmaCipher::applyCipher(const std::string& inputText,
+                                      const CipherMode /*cipherMode*/) const
+{
+    // Encryption and decryption are the same
+    return this->applyCipherAt(inputText, 0);
+}
+
+std::string EnigmaCipher::applyCipherAt(const std::string& inputText,
+                                        const std::size_t offset,
+                                        const std::size_t maxThreads) const
+{
+    std::string outputText(inputText.size(), ' ');
+    const char* in{inputText.data()};
+    char* out{outputText.data()};
+
+    // The rotors step before each letter is enciphered, so letter i of the
+    // message uses the state after i + 1 steps; each chunk looks up its first
+    // state and then walks along the table, wrapping round the cycle
+    parallelFor(
+        inputText.size(), lettersPerTask,
+        [&](std::size_t begin, std::size_t end) {
+            std::size_t index{this->stateIndex(offset + begin + 1)};
+            for (std::size_t i{begin}; i < end; ++i) {
+                const std::size_t letter{
+                    static_cast<unsigned char>(in[i] - 'A')};
+                out[i] = (letter < nLetters) ? table_[index * nLetters + letter]
+                                             : in[i];
+                if (++index == states_.size()) {
+                    index = cycleStart_;
+                }
+            }
+        },
+        maxThreads);
+
+    return outputText;
+}
@@ -0,0 +1,112 @@
+#ifndef MPAGSCIPHER_ENIGMACIPHER_HPP
+#define MPAGSCIPHER_ENIGMACIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \file EnigmaCipher.hpp
+ * \brief Contains the declaration of the EnigmaCipher class
+ */
+
+/**
+ * \class EnigmaCipher
+ * \brief Encrypt or decrypt text using a simulation of the three-rotor Enigma machine
+ *
+ * The key gives the machine settings as comma-separated fields:
+ * the rotors from left to right (I to VIII, separated by spaces), the
+ * reflector (B or C), the ring settings, the starting rotor positions and,
+ * optionally, the plugboard pairs (separated by spaces),
+ * e.g. "I II III,B,AAA,AAA,AZ BY".
+ *
+ * The rotors step, including the double step of the middle rotor, before
+ * each letter is enciphered, so the rotor positions are a fixed function of
+ * the position in the text. The sequence of positions is traced out once
+ * when the key is set and the full permutation of the alphabet for each of
+ * them is stored in a flat table, so that the machine can be started at any
+ * point in the text without stepping through everything that comes before.
+ * Since the machine is its own inverse, encryption and decryption are the
+ * same operation. Anything other than an upper-case letter is passed through
+ * unchanged, but still counts as a position in the text.
+ */
+class EnigmaCipher : public Cipher {
+  public:
+    /**
+     * \brief Create a new EnigmaCipher with the given key
+     *
+     * \param key the key to use in the cipher
+     */
+    explicit EnigmaCipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the key to use in the cipher
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Apply the cipher to a piece of text that starts part way into a message
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param offset the number of letters of the message that come before the text
+     * \param maxThreads the maximum number of threads to use, 0 means no limit
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipherAt(const std::string& inputText,
+                              const std::size_t offset,
+                              const std::size_t maxThreads = 0) const;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::Enigma; }
+
+    /**
+     * \brief Get the rotor positions after a number of letters have been typed
+     *
+     * \param offset the number of letters typed
+     * \return the letters showing in the windows, from left to right
+     */
+    std::string rotorPositions(const std::size_t offset) const;
+
+  private:
+    /// The rotor positions in the order that the machine steps through them,
+    /// each encoded as 676 * left + 26 * middle + right
+    std::vector<std::uint16_t> states_;
+
+    /// Index in states_ at which the sequence starts to repeat itself
+    std::size_t cycleStart_{0};
+
+    /// The permutation of the alphabet applied at each of the states_,
+    /// 26 output letters per state
+    std::vector<char> table_;
+
+    /**
+     * \brief Find the index in states_ of the state after a number of steps
+     *
+     * \param offset the number of steps
+     * \return the index of the state
+     */
+    std::size_t stateIndex(const std::size_t offset) const;
+};
+
+#endif    // MPAGSCIPHER_ENIGMACIPHER_HPP
@@ -0,0 +1,231 @@
+#include "FdIo.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+    /// Determine whether a file descriptor is a pipe
+    bool isPipe(const int fd)
+    {
+        struct stat status {};
+        return ::fstat(fd, &status) == 0 && S_ISFIFO(status.st_mode);
+    }
+
+    /// Ask for a pipe to be made larger, returning its size (0 if unknown)
+    std::size_t growPipe(const int fd, const std::size_t size)
+    {
+#if defined(__linux__)
+        // Unprivileged users are limited by /proc/sys/fs/pipe-max-size, in
+        // which case the pipe keeps the size it had
+        const int requested{static_cast<int>(
+            std::min(size, static_cast<std::size_t>(1 << 30)))};
+        ::fcntl(fd, F_SETPIPE_SZ, requested);
+        const int actual{::fcntl(fd, F_GETPIPE_SZ)};
+        return actual > 0 ? static_cast<std::size_t>(actual) : 0;
+#else
+        (void)fd;
+        (void)size;
+        return 0;
+#endif
+    }
+
+    /// Wait until a non-blocking descriptor is ready
+    void waitFor(const int fd, const short events)
+    {
+        pollfd pfd{fd, events, 0};
+        ::poll(&pfd, 1, -1);
+    }
+
+    /// Write all of a buffer with write(), carrying on after short writes
+    void writeAll(const int fd, const char* data, std::size_t n)
+    {
+        while (n > 0) {
+            const ssize_t result{::write(fd, data, n)};
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    waitFor(fd, POLLOUT);
+                    continue;
+                }
+                throw std::system_error{errno, std::generic_category(),
+                                        "failed to write output"};
+            }
+            data += result;
+            n -= static_cast<std::size_t>(result);
+        }
+    }
+
+#if defined(__linux__)
+    /// Hand all of a buffer's pages to a pipe with vmsplice
+    void spliceAll(const int fd, char* data, std::size_t n)
+    {
+        while (n > 0) {
+            iovec iov{data, n};
+            const ssize_t result{::vmsplice(fd, &iov, 1, 0)};
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    waitFor(fd, POLLOUT);
+                    continue;
+                }
+                throw std::system_error{errno, std::generic_category(),
+                                        "failed to splice output"};
+            }
+            data += result;
+            n -= static_cast<std::size_t>(result);
+        }
+    }
+#endif
+}    // namespace
+
+FdReader::FdReader(const int fd, const std::size_t bufferSize,
+                   const bool fillBlocks)
+    : fd_{fd}, fillBlocks_{fillBlocks}
+{
+    if (bufferSize == 0) {
+        throw std::invalid_argument{"FdReader buffer size must not be 0"};
+    }
+    buffer_.resize(bufferSize);
+    if (isPipe(fd_)) {
+        growPipe(fd_, bufferSize);
+    }
+}
+
+bool FdReader::next(const char*& data, std::size_t& n)
+{
+    // Fill the buffer, since a pipe gives back at most what is in it
+    std::size_t filled{0};
+    while (!finished_ && filled < buffer_.size()) {
+        const ssize_t result{
+            ::read(fd_, buffer_.data() + filled, buffer_.size() - filled)};
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                waitFor(fd_, POLLIN);
+                continue;
+            }
+            throw std::system_error{errno, std::generic_category(),
+                                    "failed to read input"};
+        }
+        if (result == 0) {
+            finished_ = true;
+        }
+        filled += static_cast<std::size_t>(result);
+        if (!fillBlocks_ && filled > 0) {
+            break;
+        }
+    }
+
+    data = buffer_.data();
+    n = filled;
+    return filled > 0;
+}
+
+FdWriter::FdWriter(const int fd, const std::size_t bufferSize,
+                   const bool allowVmsplice)
+    : fd_{fd}, bufferSize_{bufferSize}
+{
+    if (bufferSize == 0) {
+        throw std::invalid_argument{"FdWriter buffer size must not be 0"};
+    }
+
+#if defined(__linux__)
+    // Each block must be exactly as large as the pipe for the second one
+    // being spliced in full to mean the first has been read
+    if (allowVmsplice && isPipe(fd_)) {
+        const std::size_t pipeSize{growPipe(fd_, bufferSize)};
+        if (pipeSize > 0) {
+            bufferSize_ = pipeSize;
+            splice_ = true;
+        }
+    }
+#else
+    (void)allowVmsplice;
+#endif
+
+    mappingSize_ = bufferSize_ * (splice_ ? 2 : 1);
+    void* mapping{::mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+    if (mapping == MAP_FAILED) {
+        throw std::system_error{errno, std::generic_category(),
+                                "failed to allocate output buffers"};
+    }
+    blocks_ = static_cast<char*>(mapping);
+}
+
+FdWriter::~FdWriter()
+{
+    try {
+        this->flush();
+    } catch (const std::system_error&) {
+        // Nothing more can be done about it here
+    }
+    ::munmap(blocks_, mappingSize_);
+}
+
+void FdWriter::write(const char* data, std::size_t n)
+{
+    while (n > 0) {
+        // Without splicing, anything at least a block long can go straight
+        // out rather than being copied first
+        if (!splice_ && filled_ == 0 && n >= bufferSize_) {
+            writeAll(fd_, data, n);
+            return;
+        }
+
+        const std::size_t chunk{std::min(n, bufferSize_ - filled_)};
+        std::memcpy(blocks_ + current_ * bufferSize_ + filled_, data, chunk);
+        filled_ += chunk;
+        data += chunk;
+        n -= chunk;
+        if (filled_ == bufferSize_) {
+            this->flushBlock();
+        }
+    }
+}
+
+void FdWriter::flush()
+{
+    if (filled_ == bufferSize_) {
+        this->flushBlock();
+    } else if (filled_ > 0) {
+        // A partial block is copied into the pipe, so that the block can
+        // carry on being filled without waiting for it to be read
+        writeAll(fd_, blocks_ + current_ * bufferSize_, filled_);
+        filled_ = 0;
+    }
+}
+
+void FdWriter::flushBlock()
+{
+    char* block{blocks_ + current_ * bufferSize_};
+#if defined(__linux__)
+    if (splice_) {
+        spliceAll(fd_, block, filled_);
+        current_ = 1 - current_;
+        filled_ = 0;
+        return;
+    }
+#endif
+    writeAll(fd_, block, filled_);
+    filled_ = 0;
+}
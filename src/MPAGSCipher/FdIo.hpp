@@ -0,0 +1,168 @@
+#ifndef MPAGSCIPHER_FDIO_HPP
+#define MPAGSCIPHER_FDIO_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * \file FdIo.hpp
+ * \brief Contains the declarations of the FdReader and FdWriter classes
+ */
+
+/**
+ * \class FdReader
+ * \brief Reads an already open file descriptor (e.g. stdin) in large blocks
+ *
+ * This avoids the overhead of reading through std::cin a character at a
+ * time. If the descriptor is a pipe, the pipe is also made as large as a
+ * block (where the system allows), so that the program writing into it
+ * can run further ahead.
+ *
+ * By default each block is filled before it is given back, but for input
+ * that trickles in (e.g. a log being followed) the reader can instead give
+ * back whatever each read returns, so nothing waits for the block to fill.
+ */
+class FdReader {
+  public:
+    /**
+     * \brief Start reading a file descriptor
+     *
+     * \param fd the file descriptor, which is not closed by the reader
+     * \param bufferSize the size of each block
+     * \param fillBlocks whether to wait for each block to be full (or the
+     *                   input to end) before giving it back
+     * \throw std::invalid_argument if the buffer size is zero
+     */
+    explicit FdReader(const int fd, const std::size_t bufferSize = 1 << 20,
+                      const bool fillBlocks = true);
+
+    /**
+     * \brief Get the next block of input
+     *
+     * Unless the reader was asked not to fill its blocks, each block is full
+     * until the end of the input. The block stays valid until the next call,
+     * when its buffer is reused.
+     *
+     * \param data set to the start of the block
+     * \param n set to the number of bytes in the block
+     * \return false once all of the input has been read
+     * \throw std::system_error if a read fails
+     */
+    bool next(const char*& data, std::size_t& n);
+
+  private:
+    /// The file descriptor
+    int fd_;
+
+    /// The buffer that each block is read into
+    std::vector<char> buffer_;
+
+    /// Whether to wait for each block to be full
+    bool fillBlocks_;
+
+    /// Whether the end of the input has been reached
+    bool finished_{false};
+};
+
+/**
+ * \class FdWriter
+ * \brief Writes to an already open file descriptor (e.g. stdout) in large blocks
+ *
+ * If the descriptor is a pipe, full blocks are handed to it with vmsplice,
+ * which gives the pipe the pages of the block itself rather than copying
+ * them into the pipe's own buffers. The pages must then not be changed
+ * until the program at the other end has read them, so there are two
+ * page-aligned blocks, each as large as the pipe: once the second has been
+ * spliced in full, everything from the first must have left the pipe and
+ * it can be filled again. Otherwise (or if the descriptor is not a pipe)
+ * the blocks are written with plain write() calls.
+ */
+class FdWriter {
+  public:
+    /**
+     * \brief Start writing to a file descriptor
+     *
+     * \param fd the file descriptor, which is not closed by the writer
+     * \param bufferSize the size of each block, which for a pipe is the
+     *                   size the pipe is asked to be made
+     * \param allowVmsplice whether to use vmsplice if the descriptor is a pipe
+     * \throw std::invalid_argument if the buffer size is zero
+     * \throw std::system_error if the blocks cannot be allocated
+     */
+    explicit FdWriter(const int fd, const std::size_t bufferSize = 1 << 20,
+                      const bool allowVmsplice = true);
+
+    /// Write out anything that is left, ignoring any errors
+    ~FdWriter();
+
+    /// The writer cannot be copied
+    FdWriter(const FdWriter& rhs) = delete;
+    /// The writer cannot be moved
+    FdWriter(FdWriter&& rhs) = delete;
+    /// The writer cannot be copy assigned
+    FdWriter& operator=(const FdWriter& rhs) = delete;
+    /// The writer cannot be move assigned
+    FdWriter& operator=(FdWriter&& rhs) = delete;
+
+    /**
+     * \brief Append data to the output
+     *
+     * \param data the data
+     * \param n the number of bytes
+     * \throw std::system_error if a write fails
+     */
+    void write(const char* data, std::size_t n);
+
+    /**
+     * \brief Append a string to the output
+     *
+     * \param text the string
+     * \throw std::system_error if a write fails
+     */
+    void write(const std::string& text)
+    {
+        this->write(text.data(), text.size());
+    }
+
+    /**
+     * \brief Write out anything that has been appended so far
+     *
+     * \throw std::system_error if a write fails
+     */
+    void flush();
+
+    /**
+     * \brief Determine whether vmsplice is being used
+     *
+     * \return true if the descriptor is a pipe that full blocks are spliced into
+     */
+    bool usesVmsplice() const { return splice_; }
+
+  private:
+    /// Write out the block being filled, and start filling the next one
+    void flushBlock();
+
+    /// The file descriptor
+    int fd_;
+
+    /// The size of each block
+    std::size_t bufferSize_;
+
+    /// Whether full blocks are spliced into a pipe
+    bool splice_{false};
+
+    /// The blocks (two when splicing, otherwise one), mapped as whole pages
+    char* blocks_{nullptr};
+
+    /// The size of the mapping holding the blocks
+    std::size_t mappingSize_{0};
+
+    /// The block being filled
+    std::size_t current_{0};
+
+    /// The number of bytes in the block being filled
+    std::size_t filled_{0};
+};
+
+#endif    // MPAGSCIPHER_FDIO_HPP
@@ -0,0 +1,152 @@
+#include "FileFollower.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+FileFollower::FileFollower(const std::string& path,
+                           const std::size_t bufferSize)
+    : path_{path}
+{
+    if (bufferSize == 0) {
+        throw std::invalid_argument{"FileFollower buffer size must not be 0"};
+    }
+    buffer_.resize(bufferSize);
+
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw std::system_error{errno, std::generic_category(),
+                                "failed to open file '" + path + "'"};
+    }
+
+#if defined(__linux__)
+    // Without inotify (e.g. if the limit on watches has been reached) the
+    // file is checked every few milliseconds instead
+    inotify_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_ >= 0 &&
+        ::inotify_add_watch(inotify_, path.c_str(),
+                            IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF |
+                                IN_DELETE_SELF) < 0) {
+        ::close(inotify_);
+        inotify_ = -1;
+    }
+#endif
+}
+
+FileFollower::~FileFollower()
+{
+    ::close(fd_);
+    if (inotify_ >= 0) {
+        ::close(inotify_);
+    }
+}
+
+bool FileFollower::next(const char*& data, std::size_t& n,
+                        const int timeoutMs)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::milliseconds{timeoutMs};
+
+    data = buffer_.data();
+    n = 0;
+    while (true) {
+        const ssize_t result{::read(fd_, buffer_.data(), buffer_.size())};
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error{errno, std::generic_category(),
+                                    "failed to read file '" + path_ + "'"};
+        }
+        if (result > 0) {
+            n = static_cast<std::size_t>(result);
+            return true;
+        }
+
+        // Everything written so far has been read, so the follower stops if
+        // the file has gone, which it has if its name now refers to some
+        // other file (or none)
+        if (gone_) {
+            return false;
+        }
+        struct stat status {};
+        struct stat named {};
+        if (::fstat(fd_, &status) != 0) {
+            throw std::system_error{errno, std::generic_category(),
+                                    "failed to read file '" + path_ + "'"};
+        }
+        if (::stat(path_.c_str(), &named) != 0 ||
+            named.st_ino != status.st_ino || named.st_dev != status.st_dev) {
+            // Read once more, in case anything was written just before
+            gone_ = true;
+            continue;
+        }
+
+        // A file that is now shorter than what has been read was truncated,
+        // so is read again from the start
+        if (::lseek(fd_, 0, SEEK_CUR) > status.st_size) {
+            ::lseek(fd_, 0, SEEK_SET);
+            continue;
+        }
+
+        int remainingMs{-1};
+        if (timeoutMs >= 0) {
+            const auto remaining =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - Clock::now());
+            remainingMs = static_cast<int>(
+                std::max<std::chrono::milliseconds::rep>(remaining.count(),
+                                                         0));
+        }
+        if (!this->waitForChange(remainingMs)) {
+            return true;
+        }
+    }
+}
+
+bool FileFollower::waitForChange(const int timeoutMs)
+{
+    if (inotify_ < 0) {
+        if (timeoutMs == 0) {
+            return false;
+        }
+        const int sleepMs{(timeoutMs < 0) ? 10 : std::min(timeoutMs, 10)};
+        std::this_thread::sleep_for(std::chrono::milliseconds{sleepMs});
+        return true;
+    }
+
+    pollfd pfd{inotify_, POLLIN, 0};
+    int result{::poll(&pfd, 1, timeoutMs)};
+    while (result < 0 && errno == EINTR) {
+        result = ::poll(&pfd, 1, timeoutMs);
+    }
+    if (result < 0) {
+        throw std::system_error{errno, std::generic_category(),
+                                "failed to watch file '" + path_ + "'"};
+    }
+    if (result == 0) {
+        return false;
+    }
+
+    // Which change it was does not matter, as the file is looked at again
+    // anyway, so the events are just cleared
+    char events[4096];
+    while (::read(inotify_, events, sizeof(events)) > 0) {
+    }
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef MPAGSCIPHER_FILEFOLLOWER_HPP
+#define MPAGSCIPHER_FILEFOLLOWER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * \file FileFollower.hpp
+ * \brief Contains the declaration of the FileFollower class
+ */
+
+/**
+ * \class FileFollower
+ * \brief Reads a file and then whatever is appended to it, as tail -f does
+ *
+ * Once everything in the file has been read, the follower sleeps until the
+ * file changes, using inotify on Linux (so it wakes as soon as anything is
+ * written) and otherwise checking it every few milliseconds. If the file is
+ * truncated it is read again from the start, and once it has been removed
+ * or renamed (e.g. when a log is rotated) and everything in it has been
+ * read, the follower stops.
+ */
+class FileFollower {
+  public:
+    /**
+     * \brief Open a file to follow
+     *
+     * \param path the name of the file
+     * \param bufferSize the most that is given back at once
+     * \throw std::invalid_argument if the buffer size is zero
+     * \throw std::system_error if the file cannot be opened
+     */
+    explicit FileFollower(const std::string& path,
+                          const std::size_t bufferSize = 1 << 20);
+
+    /// Close the file
+    ~FileFollower();
+
+    /// The follower cannot be copied
+    FileFollower(const FileFollower& rhs) = delete;
+    /// The follower cannot be moved
+    FileFollower(FileFollower&& rhs) = delete;
+    /// The follower cannot be copy assigned
+    FileFollower& operator=(const FileFollower& rhs) = delete;
+    /// The follower cannot be move assigned
+    FileFollower& operator=(FileFollower&& rhs) = delete;
+
+    /**
+     * \brief Get the next piece of the file, waiting for it to be written if need be
+     *
+     * The piece stays valid until the next call, when its buffer is reused.
+     *
+     * \param data set to the start of the piece
+     * \param n set to the number of bytes in the piece, which is 0 if
+     *          nothing was written within the timeout
+     * \param timeoutMs how long to wait for the file to change, in
+     *                  milliseconds, or -1 to wait for as long as it takes
+     * \return false once the file has been removed or renamed and
+     *         everything in it has been read
+     * \throw std::system_error if reading or watching the file fails
+     */
+    bool next(const char*& data, std::size_t& n, const int timeoutMs = -1);
+
+  private:
+    /// Wait for the file to change, returning false if the timeout expired
+    bool waitForChange(const int timeoutMs);
+
+    /// The name of the file
+    std::string path_;
+
+    /// The file descriptor of the file
+    int fd_{-1};
+
+    /// The inotify instance watching the file, or -1 without inotify
+    int inotify_{-1};
+
+    /// The buffer that each piece is read into
+    std::vector<char> buffer_;
+
+    /// Whether the file has been removed or renamed
+    bool gone_{false};
+};
+
+#endif    // MPAGSCIPHER_FILEFOLLOWER_HPP
@@ -0,0 +1,99 @@
+#include "FourSquareCipher.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+    /// Number of digraphs handed to each thread at a time
+    constexpr std::size_t digraphsPerTask{1 << 17};
+}    // namespace
+
+FourSquareCipher::FourSquareCipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void FourSquareCipher::setKey(const std::string& key)
+{
+    // Split the key into its two keywords
+    const std::size_t comma{key.find(',')};
+    if (comma == std::string::npos ||
+        key.find(',', comma + 1) != std::string::npos) {
+        throw InvalidKey{
+            "Key provided to FourSquareCipher must be two keywords separated by a comma"};
+    }
+    upperGrid_.setKey(key.substr(0, comma));
+    lowerGrid_.setKey(key.substr(comma + 1));
+
+    // Work out what happens to every possible digraph in each direction:
+    // the letters at (rowOne, columnOne) in the top left and at
+    // (rowTwo, columnTwo) in the bottom right become the letters at
+    // (rowOne, columnTwo) in the top right and (rowTwo, columnOne) in the
+    // bottom left
+    const std::size_t gridSize{PolybiusGrid::size};
+    for (std::size_t first{0}; first < PolybiusGrid::nCells; ++first) {
+        for (std::size_t second{0}; second < PolybiusGrid::nCells; ++second) {
+            const std::size_t rowOne{first / gridSize};
+            const std::size_t columnOne{first % gridSize};
+            const std::size_t rowTwo{second / gridSize};
+            const std::size_t columnTwo{second % gridSize};
+
+            // Plain cells (first, second) encrypt to the letters in cells
+            // (rowOne, columnTwo) and (rowTwo, columnOne) of the keyed grids
+            const std::size_t plainIndex{
+                2 * (first * PolybiusGrid::nCells + second)};
+            encryptTable_[plainIndex] = upperGrid_.letter(rowOne, columnTwo);
+            encryptTable_[plainIndex + 1] =
+                lowerGrid_.letter(rowTwo, columnOne);
+
+            // ...and so those keyed cells decrypt back to the plain letters
+            const std::size_t cipherIndex{
+                2 * ((rowOne * gridSize + columnTwo) * PolybiusGrid::nCells +
+                     rowTwo * gridSize + columnOne)};
+            decryptTable_[cipherIndex] = plainGrid_.letter(first);
+            decryptTable_[cipherIndex + 1] = plainGrid_.letter(second);
+        }
+    }
+}
+
+std::string FourSquareCipher::applyCipher(const std::string& inputText,
+                                          const CipherMode cipherMode) const
+{
+    // Remove anything that isn't a letter (the grids all hold the same
+    // letters, so it doesn't matter which one is checked)
+    std::string outputText{inputText};
+    outputText.erase(
+        std::remove_if(std::begin(outputText), std::end(outputText),
+                       [this](char c) {
+                           return plainGrid_.cell(c) == PolybiusGrid::noCell;
+                       }),
+        std::end(outputText));
+
+    // Pad to a whole number of digraphs
+    if (outputText.size() % 2 != 0) {
+        outputText += 'X';
+    }
+
+    // Look up each digraph in the relevant table, using the cells of its
+    // letters in the grids that hold them
+    const bool encrypt{cipherMode == CipherMode::Encrypt};
+    const PolybiusGrid::DigraphTable& table{encrypt ? encryptTable_
+                                                    : decryptTable_};
+    const PolybiusGrid& firstGrid{encrypt ? plainGrid_ : upperGrid_};
+    const PolybiusGrid& secondGrid{encrypt ? plainGrid_ : lowerGrid_};
+    char* text{outputText.data()};
+    parallelFor(outputText.size() / 2, digraphsPerTask,
+                [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t i{2 * begin}; i < 2 * end; i += 2) {
+                        const std::size_t first{firstGrid.cell(text[i])};
+                        const std::size_t second{secondGrid.cell(text[i + 1])};
+                        const std::size_t index{
+                            2 * (first * PolybiusGrid::nCells + second)};
+                        text[i] = table[index];
+                        text[i + 1] = table[index + 1];
+                    }
+                });
+
+    return outputText;
+}
@@ -0,0 +1,83 @@
+#ifndef MPAGSCIPHER_FOURSQUARECIPHER_HPP
+#define MPAGSCIPHER_FOURSQUARECIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+#include "PolybiusGrid.hpp"
+
+#include <string>
+
+/**
+ * \file FourSquareCipher.hpp
+ * \brief Contains the declaration of the FourSquareCipher class
+ */
+
+/**
+ * \class FourSquareCipher
+ * \brief Encrypt or decrypt text using the Four-square cipher with the given key
+ *
+ * The key is two keywords separated by a comma, e.g. "example,keyword", which
+ * fill the top-right and bottom-left grids, while the top-left and
+ * bottom-right grids hold the plain alphabet.
+ * Each digraph of the text is replaced by the letters at the other two
+ * corners of the rectangle it forms across the four grids; if the length of
+ * the text is odd it is padded with X.
+ * The result for each of the 25 x 25 possible digraphs is worked out in
+ * advance in both directions.
+ */
+class FourSquareCipher : public Cipher {
+  public:
+    /**
+     * \brief Create a new FourSquareCipher with the given key
+     *
+     * \param key the key to use in the cipher
+     */
+    explicit FourSquareCipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the key to use in the cipher
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::FourSquare; }
+
+  private:
+    /// The plain alphabet grid, used at the top left and bottom right
+    PolybiusGrid plainGrid_{""};
+
+    /// The grid at the top right, generated from the first keyword
+    PolybiusGrid upperGrid_{""};
+
+    /// The grid at the bottom left, generated from the second keyword
+    PolybiusGrid lowerGrid_{""};
+
+    // Lookup tables generated from the grids
+
+    /// Lookup table giving the encrypted form of each digraph,
+    /// indexed by the cells of its letters in the plain grid
+    PolybiusGrid::DigraphTable encryptTable_{};
+
+    /// Lookup table giving the decrypted form of each digraph,
+    /// indexed by the cells of its letters in the upper and lower grids
+    PolybiusGrid::DigraphTable decryptTable_{};
+};
+
+#endif    // MPAGSCIPHER_FOURSQUARECIPHER_HPP
@@ -0,0 +1,296 @@
+#include "HillCipher.hpp"
+#include "Alphabet.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+
+namespace {
+    /// The number of blocks transposed into each structure-of-arrays batch
+    constexpr std::size_t batchSize{256};
+
+    /// The number of blocks handed to each thread at a time
+    constexpr std::size_t blocksPerTask{64 * batchSize};
+
+    /**
+     * \brief Invert a square matrix modulo a prime using Gauss-Jordan elimination
+     *
+     * \param matrix the matrix, stored row by row
+     * \param size the number of rows (and columns) of the matrix
+     * \param prime the modulus
+     * \return the inverse matrix, or an empty matrix if it cannot be inverted
+     */
+    HillCipher::Matrix invertModPrime(const HillCipher::Matrix& matrix,
+                                      const std::size_t size,
+                                      const std::size_t prime)
+    {
+        // Find the inverse of a non-zero number modulo the prime by searching
+        auto inverse = [prime](const std::size_t a) {
+            std::size_t x{1};
+            while ((a * x) % prime != 1) {
+                ++x;
+            }
+            return x;
+        };
+
+        // Reduce the matrix modulo the prime and start with the identity
+        HillCipher::Matrix lhs(matrix.size());
+        HillCipher::Matrix rhs(matrix.size(), 0);
+        for (std::size_t i{0}; i < matrix.size(); ++i) {
+            lhs[i] = matrix[i] % prime;
+        }
+        for (std::size_t i{0}; i < size; ++i) {
+            rhs[i * size + i] = 1;
+        }
+
+        for (std::size_t col{0}; col < size; ++col) {
+            // Find a row with a non-zero entry in this column and move it up
+            std::size_t pivot{col};
+            while (pivot < size && lhs[pivot * size + col] == 0) {
+                ++pivot;
+            }
+            if (pivot == size) {
+                return HillCipher::Matrix{};
+            }
+            for (std::size_t j{0}; j < size; ++j) {
+                std::swap(lhs[pivot * size + j], lhs[col * size + j]);
+                std::swap(rhs[pivot * size + j], rhs[col * size + j]);
+            }
+
+            // Scale the row so that the pivot becomes one
+            const std::size_t scale{inverse(lhs[col * size + col])};
+            for (std::size_t j{0}; j < size; ++j) {
+                lhs[col * size + j] = (lhs[col * size + j] * scale) % prime;
+                rhs[col * size + j] = (rhs[col * size + j] * scale) % prime;
+            }
+
+            // Eliminate this column from every other row
+            for (std::size_t row{0}; row < size; ++row) {
+                const std::size_t factor{lhs[row * size + col]};
+                if (row == col || factor == 0) {
+                    continue;
+                }
+                for (std::size_t j{0}; j < size; ++j) {
+                    lhs[row * size + j] =
+                        (lhs[row * size + j] +
+                         (prime - factor) * lhs[col * size + j]) %
+                        prime;
+                    rhs[row * size + j] =
+                        (rhs[row * size + j] +
+                         (prime - factor) * rhs[col * size + j]) %
+                        prime;
+                }
+            }
+        }
+
+        return rhs;
+    }
+
+    /**
+     * \brief Multiply a run of consecutive blocks by a matrix modulo 26
+     *
+     * The blocks are processed in batches that are transposed into a
+     * structure-of-arrays layout, so that each term of the matrix-vector
+     * products is a multiply-accumulate over a contiguous array of 16-bit
+     * lanes that the compiler can vectorise. The reduction modulo 26 is
+     * deferred until the whole sum is known, which is safe since the largest
+     * possible sum, 8 x 25 x 255, fits into 16 bits.
+     * The block size is a template parameter so that the strides of the
+     * transpositions are known at compile time.
+     *
+     * \tparam Size the number of rows (and columns) of the matrix
+     * \param matrix the matrix, stored row by row
+     * \param in the input letters
+     * \param out the output letters
+     * \param nBlocks the number of blocks to process
+     */
+    template <std::size_t Size>
+    void multiplyBlocks(const HillCipher::Matrix& matrix, const char* in,
+                        char* out, const std::size_t nBlocks)
+    {
+        std::uint16_t coeffs[Size][Size];
+        for (std::size_t row{0}; row < Size; ++row) {
+            for (std::size_t j{0}; j < Size; ++j) {
+                coeffs[row][j] =
+                    static_cast<std::uint16_t>(matrix[row * Size + j]);
+            }
+        }
+
+        std::uint16_t columns[Size][batchSize];
+        std::uint16_t sums[Size][batchSize];
+
+        for (std::size_t first{0}; first < nBlocks; first += batchSize) {
+            const std::size_t nBatch{std::min(batchSize, nBlocks - first)};
+            const char* batchIn{in + first * Size};
+            char* batchOut{out + first * Size};
+
+            // Transpose the batch, turning the letters into numbers
+            for (std::size_t b{0}; b < nBatch; ++b) {
+                for (std::size_t j{0}; j < Size; ++j) {
+                    columns[j][b] =
+                        static_cast<std::uint8_t>(batchIn[b * Size + j] - 'A');
+                }
+            }
+
+            // Form each element of the product for the whole batch at once
+            for (std::size_t row{0}; row < Size; ++row) {
+                std::uint16_t* sum{sums[row]};
+                std::fill(sum, sum + nBatch, 0);
+                for (std::size_t j{0}; j < Size; ++j) {
+                    const std::uint16_t k{coeffs[row][j]};
+                    const std::uint16_t* column{columns[j]};
+                    for (std::size_t b{0}; b < nBatch; ++b) {
+                        sum[b] = static_cast<std::uint16_t>(sum[b] +
+                                                            k * column[b]);
+                    }
+                }
+                for (std::size_t b{0}; b < nBatch; ++b) {
+                    sum[b] = static_cast<std::uint16_t>(sum[b] % 26);
+                }
+            }
+
+            // Transpose back, turning the numbers into letters
+            for (std::size_t b{0}; b < nBatch; ++b) {
+                for (std::size_t row{0}; row < Size; ++row) {
+                    batchOut[b * Size + row] =
+                        static_cast<char>('A' + sums[row][b]);
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief Call the version of multiplyBlocks for the given matrix size
+     *
+     * \param matrix the matrix, stored row by row
+     * \param size the number of rows (and columns) of the matrix
+     * \param in the input letters
+     * \param out the output letters
+     * \param nBlocks the number of blocks to process
+     */
+    void multiplyBlocks(const HillCipher::Matrix& matrix,
+                        const std::size_t size, const char* in, char* out,
+                        const std::size_t nBlocks)
+    {
+        switch (size) {
+            case 1:
+                multiplyBlocks<1>(matrix, in, out, nBlocks);
+                break;
+            case 2:
+                multiplyBlocks<2>(matrix, in, out, nBlocks);
+                break;
+            case 3:
+                multiplyBlocks<3>(matrix, in, out, nBlocks);
+                break;
+            case 4:
+                multiplyBlocks<4>(matrix, in, out, nBlocks);
+                break;
+            case 5:
+                multiplyBlocks<5>(matrix, in, out, nBlocks);
+                break;
+            case 6:
+                multiplyBlocks<6>(matrix, in, out, nBlocks);
+                break;
+            case 7:
+                multiplyBlocks<7>(matrix, in, out, nBlocks);
+                break;
+            case 8:
+                multiplyBlocks<8>(matrix, in, out, nBlocks);
+                break;
+        }
+    }
+}    // namespace
+
+HillCipher::HillCipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void HillCipher::setKey(const std::string& key)
+{
+    // Make sure the key is upper case
+    std::string letters{key};
+    std::transform(std::begin(letters), std::end(letters), std::begin(letters),
+                   ::toupper);
+
+    // Remove non-alphabet characters
+    letters.erase(std::remove_if(std::begin(letters), std::end(letters),
+                                 [](char c) { return !std::isalpha(c); }),
+                  std::end(letters));
+
+    // Check that the key fills a square matrix of a supported size
+    size_ = 0;
+    while ((size_ + 1) * (size_ + 1) <= letters.size()) {
+        ++size_;
+    }
+    if (size_ == 0 || size_ > maxSize || size_ * size_ != letters.size()) {
+        throw InvalidKey{
+            "Key provided to HillCipher must contain n*n letters, for n from 1 to 8"};
+    }
+
+    // Fill the matrix and find its inverse
+    encryptMatrix_.resize(letters.size());
+    for (std::size_t i{0}; i < letters.size(); ++i) {
+        encryptMatrix_[i] = Alphabet::alphabet.find(letters[i]);
+    }
+
+    decryptMatrix_ = invert(encryptMatrix_, size_);
+    if (decryptMatrix_.empty()) {
+        throw InvalidKey{
+            "Key provided to HillCipher gives a matrix that is not invertible modulo 26"};
+    }
+}
+
+HillCipher::Matrix HillCipher::invert(const Matrix& matrix,
+                                      const std::size_t size)
+{
+    // 26 isn't prime, so invert modulo its prime factors, 2 and 13,
+    // and then combine the results using the Chinese remainder theorem
+    const Matrix inverseMod2{invertModPrime(matrix, size, 2)};
+    const Matrix inverseMod13{invertModPrime(matrix, size, 13)};
+    if (inverseMod2.empty() || inverseMod13.empty()) {
+        return Matrix{};
+    }
+
+    // x = 13 (mod 26) is 1 mod 2 and 0 mod 13, x = 14 is 0 mod 2 and 1 mod 13
+    Matrix inverse(matrix.size());
+    for (std::size_t i{0}; i < matrix.size(); ++i) {
+        inverse[i] =
+            (13 * inverseMod2[i] + 14 * inverseMod13[i]) % Alphabet::size;
+    }
+    return inverse;
+}
+
+std::string HillCipher::applyCipher(const std::string& inputText,
+                                    const CipherMode cipherMode) const
+{
+    const Matrix& matrix{(cipherMode == CipherMode::Encrypt) ? encryptMatrix_
+                                                             : decryptMatrix_};
+
+    // The output is padded with X to a whole number of blocks
+    const std::size_t nBlocks{(inputText.size() + size_ - 1) / size_};
+    std::string outputText(nBlocks * size_, 'X');
+
+    // Every complete block is independent, so share them out between threads
+    const std::size_t nWholeBlocks{inputText.size() / size_};
+    parallelFor(nWholeBlocks, blocksPerTask,
+                [&](const std::size_t begin, const std::size_t end) {
+                    multiplyBlocks(matrix, size_,
+                                   inputText.data() + begin * size_,
+                                   outputText.data() + begin * size_,
+                                   end - begin);
+                });
+
+    // Then deal with the padded final block, if there is one
+    if (nWholeBlocks != nBlocks) {
+        const std::size_t offset{nWholeBlocks * size_};
+        std::string lastBlock{inputText.substr(offset)};
+        lastBlock.resize(size_, 'X');
+        multiplyBlocks(matrix, size_, lastBlock.data(),
+                       outputText.data() + offset, 1);
+    }
+
+    return outputText;
+}
@@ -0,0 +1,108 @@
+#ifndef MPAGSCIPHER_HILLCIPHER_HPP
+#define MPAGSCIPHER_HILLCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * \file HillCipher.hpp
+ * \brief Contains the declaration of the HillCipher class
+ */
+
+/**
+ * \class HillCipher
+ * \brief Encrypt or decrypt text using the Hill cipher with the given key
+ *
+ * The text is split into blocks of n letters, each of which is treated as a
+ * vector and multiplied by the n x n key matrix modulo 26.
+ * The key is a string of n*n letters (1 <= n <= 8), read into the matrix row
+ * by row, e.g. "GYBNQKURP" gives a 3 x 3 matrix; the matrix must be
+ * invertible modulo 26.
+ * If the length of the text is not a multiple of n it is padded with X.
+ */
+class HillCipher : public Cipher {
+  public:
+    /// The largest supported size of the key matrix
+    static constexpr std::size_t maxSize{8};
+
+    /// Type definition for a matrix of numbers modulo 26, stored row by row
+    using Matrix = std::vector<std::size_t>;
+
+    /**
+     * \brief Create a new HillCipher with the given key
+     *
+     * \param key the key to use in the cipher
+     */
+    explicit HillCipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the key to use in the cipher
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::Hill; }
+
+    /**
+     * \brief Get the size of the key matrix, i.e. the length of each block
+     *
+     * \return the size of the key matrix
+     */
+    std::size_t blockSize() const { return size_; }
+
+    /**
+     * \brief Get the key matrix, used for encryption
+     *
+     * \return the key matrix
+     */
+    const Matrix& encryptionMatrix() const { return encryptMatrix_; }
+
+    /**
+     * \brief Get the inverse of the key matrix, used for decryption
+     *
+     * \return the inverse key matrix
+     */
+    const Matrix& decryptionMatrix() const { return decryptMatrix_; }
+
+    /**
+     * \brief Invert a square matrix modulo 26
+     *
+     * \param matrix the matrix, stored row by row
+     * \param size the number of rows (and columns) of the matrix
+     * \return the inverse matrix, or an empty matrix if it cannot be inverted
+     */
+    static Matrix invert(const Matrix& matrix, const std::size_t size);
+
+  private:
+    /// The number of rows and columns of the key matrix
+    std::size_t size_{0};
+
+    /// The key matrix
+    Matrix encryptMatrix_;
+
+    /// The inverse of the key matrix
+    Matrix decryptMatrix_;
+};
+
+#endif    // MPAGSCIPHER_HILLCIPHER_HPP
@@ -0,0 +1,161 @@
+#include "KeywordScanner.hpp"
+#include "CipherSearch.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+KeywordScanner::KeywordScanner(const std::vector<std::string>& keywords,
+                               const CipherType type, const std::string& key)
+{
+    const std::string keyLetters{CipherSearch::shiftKey(type, key)};
+
+    // Build a trie of the keywords, with noState for missing children
+    using Children = std::array<std::uint32_t, 26>;
+    Children noChildren;
+    noChildren.fill(noState);
+    std::vector<Children> children(1, noChildren);
+    std::vector<std::vector<std::uint32_t>> endingHere(1);
+
+    keywordLengths_.reserve(keywords.size());
+    for (std::size_t k{0}; k < keywords.size(); ++k) {
+        const std::string& keyword{keywords[k]};
+        if (keyword.empty()) {
+            throw std::invalid_argument{"KeywordScanner keyword is empty"};
+        }
+
+        std::size_t node{0};
+        for (const char c : keyword) {
+            if (c < 'A' || c > 'Z') {
+                throw std::invalid_argument{
+                    "KeywordScanner keywords must be upper-case letters"};
+            }
+            const std::size_t letter{static_cast<std::size_t>(c - 'A')};
+            if (children[node][letter] == noState) {
+                children[node][letter] =
+                    static_cast<std::uint32_t>(children.size());
+                children.push_back(noChildren);
+                endingHere.emplace_back();
+            }
+            node = children[node][letter];
+        }
+        endingHere[node].push_back(static_cast<std::uint32_t>(k));
+        keywordLengths_.push_back(keyword.size());
+    }
+
+    const std::size_t n{children.size()};
+    if (n * rowSize >= acceptFlag) {
+        throw std::length_error{"KeywordScanner has too many keywords"};
+    }
+
+    // Work out the failure links breadth first, so that the failure state
+    // (which is always shallower) is complete before it is needed, and fill
+    // in each missing transition with the one from the failure state
+    std::vector<std::uint32_t> failure(n, 0);
+    dictionaryLink_.assign(n, noState);
+    std::vector<std::uint32_t> queue;
+    queue.reserve(n);
+    for (std::size_t c{0}; c < 26; ++c) {
+        if (children[0][c] == noState) {
+            children[0][c] = 0;
+        } else {
+            queue.push_back(children[0][c]);
+        }
+    }
+    for (std::size_t head{0}; head < queue.size(); ++head) {
+        const std::uint32_t state{queue[head]};
+        for (std::size_t c{0}; c < 26; ++c) {
+            const std::uint32_t child{children[state][c]};
+            const std::uint32_t fallback{children[failure[state]][c]};
+            if (child == noState) {
+                children[state][c] = fallback;
+                continue;
+            }
+            failure[child] = fallback;
+            dictionaryLink_[child] = endingHere[fallback].empty()
+                                         ? dictionaryLink_[fallback]
+                                         : fallback;
+            queue.push_back(child);
+        }
+    }
+
+    // Flatten the keywords that end at each state
+    keywordBegin_.reserve(n + 1);
+    keywordBegin_.push_back(0);
+    for (const auto& ids : endingHere) {
+        keywordIds_.insert(std::end(keywordIds_), std::begin(ids),
+                           std::end(ids));
+        keywordBegin_.push_back(static_cast<std::uint32_t>(keywordIds_.size()));
+    }
+
+    // Fill the transition table, leaving anything that is not a letter to
+    // go back to the start state
+    transitions_.assign(n * rowSize, 0);
+    for (std::size_t state{0}; state < n; ++state) {
+        for (std::size_t c{0}; c < 26; ++c) {
+            const std::uint32_t next{children[state][c]};
+            const bool accepts{!endingHere[next].empty() ||
+                               dictionaryLink_[next] != noState};
+            transitions_[state * rowSize + c] =
+                static_cast<std::uint32_t>(next * rowSize) |
+                (accepts ? acceptFlag : 0);
+        }
+    }
+
+    // Compile the key into a column lookup for each position in the key
+    columns_.resize(keyLetters.size());
+    for (std::size_t a{0}; a < keyLetters.size(); ++a) {
+        const std::size_t shift{static_cast<std::size_t>(keyLetters[a] - 'A')};
+        columns_[a].fill(notLetter);
+        for (std::size_t c{0}; c < 26; ++c) {
+            columns_[a]['A' + c] =
+                static_cast<std::uint8_t>((c + 26 - shift) % 26);
+        }
+    }
+}
+
+void KeywordScanner::scan(const char* text, const std::size_t n,
+                          const MatchHandler& onMatch)
+{
+    const std::size_t period{columns_.size()};
+    std::uint32_t state{state_};
+    std::size_t alignment{alignment_};
+
+    for (std::size_t i{0}; i < n; ++i) {
+        const std::uint8_t column{
+            columns_[alignment][static_cast<unsigned char>(text[i])]};
+        const std::uint32_t next{transitions_[state + column]};
+        state = next & ~acceptFlag;
+
+        if (next & acceptFlag) {
+            // Report the keywords ending here, longest first
+            const std::size_t end{offset_ + i + 1};
+            for (std::uint32_t s{state / static_cast<std::uint32_t>(rowSize)};
+                 s != noState; s = dictionaryLink_[s]) {
+                for (std::uint32_t j{keywordBegin_[s]};
+                     j < keywordBegin_[s + 1]; ++j) {
+                    const std::size_t keyword{keywordIds_[j]};
+                    onMatch(Match{end - keywordLengths_[keyword], keyword});
+                }
+            }
+        }
+
+        if (++alignment == period) {
+            alignment = 0;
+        }
+    }
+
+    state_ = state;
+    alignment_ = alignment;
+    offset_ += n;
+}
+
+void KeywordScanner::reset()
+{
+    state_ = 0;
+    alignment_ = 0;
+    offset_ = 0;
+}
@@ -0,0 +1,135 @@
+#ifndef MPAGSCIPHER_KEYWORDSCANNER_HPP
+#define MPAGSCIPHER_KEYWORDSCANNER_HPP
+
+#include "CipherType.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * \file KeywordScanner.hpp
+ * \brief Contains the declaration of the KeywordScanner class
+ */
+
+/**
+ * \class KeywordScanner
+ * \brief Find every occurrence of a list of keywords in Caesar or Vigenere encrypted text
+ *
+ * The keywords are compiled into an Aho-Corasick automaton, a DFA that reads
+ * one letter at a time and is in an accepting state whenever the text read
+ * so far ends with one of the keywords. The transitions are stored as one
+ * flat array with 32 entries per state, each holding the offset of the next
+ * state's row directly, so each step is a single load.
+ *
+ * The automaton works on plain text letters, and the key is compiled into a
+ * table for each position in the key that maps each byte of cipher text
+ * straight to the column of the letter it decrypts to, so the cipher text
+ * never has to be decrypted as such. The text can be fed in pieces of any
+ * size, and the memory used does not depend on the length of the text.
+ */
+class KeywordScanner {
+  public:
+    /**
+     * \struct Match
+     * \brief Where a keyword was found
+     */
+    struct Match {
+        /// The offset of the first letter of the keyword in the text
+        std::size_t offset;
+        /// The index of the keyword in the list given to the constructor
+        std::size_t keyword;
+    };
+
+    /// Type definition for the function called for each match
+    using MatchHandler = std::function<void(const Match&)>;
+
+    /**
+     * \brief Compile a list of keywords for text encrypted with a key
+     *
+     * \param keywords the keywords, each one or more upper-case letters
+     * \param type the cipher type, Caesar or Vigenere
+     * \param key the key the text was encrypted with
+     * \throw std::invalid_argument if the cipher is not supported or a
+     *        keyword is empty or contains anything but upper-case letters
+     * \throw InvalidKey if the key is invalid
+     * \throw std::length_error if the automaton would be too large
+     */
+    KeywordScanner(const std::vector<std::string>& keywords,
+                   const CipherType type, const std::string& key);
+
+    /**
+     * \brief Scan the next piece of cipher text
+     *
+     * Matches that started in an earlier piece are still found, and offsets
+     * count from the start of the first piece since the last reset().
+     * Anything that is not an upper-case letter breaks any match, but still
+     * takes up a position in the key.
+     *
+     * \param text the next piece of cipher text
+     * \param n the number of characters in the piece
+     * \param onMatch the function to call for each match, in order of the
+     *                end of the match
+     */
+    void scan(const char* text, const std::size_t n,
+              const MatchHandler& onMatch);
+
+    /**
+     * \brief Start again from the beginning of a text
+     */
+    void reset();
+
+    /**
+     * \brief Get the number of states in the automaton
+     *
+     * \return the number of states, including the start state
+     */
+    std::size_t nStates() const { return keywordBegin_.size() - 1; }
+
+  private:
+    /// The number of entries in each row of the transition table
+    static constexpr std::size_t rowSize{32};
+
+    /// The column used for anything that is not a letter
+    static constexpr std::uint8_t notLetter{26};
+
+    /// Flag set in a transition that leads to an accepting state
+    static constexpr std::uint32_t acceptFlag{1u << 31};
+
+    /// Value of dictionaryLink_ for states with no accepting suffix
+    static constexpr std::uint32_t noState{~0u};
+
+    /// The transitions, indexed by row offset plus column, giving the row
+    /// offset of the next state (with acceptFlag if it accepts)
+    std::vector<std::uint32_t> transitions_;
+
+    /// For each position in the key, the column for each byte of cipher text
+    std::vector<std::array<std::uint8_t, 256>> columns_;
+
+    /// Start of each state's keywords in keywordIds_ (one extra at the end)
+    std::vector<std::uint32_t> keywordBegin_;
+
+    /// The keywords that end at each state, grouped by state
+    std::vector<std::uint32_t> keywordIds_;
+
+    /// For each state, the longest proper suffix state that some keyword
+    /// ends at
+    std::vector<std::uint32_t> dictionaryLink_;
+
+    /// The length of each keyword
+    std::vector<std::size_t> keywordLengths_;
+
+    /// The current state, as its row offset
+    std::uint32_t state_{0};
+
+    /// The position in the key of the next character
+    std::size_t alignment_{0};
+
+    /// The offset of the next character
+    std::size_t offset_{0};
+};
+
+#endif    // MPAGSCIPHER_KEYWORDSCANNER_HPP
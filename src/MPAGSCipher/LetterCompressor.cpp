@@ -0,0 +1,152 @@
+#include "LetterCompressor.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    /// The number of bits in the hash of 4 letters
+    constexpr std::size_t hashBits{16};
+
+    /// The value of a hash table entry that has not been filled
+    constexpr std::uint32_t noPosition{~0u};
+
+    /// Hash the 4 letters starting at a position
+    std::size_t hash4(const char* p)
+    {
+        std::uint32_t word;
+        std::memcpy(&word, p, 4);
+        return (word * 2654435761u) >> (32 - hashBits);
+    }
+
+    /// Append a number as base-13 letters, least significant digit first
+    void putNumber(std::string& out, std::size_t value)
+    {
+        while (value >= 13) {
+            out += static_cast<char>('N' + value % 13);
+            value /= 13;
+        }
+        out += static_cast<char>('A' + value);
+    }
+
+    /// Read a number written by putNumber, advancing past it
+    std::size_t getNumber(const std::string& in, std::size_t& pos)
+    {
+        std::size_t value{0};
+        std::size_t scale{1};
+        for (std::size_t nDigits{0}; pos < in.size() && nDigits < 12;
+             ++nDigits) {
+            const unsigned int digit{
+                static_cast<unsigned char>(in[pos++] - 'A')};
+            if (digit < 13) {
+                return value + digit * scale;
+            }
+            if (digit >= 26) {
+                break;
+            }
+            value += (digit - 13) * scale;
+            scale *= 13;
+        }
+        throw std::invalid_argument{"malformed compressed text"};
+    }
+}    // namespace
+
+namespace LetterCompressor {
+    std::string compress(const std::string& text)
+    {
+        const std::size_t n{text.size()};
+        const char* const p{text.data()};
+        std::string out;
+        out.reserve(n / 2 + 16);
+
+        std::vector<std::uint32_t> table(std::size_t{1} << hashBits,
+                                         noPosition);
+        std::size_t anchor{0};
+        std::size_t i{0};
+        while (i + minMatch <= n) {
+            const std::size_t h{hash4(p + i)};
+            const std::uint32_t candidate{table[h]};
+            table[h] = static_cast<std::uint32_t>(i);
+
+            if (candidate == noPosition || i - candidate > window ||
+                std::memcmp(p + candidate, p + i, minMatch) != 0) {
+                // Step further the longer there has been no match
+                i += 1 + ((i - anchor) >> 6);
+                continue;
+            }
+
+            // Extend the match forwards, then backwards over the literals
+            std::size_t match{candidate};
+            std::size_t length{minMatch};
+            while (i + length < n && p[match + length] == p[i + length]) {
+                ++length;
+            }
+            while (i > anchor && match > 0 && p[match - 1] == p[i - 1]) {
+                --i;
+                --match;
+                ++length;
+            }
+
+            putNumber(out, i - anchor);
+            out.append(p + anchor, i - anchor);
+            putNumber(out, i - match - 1);
+            putNumber(out, length - minMatch);
+
+            i += length;
+            anchor = i;
+            if (i >= 2 && i + 2 <= n) {
+                table[hash4(p + i - 2)] = static_cast<std::uint32_t>(i - 2);
+            }
+        }
+
+        // The last run of literals has no match after it
+        putNumber(out, n - anchor);
+        out.append(p + anchor, n - anchor);
+        return out;
+    }
+
+    std::string decompress(const std::string& compressed,
+                           const std::size_t expectedSize)
+    {
+        const std::size_t maxSize{expectedSize > 0 ? expectedSize
+                                                   : ~std::size_t{0}};
+        std::string out;
+        out.reserve(expectedSize);
+
+        std::size_t pos{0};
+        while (true) {
+            const std::size_t nLiterals{getNumber(compressed, pos)};
+            if (nLiterals > compressed.size() - pos ||
+                nLiterals > maxSize - out.size()) {
+                throw std::invalid_argument{"malformed compressed text"};
+            }
+            out.append(compressed, pos, nLiterals);
+            pos += nLiterals;
+            if (pos == compressed.size()) {
+                return out;
+            }
+
+            const std::size_t offset{getNumber(compressed, pos) + 1};
+            const std::size_t length{getNumber(compressed, pos) + minMatch};
+            if (offset > out.size() || length > maxSize - out.size()) {
+                throw std::invalid_argument{"malformed compressed text"};
+            }
+
+            // A match that overlaps itself has to be copied a letter at a
+            // time, as it copies letters that it has itself written
+            const std::size_t from{out.size() - offset};
+            const std::size_t to{out.size()};
+            out.resize(to + length);
+            if (offset >= length) {
+                std::memcpy(&out[to], &out[from], length);
+            } else {
+                for (std::size_t k{0}; k < length; ++k) {
+                    out[to + k] = out[from + k];
+                }
+            }
+        }
+    }
+}    // namespace LetterCompressor
@@ -0,0 +1,62 @@
+#ifndef MPAGSCIPHER_LETTERCOMPRESSOR_HPP
+#define MPAGSCIPHER_LETTERCOMPRESSOR_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \file LetterCompressor.hpp
+ * \brief Contains the declarations of the functions for compressing text made of upper-case letters
+ */
+
+/**
+ * \namespace LetterCompressor
+ * \brief Namespace to group the functions of a fast LZ77 compressor whose output is also upper-case letters
+ *
+ * The format follows LZ4: a sequence of runs of literal letters, each
+ * followed by a match that copies letters from earlier in the output. The
+ * difference is that every number (the length of a run of literals, and
+ * the offset and length of a match) is written as letters too, as a
+ * little-endian base-13 number where A-M are the last digit and N-Z are
+ * digits with more to follow. Literals are copied as they are, so the
+ * compressed text is never much longer than the original, and since it is
+ * still upper-case letters it can be encrypted by the classical ciphers.
+ *
+ * Each sequence is the literal run length, the literals, then (unless
+ * that was the end of the text) the match offset less 1 and the match
+ * length less the minimum match length.
+ */
+namespace LetterCompressor {
+    /// The shortest match that is worth encoding
+    constexpr std::size_t minMatch{8};
+
+    /// The furthest back a match can be
+    constexpr std::size_t window{1 << 16};
+
+    /**
+     * \brief Compress a text
+     *
+     * Matches are found greedily with a hash table of the last position
+     * at which each 4 letters were seen, skipping ahead faster the longer
+     * it has been since the last match, as LZ4 does.
+     *
+     * \param text the text, which is expected to be upper-case letters
+     * \return the compressed text, made of upper-case letters
+     */
+    std::string compress(const std::string& text);
+
+    /**
+     * \brief Decompress a text
+     *
+     * \param compressed the compressed text
+     * \param expectedSize the size of the result if it is known, in which
+     *                     case the text is rejected if it would be longer,
+     *                     or 0 if not
+     * \return the original text
+     * \throw std::invalid_argument if the compressed text is malformed
+     */
+    std::string decompress(const std::string& compressed,
+                           const std::size_t expectedSize = 0);
+}    // namespace LetterCompressor
+
+#endif    // MPAGSCIPHER_LETTERCOMPRESSOR_HPP
@@ -0,0 +1,70 @@
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& fileName)
+    : MappedFile{fileName, 0, std::numeric_limits<std::size_t>::max()}
+{
+}
+
+MappedFile::MappedFile(const std::string& fileName, const std::size_t offset,
+                       const std::size_t length)
+{
+    const int fd{::open(fileName.c_str(), O_RDONLY)};
+    if (fd < 0) {
+        throw std::system_error{errno, std::generic_category(),
+                                "failed to open '" + fileName + "'"};
+    }
+
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+        const int error{errno};
+        ::close(fd);
+        throw std::system_error{error, std::generic_category(),
+                                "failed to stat '" + fileName + "'"};
+    }
+    const std::size_t fileSize{static_cast<std::size_t>(status.st_size)};
+    const std::size_t begin{std::min(offset, fileSize)};
+    size_ = std::min(length, fileSize - begin);
+
+    // An empty part cannot be mapped, but then there is nothing to read anyway
+    if (size_ > 0) {
+        // The mapping has to start on a page boundary
+        const std::size_t pageSize{
+            static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+        const std::size_t start{begin - begin % pageSize};
+        mappingSize_ = size_ + (begin - start);
+        mapping_ = ::mmap(nullptr, mappingSize_, PROT_READ, MAP_PRIVATE, fd,
+                          static_cast<off_t>(start));
+        if (mapping_ == MAP_FAILED) {
+            const int error{errno};
+            mapping_ = nullptr;
+            ::close(fd);
+            throw std::system_error{error, std::generic_category(),
+                                    "failed to map '" + fileName + "'"};
+        }
+        data_ = static_cast<const char*>(mapping_) + (begin - start);
+
+        // The file is read from start to finish, so ask for read-ahead
+        ::madvise(mapping_, mappingSize_, MADV_SEQUENTIAL);
+    }
+
+    // The mapping stays valid once the file is closed
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (mapping_) {
+        ::munmap(mapping_, mappingSize_);
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef MPAGSCIPHER_MAPPEDFILE_HPP
+#define MPAGSCIPHER_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \file MappedFile.hpp
+ * \brief Contains the declaration of the MappedFile class
+ */
+
+/**
+ * \class MappedFile
+ * \brief A read-only view of the contents of a file, mapped into memory
+ *
+ * The pages of the file are only read in by the operating system as they are
+ * touched, so large files can be streamed through without ever being copied
+ * into a buffer of their own.
+ */
+class MappedFile {
+  public:
+    /**
+     * \brief Map the given file into memory
+     *
+     * \param fileName the name of the file
+     * \throw std::system_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& fileName);
+
+    /**
+     * \brief Map part of the given file into memory
+     *
+     * Only the pages holding that part are mapped, so that e.g. each of
+     * several processes can work on a part of a huge file of its own.
+     *
+     * \param fileName the name of the file
+     * \param offset the offset of the first byte of the part
+     * \param length the number of bytes in the part (it stops at the end of
+     *               the file if that comes first)
+     * \throw std::system_error if the file cannot be opened or mapped
+     */
+    MappedFile(const std::string& fileName, const std::size_t offset,
+               const std::size_t length);
+
+    /// Unmap the file
+    ~MappedFile();
+
+    /// The mapping cannot be copied
+    MappedFile(const MappedFile& rhs) = delete;
+    /// The mapping cannot be moved
+    MappedFile(MappedFile&& rhs) = delete;
+    /// The mapping cannot be copy assigned
+    MappedFile& operator=(const MappedFile& rhs) = delete;
+    /// The mapping cannot be move assigned
+    MappedFile& operator=(MappedFile&& rhs) = delete;
+
+    /**
+     * \brief Get the contents of the file
+     *
+     * \return a pointer to the first byte of the file (nullptr if it is empty)
+     */
+    const char* data() const { return data_; }
+
+    /**
+     * \brief Get the size of the file
+     *
+     * \return the number of bytes in the file
+     */
+    std::size_t size() const { return size_; }
+
+  private:
+    /// The start of the contents
+    const char* data_{nullptr};
+
+    /// The size of the contents
+    std::size_t size_{0};
+
+    /// The start of the mapping, which is on a page boundary
+    void* mapping_{nullptr};
+
+    /// The size of the mapping
+    std::size_t mappingSize_{0};
+};
+
+#endif    // MPAGSCIPHER_MAPPEDFILE_HPP
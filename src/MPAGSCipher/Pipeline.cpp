@@ -0,0 +1,131 @@
+#include "Pipeline.hpp"
+#include "SpscRing.hpp"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+Pipeline::Stats Pipeline::run(const Source& source, const Transform& transform,
+                              const Sink& sink, const std::size_t nWorkers,
+                              const std::size_t depth)
+{
+    if (nWorkers == 0 || depth == 0) {
+        throw std::invalid_argument{
+            "Pipeline needs at least one worker and a nonzero depth"};
+    }
+
+    // Enough blocks for every ring into and out of the workers to be full
+    // at once, so that the reader never waits for the writer unless the
+    // workers are behind
+    using Ring = SpscRing<std::size_t>;
+    const std::size_t nBlocks{2 * depth * nWorkers};
+    std::vector<Block> blocks(nBlocks);
+    std::vector<std::unique_ptr<Ring>> toWorkers;
+    std::vector<std::unique_ptr<Ring>> toWriter;
+    for (std::size_t w{0}; w < nWorkers; ++w) {
+        toWorkers.push_back(std::make_unique<Ring>(depth));
+        toWriter.push_back(std::make_unique<Ring>(depth));
+    }
+    Ring recycled{nBlocks};
+
+    // Keep the first exception, and close every ring so that all of the
+    // stages give up rather than waiting for each other
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+    const auto fail = [&]() {
+        {
+            std::lock_guard<std::mutex> lock{errorMutex};
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        failed.store(true);
+        for (std::size_t w{0}; w < nWorkers; ++w) {
+            toWorkers[w]->close();
+            toWriter[w]->close();
+        }
+        recycled.close();
+    };
+
+    // The reader fills the blocks, using each one once before waiting for
+    // the writer to give them back, and deals them out to the workers in turn
+    std::thread reader{[&]() {
+        try {
+            std::size_t nFresh{0};
+            for (std::uint64_t i{0};; ++i) {
+                std::size_t b{0};
+                if (nFresh < nBlocks) {
+                    b = nFresh++;
+                } else if (!recycled.pop(b)) {
+                    break;
+                }
+                Block& block{blocks[b]};
+                block.input.clear();
+                block.output.clear();
+                block.offset = 0;
+                if (!source(block) || !toWorkers[i % nWorkers]->push(b)) {
+                    break;
+                }
+            }
+        } catch (...) {
+            fail();
+        }
+        for (auto& ring : toWorkers) {
+            ring->close();
+        }
+    }};
+
+    std::vector<std::thread> workers;
+    workers.reserve(nWorkers);
+    for (std::size_t w{0}; w < nWorkers; ++w) {
+        workers.emplace_back([&, w]() {
+            try {
+                std::size_t b{0};
+                while (toWorkers[w]->pop(b) && !failed.load()) {
+                    transform(blocks[b]);
+                    if (!toWriter[w]->push(b)) {
+                        break;
+                    }
+                }
+            } catch (...) {
+                fail();
+            }
+            toWriter[w]->close();
+        });
+    }
+
+    // The writer collects the blocks from the workers in the order they
+    // were dealt out, so the first ring to run dry marks the end
+    Stats stats;
+    stats.workers = nWorkers;
+    try {
+        std::size_t b{0};
+        while (toWriter[stats.blocks % nWorkers]->pop(b) && !failed.load()) {
+            sink(blocks[b]);
+            ++stats.blocks;
+            recycled.push(b);
+        }
+    } catch (...) {
+        fail();
+    }
+
+    reader.join();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    for (std::size_t w{0}; w < nWorkers; ++w) {
+        stats.toWorkers += toWorkers[w]->stats();
+        stats.toWriter += toWriter[w]->stats();
+    }
+    stats.recycled = recycled.stats();
+    return stats;
+}
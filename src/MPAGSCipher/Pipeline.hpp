@@ -0,0 +1,98 @@
+#ifndef MPAGSCIPHER_PIPELINE_HPP
+#define MPAGSCIPHER_PIPELINE_HPP
+
+#include "SpscRing.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * \file Pipeline.hpp
+ * \brief Contains the declarations of the functions and structures for running the reader/cipher/writer pipeline
+ */
+
+/**
+ * \namespace Pipeline
+ * \brief Namespace to group the functions and structures for running reading, processing and writing at the same time
+ *
+ * The text is passed through in blocks by three stages: a reader thread
+ * fills each block from the source, one or more worker threads process
+ * them, and the calling thread hands them to the sink in order. The stages
+ * are connected by bounded lock-free single-producer/single-consumer rings
+ * (see SpscRing): the reader deals the blocks out to the workers in turn,
+ * each through its own ring, and the writer collects them back in the same
+ * order, each worker through its own ring, which keeps every ring to a
+ * single producer and a single consumer. The blocks themselves are a fixed
+ * set that the writer hands back to the reader through another ring once
+ * they have been written, so their buffers are reused rather than being
+ * allocated for each block.
+ *
+ * Since the stages overlap, the time taken for a large input approaches
+ * that of the slowest stage rather than the sum of them all.
+ */
+namespace Pipeline {
+    /**
+     * \struct Block
+     * \brief A block of text passing through the pipeline
+     */
+    struct Block {
+        /// The text as read by the source
+        std::string input;
+        /// The text as processed by the workers
+        std::string output;
+        /// Where the block starts, for the source to set if it is needed
+        std::uint64_t offset{0};
+    };
+
+    /// Fills an empty block, or returns false if there is nothing left
+    using Source = std::function<bool(Block& block)>;
+
+    /// Processes a block, setting its output from its input and offset
+    using Transform = std::function<void(Block& block)>;
+
+    /// Writes out the output of a block
+    using Sink = std::function<void(const Block& block)>;
+
+    /**
+     * \struct Stats
+     * \brief The counts for each set of rings in the pipeline once it has finished
+     */
+    struct Stats {
+        /// The number of blocks that went through the pipeline
+        std::uint64_t blocks{0};
+        /// The number of workers
+        std::size_t workers{0};
+        /// The rings from the reader to the workers, added together
+        RingStats toWorkers;
+        /// The rings from the workers to the writer, added together
+        RingStats toWriter;
+        /// The ring of empty blocks from the writer back to the reader
+        RingStats recycled;
+    };
+
+    /**
+     * \brief Run the pipeline until the source runs out
+     *
+     * The source is called on a reader thread and the transform on each of
+     * the worker threads (so must be safe to call on several blocks at
+     * once), while the sink is called on the calling thread with the blocks
+     * in the order the source gave them. If any of them throws, the
+     * pipeline is stopped and the first exception is rethrown here once all
+     * of the threads have finished.
+     *
+     * \param source fills each block in turn
+     * \param transform processes each block
+     * \param sink writes out each block
+     * \param nWorkers the number of worker threads
+     * \param depth the number of blocks each ring can hold
+     * \return the counts for the rings
+     * \throw std::invalid_argument if the number of workers or depth is zero
+     */
+    Stats run(const Source& source, const Transform& transform,
+              const Sink& sink, const std::size_t nWorkers,
+              const std::size_t depth);
+}    // namespace Pipeline
+
+#endif    // MPAGSCIPHER_PIPELINE_HPP
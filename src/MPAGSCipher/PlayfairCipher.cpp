@@ -1,9 +1,14 @@
 #include "PlayfairCipher.hpp"
-#include "Alphabet.hpp"
+#include "ThreadPool.hpp"
 
 #include <algorithm>
 #include <string>
 
+namespace {
+    /// Number of digraphs handed to each thread at a time
+    constexpr std::size_t digraphsPerTask{1 << 17};
+}    // namespace
+
 PlayfairCipher::PlayfairCipher(const std::string& key)
 {
     this->setKey(key);
@@ -11,54 +16,59 @@ PlayfairCipher::PlayfairCipher(const std::string& key)
 
 void PlayfairCipher::setKey(const std::string& key)
 {
-    // Store the original key
-    key_ = key;
-
-    // Append the alphabet to the key
-    key_ += Alphabet::alphabet;
-
-    // Make sure the key is upper case
-    std::transform(std::begin(key_), std::end(key_), std::begin(key_),
-                   ::toupper);
-
-    // Remove non-alphabet characters
-    key_.erase(std::remove_if(std::begin(key_), std::end(key_),
-                              [](char c) { return !std::isalpha(c); }),
-               std::end(key_));
-
-    // Change J -> I
-    std::transform(std::begin(key_), std::end(key_), std::begin(key_),
-                   [](char c) { return (c == 'J') ? 'I' : c; });
-
-    // Remove duplicated letters
-    std::string lettersFound{""};
-    auto detectDuplicates = [&](char c) {
-        if (lettersFound.find(c) == std::string::npos) {
-            lettersFound += c;
-            return false;
-        } else {
-            return true;
+    // Fill the grid from the key
+    grid_.setKey(key);
+
+    // Work out what happens to every possible digraph in each direction
+    const std::size_t gridSize{PolybiusGrid::size};
+    for (std::size_t first{0}; first < PolybiusGrid::nCells; ++first) {
+        for (std::size_t second{0}; second < PolybiusGrid::nCells; ++second) {
+            const std::size_t index{
+                2 * (first * PolybiusGrid::nCells + second)};
+            for (const CipherMode cipherMode :
+                 {CipherMode::Encrypt, CipherMode::Decrypt}) {
+                // Depending on encryption/decryption mode, set whether to
+                // increment or decrement the column/row index (modulo the
+                // grid dimension)
+                const std::size_t shift{
+                    (cipherMode == CipherMode::Encrypt) ? 1u : gridSize - 1u};
+
+                std::size_t rowOne{first / gridSize};
+                std::size_t columnOne{first % gridSize};
+                std::size_t rowTwo{second / gridSize};
+                std::size_t columnTwo{second % gridSize};
+
+                // Find whether the two points are on a row, a column or form a rectangle/square
+                // Then apply the appropriate rule to these coords to get new coords
+                if (rowOne == rowTwo) {
+                    // Row - so increment/decrement the column indices (modulo the grid dimension)
+                    columnOne = (columnOne + shift) % gridSize;
+                    columnTwo = (columnTwo + shift) % gridSize;
+
+                } else if (columnOne == columnTwo) {
+                    // Column - so increment/decrement the row indices (modulo the grid dimension)
+                    rowOne = (rowOne + shift) % gridSize;
+                    rowTwo = (rowTwo + shift) % gridSize;
+
+                } else {
+                    // Rectangle/Square - so keep the rows the same and swap the columns
+                    // (NB the operation is actually the same regardless of encrypt/decrypt
+                    // since applying the same operation twice gets you back to where you were)
+                    std::swap(columnOne, columnTwo);
+                }
+
+                // Store the letters associated with the new coords
+                PolybiusGrid::DigraphTable& table{
+                    (cipherMode == CipherMode::Encrypt) ? encryptTable_
+                                                        : decryptTable_};
+                table[index] = grid_.letter(rowOne, columnOne);
+                table[index + 1] = grid_.letter(rowTwo, columnTwo);
+            }
         }
-    };
-    key_.erase(
-        std::remove_if(std::begin(key_), std::end(key_), detectDuplicates),
-        std::end(key_));
-
-    // Store the coordinates of each letter
-    // (at this point the key length must be equal to the square of the grid dimension)
-    for (std::size_t i{0}; i < keyLength_; ++i) {
-        std::size_t row{i / gridSize_};
-        std::size_t column{i % gridSize_};
-
-        auto coords = std::make_pair(row, column);
-
-        charLookup_[key_[i]] = coords;
-        coordLookup_[coords] = key_[i];
     }
 }
 
-std::string PlayfairCipher::applyCipher(const std::string& inputText,
-                                        const CipherMode cipherMode) const
+std::string PlayfairCipher::prepareText(const std::string& inputText)
 {
     // Create the output string, initially a copy of the input text
     std::string outputText{inputText};
@@ -68,6 +78,13 @@ std::string PlayfairCipher::applyCipher(const std::string& inputText,
                    std::begin(outputText),
                    [](char c) { return (c == 'J') ? 'I' : c; });
 
+    // Remove anything that isn't in the grid (every grid holds the same
+    // letters, so this doesn't depend on the key)
+    outputText.erase(
+        std::remove_if(std::begin(outputText), std::end(outputText),
+                       [](char c) { return c < 'A' || c > 'Z'; }),
+        std::end(outputText));
+
     // Find repeated characters (but only when they occur within a bigram)
     // and add an X (or a Q for repeated X's) between them
     std::string tmpText{""};
@@ -99,42 +116,30 @@ std::string PlayfairCipher::applyCipher(const std::string& inputText,
     // Swap the contents of the original and modified strings - cheaper than assignment
     outputText.swap(tmpText);
 
-    // Depending on encryption/decryption mode, set whether to increment or
-    // decrement the column/row index (modulo the grid dimension)
-    const std::size_t shift{
-        (cipherMode == CipherMode::Encrypt) ? 1u : gridSize_ - 1u};
-
-    // Loop over the input digraphs
-    for (std::size_t i{0}; i < outputText.size(); i += 2) {
-        // Find the coordinates in the grid for each digraph
-        PlayfairCoords pointOne{charLookup_.at(outputText[i])};
-        PlayfairCoords pointTwo{charLookup_.at(outputText[i + 1])};
-        auto& [rowOne, columnOne]{pointOne};
-        auto& [rowTwo, columnTwo]{pointTwo};
-
-        // Find whether the two points are on a row, a column or form a rectangle/square
-        // Then apply the appropriate rule to these coords to get new coords
-        if (rowOne == rowTwo) {
-            // Row - so increment/decrement the column indices (modulo the grid dimension)
-            columnOne = (columnOne + shift) % gridSize_;
-            columnTwo = (columnTwo + shift) % gridSize_;
-
-        } else if (columnOne == columnTwo) {
-            // Column - so increment/decrement the row indices (modulo the grid dimension)
-            rowOne = (rowOne + shift) % gridSize_;
-            rowTwo = (rowTwo + shift) % gridSize_;
-
-        } else {
-            // Rectangle/Square - so keep the rows the same and swap the columns
-            // (NB the operation is actually the same regardless of encrypt/decrypt
-            // since applying the same operation twice gets you back to where you were)
-            std::swap(columnOne, columnTwo);
-        }
+    return outputText;
+}
 
-        // Find the letters associated with the new coords and make the replacements
-        outputText[i] = coordLookup_.at(pointOne);
-        outputText[i + 1] = coordLookup_.at(pointTwo);
-    }
+std::string PlayfairCipher::applyCipher(const std::string& inputText,
+                                        const CipherMode cipherMode) const
+{
+    // Put the text into digraphs
+    std::string outputText{PlayfairCipher::prepareText(inputText)};
+
+    // Look up each digraph in the relevant table - the digraphs are
+    // independent of each other, so this can be split across threads
+    const PolybiusGrid::DigraphTable& table{
+        (cipherMode == CipherMode::Encrypt) ? encryptTable_ : decryptTable_};
+    char* text{outputText.data()};
+    parallelFor(outputText.size() / 2, digraphsPerTask,
+                [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t i{2 * begin}; i < 2 * end; i += 2) {
+                        const std::size_t index{
+                            2 * (grid_.cell(text[i]) * PolybiusGrid::nCells +
+                                 grid_.cell(text[i + 1]))};
+                        text[i] = table[index];
+                        text[i + 1] = table[index + 1];
+                    }
+                });
 
     // Return the output text
     return outputText;
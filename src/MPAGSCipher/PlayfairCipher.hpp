@@ -4,8 +4,8 @@
 #include "Cipher.hpp"
 #include "CipherMode.hpp"
 #include "CipherType.hpp"
+#include "PolybiusGrid.hpp"
 
-#include <map>
 #include <string>
 
 /**
@@ -16,6 +16,9 @@
 /**
  * \class PlayfairCipher
  * \brief Encrypt or decrypt text using the Playfair cipher with the given key
+ *
+ * The key fills a PolybiusGrid, from which the result of enciphering each of
+ * the 25 x 25 possible digraphs is worked out in advance in both directions.
  */
 class PlayfairCipher : public Cipher {
   public:
@@ -50,26 +53,50 @@ class PlayfairCipher : public Cipher {
      */
     CipherType type() const override { return CipherType::Playfair; }
 
-  private:
-    /// The grid size
-    const std::string::size_type gridSize_{5};
+    /**
+     * \brief Prepare text for encryption or decryption
+     *
+     * J is changed to I, anything that is not in the grid is removed, an X
+     * (or Q) is inserted between repeated letters within a digraph, and a Z
+     * (or X) is added to make the length even. None of this depends on the
+     * key, so it only needs doing once however many keys are tried.
+     *
+     * \param inputText the text to prepare
+     * \return the text as a sequence of digraphs
+     */
+    static std::string prepareText(const std::string& inputText);
 
-    /// The key length = grid size^2
-    const std::string::size_type keyLength_{gridSize_ * gridSize_};
+    /**
+     * \brief Get the grid generated from the key
+     *
+     * \return the grid
+     */
+    const PolybiusGrid& grid() const { return grid_; }
 
-    /// The cipher key
-    std::string key_{""};
+    /**
+     * \brief Get the lookup table for digraphs in the given direction
+     *
+     * \param cipherMode whether to get the encryption or decryption table
+     * \return the table, indexed by the cells of each digraph in grid()
+     */
+    const PolybiusGrid::DigraphTable& digraphTable(
+        const CipherMode cipherMode) const
+    {
+        return (cipherMode == CipherMode::Encrypt) ? encryptTable_
+                                                   : decryptTable_;
+    }
 
-    // Lookup tables generated from the key
+  private:
+    /// The grid generated from the key
+    PolybiusGrid grid_{""};
 
-    /// Type definition for the coordinates in the 5x5 table
-    using PlayfairCoords = std::pair<std::size_t, std::size_t>;
+    // Lookup tables generated from the grid
 
-    /// Lookup table to go from the character to the coordinates
-    std::map<char, PlayfairCoords> charLookup_;
+    /// Lookup table giving the encrypted form of each digraph
+    PolybiusGrid::DigraphTable encryptTable_{};
 
-    /// Lookup table to go from the coordinates to the character
-    std::map<PlayfairCoords, char> coordLookup_;
+    /// Lookup table giving the decrypted form of each digraph
+    PolybiusGrid::DigraphTable decryptTable_{};
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "PolybiusGrid.hpp"
+#include "Alphabet.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+PolybiusGrid::PolybiusGrid(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void PolybiusGrid::setKey(const std::string& key)
+{
+    // Append the alphabet to the key
+    letters_ = key + Alphabet::alphabet;
+
+    // Make sure the key is upper case
+    std::transform(std::begin(letters_), std::end(letters_),
+                   std::begin(letters_), ::toupper);
+
+    // Remove non-alphabet characters
+    letters_.erase(std::remove_if(std::begin(letters_), std::end(letters_),
+                                  [](char c) { return !std::isalpha(c); }),
+                   std::end(letters_));
+
+    // Change J -> I
+    std::transform(std::begin(letters_), std::end(letters_),
+                   std::begin(letters_),
+                   [](char c) { return (c == 'J') ? 'I' : c; });
+
+    // Remove duplicated letters
+    std::string lettersFound{""};
+    auto detectDuplicates = [&](char c) {
+        if (lettersFound.find(c) == std::string::npos) {
+            lettersFound += c;
+            return false;
+        } else {
+            return true;
+        }
+    };
+    letters_.erase(std::remove_if(std::begin(letters_), std::end(letters_),
+                                  detectDuplicates),
+                   std::end(letters_));
+
+    // Store the cell of each letter
+    // (at this point there must be exactly one letter per cell)
+    cells_.fill(static_cast<std::uint8_t>(noCell));
+    for (std::size_t i{0}; i < nCells; ++i) {
+        cells_[static_cast<unsigned char>(letters_[i])] =
+            static_cast<std::uint8_t>(i);
+    }
+    cells_[static_cast<unsigned char>('J')] = cells_['I'];
+}
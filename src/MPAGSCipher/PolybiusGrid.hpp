@@ -0,0 +1,99 @@
+#ifndef MPAGSCIPHER_POLYBIUSGRID_HPP
+#define MPAGSCIPHER_POLYBIUSGRID_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * \file PolybiusGrid.hpp
+ * \brief Contains the declaration of the PolybiusGrid class
+ */
+
+/**
+ * \class PolybiusGrid
+ * \brief A keyed 5x5 grid of letters, as used by the Playfair, Bifid and Four-square ciphers
+ *
+ * The grid is filled row by row with the (upper-cased) letters of the key,
+ * dropping duplicates, followed by the rest of the alphabet, with J merged
+ * into I to leave 25 letters.
+ * The cells are numbered 0-24 row by row, and both directions of the lookup
+ * are held in flat arrays.
+ */
+class PolybiusGrid {
+  public:
+    /// The number of rows (and columns) in the grid
+    static constexpr std::size_t size{5};
+
+    /// The number of cells in the grid
+    static constexpr std::size_t nCells{size * size};
+
+    /// Value returned by cell() for characters that are not in the grid
+    static constexpr std::size_t noCell{nCells};
+
+    /// Type definition for a table giving the two output letters for each
+    /// pair of input cells, indexed by 2 * (nCells * first + second)
+    using DigraphTable = std::array<char, 2 * nCells * nCells>;
+
+    /**
+     * \brief Create a new PolybiusGrid with the given key
+     *
+     * \param key the key used to fill the grid
+     */
+    explicit PolybiusGrid(const std::string& key);
+
+    /**
+     * \brief Set the key used to fill the grid
+     *
+     * \param key the key used to fill the grid
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Find the cell holding a letter
+     *
+     * \param c the letter, J is treated as I
+     * \return the number of the cell, or noCell if c is not an upper-case letter
+     */
+    std::size_t cell(const char c) const
+    {
+        return cells_[static_cast<unsigned char>(c)];
+    }
+
+    /**
+     * \brief Find the letter in a cell
+     *
+     * \param cell the number of the cell
+     * \return the letter in that cell
+     */
+    char letter(const std::size_t cell) const { return letters_[cell]; }
+
+    /**
+     * \brief Find the letter at a given row and column
+     *
+     * \param row the row of the cell
+     * \param column the column of the cell
+     * \return the letter in that cell
+     */
+    char letter(const std::size_t row, const std::size_t column) const
+    {
+        return letters_[row * size + column];
+    }
+
+    /**
+     * \brief Get the contents of the grid
+     *
+     * \return the 25 letters of the grid, row by row
+     */
+    const std::string& letters() const { return letters_; }
+
+  private:
+    /// The letters in each cell, row by row
+    std::string letters_{""};
+
+    /// The cell holding each character, indexed by the character
+    std::array<std::uint8_t, 256> cells_{};
+};
+
+#endif    // MPAGSCIPHER_POLYBIUSGRID_HPP
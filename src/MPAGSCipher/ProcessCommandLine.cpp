@@ -1,5 +1,7 @@
 #include "ProcessCommandLine.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -99,6 +101,165 @@ bool processCommandLine(const std::vector<std::string>& cmdLineArgs,
                 settings.cipherKey.push_back(cmdLineArgs[i + 1]);
                 ++i;
             }
+        } else if (cmdLineArgs[i] == "--search") {
+            // Handle search option
+            // Next element is the phrase unless --search is the last argument
+            if (i == nCmdLineArgs - 1) {
+                throw MissingArgument{"--search requires a phrase argument"};
+                break;
+            } else {
+                // Got the phrase, so assign the value and advance past it
+                settings.searchPhrase = cmdLineArgs[i + 1];
+                ++i;
+            }
+        } else if (cmdLineArgs[i] == "--watchlist") {
+            // Handle watchlist option
+            // Next element is filename unless --watchlist is the last argument
+            if (i == nCmdLineArgs - 1) {
+                throw MissingArgument{"--watchlist requires a filename argument"};
+                break;
+            } else {
+                // Got filename, so assign value and advance past it
+                settings.watchlistFile = cmdLineArgs[i + 1];
+                ++i;
+            }
+        } else if (cmdLineArgs[i] == "--range") {
+            // Handle range option
+            // Next element is START:LEN unless --range is the last argument
+            if (i == nCmdLineArgs - 1) {
+                throw MissingArgument{"--range requires a START:LEN argument"};
+                break;
+            } else {
+                // Check that we have two non-empty strings of digits either
+                // side of the colon before converting them
+                const std::string& arg{cmdLineArgs[i + 1]};
+                const std::size_t colon{arg.find(':')};
+                const auto isNumber = [](const std::string& str) {
+                    return !str.empty() &&
+                           std::all_of(std::begin(str), std::end(str),
+                                       [](char c) { return std::isdigit(c); });
+                };
+                if (colon == std::string::npos ||
+                    !isNumber(arg.substr(0, colon)) ||
+                    !isNumber(arg.substr(colon + 1))) {
+                    std::cerr
+                        << "[error] --range requires a START:LEN argument,\n"
+                        << "        the supplied string (" << arg
+                        << ") could not be successfully converted"
+                        << std::endl;
+                    return false;
+                }
+                settings.rangeRequested = true;
+                settings.rangeStart = std::stoull(arg.substr(0, colon));
+                settings.rangeLength = std::stoull(arg.substr(colon + 1));
+                ++i;
+            }
+        } else if (cmdLineArgs[i] == "--container") {
+            settings.container = true;
+        } else if (cmdLineArgs[i] == "--compress") {
+            settings.compress = true;
+        } else if (cmdLineArgs[i] == "--pipeline-stats") {
+            settings.pipelineStats = true;
+        } else if (cmdLineArgs[i] == "--records") {
+            settings.records = true;
+        } else if (cmdLineArgs[i] == "--follow") {
+            settings.follow = true;
+        } else if (cmdLineArgs[i] == "--recursive") {
+            settings.recursive = true;
+        } else if (cmdLineArgs[i] == "--csv-fields") {
+            // Handle CSV fields option
+            // Next element is a list of field numbers unless --csv-fields is the last argument
+            if (i == nCmdLineArgs - 1) {
+                throw MissingArgument{
+                    "--csv-fields requires a comma-separated list of field numbers"};
+                break;
+            } else {
+                // Each field number must be a (not too long) string of digits
+                // that is not 0, since the fields are counted from 1
+                const std::string& arg{cmdLineArgs[i + 1]};
+                std::vector<std::size_t> fields;
+                std::size_t start{0};
+                while (start <= arg.size()) {
+                    std::size_t end{arg.find(',', start)};
+                    if (end == std::string::npos) {
+                        end = arg.size();
+                    }
+                    const std::string field{arg.substr(start, end - start)};
+                    if (field.empty() || field.size() > 9 ||
+                        !std::all_of(std::begin(field), std::end(field),
+                                     [](char c) { return std::isdigit(c); }) ||
+                        std::stoul(field) == 0) {
+                        std::cerr
+                            << "[error] --csv-fields requires a comma-separated list of field numbers,\n"
+                            << "        the supplied string (" << arg
+                            << ") could not be successfully converted"
+                            << std::endl;
+                        return false;
+                    }
+                    fields.push_back(std::stoul(field) - 1);
+                    start = end + 1;
+                }
+                settings.csvFields = fields;
+                ++i;
+            }
+        } else if (cmdLineArgs[i] == "--csv-delimiter") {
+            // Handle CSV delimiter option
+            // Next element is the delimiter unless --csv-delimiter is the last argument
+            if (i == nCmdLineArgs - 1) {
+                throw MissingArgument{
+                    "--csv-delimiter requires a character argument"};
+                break;
+            } else {
+                // A tab is hard to type on the command line, so can be named
+                const std::string& arg{cmdLineArgs[i + 1]};
+                if (arg == "tab") {
+                    settings.csvDelimiter = '\t';
+                } else if (arg.size() == 1 && arg[0] != '"' &&
+                           arg[0] != '\n' && arg[0] != '\r') {
+                    settings.csvDelimiter = arg[0];
+                } else {
+                    std::cerr
+                        << "[error] --csv-delimiter requires a single character (or tab),\n"
+                        << "        other than a quote or newline - the supplied string ("
+                        << arg << ") cannot be used" << std::endl;
+                    return false;
+                }
+                ++i;
+            }
+        } else if (cmdLineArgs[i] == "--io-depth" ||
+                   cmdLineArgs[i] == "--io-buffer" ||
+                   cmdLineArgs[i] == "--shards") {
+            // Handle the I/O and sharding options
+            // Next element is a positive integer unless the option is the last argument
+            const std::string& option{cmdLineArgs[i]};
+            if (i == nCmdLineArgs - 1) {
+                throw MissingArgument{option +
+                                      " requires a positive integer argument"};
+                break;
+            } else {
+                // Check for a (not too long) string of digits that is not 0
+                const std::string& arg{cmdLineArgs[i + 1]};
+                if (arg.empty() || arg.size() > 9 ||
+                    !std::all_of(std::begin(arg), std::end(arg),
+                                 [](char c) { return std::isdigit(c); }) ||
+                    std::stoul(arg) == 0) {
+                    std::cerr
+                        << "[error] " << option
+                        << " requires a positive integer argument,\n"
+                        << "        the supplied string (" << arg
+                        << ") could not be successfully converted"
+                        << std::endl;
+                    return false;
+                }
+                if (option == "--io-depth") {
+                    settings.ioQueueDepth = std::stoul(arg);
+                } else if (option == "--shards") {
+                    settings.shards = std::stoul(arg);
+                } else {
+                    settings.ioBufferSize = std::stoul(arg) * 1024;
+                }
+                ++i;
+            }
         } else if (cmdLineArgs[i] == "--encrypt") {
             settings.cipherMode = CipherMode::Encrypt;
         } else if (cmdLineArgs[i] == "--decrypt") {
@@ -117,6 +278,31 @@ bool processCommandLine(const std::vector<std::string>& cmdLineArgs,
                     settings.cipherType.push_back(CipherType::Playfair);
                 } else if (cmdLineArgs[i + 1] == "vigenere") {
                     settings.cipherType.push_back(CipherType::Vigenere);
+                } else if (cmdLineArgs[i + 1] == "substitution") {
+                    settings.cipherType.push_back(CipherType::Substitution);
+                } else if (cmdLineArgs[i + 1] == "affine") {
+                    settings.cipherType.push_back(CipherType::Affine);
+                } else if (cmdLineArgs[i + 1] == "hill") {
+                    settings.cipherType.push_back(CipherType::Hill);
+                } else if (cmdLineArgs[i + 1] == "columnar") {
+                    settings.cipherType.push_back(
+                        CipherType::ColumnarTransposition);
+                } else if (cmdLineArgs[i + 1] == "railfence") {
+                    settings.cipherType.push_back(CipherType::RailFence);
+                } else if (cmdLineArgs[i + 1] == "enigma") {
+                    settings.cipherType.push_back(CipherType::Enigma);
+                } else if (cmdLineArgs[i + 1] == "bifid") {
+                    settings.cipherType.push_back(CipherType::Bifid);
+                } else if (cmdLineArgs[i + 1] == "foursquare") {
+                    settings.cipherType.push_back(CipherType::FourSquare);
+                } else if (cmdLineArgs[i + 1] == "autokey") {
+                    settings.cipherType.push_back(CipherType::Autokey);
+                } else if (cmdLineArgs[i + 1] == "runningkey") {
+                    settings.cipherType.push_back(CipherType::RunningKey);
+                } else if (cmdLineArgs[i + 1] == "chacha20") {
+                    settings.cipherType.push_back(CipherType::ChaCha20);
+                } else if (cmdLineArgs[i + 1] == "aesctr") {
+                    settings.cipherType.push_back(CipherType::AesCtr);
                 } else {
                     throw UnknownArgument{"unknown cipher "};
                     break;
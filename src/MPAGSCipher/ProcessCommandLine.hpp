@@ -4,6 +4,7 @@
 #include "CipherMode.hpp"
 #include "CipherType.hpp"
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -32,6 +33,38 @@ struct ProgramSettings {
     std::vector<CipherType> cipherType;
     /// Flag indicating the mode in which the cipher should run (i.e. encrypt or decrypt)
     CipherMode cipherMode;
+    /// Phrase to look for in the encrypted input, instead of decrypting it
+    std::string searchPhrase{""};
+    /// Name of the file of keywords to look for in the encrypted input
+    std::string watchlistFile{""};
+    /// Indicates that only part of the input file is to be processed
+    bool rangeRequested{false};
+    /// Offset of the first character of the input file to process
+    std::size_t rangeStart{0};
+    /// Number of characters of the input file to process
+    std::size_t rangeLength{0};
+    /// Indicates that the encrypted text is written to/read from a block-indexed container
+    bool container{false};
+    /// Indicates that the text is compressed before it is put in a container
+    bool compress{false};
+    /// Number of reads/writes of the input/output file to keep in flight
+    std::size_t ioQueueDepth{4};
+    /// Size in bytes of each read/write of the input/output file
+    std::size_t ioBufferSize{1 << 20};
+    /// Indicates that the stats of the reader/cipher/writer pipeline are to be printed
+    bool pipelineStats{false};
+    /// Indicates that each line of the input is encrypted/decrypted on its own
+    bool records{false};
+    /// Which fields (counting from 0) of each CSV record to encrypt/decrypt, empty if not CSV
+    std::vector<std::size_t> csvFields{};
+    /// Character that separates the fields of each CSV record
+    char csvDelimiter{','};
+    /// Indicates that the input file is followed as it grows, as tail -f does
+    bool follow{false};
+    /// Indicates that the input and output are directory trees, every file in which is encrypted/decrypted
+    bool recursive{false};
+    /// The number of worker processes to split the input file between, 0 if it is not split
+    std::size_t shards{0};
 };
 
 /**
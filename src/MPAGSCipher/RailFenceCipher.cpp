@@ -0,0 +1,111 @@
+#include "RailFenceCipher.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Number of characters of the output handed to each thread at a time
+    constexpr std::size_t charsPerTask{1 << 18};
+
+    /**
+     * \brief Count the positions in the text of the form k * cycle + offset
+     *
+     * \param length the length of the text
+     * \param cycle the length of one zig-zag
+     * \param offset the first such position
+     * \return the number of positions
+     */
+    std::size_t countPositions(const std::size_t length,
+                               const std::size_t cycle,
+                               const std::size_t offset)
+    {
+        return (length > offset) ? (length - offset + cycle - 1) / cycle : 0;
+    }
+}    // namespace
+
+RailFenceCipher::RailFenceCipher(const std::size_t key) : nRails_{key}
+{
+    if (nRails_ == 0) {
+        throw InvalidKey{"Key provided to RailFenceCipher must be at least 1"};
+    }
+}
+
+RailFenceCipher::RailFenceCipher(const std::string& key)
+{
+    // The key must be a positive integer
+    if (key.empty() || key.size() > 9 ||
+        !std::all_of(std::begin(key), std::end(key),
+                     [](char c) { return std::isdigit(c); })) {
+        throw InvalidKey{
+            "Key provided to RailFenceCipher must be a positive integer"};
+    }
+
+    nRails_ = std::stoul(key);
+    if (nRails_ == 0) {
+        throw InvalidKey{"Key provided to RailFenceCipher must be at least 1"};
+    }
+}
+
+std::string RailFenceCipher::applyCipher(const std::string& inputText,
+                                         const CipherMode cipherMode) const
+{
+    const std::size_t length{inputText.size()};
+    if (nRails_ == 1 || length == 0) {
+        return inputText;
+    }
+
+    // The rail holding each position repeats with this period,
+    // e.g. 0 1 2 3 2 1 | 0 1 2 3 2 1 | ... for 4 rails
+    const std::size_t cycle{2 * (nRails_ - 1)};
+
+    // Find where each rail starts in the ciphertext - the top and bottom rails
+    // get one position per cycle, the others get two
+    std::vector<std::size_t> railStart(nRails_ + 1, 0);
+    for (std::size_t rail{0}; rail < nRails_; ++rail) {
+        std::size_t count{countPositions(length, cycle, rail)};
+        if (rail != 0 && rail != nRails_ - 1) {
+            count += countPositions(length, cycle, cycle - rail);
+        }
+        railStart[rail + 1] = railStart[rail] + count;
+    }
+
+    // Each position in the ciphertext can be mapped directly onto its
+    // position in the plaintext, so split the ciphertext into chunks
+    // and fill (or read) each chunk independently
+    std::string outputText(length, ' ');
+    const char* in{inputText.data()};
+    char* out{outputText.data()};
+
+    parallelFor(length, charsPerTask, [&](std::size_t begin, std::size_t end) {
+        // Find the rail on which this chunk starts
+        std::size_t rail{static_cast<std::size_t>(
+            std::upper_bound(std::begin(railStart), std::end(railStart),
+                             begin) -
+            std::begin(railStart) - 1)};
+
+        std::size_t i{begin};
+        while (i < end) {
+            const std::size_t railEnd{std::min(railStart[rail + 1], end)};
+            const bool edgeRail{rail == 0 || rail == nRails_ - 1};
+            for (std::size_t j{i - railStart[rail]}; i < railEnd; ++i, ++j) {
+                // The j-th letter on the rail, either one per cycle or,
+                // for the middle rails, alternately on the way down and up
+                const std::size_t position{
+                    edgeRail ? j * cycle + rail
+                             : (j / 2) * cycle +
+                                   ((j % 2 == 0) ? rail : cycle - rail)};
+                if (cipherMode == CipherMode::Encrypt) {
+                    out[i] = in[position];
+                } else {
+                    out[position] = in[i];
+                }
+            }
+            ++rail;
+        }
+    });
+
+    return outputText;
+}
@@ -0,0 +1,64 @@
+#ifndef MPAGSCIPHER_RAILFENCECIPHER_HPP
+#define MPAGSCIPHER_RAILFENCECIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \file RailFenceCipher.hpp
+ * \brief Contains the declaration of the RailFenceCipher class
+ */
+
+/**
+ * \class RailFenceCipher
+ * \brief Encrypt or decrypt text using the rail fence cipher with the given key
+ *
+ * The text is written in a zig-zag down and up across the given number of
+ * rails, and then read off rail by rail.
+ * Since this is a fixed permutation of the positions in the text, the
+ * position of every letter on each rail is calculated directly rather than
+ * by tracing out the zig-zag.
+ */
+class RailFenceCipher : public Cipher {
+  public:
+    /**
+     * \brief Create a new RailFenceCipher with the given number of rails
+     *
+     * \param key the number of rails
+     */
+    explicit RailFenceCipher(const std::size_t key);
+
+    /**
+     * \brief Create a new RailFenceCipher, converting the given string into the key
+     *
+     * \param key the string to convert into the number of rails
+     */
+    explicit RailFenceCipher(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::RailFence; }
+
+  private:
+    /// The number of rails
+    std::size_t nRails_{1};
+};
+
+#endif    // MPAGSCIPHER_RAILFENCECIPHER_HPP
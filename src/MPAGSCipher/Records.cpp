@@ -0,0 +1,78 @@
+#include "Records.hpp"
+#include "TransformChar.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace {
+    /// The transliteration of each character, worked out once
+    const std::array<std::string, 256>& letterTable()
+    {
+        static const std::array<std::string, 256> table{[]() {
+            std::array<std::string, 256> letters;
+            for (std::size_t c{0}; c < letters.size(); ++c) {
+                letters[c] = transformChar(static_cast<char>(c));
+            }
+            return letters;
+        }()};
+        return table;
+    }
+}    // namespace
+
+bool Records::Splitter::add(const char* data, const std::size_t n,
+                            std::string& block)
+{
+    // Find the end of the last record that is complete
+    std::size_t complete{n};
+    while (complete > 0 && data[complete - 1] != '\n') {
+        --complete;
+    }
+    if (complete == 0) {
+        partial_.append(data, n);
+        return false;
+    }
+
+    block += partial_;
+    block.append(data, complete);
+    partial_.assign(data + complete, n - complete);
+    return true;
+}
+
+bool Records::Splitter::finish(std::string& block)
+{
+    if (partial_.empty()) {
+        return false;
+    }
+    block += partial_;
+    partial_.clear();
+    return true;
+}
+
+void Records::apply(const std::string& block,
+                    const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                    const CipherMode cipherMode, std::string& output)
+{
+    const auto& letters = letterTable();
+    std::string record;
+    std::size_t start{0};
+    while (start < block.size()) {
+        std::size_t end{block.find('\n', start)};
+        if (end == std::string::npos) {
+            end = block.size();
+        }
+
+        // Each record is a message of its own, so every cipher starts again
+        record.clear();
+        for (std::size_t i{start}; i < end; ++i) {
+            record += letters[static_cast<unsigned char>(block[i])];
+        }
+        for (const auto& cipher : ciphers) {
+            record = cipher->applyCipher(record, cipherMode);
+        }
+        output += record;
+        output += '\n';
+
+        start = end + 1;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef MPAGSCIPHER_RECORDS_HPP
+#define MPAGSCIPHER_RECORDS_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \file Records.hpp
+ * \brief Contains the declarations of the functions and classes for processing newline-delimited records
+ */
+
+/**
+ * \namespace Records
+ * \brief Namespace to group the functions and classes for encrypting each line of a text on its own
+ *
+ * In record mode each line of the input is a record that is transliterated
+ * and encrypted (or decrypted) as if it were a whole message, so the
+ * ciphers start again from the beginning of their key on every line and
+ * the output has one line for each line of the input. This keeps the line
+ * structure of e.g. a log file, so that the output can still be processed
+ * a line at a time, and any line can be decrypted without the others.
+ */
+namespace Records {
+    /**
+     * \class Splitter
+     * \brief Splits a stream of input into blocks that hold only whole records
+     *
+     * Each piece of input is cut after its last newline, and whatever comes
+     * after that is held back until the rest of the record arrives.
+     */
+    class Splitter {
+      public:
+        /**
+         * \brief Add a piece of input
+         *
+         * \param data the start of the piece
+         * \param n the number of bytes in the piece
+         * \param block has the whole records that are now complete appended
+         * \return true if any records were appended
+         */
+        bool add(const char* data, const std::size_t n, std::string& block);
+
+        /**
+         * \brief Take the last record, once the input has ended
+         *
+         * \param block has the record held back (if any) appended, as a
+         *              record even though it has no newline
+         * \return true if there was a record held back
+         */
+        bool finish(std::string& block);
+
+      private:
+        /// The start of a record whose newline has not been seen yet
+        std::string partial_;
+    };
+
+    /**
+     * \brief Transliterate and encrypt/decrypt each record of a block on its own
+     *
+     * \param block the records, each ending with a newline (the last one
+     *              may have none)
+     * \param ciphers the ciphers, in the order they are to be applied
+     * \param cipherMode whether to encrypt or decrypt
+     * \param output has the result of each record appended, followed by a
+     *               newline
+     */
+    void apply(const std::string& block,
+               const std::vector<std::unique_ptr<Cipher>>& ciphers,
+               const CipherMode cipherMode, std::string& output);
+}    // namespace Records
+
+#endif    // MPAGSCIPHER_RECORDS_HPP
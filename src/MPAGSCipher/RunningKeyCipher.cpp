@@ -0,0 +1,101 @@
+#include "RunningKeyCipher.hpp"
+#include "ShiftKernel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+    /// Number of letters of the book gathered at a time
+    constexpr std::size_t lettersPerBlock{1 << 16};
+
+    /// Type definition for the table that picks the letters out of the book
+    using LetterTable = std::array<char, 256>;
+
+    /**
+     * \brief Make the table that gives the upper-case form of each letter
+     *
+     * \return the table, holding 0 for anything that is not a letter
+     */
+    LetterTable makeLetterTable()
+    {
+        LetterTable table{};
+        for (char c{'A'}; c <= 'Z'; ++c) {
+            table[static_cast<unsigned char>(c)] = c;
+            table[static_cast<unsigned char>(c - 'A' + 'a')] = c;
+        }
+        return table;
+    }
+
+    /// The upper-case form of each letter, 0 for anything else
+    const LetterTable letterTable{makeLetterTable()};
+}    // namespace
+
+RunningKeyCipher::RunningKeyCipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void RunningKeyCipher::setKey(const std::string& key)
+{
+    if (key.empty()) {
+        throw InvalidKey{
+            "Key provided to RunningKeyCipher must be the name of a file"};
+    }
+
+    try {
+        book_ = std::make_unique<MappedFile>(key);
+    } catch (const std::system_error& e) {
+        throw InvalidKey{"Key provided to RunningKeyCipher is not readable: " +
+                         std::string{e.what()}};
+    }
+
+    // Make sure that there is something to use as the key stream
+    const char* begin{book_->data()};
+    const char* end{begin + book_->size()};
+    if (std::none_of(begin, end, [](char c) {
+            return letterTable[static_cast<unsigned char>(c)] != 0;
+        })) {
+        throw InvalidKey{
+            "Key provided to RunningKeyCipher names a file with no letters"};
+    }
+}
+
+std::string RunningKeyCipher::applyCipher(const std::string& inputText,
+                                          const CipherMode cipherMode) const
+{
+    const std::size_t length{inputText.size()};
+    std::string outputText(length, ' ');
+
+    const char* book{book_->data()};
+    const std::size_t bookSize{book_->size()};
+    std::size_t bookPosition{0};
+
+    // Work through the text a block at a time, gathering just enough letters
+    // from the book for each block before shifting it
+    std::vector<char> keyStream(lettersPerBlock);
+    for (std::size_t offset{0}; offset < length; offset += lettersPerBlock) {
+        const std::size_t blockLength{
+            std::min(lettersPerBlock, length - offset)};
+
+        std::size_t nLetters{0};
+        while (nLetters < blockLength) {
+            const char letter{
+                letterTable[static_cast<unsigned char>(book[bookPosition])]};
+            if (letter != 0) {
+                keyStream[nLetters++] = letter;
+            }
+            if (++bookPosition == bookSize) {
+                bookPosition = 0;
+            }
+        }
+
+        ShiftKernel::applyKeyStream(inputText.data() + offset, keyStream.data(),
+                                    outputText.data() + offset, blockLength,
+                                    cipherMode);
+    }
+
+    return outputText;
+}
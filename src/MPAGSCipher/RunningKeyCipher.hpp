@@ -0,0 +1,65 @@
+#ifndef MPAGSCIPHER_RUNNINGKEYCIPHER_HPP
+#define MPAGSCIPHER_RUNNINGKEYCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+#include "MappedFile.hpp"
+
+#include <memory>
+#include <string>
+
+/**
+ * \file RunningKeyCipher.hpp
+ * \brief Contains the declaration of the RunningKeyCipher class
+ */
+
+/**
+ * \class RunningKeyCipher
+ * \brief Encrypt or decrypt text using the running key variant of the Vigenere cipher
+ *
+ * The key is the name of a file (the book) whose letters, taken in order and
+ * ignoring anything else, make up the key stream. If the book has fewer
+ * letters than the text it is started again from the beginning.
+ * The book is mapped into memory and its letters are gathered a block at a
+ * time, in step with the text, so it is never read into memory as a whole.
+ */
+class RunningKeyCipher : public Cipher {
+  public:
+    /**
+     * \brief Create a new RunningKeyCipher with the given key
+     *
+     * \param key the name of the file to use as the book
+     */
+    explicit RunningKeyCipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the name of the file to use as the book
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::RunningKey; }
+
+  private:
+    /// The book, mapped into memory
+    std::unique_ptr<MappedFile> book_;
+};
+
+#endif    // MPAGSCIPHER_RUNNINGKEYCIPHER_HPP
@@ -0,0 +1,359 @@
+#include "ShardedCipher.hpp"
+#include "CipherChain.hpp"
+#include "MappedFile.hpp"
+#include "TransformChar.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    /// The progress of a worker, which is shared with the parent
+    using Counter = std::atomic<std::uint64_t>;
+    static_assert(Counter::is_always_lock_free,
+                  "the progress counters must be usable between processes");
+
+    /// Make the transliteration of each character
+    std::array<std::string, 256> makeLetters()
+    {
+        std::array<std::string, 256> letters;
+        for (std::size_t c{0}; c < letters.size(); ++c) {
+            letters[c] = transformChar(static_cast<char>(c));
+        }
+        return letters;
+    }
+
+    /// Write some text at an offset in a file
+    void writeAt(const int fd, const std::string& text, std::uint64_t offset,
+                 const std::string& fileName)
+    {
+        const char* data{text.data()};
+        std::size_t n{text.size()};
+        while (n > 0) {
+            const ssize_t result{
+                ::pwrite(fd, data, n, static_cast<off_t>(offset))};
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error{errno, std::generic_category(),
+                                        "failed to write '" + fileName + "'"};
+            }
+            data += result;
+            n -= static_cast<std::size_t>(result);
+            offset += static_cast<std::uint64_t>(result);
+        }
+    }
+
+    /**
+     * \class OutputFile
+     * \brief The file the workers write into, which is closed when it goes out of scope
+     */
+    class OutputFile {
+      public:
+        /// Create (or truncate) the file
+        explicit OutputFile(const std::string& fileName)
+        {
+            fd_ = ::open(fileName.c_str(),
+                         O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd_ < 0) {
+                throw std::system_error{errno, std::generic_category(),
+                                        "failed to create '" + fileName + "'"};
+            }
+        }
+
+        /// Close the file
+        ~OutputFile() { ::close(fd_); }
+
+        /// The file cannot be copied
+        OutputFile(const OutputFile& rhs) = delete;
+        /// The file cannot be moved
+        OutputFile(OutputFile&& rhs) = delete;
+        /// The file cannot be copy assigned
+        OutputFile& operator=(const OutputFile& rhs) = delete;
+        /// The file cannot be move assigned
+        OutputFile& operator=(OutputFile&& rhs) = delete;
+
+        /// Get the file descriptor
+        int fd() const { return fd_; }
+
+      private:
+        /// The file descriptor
+        int fd_{-1};
+    };
+
+    /**
+     * \class SharedCounters
+     * \brief Counters in memory that stays shared with the processes forked after it is made
+     */
+    class SharedCounters {
+      public:
+        /// Map the memory and zero the counters
+        explicit SharedCounters(const std::size_t n)
+            : size_{std::max<std::size_t>(n, 1) * sizeof(Counter)}
+        {
+            void* mapping{::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_ANONYMOUS, -1, 0)};
+            if (mapping == MAP_FAILED) {
+                throw std::system_error{errno, std::generic_category(),
+                                        "failed to map shared memory"};
+            }
+            counters_ = static_cast<Counter*>(mapping);
+            for (std::size_t i{0}; i < n; ++i) {
+                new (counters_ + i) Counter{0};
+            }
+        }
+
+        /// Unmap the memory
+        ~SharedCounters() { ::munmap(counters_, size_); }
+
+        /// The counters cannot be copied
+        SharedCounters(const SharedCounters& rhs) = delete;
+        /// The counters cannot be moved
+        SharedCounters(SharedCounters&& rhs) = delete;
+        /// The counters cannot be copy assigned
+        SharedCounters& operator=(const SharedCounters& rhs) = delete;
+        /// The counters cannot be move assigned
+        SharedCounters& operator=(SharedCounters&& rhs) = delete;
+
+        /// Get one of the counters
+        Counter& operator[](const std::size_t i) { return counters_[i]; }
+
+      private:
+        /// The size of the mapping
+        std::size_t size_{0};
+
+        /// The counters
+        Counter* counters_{nullptr};
+    };
+
+    /// Encrypt a shard, a block at a time, in a worker process
+    void runShard(const ShardedCipher::Shard& shard,
+                  const std::string& inputFile, const std::string& outputFile,
+                  const int fd,
+                  const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                  const CipherMode cipherMode,
+                  const std::array<std::string, 256>& letters, Counter& done)
+    {
+        const std::size_t begin{static_cast<std::size_t>(shard.begin)};
+        const std::size_t size{static_cast<std::size_t>(shard.end) - begin};
+        const MappedFile input{inputFile, begin, size};
+        if (input.size() != size) {
+            throw std::runtime_error{"'" + inputFile +
+                                     "' was changed while being read"};
+        }
+
+        const std::size_t blockSize{1 << 20};
+        std::uint64_t offset{shard.offset};
+        std::string text;
+        text.reserve(blockSize);
+        for (std::size_t block{0}; block < size; block += blockSize) {
+            const std::size_t end{std::min(block + blockSize, size)};
+            text.clear();
+            for (std::size_t i{block}; i < end; ++i) {
+                text += letters[static_cast<unsigned char>(input.data()[i])];
+            }
+            for (const auto& cipher : ciphers) {
+                text = CipherChain::applyCipherAt(*cipher, text, cipherMode,
+                                                  offset);
+            }
+            writeAt(fd, text, offset, outputFile);
+            offset += text.size();
+            done.store(end, std::memory_order_relaxed);
+        }
+        if (offset != shard.offset + shard.nLetters) {
+            throw std::runtime_error{"'" + inputFile +
+                                     "' was changed while being read"};
+        }
+    }
+
+    /// Describe how a worker that failed ended
+    std::string describeFailure(const ShardedCipher::Shard& shard,
+                                const int status)
+    {
+        std::string what{"the worker for bytes " + std::to_string(shard.begin) +
+                         " to " + std::to_string(shard.end) + " "};
+        if (WIFSIGNALED(status)) {
+            return what + "was killed by signal " +
+                   std::to_string(WTERMSIG(status));
+        }
+        return what + "failed with exit status " +
+               std::to_string(WEXITSTATUS(status));
+    }
+}    // namespace
+
+std::vector<ShardedCipher::Shard> ShardedCipher::plan(
+    const std::string& inputFile, const std::size_t nShards)
+{
+    const MappedFile input{inputFile};
+    const std::array<std::string, 256> letters{makeLetters()};
+    std::array<std::uint64_t, 256> lengths;
+    for (std::size_t c{0}; c < letters.size(); ++c) {
+        lengths[c] = letters[c].size();
+    }
+
+    // Each shard starts on a page boundary, so that no page of the input is
+    // mapped by more than one worker
+    const std::uint64_t pageSize{
+        static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE))};
+    const std::uint64_t size{input.size()};
+    const std::uint64_t n{std::max<std::uint64_t>(nShards, 1)};
+    const std::uint64_t perShard{(size + n - 1) / n};
+    const std::uint64_t shardSize{
+        std::max((perShard + pageSize - 1) / pageSize * pageSize, pageSize)};
+
+    std::vector<Shard> shards;
+    std::uint64_t offset{0};
+    for (std::uint64_t begin{0}; begin < size; begin += shardSize) {
+        Shard shard;
+        shard.begin = begin;
+        shard.end = std::min(begin + shardSize, size);
+        shard.offset = offset;
+        for (std::uint64_t i{shard.begin}; i < shard.end; ++i) {
+            const char c{input.data()[i]};
+            shard.nLetters += lengths[static_cast<unsigned char>(c)];
+        }
+        offset += shard.nLetters;
+        shards.push_back(shard);
+    }
+    return shards;
+}
+
+ShardedCipher::Stats ShardedCipher::apply(
+    const std::string& inputFile, const std::string& outputFile,
+    const std::vector<std::unique_ptr<Cipher>>& ciphers,
+    const CipherMode cipherMode, const std::size_t nWorkers,
+    const Progress& progress)
+{
+    if (!std::all_of(ciphers.begin(), ciphers.end(), [](const auto& cipher) {
+            return CipherChain::isSeekable(cipher->type());
+        })) {
+        throw std::invalid_argument{
+            "a file can only be sharded with ciphers that can start part way "
+            "into a text"};
+    }
+
+    std::size_t n{nWorkers};
+    if (n == 0) {
+        n = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    const std::vector<Shard> shards{plan(inputFile, n)};
+    const std::array<std::string, 256> letters{makeLetters()};
+
+    Stats stats;
+    stats.workers = shards.size();
+    if (!shards.empty()) {
+        stats.bytesIn = shards.back().end;
+        stats.bytesOut = shards.back().offset + shards.back().nLetters;
+    }
+
+    // Set the output to its final size up front, so that each worker can
+    // write its part in place whenever it is ready
+    OutputFile output{outputFile};
+    if (::ftruncate(output.fd(), static_cast<off_t>(stats.bytesOut + 1)) != 0) {
+        throw std::system_error{errno, std::generic_category(),
+                                "failed to resize '" + outputFile + "'"};
+    }
+    writeAt(output.fd(), "\n", stats.bytesOut, outputFile);
+    ++stats.bytesOut;
+
+    SharedCounters done{shards.size()};
+    std::vector<pid_t> workers(shards.size(), -1);
+    std::size_t nRunning{0};
+    std::string failure;
+    const auto stopWorkers = [&]() {
+        for (const pid_t worker : workers) {
+            if (worker > 0) {
+                ::kill(worker, SIGTERM);
+            }
+        }
+    };
+
+    // Nothing is shared with the workers but the output file and the
+    // counters, and each leaves with _exit so that it does not flush or
+    // destroy anything that belongs to the parent
+    for (std::size_t i{0}; i < shards.size(); ++i) {
+        const pid_t worker{::fork()};
+        if (worker < 0) {
+            const int error{errno};
+            stopWorkers();
+            for (const pid_t started : workers) {
+                if (started > 0) {
+                    ::waitpid(started, nullptr, 0);
+                }
+            }
+            throw std::system_error{error, std::generic_category(),
+                                    "failed to fork a worker"};
+        }
+        if (worker == 0) {
+            int status{0};
+            try {
+                runShard(shards[i], inputFile, outputFile, output.fd(),
+                         ciphers, cipherMode, letters, done[i]);
+            } catch (const std::exception& e) {
+                std::cerr << "[error] " << e.what() << std::endl;
+                status = 1;
+            }
+            ::_exit(status);
+        }
+        workers[i] = worker;
+        ++nRunning;
+    }
+
+    // Wait for the workers, reporting how far they have got as they go, and
+    // stop the rest as soon as one fails
+    while (nRunning > 0) {
+        for (std::size_t i{0}; i < workers.size(); ++i) {
+            if (workers[i] <= 0) {
+                continue;
+            }
+            int status{0};
+            const pid_t result{::waitpid(workers[i], &status, WNOHANG)};
+            if (result == 0 || (result < 0 && errno == EINTR)) {
+                continue;
+            }
+            workers[i] = -1;
+            --nRunning;
+            const bool succeeded{result > 0 && WIFEXITED(status) &&
+                                 WEXITSTATUS(status) == 0};
+            if (!succeeded && failure.empty()) {
+                failure = (result < 0) ? "a worker was lost"
+                                       : describeFailure(shards[i], status);
+                stopWorkers();
+            }
+        }
+        if (progress) {
+            std::uint64_t bytesDone{0};
+            for (std::size_t i{0}; i < shards.size(); ++i) {
+                bytesDone += done[i].load(std::memory_order_relaxed);
+            }
+            progress(bytesDone, stats.bytesIn);
+        }
+        if (nRunning > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+    }
+
+    if (!failure.empty()) {
+        throw std::runtime_error{failure};
+    }
+    return stats;
+}
@@ -0,0 +1,108 @@
+#ifndef MPAGSCIPHER_SHARDEDCIPHER_HPP
+#define MPAGSCIPHER_SHARDEDCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \file ShardedCipher.hpp
+ * \brief Contains the declarations of the functions for encrypting a huge file with several processes
+ */
+
+/**
+ * \namespace ShardedCipher
+ * \brief Namespace to group the functions for encrypting one huge file with a process per shard
+ *
+ * The input file is split into shards, disjoint byte ranges that each start
+ * on a page boundary, and a worker process is forked for each. Before
+ * forking, the parent counts the letters in each shard, which gives where
+ * its text starts in the output, and so the phase of each cipher's key
+ * there. It then sets the output file to its final size, so that each
+ * worker can map just its own shard of the input and write its text
+ * straight into place with pwrite, without anything being passed between
+ * the processes but how far each has got.
+ *
+ * Each worker has memory of its own, so one that runs out of it (or
+ * crashes) cannot bring down the others - the parent notices, stops the
+ * rest, and reports which shard failed.
+ */
+namespace ShardedCipher {
+    /**
+     * \struct Shard
+     * \brief The part of the input that one worker encrypts
+     */
+    struct Shard {
+        /// The offset of the first byte of the shard in the input
+        std::uint64_t begin{0};
+        /// The offset one past the last byte of the shard in the input
+        std::uint64_t end{0};
+        /// The offset of the first letter of the shard in the output
+        std::uint64_t offset{0};
+        /// The number of letters the shard becomes
+        std::uint64_t nLetters{0};
+    };
+
+    /**
+     * \struct Stats
+     * \brief What was done to a file
+     */
+    struct Stats {
+        /// The number of worker processes
+        std::size_t workers{0};
+        /// The number of bytes read
+        std::uint64_t bytesIn{0};
+        /// The number of bytes written
+        std::uint64_t bytesOut{0};
+    };
+
+    /// Type definition for a function told how many bytes of how many have been done
+    using Progress = std::function<void(std::uint64_t, std::uint64_t)>;
+
+    /**
+     * \brief Split a file into shards and find where each starts in the output
+     *
+     * \param inputFile the name of the file
+     * \param nShards the most shards to split it into - a small file is split
+     *                into fewer, so that each shard is at least a page
+     * \return the shards, in order, with none for an empty file
+     * \throw std::system_error if the file cannot be read
+     */
+    std::vector<Shard> plan(const std::string& inputFile,
+                            const std::size_t nShards);
+
+    /**
+     * \brief Encrypt/decrypt a file with a worker process per shard
+     *
+     * The output is the same as that of encrypting the whole file at once:
+     * the transliterated text followed by a newline.
+     *
+     * \param inputFile the name of the file to read
+     * \param outputFile the name of the file to write, which must be a file
+     *                   that can be resized and written at any offset
+     * \param ciphers the ciphers, in the order they are to be applied, which
+     *                must all be able to start part way into a text
+     * \param cipherMode whether to encrypt or decrypt
+     * \param nWorkers the most worker processes to fork, 0 means one per
+     *                 hardware thread
+     * \param progress if set, called now and then while the workers run
+     * \return what was done
+     * \throw std::invalid_argument if a cipher cannot start part way into a
+     *        text
+     * \throw std::system_error if a file cannot be read or written, or a
+     *        worker cannot be forked
+     * \throw std::runtime_error if a worker fails
+     */
+    Stats apply(const std::string& inputFile, const std::string& outputFile,
+                const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                const CipherMode cipherMode, const std::size_t nWorkers = 0,
+                const Progress& progress = {});
+}    // namespace ShardedCipher
+
+#endif    // MPAGSCIPHER_SHARDEDCIPHER_HPP
@@ -0,0 +1,109 @@
+#include "ShiftKernel.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define MPAGSCIPHER_SHIFTKERNEL_AVX2
+#endif
+
+namespace {
+    /**
+     * \brief Shift a text by a key stream, one character at a time
+     *
+     * \param text the text to shift
+     * \param key the key stream
+     * \param out the output buffer
+     * \param n the number of characters to process
+     * \param cipherMode whether to shift forward (encrypt) or back (decrypt)
+     */
+    void applyKeyStreamScalar(const char* text, const char* key, char* out,
+                              const std::size_t n, const CipherMode cipherMode)
+    {
+        for (std::size_t i{0}; i < n; ++i) {
+            const unsigned int letter{
+                static_cast<unsigned char>(text[i] - 'A')};
+            if (letter >= 26) {
+                out[i] = text[i];
+                continue;
+            }
+            const unsigned int shift{static_cast<unsigned char>(key[i] - 'A')};
+            unsigned int shifted{(cipherMode == CipherMode::Encrypt)
+                                     ? letter + shift
+                                     : letter + 26 - shift};
+            if (shifted >= 26) {
+                shifted -= 26;
+            }
+            out[i] = static_cast<char>('A' + shifted);
+        }
+    }
+
+#ifdef MPAGSCIPHER_SHIFTKERNEL_AVX2
+    /**
+     * \brief Shift a text by a key stream, 32 characters at a time
+     *
+     * Both streams are turned into letter indices 0-25 and added (or, for
+     * decryption, the key is subtracted from 26 first and then added), after
+     * which 26 is taken off wherever the sum has reached 26 - this avoids any
+     * division and keeps every intermediate value within a byte.
+     *
+     * \param text the text to shift
+     * \param key the key stream
+     * \param out the output buffer
+     * \param n the number of characters to process
+     * \param cipherMode whether to shift forward (encrypt) or back (decrypt)
+     */
+    __attribute__((target("avx2"))) void applyKeyStreamAVX2(
+        const char* text, const char* key, char* out, const std::size_t n,
+        const CipherMode cipherMode)
+    {
+        const __m256i letterA{_mm256_set1_epi8('A')};
+        const __m256i maxLetter{_mm256_set1_epi8(25)};
+        const __m256i twentySix{_mm256_set1_epi8(26)};
+        const bool encrypt{cipherMode == CipherMode::Encrypt};
+
+        std::size_t i{0};
+        for (; i + 32 <= n; i += 32) {
+            const __m256i c{
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i))};
+            const __m256i k{
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + i))};
+
+            // Letter index, wrapping around for anything below 'A'
+            const __m256i letter{_mm256_sub_epi8(c, letterA)};
+            const __m256i isLetter{
+                _mm256_cmpeq_epi8(_mm256_min_epu8(letter, maxLetter), letter)};
+
+            __m256i shift{_mm256_sub_epi8(k, letterA)};
+            if (!encrypt) {
+                shift = _mm256_sub_epi8(twentySix, shift);
+            }
+            __m256i shifted{_mm256_add_epi8(letter, shift)};
+            const __m256i inRange{_mm256_cmpeq_epi8(
+                _mm256_min_epu8(shifted, maxLetter), shifted)};
+            shifted = _mm256_sub_epi8(
+                shifted, _mm256_andnot_si256(inRange, twentySix));
+
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(out + i),
+                _mm256_blendv_epi8(c, _mm256_add_epi8(shifted, letterA),
+                                   isLetter));
+        }
+
+        // Deal with whatever is left over
+        applyKeyStreamScalar(text + i, key + i, out + i, n - i, cipherMode);
+    }
+#endif
+}    // namespace
+
+void ShiftKernel::applyKeyStream(const char* text, const char* key, char* out,
+                                 const std::size_t n,
+                                 const CipherMode cipherMode)
+{
+#ifdef MPAGSCIPHER_SHIFTKERNEL_AVX2
+    static const bool haveAVX2{__builtin_cpu_supports("avx2") != 0};
+    if (haveAVX2) {
+        applyKeyStreamAVX2(text, key, out, n, cipherMode);
+        return;
+    }
+#endif
+    applyKeyStreamScalar(text, key, out, n, cipherMode);
+}
@@ -0,0 +1,40 @@
+#ifndef MPAGSCIPHER_SHIFTKERNEL_HPP
+#define MPAGSCIPHER_SHIFTKERNEL_HPP
+
+#include "CipherMode.hpp"
+
+#include <cstddef>
+
+/**
+ * \file ShiftKernel.hpp
+ * \brief Contains the declaration of the kernel that shifts a text by a key stream
+ */
+
+/**
+ * \namespace ShiftKernel
+ * \brief Namespace to hold the kernel shared by the Vigenere family of ciphers
+ */
+namespace ShiftKernel {
+    /**
+     * \brief Shift each letter of a text by the corresponding letter of a key stream
+     *
+     * Letter i of the text is moved forward (encryption) or back (decryption)
+     * through the alphabet by the position of letter i of the key stream,
+     * modulo 26, so that e.g. 'H' encrypted with 'C' gives 'J'.
+     * Anything in the text that is not an upper-case letter is copied as-is.
+     * The key stream must consist of upper-case letters only.
+     * On x86-64 processors that support it, 32 letters are processed at once
+     * using AVX2.
+     *
+     * \param text the text to shift
+     * \param key the key stream, at least n letters long
+     * \param out the output buffer (may be the same as the text, but must
+     *            not otherwise overlap either input)
+     * \param n the number of characters to process
+     * \param cipherMode whether to shift forward (encrypt) or back (decrypt)
+     */
+    void applyKeyStream(const char* text, const char* key, char* out,
+                        const std::size_t n, const CipherMode cipherMode);
+}    // namespace ShiftKernel
+
+#endif    // MPAGSCIPHER_SHIFTKERNEL_HPP
@@ -0,0 +1,282 @@
+#ifndef MPAGSCIPHER_SPSCRING_HPP
+#define MPAGSCIPHER_SPSCRING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * \file SpscRing.hpp
+ * \brief Contains the declaration of the SpscRing class template and the RingStats structure
+ */
+
+/**
+ * \struct RingStats
+ * \brief Counts of how often the two ends of a ring had to wait, and how full it was
+ */
+struct RingStats {
+    /// The number of slots in the ring
+    std::size_t capacity{0};
+    /// The number of values pushed
+    std::uint64_t pushes{0};
+    /// The number of pushes that found the ring full and had to wait
+    std::uint64_t pushStalls{0};
+    /// The number of pops that found the ring empty and had to wait
+    std::uint64_t popStalls{0};
+    /// The sum of the number of values in the ring just after each push
+    std::uint64_t occupancySum{0};
+    /// The largest number of values that were in the ring at once
+    std::size_t maxOccupancy{0};
+
+    /**
+     * \brief Get the average number of values in the ring just after a push
+     *
+     * \return the mean occupancy, or 0 if nothing has been pushed
+     */
+    double meanOccupancy() const
+    {
+        return pushes == 0 ? 0.0
+                           : static_cast<double>(occupancySum) /
+                                 static_cast<double>(pushes);
+    }
+
+    /**
+     * \brief Add the counts of another ring to these
+     *
+     * \param rhs the stats of the other ring
+     * \return these stats
+     */
+    RingStats& operator+=(const RingStats& rhs)
+    {
+        capacity += rhs.capacity;
+        pushes += rhs.pushes;
+        pushStalls += rhs.pushStalls;
+        popStalls += rhs.popStalls;
+        occupancySum += rhs.occupancySum;
+        maxOccupancy = std::max(maxOccupancy, rhs.maxOccupancy);
+        return *this;
+    }
+};
+
+/**
+ * \class SpscRing
+ * \brief A bounded lock-free queue between exactly one producer thread and one consumer thread
+ *
+ * The producer only writes the tail and the consumer only writes the head,
+ * so each index is a single atomic with no locking, and they are kept on
+ * separate cache lines so that the two threads do not fight over them.
+ * Each end also keeps its own copy of the other end's index and only
+ * reloads it when the ring looks full (or empty), which keeps most pushes
+ * and pops to a single atomic store.
+ *
+ * A ring that is closed accepts no more values, and once it is empty
+ * pop() returns false, which is how the producer signals the end of its
+ * values (or either end gives up after an error).
+ *
+ * \tparam T the type of value in the ring, which should be cheap to copy
+ */
+template <typename T>
+class SpscRing {
+  public:
+    /**
+     * \brief Create an empty ring
+     *
+     * \param capacity the number of values the ring can hold, which is
+     *                 rounded up to a power of two
+     * \throw std::invalid_argument if the capacity is zero
+     */
+    explicit SpscRing(const std::size_t capacity)
+    {
+        if (capacity == 0) {
+            throw std::invalid_argument{"SpscRing capacity must be nonzero"};
+        }
+        std::size_t size{1};
+        while (size < capacity) {
+            size *= 2;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    /**
+     * \brief Get the number of values the ring can hold
+     *
+     * \return the capacity
+     */
+    std::size_t capacity() const { return slots_.size(); }
+
+    /**
+     * \brief Add a value if there is room, without waiting (producer only)
+     *
+     * \param value the value to add
+     * \return true if the value was added
+     */
+    bool tryPush(const T& value)
+    {
+        const std::size_t tail{tail_.load(std::memory_order_relaxed)};
+        if (tail - cachedHead_ == slots_.size()) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == slots_.size()) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+
+        // Only the producer writes these, so plain read-modify-writes will do
+        const std::size_t occupancy{tail + 1 - cachedHead_};
+        pushes_.store(pushes_.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+        occupancySum_.store(
+            occupancySum_.load(std::memory_order_relaxed) + occupancy,
+            std::memory_order_relaxed);
+        if (occupancy > maxOccupancy_.load(std::memory_order_relaxed)) {
+            maxOccupancy_.store(occupancy, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * \brief Take the oldest value if there is one, without waiting (consumer only)
+     *
+     * \param value set to the value taken
+     * \return true if a value was taken
+     */
+    bool tryPop(T& value)
+    {
+        const std::size_t head{head_.load(std::memory_order_relaxed)};
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) {
+                return false;
+            }
+        }
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * \brief Add a value, waiting for room if the ring is full (producer only)
+     *
+     * \param value the value to add
+     * \return true if the value was added, false if the ring was closed
+     */
+    bool push(const T& value)
+    {
+        if (tryPush(value)) {
+            return true;
+        }
+        pushStalls_.fetch_add(1, std::memory_order_relaxed);
+        for (std::size_t spins{0}; !tryPush(value); ++spins) {
+            if (closed_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            backOff(spins);
+        }
+        return true;
+    }
+
+    /**
+     * \brief Take the oldest value, waiting for one if the ring is empty (consumer only)
+     *
+     * \param value set to the value taken
+     * \return true if a value was taken, false if the ring is closed and empty
+     */
+    bool pop(T& value)
+    {
+        if (tryPop(value)) {
+            return true;
+        }
+        popStalls_.fetch_add(1, std::memory_order_relaxed);
+        for (std::size_t spins{0}; !tryPop(value); ++spins) {
+            if (closed_.load(std::memory_order_acquire)) {
+                // Anything pushed before the ring was closed is still taken
+                return tryPop(value);
+            }
+            backOff(spins);
+        }
+        return true;
+    }
+
+    /// Stop any more values from being added, and wake up both ends
+    void close() { closed_.store(true, std::memory_order_release); }
+
+    /**
+     * \brief Get the counts of stalls and occupancy so far
+     *
+     * This can be called from any thread, though the counts may be slightly
+     * out of step with each other while the ring is in use.
+     *
+     * \return the stats
+     */
+    RingStats stats() const
+    {
+        RingStats stats;
+        stats.capacity = slots_.size();
+        stats.pushes = pushes_.load(std::memory_order_relaxed);
+        stats.pushStalls = pushStalls_.load(std::memory_order_relaxed);
+        stats.popStalls = popStalls_.load(std::memory_order_relaxed);
+        stats.occupancySum = occupancySum_.load(std::memory_order_relaxed);
+        stats.maxOccupancy = maxOccupancy_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+  private:
+    /// Wait a little before trying again, spinning at first, then giving up
+    /// the processor, then sleeping so a long wait (e.g. on a disk) is cheap
+    static void backOff(const std::size_t spins)
+    {
+        if (spins < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds{50});
+        }
+    }
+
+    /// The size of a cache line, to keep the two ends apart
+    static constexpr std::size_t cacheLine{64};
+
+    /// The slots, whose number is a power of two
+    std::vector<T> slots_;
+
+    /// The mask that turns an index into a slot
+    std::size_t mask_{0};
+
+    /// The index of the next value to pop, written by the consumer
+    alignas(cacheLine) std::atomic<std::size_t> head_{0};
+
+    /// The consumer's copy of the tail
+    std::size_t cachedTail_{0};
+
+    /// The number of pops that had to wait
+    std::atomic<std::uint64_t> popStalls_{0};
+
+    /// The index of the next value to push, written by the producer
+    alignas(cacheLine) std::atomic<std::size_t> tail_{0};
+
+    /// The producer's copy of the head
+    std::size_t cachedHead_{0};
+
+    /// The number of values pushed
+    std::atomic<std::uint64_t> pushes_{0};
+
+    /// The number of pushes that had to wait
+    std::atomic<std::uint64_t> pushStalls_{0};
+
+    /// The sum of the occupancy just after each push
+    std::atomic<std::uint64_t> occupancySum_{0};
+
+    /// The largest occupancy seen by the producer
+    std::atomic<std::size_t> maxOccupancy_{0};
+
+    /// Whether the ring has been closed
+    alignas(cacheLine) std::atomic<bool> closed_{false};
+};
+
+#endif    // MPAGSCIPHER_SPSCRING_HPP
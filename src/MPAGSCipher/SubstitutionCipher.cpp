@@ -0,0 +1,175 @@
+#include "SubstitutionCipher.hpp"
+#include "Alphabet.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define MPAGSCIPHER_SUBSTITUTION_AVX2
+#endif
+
+namespace {
+    /// Type definition for the byte lookup tables
+    using LookupTable = std::array<char, 256>;
+
+    /**
+     * \brief Apply a byte lookup table to a buffer, one character at a time
+     *
+     * \param table the lookup table
+     * \param in the input buffer
+     * \param out the output buffer (may be the same as the input)
+     * \param n the number of characters to process
+     */
+    void applyTableScalar(const LookupTable& table, const char* in, char* out,
+                          const std::size_t n)
+    {
+        for (std::size_t i{0}; i < n; ++i) {
+            out[i] = table[static_cast<unsigned char>(in[i])];
+        }
+    }
+
+#ifdef MPAGSCIPHER_SUBSTITUTION_AVX2
+    /**
+     * \brief Apply a byte lookup table to a buffer, 32 characters at a time
+     *
+     * Only the 26 upper-case letters can be changed by a substitution
+     * table, so their images fit into two 16-byte shuffle tables
+     * (letters A-P and Q-Z) that are looked up with vpshufb using the letter
+     * index as the shuffle control. All other bytes are passed through as-is,
+     * exactly as they are by the scalar table.
+     *
+     * \param table the lookup table
+     * \param in the input buffer
+     * \param out the output buffer (may be the same as the input)
+     * \param n the number of characters to process
+     */
+    __attribute__((target("avx2"))) void applyTableAVX2(
+        const LookupTable& table, const char* in, char* out, const std::size_t n)
+    {
+        alignas(16) char lo[16]{};
+        alignas(16) char hi[16]{};
+        for (std::size_t i{0}; i < 16; ++i) {
+            lo[i] = table[static_cast<unsigned char>('A' + i)];
+        }
+        for (std::size_t i{0}; i < 10; ++i) {
+            hi[i] = table[static_cast<unsigned char>('Q' + i)];
+        }
+        const __m256i tableLo{_mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(lo)))};
+        const __m256i tableHi{_mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(hi)))};
+        const __m256i letterA{_mm256_set1_epi8('A')};
+        const __m256i sixteen{_mm256_set1_epi8(16)};
+        const __m256i maxLetter{_mm256_set1_epi8(25)};
+        const __m256i maxLo{_mm256_set1_epi8(15)};
+
+        std::size_t i{0};
+        for (; i + 32 <= n; i += 32) {
+            const __m256i c{
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i))};
+            // Letter index, wrapping around for anything below 'A'
+            const __m256i idx{_mm256_sub_epi8(c, letterA)};
+            const __m256i isLetter{
+                _mm256_cmpeq_epi8(_mm256_min_epu8(idx, maxLetter), idx)};
+            const __m256i isLo{
+                _mm256_cmpeq_epi8(_mm256_min_epu8(idx, maxLo), idx)};
+            const __m256i fromLo{_mm256_shuffle_epi8(tableLo, idx)};
+            const __m256i fromHi{
+                _mm256_shuffle_epi8(tableHi, _mm256_sub_epi8(idx, sixteen))};
+            const __m256i mapped{_mm256_blendv_epi8(fromHi, fromLo, isLo)};
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_blendv_epi8(c, mapped, isLetter));
+        }
+
+        // Deal with whatever is left over
+        applyTableScalar(table, in + i, out + i, n - i);
+    }
+#endif
+
+    /**
+     * \brief Apply a byte lookup table to a buffer using the fastest available kernel
+     *
+     * \param table the lookup table
+     * \param in the input buffer
+     * \param out the output buffer (may be the same as the input)
+     * \param n the number of characters to process
+     */
+    void applyTable(const LookupTable& table, const char* in, char* out,
+                    const std::size_t n)
+    {
+#ifdef MPAGSCIPHER_SUBSTITUTION_AVX2
+        static const bool haveAVX2{__builtin_cpu_supports("avx2") != 0};
+        if (haveAVX2) {
+            applyTableAVX2(table, in, out, n);
+            return;
+        }
+#endif
+        applyTableScalar(table, in, out, n);
+    }
+}    // namespace
+
+SubstitutionCipher::SubstitutionCipher(const std::string& key)
+{
+    this->setKey(key);
+}
+
+void SubstitutionCipher::setKey(const std::string& key)
+{
+    // Store the original key
+    key_ = key;
+
+    // Append the alphabet to the key
+    key_ += Alphabet::alphabet;
+
+    // Make sure the key is upper case
+    std::transform(std::begin(key_), std::end(key_), std::begin(key_),
+                   ::toupper);
+
+    // Remove non-alphabet characters
+    key_.erase(std::remove_if(std::begin(key_), std::end(key_),
+                              [](char c) { return !std::isalpha(c); }),
+               std::end(key_));
+
+    // Remove duplicated letters, leaving a permutation of the alphabet
+    std::string lettersFound{""};
+    auto detectDuplicates = [&](char c) {
+        if (lettersFound.find(c) == std::string::npos) {
+            lettersFound += c;
+            return false;
+        } else {
+            return true;
+        }
+    };
+    key_.erase(
+        std::remove_if(std::begin(key_), std::end(key_), detectDuplicates),
+        std::end(key_));
+
+    // Fill the lookup tables - anything that isn't an upper-case letter
+    // is mapped onto itself
+    for (std::size_t i{0}; i < encryptTable_.size(); ++i) {
+        encryptTable_[i] = static_cast<char>(i);
+        decryptTable_[i] = static_cast<char>(i);
+    }
+    for (std::size_t i{0}; i < Alphabet::size; ++i) {
+        const char plainChar{Alphabet::alphabet[i]};
+        const char cipherChar{key_[i]};
+        encryptTable_[static_cast<unsigned char>(plainChar)] = cipherChar;
+        decryptTable_[static_cast<unsigned char>(cipherChar)] = plainChar;
+    }
+}
+
+std::string SubstitutionCipher::applyCipher(const std::string& inputText,
+                                            const CipherMode cipherMode) const
+{
+    // Create the output string, initially a copy of the input text,
+    // and apply the relevant lookup table to it in place
+    std::string outputText{inputText};
+
+    const LookupTable& table{
+        (cipherMode == CipherMode::Encrypt) ? encryptTable_ : decryptTable_};
+    applyTable(table, outputText.data(), outputText.data(), outputText.size());
+
+    return outputText;
+}
@@ -0,0 +1,84 @@
+#ifndef MPAGSCIPHER_SUBSTITUTIONCIPHER_HPP
+#define MPAGSCIPHER_SUBSTITUTIONCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "CipherType.hpp"
+
+#include <array>
+#include <string>
+
+/**
+ * \file SubstitutionCipher.hpp
+ * \brief Contains the declaration of the SubstitutionCipher class
+ */
+
+/**
+ * \class SubstitutionCipher
+ * \brief Encrypt or decrypt text using a general monoalphabetic substitution cipher
+ *
+ * The key is turned into a mixed cipher alphabet: the (upper-cased) letters of
+ * the key are taken in order, duplicates are dropped and the remaining letters
+ * of the alphabet are appended.
+ * A full 26-letter permutation is therefore used as-is, e.g. the Atbash cipher
+ * is given by the key "ZYXWVUTSRQPONMLKJIHGFEDCBA".
+ *
+ * Both directions of the cipher are held as 256-entry byte lookup tables so
+ * that applying the cipher costs a single table load per character,
+ * whatever the permutation.
+ */
+class SubstitutionCipher : public Cipher {
+  public:
+    /**
+     * \brief Create a new SubstitutionCipher with the given key
+     *
+     * \param key the key to use in the cipher
+     */
+    explicit SubstitutionCipher(const std::string& key);
+
+    /**
+     * \brief Set the key to be used for the encryption/decryption
+     *
+     * \param key the key to use in the cipher
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * \brief Apply the cipher to the provided text
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipher(const std::string& inputText,
+                            const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Determine the type of cipher algorithm
+     *
+     * \return the cipher type
+     */
+    CipherType type() const override { return CipherType::Substitution; }
+
+    /**
+     * \brief Get the cipher alphabet, i.e. the image of each plaintext letter
+     *
+     * \return the 26-letter cipher alphabet
+     */
+    const std::string& cipherAlphabet() const { return key_; }
+
+  private:
+    /// The cipher alphabet (a permutation of the 26 letters)
+    std::string key_{""};
+
+    /// Type definition for the byte lookup tables
+    using LookupTable = std::array<char, 256>;
+
+    /// Lookup table for encryption, indexed by the input byte
+    LookupTable encryptTable_{};
+
+    /// Lookup table for decryption, indexed by the input byte
+    LookupTable decryptTable_{};
+};
+
+#endif    // MPAGSCIPHER_SUBSTITUTIONCIPHER_HPP
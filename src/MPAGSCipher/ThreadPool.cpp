@@ -0,0 +1,165 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+ThreadPool::ThreadPool(const std::size_t nThreads)
+{
+    std::size_t nWorkers{nThreads};
+    if (nWorkers == 0) {
+        nWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    workers_.reserve(nWorkers);
+    for (std::size_t i{0}; i < nWorkers; ++i) {
+        workers_.emplace_back([this]() { this->workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+    }
+    wakeUp_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        tasks_.push_back(std::move(task));
+    }
+    wakeUp_.notify_one();
+}
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::workerLoop()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            wakeUp_.wait(lock,
+                         [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                // Only get here when stopping and there is nothing left to do
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+namespace {
+    /**
+     * \struct ParallelForJob
+     * \brief The state shared between the threads taking part in a parallelFor
+     */
+    struct ParallelForJob {
+        /// The size of the range
+        std::size_t n{0};
+        /// The size of each chunk
+        std::size_t grainSize{1};
+        /// The total number of chunks
+        std::size_t nChunks{0};
+        /// The function to call for each chunk
+        const std::function<void(std::size_t, std::size_t)>* body{nullptr};
+        /// The index of the next chunk to be handed out
+        std::atomic<std::size_t> nextChunk{0};
+        /// The number of chunks that have been completed
+        std::size_t nDone{0};
+        /// The first exception thrown by the body, if any
+        std::exception_ptr error;
+        /// Mutex guarding the completion count and the exception
+        std::mutex mutex;
+        /// Used to wake up the calling thread once all chunks are complete
+        std::condition_variable finished;
+
+        /// Process chunks until there are none left to hand out
+        void run()
+        {
+            while (true) {
+                const std::size_t chunk{nextChunk.fetch_add(1)};
+                if (chunk >= nChunks) {
+                    return;
+                }
+                const std::size_t begin{chunk * grainSize};
+                const std::size_t end{std::min(begin + grainSize, n)};
+
+                std::exception_ptr chunkError;
+                try {
+                    (*body)(begin, end);
+                } catch (...) {
+                    chunkError = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock{mutex};
+                if (chunkError && !error) {
+                    error = chunkError;
+                }
+                if (++nDone == nChunks) {
+                    finished.notify_all();
+                }
+            }
+        }
+    };
+}    // namespace
+
+void parallelFor(const std::size_t n, const std::size_t grainSize,
+                 const std::function<void(std::size_t, std::size_t)>& body,
+                 const std::size_t maxThreads)
+{
+    if (n == 0) {
+        return;
+    }
+
+    const std::size_t grain{std::max<std::size_t>(grainSize, 1)};
+    const std::size_t nChunks{(n + grain - 1) / grain};
+
+    // Don't bother with the pool if there is only one chunk to process
+    // or if we've been asked to use a single thread
+    if (nChunks == 1 || maxThreads == 1) {
+        body(0, n);
+        return;
+    }
+
+    auto job = std::make_shared<ParallelForJob>();
+    job->n = n;
+    job->grainSize = grain;
+    job->nChunks = nChunks;
+    job->body = &body;
+
+    // Start helpers on the pool - any that only get to run after all the
+    // chunks have been handed out simply return without touching the body
+    ThreadPool& pool{ThreadPool::instance()};
+    std::size_t nHelpers{std::min(pool.size(), nChunks - 1)};
+    if (maxThreads != 0) {
+        nHelpers = std::min(nHelpers, maxThreads - 1);
+    }
+    for (std::size_t i{0}; i < nHelpers; ++i) {
+        pool.submit([job]() { job->run(); });
+    }
+
+    // Take part ourselves, then wait for the chunks being run by the helpers
+    job->run();
+    std::unique_lock<std::mutex> lock{job->mutex};
+    job->finished.wait(lock, [&job]() { return job->nDone == job->nChunks; });
+
+    if (job->error) {
+        std::rethrow_exception(job->error);
+    }
+}
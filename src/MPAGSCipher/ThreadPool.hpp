@@ -0,0 +1,101 @@
+#ifndef MPAGSCIPHER_THREADPOOL_HPP
+#define MPAGSCIPHER_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file ThreadPool.hpp
+ * \brief Contains the declaration of the ThreadPool class and the parallelFor function
+ */
+
+/**
+ * \class ThreadPool
+ * \brief A fixed set of worker threads that run tasks taken from a shared queue
+ */
+class ThreadPool {
+  public:
+    /**
+     * \brief Create a new ThreadPool
+     *
+     * \param nThreads the number of worker threads, 0 means one per hardware thread
+     */
+    explicit ThreadPool(const std::size_t nThreads = 0);
+
+    /// Finish any queued tasks, then stop and join the worker threads
+    ~ThreadPool();
+
+    /// The pool cannot be copied
+    ThreadPool(const ThreadPool& rhs) = delete;
+    /// The pool cannot be moved
+    ThreadPool(ThreadPool&& rhs) = delete;
+    /// The pool cannot be copy assigned
+    ThreadPool& operator=(const ThreadPool& rhs) = delete;
+    /// The pool cannot be move assigned
+    ThreadPool& operator=(ThreadPool&& rhs) = delete;
+
+    /**
+     * \brief Queue a task to be run by one of the worker threads
+     *
+     * \param task the task to run
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * \brief Get the number of worker threads
+     *
+     * \return the number of worker threads
+     */
+    std::size_t size() const { return workers_.size(); }
+
+    /**
+     * \brief Get the pool shared by the whole program
+     *
+     * \return the shared pool, created on first use
+     */
+    static ThreadPool& instance();
+
+  private:
+    /// The worker threads
+    std::vector<std::thread> workers_;
+
+    /// The queue of tasks waiting to be run
+    std::deque<std::function<void()>> tasks_;
+
+    /// Mutex guarding the task queue and the stop flag
+    std::mutex mutex_;
+
+    /// Used to wake up workers when a task is queued or the pool is stopped
+    std::condition_variable wakeUp_;
+
+    /// Whether the workers have been told to stop
+    bool stopping_{false};
+
+    /// The loop run by each worker thread
+    void workerLoop();
+};
+
+/**
+ * \brief Run a function over the range [0, n) in parallel, split into chunks
+ *
+ * Chunks are handed out dynamically to the calling thread and to helpers
+ * running on the shared ThreadPool, and the call returns once every chunk
+ * has been processed. The calling thread always takes part, so it is safe
+ * to call parallelFor from inside a task that is itself running on the pool.
+ * If the body throws, the first exception is rethrown in the calling thread.
+ *
+ * \param n the size of the range
+ * \param grainSize the size of each chunk (the last one may be smaller)
+ * \param body the function to call for each chunk, with its begin and end
+ * \param maxThreads the maximum number of threads to use, 0 means no limit
+ */
+void parallelFor(const std::size_t n, const std::size_t grainSize,
+                 const std::function<void(std::size_t, std::size_t)>& body,
+                 const std::size_t maxThreads = 0);
+
+#endif    // MPAGSCIPHER_THREADPOOL_HPP
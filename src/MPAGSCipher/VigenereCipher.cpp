@@ -1,81 +1,82 @@
 #include "VigenereCipher.hpp"
-#include "Alphabet.hpp"
+#include "ShiftKernel.hpp"
+#include "ThreadPool.hpp"
 
 #include <algorithm>
-#include <iostream>
+#include <cctype>
 #include <string>
 
+namespace {
+    /// Approximate number of letters handed to each thread at a time
+    constexpr std::size_t lettersPerChunk{1 << 16};
+}    // namespace
+
 VigenereCipher::VigenereCipher(const std::string& key)
 {
     this->setKey(key);
 }
 
-void VigenereCipher::setKey(const std::string& key)
+std::string VigenereCipher::normaliseKey(const std::string& key)
 {
-    // Store the original key
-    key_ = key;
-
     // Make sure the key is upper case
-    std::transform(std::begin(key_), std::end(key_), std::begin(key_),
+    std::string newKey{key};
+    std::transform(std::begin(newKey), std::end(newKey), std::begin(newKey),
                    ::toupper);
 
     // Remove non-alphabet characters
-    key_.erase(std::remove_if(std::begin(key_), std::end(key_),
-                              [](char c) { return !std::isalpha(c); }),
-               std::end(key_));
+    newKey.erase(std::remove_if(std::begin(newKey), std::end(newKey),
+                                [](char c) { return !std::isalpha(c); }),
+                 std::end(newKey));
 
     // Check that the key is not now empty
-    if (key_.empty()) {
+    if (newKey.empty()) {
         throw InvalidKey{"Key provided to VigenereCipher is empty"};
     }
 
-    // Loop through the key
-    charLookup_.clear();
-    for (const char letter : key_) {
-        // Check if we've already seen this letter before
-        // NB C++20 will allow us to be clearer:
-        // if (charLookup_.contains(letter))
-        if (charLookup_.find(letter) != charLookup_.end()) {
-            continue;
-        }
+    return newKey;
+}
 
-        // Find the position of the letter in the alphabet
-        const std::size_t index{Alphabet::alphabet.find(letter)};
+void VigenereCipher::setKey(const std::string& key)
+{
+    // Store the key in upper-case letters only
+    key_ = VigenereCipher::normaliseKey(key);
 
-        // Construct a Caesar cipher object in-place using the position as the key,
-        // storing it so that it can be retrieved based on the character in the key
-        charLookup_.emplace(std::piecewise_construct, std::make_tuple(letter),
-                            std::make_tuple(index));
+    // Repeat the key to fill a chunk, plus once more so that a chunk can
+    // start from any position in the key
+    nChunkLetters_ =
+        std::max<std::size_t>(1, lettersPerChunk / key_.size()) * key_.size();
+    keyStream_.clear();
+    keyStream_.reserve(nChunkLetters_ + key_.size());
+    while (keyStream_.size() < nChunkLetters_ + key_.size()) {
+        keyStream_ += key_;
     }
 }
 
 std::string VigenereCipher::applyCipher(const std::string& inputText,
                                         const CipherMode cipherMode) const
 {
-    // Store the size of the input text and of the key
-    const std::size_t inputSize{inputText.size()};
-    const std::size_t keySize{key_.size()};
+    return this->applyCipherAt(inputText, cipherMode, 0);
+}
 
-    // Create the output string, reserving space for
-    // as many characters as are in the input text
-    std::string outputText;
-    outputText.reserve(inputSize);
+std::string VigenereCipher::applyCipherAt(const std::string& inputText,
+                                          const CipherMode cipherMode,
+                                          const std::size_t offset) const
+{
+    // Create the output string, the same size as the input text
+    std::string outputText(inputText.size(), ' ');
 
-    // Loop through the text
-    for (std::size_t i{0}; i < inputSize; ++i) {
-        // Determine the corresponding character in the key based on the position
-        // (repeating the key if necessary)
-        const char keyChar{key_[i % keySize]};
+    // Every chunk starts a whole number of key lengths into the text, so
+    // they all start at the same position in the key
+    const char* keyStart{keyStream_.data() + offset % key_.size()};
 
-        // Find the corresponding Caesar cipher
-        const CaesarCipher& cipher{charLookup_.at(keyChar)};
-
-        // Use it to encrypt/decrypt the character of the text
-        // and put the new character into the output
-        const std::string oldChar{inputText[i]};
-        outputText += cipher.applyCipher(oldChar, cipherMode);
-    }
+    // Shift each chunk of the text by the key stream
+    parallelFor(inputText.size(), nChunkLetters_,
+                [&](std::size_t begin, std::size_t end) {
+                    ShiftKernel::applyKeyStream(
+                        inputText.data() + begin, keyStart,
+                        outputText.data() + begin, end - begin, cipherMode);
+                });
 
     // Return the output text
     return outputText;
-}
\ No newline at end of file
+}
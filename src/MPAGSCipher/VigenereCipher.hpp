@@ -1,13 +1,11 @@
 #ifndef MPAGSCIPHER_VIGENERECIPHER_HPP
 #define MPAGSCIPHER_VIGENERECIPHER_HPP
 
-#include "CaesarCipher.hpp"
 #include "Cipher.hpp"
 #include "CipherMode.hpp"
 #include "CipherType.hpp"
 
-#include <map>
-#include <stdexcept>
+#include <cstddef>
 #include <string>
 
 /**
@@ -18,6 +16,10 @@
 /**
  * \class VigenereCipher
  * \brief Encrypt or decrypt text using the Vigenere cipher with the given key
+ *
+ * The key is repeated to form a key stream as long as the text, which is
+ * applied with the same vectorised kernel as the AutokeyCipher and
+ * RunningKeyCipher.
  */
 class VigenereCipher : public Cipher {
   public:
@@ -45,6 +47,22 @@ class VigenereCipher : public Cipher {
     std::string applyCipher(const std::string& inputText,
                             const CipherMode cipherMode) const override;
 
+    /**
+     * \brief Apply the cipher to a piece of text that starts part way into a message
+     *
+     * Each letter only depends on its position modulo the key length, so
+     * the piece can be processed without the text that comes before it.
+     *
+     * \param inputText the text to encrypt or decrypt
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \param offset the number of characters of the message that come before
+     *               the text
+     * \return the result of applying the cipher to the input text
+     */
+    std::string applyCipherAt(const std::string& inputText,
+                              const CipherMode cipherMode,
+                              const std::size_t offset) const;
+
     /**
      * \brief Determine the type of cipher algorithm
      *
@@ -52,12 +70,26 @@ class VigenereCipher : public Cipher {
      */
     CipherType type() const override { return CipherType::Vigenere; }
 
+    /**
+     * \brief Put a key into the form used by the cipher
+     *
+     * \param key the key, which may contain any characters
+     * \return the key as upper-case letters only
+     * \throw InvalidKey if the key contains no letters
+     */
+    static std::string normaliseKey(const std::string& key);
+
   private:
     /// The cipher key
     std::string key_{""};
 
-    /// Lookup table to go from the character to the corresponding Caesar cipher
-    std::map<char, CaesarCipher> charLookup_;
+    /// The number of letters handed to each thread at a time, a whole
+    /// number of key lengths
+    std::size_t nChunkLetters_{0};
+
+    /// The key repeated enough times to cover a whole chunk of the text,
+    /// starting from any position in the key
+    std::string keyStream_{""};
 };
 
 #endif
\ No newline at end of file
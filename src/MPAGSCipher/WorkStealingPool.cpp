@@ -0,0 +1,142 @@
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace {
+    /// The pool whose task the current thread is running, if any
+    thread_local const WorkStealingPool* currentPool{nullptr};
+
+    /// The queue of the current thread in that pool
+    thread_local std::size_t currentQueue{0};
+
+    /// Wait a little before looking for work again
+    void backOff(const std::size_t nIdle)
+    {
+        if (nIdle < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds{50});
+        }
+    }
+}    // namespace
+
+WorkStealingPool::WorkStealingPool(const std::size_t nThreads)
+{
+    std::size_t n{nThreads};
+    if (n == 0) {
+        n = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    queues_.reserve(n);
+    for (std::size_t i{0}; i < n; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+}
+
+void WorkStealingPool::spawn(Task task)
+{
+    // Count the task before it can be taken, so that the count cannot reach
+    // zero while it is waiting to run
+    pending_.fetch_add(1);
+    std::size_t queue{currentQueue};
+    if (currentPool != this) {
+        queue = nextQueue_;
+        nextQueue_ = (nextQueue_ + 1) % queues_.size();
+    }
+    std::lock_guard<std::mutex> lock{queues_[queue]->mutex};
+    queues_[queue]->tasks.push_back(std::move(task));
+}
+
+WorkStealingPool::Stats WorkStealingPool::run()
+{
+    std::vector<std::thread> threads;
+    threads.reserve(queues_.size() - 1);
+    for (std::size_t i{1}; i < queues_.size(); ++i) {
+        threads.emplace_back([this, i]() { this->workerLoop(i); });
+    }
+    this->workerLoop(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Stats stats;
+    stats.threads = queues_.size();
+    for (auto& queue : queues_) {
+        stats.tasks += queue->nRun;
+        stats.steals += queue->nStolen;
+        queue->nRun = 0;
+        queue->nStolen = 0;
+    }
+
+    if (error_) {
+        std::exception_ptr error{error_};
+        error_ = nullptr;
+        failed_ = false;
+        std::rethrow_exception(error);
+    }
+    return stats;
+}
+
+bool WorkStealingPool::take(const std::size_t self, Task& task)
+{
+    Queue& own{*queues_[self]};
+    {
+        std::lock_guard<std::mutex> lock{own.mutex};
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal the oldest task of the next thread along that has any
+    for (std::size_t k{1}; k < queues_.size(); ++k) {
+        Queue& victim{*queues_[(self + k) % queues_.size()]};
+        std::lock_guard<std::mutex> lock{victim.mutex};
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            ++own.nStolen;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(const std::size_t self)
+{
+    currentPool = this;
+    currentQueue = self;
+
+    // A task can only be spawned by another that has not finished, so once
+    // none are pending there is nothing more to come
+    std::size_t nIdle{0};
+    while (pending_.load() > 0) {
+        Task task;
+        if (!this->take(self, task)) {
+            backOff(nIdle++);
+            continue;
+        }
+        nIdle = 0;
+
+        if (!failed_) {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock{errorMutex_};
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+                failed_ = true;
+            }
+            ++queues_[self]->nRun;
+        }
+        pending_.fetch_sub(1);
+    }
+
+    currentPool = nullptr;
+}
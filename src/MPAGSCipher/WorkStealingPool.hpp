@@ -0,0 +1,120 @@
+#ifndef MPAGSCIPHER_WORKSTEALINGPOOL_HPP
+#define MPAGSCIPHER_WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file WorkStealingPool.hpp
+ * \brief Contains the declaration of the WorkStealingPool class
+ */
+
+/**
+ * \class WorkStealingPool
+ * \brief Runs tasks that spawn further tasks on threads that steal work from each other
+ *
+ * Unlike the ThreadPool, where every task goes through one shared queue,
+ * each thread here has a queue of its own. A task spawned by a running task
+ * goes on the back of its own thread's queue, and each thread takes its next
+ * task from the back of its own queue, so it carries on with the work it
+ * has just found (e.g. the files in a directory it has just listed) while
+ * that is still in its caches. A thread whose queue is empty steals from
+ * the front of another's, where the oldest and usually largest pieces of
+ * work are, so the threads stay busy however unevenly the work turns up.
+ */
+class WorkStealingPool {
+  public:
+    /// Type definition for a task
+    using Task = std::function<void()>;
+
+    /**
+     * \struct Stats
+     * \brief How the tasks of a run were spread over the threads
+     */
+    struct Stats {
+        /// The number of threads that ran tasks
+        std::size_t threads{0};
+        /// The number of tasks that were run
+        std::size_t tasks{0};
+        /// The number of tasks that were stolen from another thread's queue
+        std::size_t steals{0};
+    };
+
+    /**
+     * \brief Create a pool
+     *
+     * \param nThreads the number of threads to run the tasks on (including
+     *                 the one that calls run()), 0 means one per hardware thread
+     */
+    explicit WorkStealingPool(const std::size_t nThreads = 0);
+
+    /**
+     * \brief Add a task to be run
+     *
+     * This can be called before run(), in which case the tasks are dealt
+     * out between the threads' queues, or from a running task, in which
+     * case the new task goes on the queue of the thread running it.
+     *
+     * \param task the task
+     */
+    void spawn(Task task);
+
+    /**
+     * \brief Run the tasks, and every task they spawn, until there are none left
+     *
+     * The calling thread runs tasks too. Once a task has thrown, any tasks
+     * that have not started yet are dropped.
+     *
+     * \return how the tasks were spread over the threads
+     * \throw the first exception thrown by a task
+     */
+    Stats run();
+
+  private:
+    /**
+     * \struct Queue
+     * \brief The queue of tasks of one thread
+     */
+    struct Queue {
+        /// Mutex guarding the tasks
+        std::mutex mutex;
+        /// The tasks, newest at the back
+        std::deque<Task> tasks;
+        /// The number of tasks run by the thread
+        std::size_t nRun{0};
+        /// The number of tasks the thread stole
+        std::size_t nStolen{0};
+    };
+
+    /// Take a task from the back of a thread's own queue, or steal one
+    bool take(const std::size_t self, Task& task);
+
+    /// The loop run by each thread
+    void workerLoop(const std::size_t self);
+
+    /// The queues, one per thread
+    std::vector<std::unique_ptr<Queue>> queues_;
+
+    /// The queue that the next task spawned from outside the pool goes on
+    std::size_t nextQueue_{0};
+
+    /// The number of tasks spawned that have not finished yet
+    std::atomic<std::size_t> pending_{0};
+
+    /// Whether a task has thrown
+    std::atomic<bool> failed_{false};
+
+    /// The first exception thrown by a task
+    std::exception_ptr error_;
+
+    /// Mutex guarding the exception
+    std::mutex errorMutex_;
+};
+
+#endif    // MPAGSCIPHER_WORKSTEALINGPOOL_HPP
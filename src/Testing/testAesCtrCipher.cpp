@@ -0,0 +1,169 @@
+//! Unit Tests for MPAGSCipher AesCtrCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "AesCtrCipher.hpp"
+
+#include <string>
+
+namespace {
+    /**
+     * \brief Convert a string of bytes to hexadecimal
+     *
+     * \param bytes the bytes
+     * \return the hexadecimal string
+     */
+    std::string toHex(const std::string& bytes)
+    {
+        const char digits[]{"0123456789abcdef"};
+        std::string hex;
+        for (const char c : bytes) {
+            const auto byte = static_cast<unsigned char>(c);
+            hex += digits[byte >> 4];
+            hex += digits[byte & 0xf];
+        }
+        return hex;
+    }
+
+    /**
+     * \brief Convert a hexadecimal string to bytes
+     *
+     * \param hex the hexadecimal string
+     * \return the bytes
+     */
+    std::string fromHex(const std::string& hex)
+    {
+        std::string bytes;
+        for (std::size_t i{0}; i < hex.size(); i += 2) {
+            bytes += static_cast<char>(
+                std::stoul(hex.substr(i, 2), nullptr, 16));
+        }
+        return bytes;
+    }
+
+    /// The plaintext of the NIST SP 800-38A examples
+    const std::string nistPlainText{fromHex(
+        "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+        "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710")};
+
+    /// The initial counter block of the NIST SP 800-38A examples
+    const std::string nistCounter{"f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"};
+}    // namespace
+
+TEST_CASE("AES block encryption (FIPS-197 appendix C)", "[aesctr]")
+{
+    // With a zero plaintext the output is just the encrypted counter block
+    const std::string zeros(16, '\0');
+    const std::string block{"00112233445566778899aabbccddeeff"};
+
+    AesCtrCipher aes128{"000102030405060708090a0b0c0d0e0f," + block};
+    REQUIRE(toHex(aes128.applyCipher(zeros, CipherMode::Encrypt)) ==
+            "69c4e0d86a7b0430d8cdb78070b4c55a");
+
+    AesCtrCipher aes192{
+        "000102030405060708090a0b0c0d0e0f1011121314151617," + block};
+    REQUIRE(toHex(aes192.applyCipher(zeros, CipherMode::Encrypt)) ==
+            "dda97ca4864cdfe06eaf70a0ec0d7191");
+
+    AesCtrCipher aes256{
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f," +
+        block};
+    REQUIRE(toHex(aes256.applyCipher(zeros, CipherMode::Encrypt)) ==
+            "8ea2b7ca516745bfeafc49904b496089");
+}
+
+TEST_CASE("AES-128 CTR (NIST SP 800-38A F.5.1 and F.5.2)", "[aesctr]")
+{
+    const std::string cipherHex{
+        "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+        "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee"};
+
+    AesCtrCipher aes{"2b7e151628aed2a6abf7158809cf4f3c," + nistCounter};
+    for (const auto implementation : {AesCtrCipher::Implementation::Bitsliced,
+                                      AesCtrCipher::Implementation::AESNI}) {
+        if (!AesCtrCipher::isSupported(implementation)) {
+            continue;
+        }
+        const std::string cipherText{
+            aes.applyCipherWith(nistPlainText, implementation)};
+        REQUIRE(toHex(cipherText) == cipherHex);
+        REQUIRE(aes.applyCipherWith(cipherText, implementation) ==
+                nistPlainText);
+    }
+}
+
+TEST_CASE("AES-256 CTR (NIST SP 800-38A F.5.5 and F.5.6)", "[aesctr]")
+{
+    const std::string cipherHex{
+        "601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c5"
+        "2b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6"};
+
+    AesCtrCipher aes{
+        "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4," +
+        nistCounter};
+    for (const auto implementation : {AesCtrCipher::Implementation::Bitsliced,
+                                      AesCtrCipher::Implementation::AESNI}) {
+        if (!AesCtrCipher::isSupported(implementation)) {
+            continue;
+        }
+        const std::string cipherText{
+            aes.applyCipherWith(nistPlainText, implementation)};
+        REQUIRE(toHex(cipherText) == cipherHex);
+        REQUIRE(aes.applyCipherWith(cipherText, implementation) ==
+                nistPlainText);
+    }
+}
+
+TEST_CASE("AES-CTR counter carries between halves", "[aesctr]")
+{
+    // The second block of the first run uses the counter that the second
+    // run starts from, which needs a carry into the upper half
+    const std::string key{"2b7e151628aed2a6abf7158809cf4f3c,"};
+    AesCtrCipher first{key + "0000000000000000ffffffffffffffff"};
+    AesCtrCipher second{key + "00000000000000010000000000000000"};
+    const std::string zeros(32, '\0');
+    REQUIRE(first.applyCipher(zeros, CipherMode::Encrypt).substr(16) ==
+            second.applyCipher(zeros, CipherMode::Encrypt).substr(0, 16));
+}
+
+TEST_CASE("AES-CTR implementations agree", "[aesctr]")
+{
+    // Long enough to be split between threads, and not a whole number of
+    // blocks, so that every implementation has a ragged end to deal with
+    std::string data(300007, '\0');
+    for (std::size_t i{0}; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 131 + i / 256);
+    }
+
+    AesCtrCipher aes{"2b7e151628aed2a6abf7158809cf4f3c," + nistCounter};
+    const std::string expected{aes.applyCipherWith(
+        data, AesCtrCipher::Implementation::Bitsliced, 1)};
+
+    for (const auto implementation : {AesCtrCipher::Implementation::Bitsliced,
+                                      AesCtrCipher::Implementation::AESNI}) {
+        if (!AesCtrCipher::isSupported(implementation)) {
+            continue;
+        }
+        for (const std::size_t length :
+             {0, 1, 15, 16, 17, 63, 64, 65, 127, 129, 1000}) {
+            REQUIRE(aes.applyCipherWith(data.substr(0, length),
+                                        implementation) ==
+                    expected.substr(0, length));
+        }
+        REQUIRE(aes.applyCipherWith(data, implementation) == expected);
+    }
+    REQUIRE(aes.applyCipher(expected, CipherMode::Decrypt) == data);
+}
+
+TEST_CASE("AES-CTR key validation", "[aesctr]")
+{
+    const std::string key{"2b7e151628aed2a6abf7158809cf4f3c"};
+    REQUIRE_THROWS_AS(AesCtrCipher{""}, InvalidKey);
+    REQUIRE_THROWS_AS(AesCtrCipher{key}, InvalidKey);
+    REQUIRE_THROWS_AS(AesCtrCipher{key + ",0011"}, InvalidKey);
+    REQUIRE_THROWS_AS(AesCtrCipher{key.substr(2) + "," + nistCounter},
+                      InvalidKey);
+    REQUIRE_THROWS_AS(AesCtrCipher{key + "00," + nistCounter}, InvalidKey);
+    REQUIRE_THROWS_AS(AesCtrCipher{"zz" + key.substr(2) + "," + nistCounter},
+                      InvalidKey);
+}
@@ -0,0 +1,40 @@
+//! Unit Tests for MPAGSCipher AffineCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "AffineCipher.hpp"
+
+TEST_CASE("Affine Cipher encryption", "[affine]")
+{
+    AffineCipher ac{5, 8};
+    REQUIRE(ac.applyCipher("AFFINECIPHER", CipherMode::Encrypt) ==
+            "IHHWVCSWFRCP");
+}
+
+TEST_CASE("Affine Cipher decryption", "[affine]")
+{
+    AffineCipher ac{"5,8"};
+    REQUIRE(ac.applyCipher("IHHWVCSWFRCP", CipherMode::Decrypt) ==
+            "AFFINECIPHER");
+}
+
+TEST_CASE("Affine Cipher modular inverses", "[affine]")
+{
+    for (std::size_t a{1}; a < 26; ++a) {
+        const std::size_t aInverse{AffineCipher::modularInverse(a)};
+        if (a % 2 == 0 || a == 13) {
+            REQUIRE(aInverse == 0);
+        } else {
+            REQUIRE((a * aInverse) % 26 == 1);
+        }
+    }
+}
+
+TEST_CASE("Affine Cipher key validation", "[affine]")
+{
+    REQUIRE_THROWS_AS(AffineCipher(13, 1), InvalidKey);
+    REQUIRE_THROWS_AS(AffineCipher("4,3"), InvalidKey);
+    REQUIRE_THROWS_AS(AffineCipher("7"), InvalidKey);
+    REQUIRE_THROWS_AS(AffineCipher(""), InvalidKey);
+    REQUIRE_NOTHROW(AffineCipher("31,100"));
+}
@@ -0,0 +1,125 @@
+//! Unit Tests for MPAGSCipher AsyncReader and AsyncWriter Classes
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "AsyncFile.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace {
+    std::string makeContents(const std::size_t n)
+    {
+        std::string contents(n, 'A');
+        for (std::size_t i{0}; i < n; ++i) {
+            contents[i] = static_cast<char>('A' + (i * 7 + i / 13) % 26);
+        }
+        return contents;
+    }
+
+    std::string readAll(AsyncReader& reader)
+    {
+        std::string contents;
+        const char* data{nullptr};
+        std::size_t n{0};
+        while (reader.next(data, n)) {
+            contents.append(data, n);
+        }
+        return contents;
+    }
+}    // namespace
+
+TEST_CASE("Async reads give back the file", "[asyncfile]")
+{
+    const std::string fileName{"testAsyncFile.read.txt"};
+    const std::string contents{makeContents(10007)};
+    {
+        std::ofstream file{fileName, std::ios::binary};
+        file << contents;
+    }
+
+    for (const IoBackend backend : {IoBackend::Automatic, IoBackend::Threads}) {
+        // Buffers that do not divide the file, and more of them than needed
+        AsyncReader small{fileName, 100, 3, backend};
+        REQUIRE(readAll(small) == contents);
+        AsyncReader large{fileName, 4096, 8, backend};
+        REQUIRE(readAll(large) == contents);
+        AsyncReader whole{fileName, 1 << 20, 4, backend};
+        REQUIRE(readAll(whole) == contents);
+    }
+
+    // Stopping part way through waits for the reads in flight
+    {
+        AsyncReader reader{fileName, 64, 4};
+        const char* data{nullptr};
+        std::size_t n{0};
+        REQUIRE(reader.next(data, n));
+        REQUIRE(std::string(data, n) == contents.substr(0, 64));
+    }
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Async reads of an empty file", "[asyncfile]")
+{
+    const std::string fileName{"testAsyncFile.empty.txt"};
+    {
+        std::ofstream file{fileName};
+    }
+
+    AsyncReader reader{fileName, 100, 3};
+    REQUIRE(readAll(reader).empty());
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Async writes give back the data", "[asyncfile]")
+{
+    const std::string fileName{"testAsyncFile.write.txt"};
+    const std::string contents{makeContents(10007)};
+
+    for (const IoBackend backend : {IoBackend::Automatic, IoBackend::Threads}) {
+        {
+            AsyncWriter writer{fileName, 100, 3, backend};
+            // Pieces that straddle the buffers
+            for (std::size_t i{0}; i < contents.size(); i += 37) {
+                writer.write(contents.substr(i, 37));
+            }
+            writer.close();
+        }
+        std::ifstream file{fileName, std::ios::binary};
+        const std::string written{std::istreambuf_iterator<char>{file},
+                                  std::istreambuf_iterator<char>{}};
+        REQUIRE(written == contents);
+    }
+
+    // The destructor writes out anything left
+    {
+        AsyncWriter writer{fileName, 4096, 2};
+        writer.write("HELLO");
+    }
+    std::ifstream file{fileName, std::ios::binary};
+    const std::string written{std::istreambuf_iterator<char>{file},
+                              std::istreambuf_iterator<char>{}};
+    REQUIRE(written == "HELLO");
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Async files that cannot be opened", "[asyncfile]")
+{
+    REQUIRE_THROWS_AS(AsyncReader("testAsyncFile.missing.txt", 100, 3),
+                      std::system_error);
+    REQUIRE_THROWS_AS(AsyncWriter("no/such/directory/file.txt", 100, 3),
+                      std::system_error);
+}
+
+TEST_CASE("Async file sizes must be positive", "[asyncfile]")
+{
+    REQUIRE_THROWS_AS(AsyncWriter("testAsyncFile.bad.txt", 0, 3),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(AsyncWriter("testAsyncFile.bad.txt", 100, 0),
+                      std::invalid_argument);
+}
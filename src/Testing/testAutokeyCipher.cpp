@@ -0,0 +1,60 @@
+//! Unit Tests for MPAGSCipher AutokeyCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "AutokeyCipher.hpp"
+
+#include <string>
+
+TEST_CASE("Autokey Cipher encryption", "[autokey]")
+{
+    AutokeyCipher ac{"queenly"};
+    REQUIRE(ac.applyCipher("ATTACKATDAWN", CipherMode::Encrypt) ==
+            "QNXEPVYTWTWP");
+}
+
+TEST_CASE("Autokey Cipher decryption", "[autokey]")
+{
+    AutokeyCipher ac{"queenly"};
+    REQUIRE(ac.applyCipher("QNXEPVYTWTWP", CipherMode::Decrypt) ==
+            "ATTACKATDAWN");
+}
+
+TEST_CASE("Autokey Cipher text shorter than the key", "[autokey]")
+{
+    AutokeyCipher ac{"kilt"};
+    REQUIRE(ac.applyCipher("WEAREDISCOVEREDFLEEATONCE", CipherMode::Encrypt) ==
+            "GMLKAHIJGRDWTSYJCIHFESRCX");
+    REQUIRE(ac.applyCipher("ABC", CipherMode::Encrypt) == "KJN");
+    REQUIRE(ac.applyCipher("KJN", CipherMode::Decrypt) == "ABC");
+    REQUIRE(ac.applyCipher("", CipherMode::Encrypt).empty());
+}
+
+TEST_CASE("Autokey Cipher long text", "[autokey]")
+{
+    std::string plainText;
+    for (std::size_t i{0}; i < 1000003; ++i) {
+        plainText += static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+
+    // Each letter is shifted by the letter five places before it
+    const std::string primer{"PRIME"};
+    std::string expected(plainText.size(), ' ');
+    for (std::size_t i{0}; i < plainText.size(); ++i) {
+        const char key{i < 5 ? primer[i] : plainText[i - 5]};
+        expected[i] =
+            static_cast<char>('A' + (plainText[i] - 'A' + key - 'A') % 26);
+    }
+
+    AutokeyCipher ac{primer};
+    const std::string cipherText{
+        ac.applyCipher(plainText, CipherMode::Encrypt)};
+    REQUIRE(cipherText == expected);
+    REQUIRE(ac.applyCipher(cipherText, CipherMode::Decrypt) == plainText);
+}
+
+TEST_CASE("Autokey Cipher key validation", "[autokey]")
+{
+    REQUIRE_THROWS_AS(AutokeyCipher{""}, InvalidKey);
+    REQUIRE_THROWS_AS(AutokeyCipher{"1234"}, InvalidKey);
+}
@@ -0,0 +1,124 @@
+//! Unit Tests for MPAGSCipher BatchCipher functions
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "BatchCipher.hpp"
+#include "CipherFactory.hpp"
+#include "CipherType.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    const std::string englishText{
+        "ITWASTHEBESTOFTIMESITWASTHEWORSTOFTIMESITWASTHEAGEOFWISDOMITWASTHE"
+        "AGEOFFOOLISHNESSITWASTHEEPOCHOFBELIEFITWASTHEEPOCHOFINCREDULITY"};
+
+    /// Check the batch functions against one cipher per key
+    void checkAgainstCiphers(const CipherType type, const std::string& text,
+                             const std::vector<std::string>& keys)
+    {
+        for (const CipherMode mode :
+             {CipherMode::Encrypt, CipherMode::Decrypt}) {
+            const std::vector<std::string> outputs{
+                BatchCipher::applyCipher(type, text, keys, mode)};
+            const std::vector<double> scores{
+                BatchCipher::scoreKeys(type, text, keys, mode)};
+            REQUIRE(outputs.size() == keys.size());
+            REQUIRE(scores.size() == keys.size());
+            for (std::size_t i{0}; i < keys.size(); ++i) {
+                const std::string expected{
+                    CipherFactory::makeCipher(type, keys[i])
+                        ->applyCipher(text, mode)};
+                REQUIRE(outputs[i] == expected);
+                REQUIRE(scores[i] ==
+                        Approx(BatchCipher::chiSquared(
+                            BatchCipher::countLetters(expected))));
+            }
+        }
+    }
+}    // namespace
+
+TEST_CASE("Batch Caesar matches CaesarCipher", "[batch]")
+{
+    std::vector<std::string> keys;
+    for (std::size_t key{0}; key < 30; ++key) {
+        keys.push_back(std::to_string(key));
+    }
+    checkAgainstCiphers(CipherType::Caesar, englishText, keys);
+}
+
+TEST_CASE("Batch Vigenere matches VigenereCipher", "[batch]")
+{
+    const std::vector<std::string> keys{"key", "lemon", "a", "Hello World",
+                                        "ZYXWVUTSRQPONMLKJIHGFEDCBAZ"};
+    checkAgainstCiphers(CipherType::Vigenere, englishText, keys);
+
+    // Long enough to need several chunks, with a key length that does not
+    // divide the chunk size
+    std::string longText;
+    for (std::size_t i{0}; i < 100003; ++i) {
+        longText += static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+    checkAgainstCiphers(CipherType::Vigenere, longText, keys);
+}
+
+TEST_CASE("Batch Playfair matches PlayfairCipher", "[batch]")
+{
+    const std::vector<std::string> keys{"playfairexample", "", "monarchy",
+                                        "Hello World", "ZYXWV"};
+    checkAgainstCiphers(CipherType::Playfair, englishText, keys);
+    checkAgainstCiphers(CipherType::Playfair, "BOOTJAX", keys);
+}
+
+TEST_CASE("Batch with no keys or no text", "[batch]")
+{
+    REQUIRE(BatchCipher::applyCipher(CipherType::Vigenere, englishText, {},
+                                     CipherMode::Encrypt)
+                .empty());
+    REQUIRE(BatchCipher::scoreKeys(CipherType::Playfair, englishText, {},
+                                   CipherMode::Encrypt)
+                .empty());
+    const std::vector<std::string> outputs{BatchCipher::applyCipher(
+        CipherType::Caesar, "", {"1", "2"}, CipherMode::Encrypt)};
+    REQUIRE(outputs == std::vector<std::string>{"", ""});
+    REQUIRE(BatchCipher::chiSquared(BatchCipher::countLetters("")) == 0.0);
+}
+
+TEST_CASE("Batch scores find the Caesar key", "[batch]")
+{
+    const std::string cipherText{
+        CipherFactory::makeCipher(CipherType::Caesar, "11")
+            ->applyCipher(englishText, CipherMode::Encrypt)};
+
+    std::vector<std::string> keys;
+    for (std::size_t key{0}; key < 26; ++key) {
+        keys.push_back(std::to_string(key));
+    }
+    const std::vector<double> scores{BatchCipher::scoreKeys(
+        CipherType::Caesar, cipherText, keys, CipherMode::Decrypt)};
+    REQUIRE(std::min_element(std::begin(scores), std::end(scores)) -
+                std::begin(scores) ==
+            11);
+}
+
+TEST_CASE("Batch rejects unsupported ciphers and bad keys", "[batch]")
+{
+    REQUIRE(BatchCipher::isSupported(CipherType::Caesar));
+    REQUIRE_FALSE(BatchCipher::isSupported(CipherType::Enigma));
+    REQUIRE_THROWS_AS(BatchCipher::applyCipher(CipherType::Enigma, "ABC",
+                                               {"key"}, CipherMode::Encrypt),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(BatchCipher::scoreKeys(CipherType::Hill, "ABC", {"key"},
+                                             CipherMode::Encrypt),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(BatchCipher::applyCipher(CipherType::Vigenere, "ABC",
+                                               {"key", "123"},
+                                               CipherMode::Encrypt),
+                      InvalidKey);
+    REQUIRE_THROWS_AS(BatchCipher::scoreKeys(CipherType::Vigenere, "ABC",
+                                             {"!", "key"}, CipherMode::Encrypt),
+                      InvalidKey);
+}
@@ -0,0 +1,65 @@
+//! Unit Tests for MPAGSCipher BifidCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "BifidCipher.hpp"
+
+#include <string>
+
+TEST_CASE("Bifid Cipher encryption", "[bifid]")
+{
+    BifidCipher bc{"BGWKZQPNDSIOAXEFCLUMTHYVR"};
+    REQUIRE(bc.applyCipher("FLEEATONCE", CipherMode::Encrypt) == "UAEOLWRINS");
+}
+
+TEST_CASE("Bifid Cipher decryption", "[bifid]")
+{
+    BifidCipher bc{"BGWKZQPNDSIOAXEFCLUMTHYVR"};
+    REQUIRE(bc.applyCipher("UAEOLWRINS", CipherMode::Decrypt) == "FLEEATONCE");
+}
+
+TEST_CASE("Bifid Cipher with a period", "[bifid]")
+{
+    BifidCipher periodic{"playfair,5"};
+    REQUIRE(periodic.applyCipher("WEAREDISCOVEREDFLEEATONCE",
+                                 CipherMode::Encrypt) ==
+            "WLHAIROTYOWBRLFPHFIASOMIN");
+    REQUIRE(periodic.applyCipher("WLHAIROTYOWBRLFPHFIASOMIN",
+                                 CipherMode::Decrypt) ==
+            "WEAREDISCOVEREDFLEEATONCE");
+
+    BifidCipher whole{"playfair"};
+    REQUIRE(whole.applyCipher("WEAREDISCOVEREDFLEEATONCE",
+                              CipherMode::Encrypt) ==
+            "WLGCCWBIAESOHAIUSRLFVPMIN");
+    BifidCipher zeroPeriod{"playfair,0"};
+    REQUIRE(zeroPeriod.applyCipher("WLGCCWBIAESOHAIUSRLFVPMIN",
+                                   CipherMode::Decrypt) ==
+            "WEAREDISCOVEREDFLEEATONCE");
+}
+
+TEST_CASE("Bifid Cipher long text", "[bifid]")
+{
+    // Long enough to be split across several chunks, with a period that
+    // doesn't divide the chunk size
+    const std::string letters{"ABCDEFGHIKLMNOPQRSTUVWXYZ"};
+    std::string plainText;
+    for (std::size_t i{0}; i < 1000003; ++i) {
+        // Only use letters that are in the grid, i.e. no J
+        plainText += letters[(i * 7 + i / 25) % 25];
+    }
+    for (const char* key : {"secret,7", "secret"}) {
+        BifidCipher bc{key};
+        const std::string cipherText{
+            bc.applyCipher(plainText, CipherMode::Encrypt)};
+        REQUIRE(cipherText != plainText);
+        REQUIRE(bc.applyCipher(cipherText, CipherMode::Decrypt) == plainText);
+    }
+}
+
+TEST_CASE("Bifid Cipher key validation", "[bifid]")
+{
+    REQUIRE_THROWS_AS(BifidCipher{"secret,"}, InvalidKey);
+    REQUIRE_THROWS_AS(BifidCipher{"secret,five"}, InvalidKey);
+    REQUIRE_THROWS_AS(BifidCipher{"secret,-5"}, InvalidKey);
+}
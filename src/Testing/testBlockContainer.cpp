@@ -0,0 +1,228 @@
+//! Unit Tests for MPAGSCipher BlockContainer functions and Reader class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "BlockContainer.hpp"
+#include "CaesarCipher.hpp"
+#include "ChaCha20Cipher.hpp"
+#include "PlayfairCipher.hpp"
+#include "VigenereCipher.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    const std::string plainText{
+        "THEQUICKBROWNFOXJUMPSOVERTHELAZYDOGANDRUNSAWAYFROMTHEFARMER"};
+
+    std::vector<std::unique_ptr<Cipher>> makeVigenereChain()
+    {
+        std::vector<std::unique_ptr<Cipher>> ciphers;
+        ciphers.push_back(std::make_unique<VigenereCipher>("lemon"));
+        ciphers.push_back(std::make_unique<CaesarCipher>(5));
+        return ciphers;
+    }
+
+    const std::vector<CipherType> vigenereTypes{CipherType::Vigenere,
+                                                CipherType::Caesar};
+    const std::vector<std::string> vigenereKeys{"lemon", "5"};
+}    // namespace
+
+TEST_CASE("Container round trip", "[blockcontainer]")
+{
+    auto ciphers = makeVigenereChain();
+    std::istringstream in{BlockContainer::encode(plainText, ciphers,
+                                                 vigenereTypes, vigenereKeys,
+                                                 8)};
+    BlockContainer::Reader reader{in};
+
+    REQUIRE(reader.cipherTypes() == vigenereTypes);
+    REQUIRE(reader.keyFingerprint() ==
+            BlockContainer::keyFingerprint(vigenereTypes, vigenereKeys));
+    REQUIRE(reader.plainSize() == plainText.size());
+    REQUIRE(reader.blocks().size() == (plainText.size() + 7) / 8);
+
+    std::reverse(std::begin(ciphers), std::end(ciphers));
+    REQUIRE(reader.decode(ciphers) == plainText);
+}
+
+TEST_CASE("Container blocks are encrypted independently", "[blockcontainer]")
+{
+    auto ciphers = makeVigenereChain();
+    const std::string container{BlockContainer::encode(
+        plainText, ciphers, vigenereTypes, vigenereKeys, 8)};
+    std::istringstream in{container};
+    BlockContainer::Reader reader{in};
+
+    // Each block starts again from the beginning of the key
+    for (const auto& block : reader.blocks()) {
+        std::string expected{plainText.substr(block.plainOffset, 8)};
+        for (const auto& cipher : ciphers) {
+            expected = cipher->applyCipher(expected, CipherMode::Encrypt);
+        }
+        REQUIRE(container.substr(block.cipherOffset, block.cipherLength) ==
+                expected);
+    }
+}
+
+TEST_CASE("Container range decoding", "[blockcontainer]")
+{
+    auto ciphers = makeVigenereChain();
+    std::istringstream in{BlockContainer::encode(plainText, ciphers,
+                                                 vigenereTypes, vigenereKeys,
+                                                 8)};
+    BlockContainer::Reader reader{in};
+    std::reverse(std::begin(ciphers), std::end(ciphers));
+
+    REQUIRE(reader.decode(ciphers, 0, 3) == "THE");
+    REQUIRE(reader.decode(ciphers, 6, 5) == plainText.substr(6, 5));
+    REQUIRE(reader.decode(ciphers, 13, 30) == plainText.substr(13, 30));
+    REQUIRE(reader.decode(ciphers, 50, 100) == plainText.substr(50));
+    REQUIRE(reader.decode(ciphers, 100, 5).empty());
+}
+
+TEST_CASE("Container with Playfair", "[blockcontainer]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<PlayfairCipher>("playfairexample"));
+    const std::vector<CipherType> types{CipherType::Playfair};
+    const std::vector<std::string> keys{"playfairexample"};
+    std::istringstream in{
+        BlockContainer::encode(plainText, ciphers, types, keys, 9)};
+    BlockContainer::Reader reader{in};
+
+    // Each block decrypts to what Playfair gives for that block on its own
+    std::string expected;
+    for (const auto& block : reader.blocks()) {
+        const std::string text{plainText.substr(block.plainOffset, 9)};
+        expected += ciphers[0]->applyCipher(
+            ciphers[0]->applyCipher(text, CipherMode::Encrypt),
+            CipherMode::Decrypt);
+    }
+    REQUIRE(reader.decode(ciphers) == expected);
+}
+
+TEST_CASE("Compressed container", "[blockcontainer]")
+{
+    std::string text;
+    for (std::size_t i{0}; i < 50; ++i) {
+        text += plainText;
+    }
+    auto ciphers = makeVigenereChain();
+    const std::string container{BlockContainer::encode(
+        text, ciphers, vigenereTypes, vigenereKeys, 1000, true)};
+    REQUIRE(container.size() < text.size() / 2);
+
+    std::istringstream in{container};
+    BlockContainer::Reader reader{in};
+    REQUIRE(reader.compressed());
+    REQUIRE(reader.plainSize() == text.size());
+
+    std::reverse(std::begin(ciphers), std::end(ciphers));
+    REQUIRE(reader.decode(ciphers) == text);
+    REQUIRE(reader.decode(ciphers, 990, 30) == text.substr(990, 30));
+}
+
+TEST_CASE("Compression needs reversible ciphers", "[blockcontainer]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<PlayfairCipher>("playfairexample"));
+    REQUIRE_THROWS_AS(BlockContainer::encode(plainText, ciphers,
+                                             {CipherType::Playfair},
+                                             {"playfairexample"},
+                                             BlockContainer::defaultBlockSize,
+                                             true),
+                      std::invalid_argument);
+}
+
+TEST_CASE("Empty container", "[blockcontainer]")
+{
+    auto ciphers = makeVigenereChain();
+    std::istringstream in{
+        BlockContainer::encode("", ciphers, vigenereTypes, vigenereKeys)};
+    BlockContainer::Reader reader{in};
+    REQUIRE(reader.blocks().empty());
+    REQUIRE(reader.decode(ciphers).empty());
+}
+
+TEST_CASE("Key fingerprints differ", "[blockcontainer]")
+{
+    const auto fingerprint = BlockContainer::keyFingerprint(vigenereTypes,
+                                                            vigenereKeys);
+    REQUIRE(fingerprint != BlockContainer::keyFingerprint(
+                               vigenereTypes, {"lemon", "6"}));
+    REQUIRE(fingerprint != BlockContainer::keyFingerprint(
+                               vigenereTypes, {"lemo", "n5"}));
+    REQUIRE(fingerprint != BlockContainer::keyFingerprint(
+                               {CipherType::Autokey, CipherType::Caesar},
+                               vigenereKeys));
+}
+
+TEST_CASE("Byte ciphers cannot be put in a container", "[blockcontainer]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<ChaCha20Cipher>(
+        std::string(64, '0') + "," + std::string(24, '0')));
+    REQUIRE_THROWS_AS(BlockContainer::encode(plainText, ciphers,
+                                             {CipherType::ChaCha20}, {"k"}),
+                      std::invalid_argument);
+}
+
+TEST_CASE("Malformed containers are rejected", "[blockcontainer]")
+{
+    auto ciphers = makeVigenereChain();
+    const std::string container{BlockContainer::encode(
+        plainText, ciphers, vigenereTypes, vigenereKeys, 8)};
+
+    SECTION("Truncated")
+    {
+        std::istringstream in{container.substr(0, container.size() - 1)};
+        REQUIRE_THROWS_AS(BlockContainer::Reader{in}, InvalidContainer);
+    }
+    SECTION("Not a container")
+    {
+        std::istringstream in{plainText};
+        REQUIRE_THROWS_AS(BlockContainer::Reader{in}, InvalidContainer);
+    }
+    SECTION("Corrupt index")
+    {
+        std::string corrupt{container};
+        corrupt[corrupt.size() - 24 - 36 + 16] ^= 1;
+        std::istringstream in{corrupt};
+        REQUIRE_THROWS_AS(BlockContainer::Reader{in}, InvalidContainer);
+    }
+}
+
+TEST_CASE("Corrupt blocks are reported", "[blockcontainer]")
+{
+    auto ciphers = makeVigenereChain();
+    std::string container{BlockContainer::encode(
+        plainText, ciphers, vigenereTypes, vigenereKeys, 8)};
+    std::reverse(std::begin(ciphers), std::end(ciphers));
+
+    // Flip a bit in the cipher text of blocks 2 and 5
+    for (const std::size_t iBlock : {2, 5}) {
+        std::istringstream in{container};
+        BlockContainer::Reader reader{in};
+        container[reader.blocks()[iBlock].cipherOffset + 3] ^= 0x20;
+    }
+    std::istringstream in{container};
+    BlockContainer::Reader reader{in};
+
+    try {
+        reader.decode(ciphers);
+        FAIL("No exception thrown");
+    } catch (const CorruptBlock& e) {
+        REQUIRE(e.block() == 2);
+    }
+
+    // Ranges that avoid the corrupt blocks can still be read
+    REQUIRE(reader.decode(ciphers, 0, 16) == plainText.substr(0, 16));
+    REQUIRE(reader.decode(ciphers, 24, 10) == plainText.substr(24, 10));
+    REQUIRE_THROWS_AS(reader.decode(ciphers, 30, 20), CorruptBlock);
+}
@@ -0,0 +1,125 @@
+//! Unit Tests for MPAGSCipher ChaCha20Cipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "ChaCha20Cipher.hpp"
+
+#include <string>
+
+namespace {
+    /// The key used in the examples in RFC 8439
+    const std::string rfcKey{
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"};
+
+    /**
+     * \brief Convert a string of bytes to hexadecimal
+     *
+     * \param bytes the bytes
+     * \return the hexadecimal string
+     */
+    std::string toHex(const std::string& bytes)
+    {
+        const char digits[]{"0123456789abcdef"};
+        std::string hex;
+        for (const char c : bytes) {
+            const auto byte = static_cast<unsigned char>(c);
+            hex += digits[byte >> 4];
+            hex += digits[byte & 0xf];
+        }
+        return hex;
+    }
+}    // namespace
+
+TEST_CASE("ChaCha20 block function (RFC 8439 section 2.3.2)", "[chacha20]")
+{
+    ChaCha20Cipher cc{rfcKey + ",000000090000004a00000000,1"};
+    REQUIRE(toHex(cc.applyCipher(std::string(64, '\0'),
+                                 CipherMode::Encrypt)) ==
+            "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+            "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e");
+}
+
+TEST_CASE("ChaCha20 key stream with all-zero key (RFC 8439 appendix A.2)",
+          "[chacha20]")
+{
+    ChaCha20Cipher cc{std::string(64, '0') + "," + std::string(24, '0')};
+    REQUIRE(toHex(cc.applyCipher(std::string(64, '\0'),
+                                 CipherMode::Encrypt)) ==
+            "76b8e0ada0f13d90405d6ae55386bd28bdd219b8a08ded1aa836efcc8b770dc7"
+            "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee6586");
+}
+
+TEST_CASE("ChaCha20 encryption and decryption (RFC 8439 section 2.4.2)",
+          "[chacha20]")
+{
+    const std::string plainText{
+        "Ladies and Gentlemen of the class of '99: If I could offer you only "
+        "one tip for the future, sunscreen would be it."};
+    const std::string cipherHex{
+        "6e2e359a2568f98041ba0728dd0d6981e97e7aec1d4360c20a27afccfd9fae0b"
+        "f91b65c5524733ab8f593dabcd62b3571639d624e65152ab8f530c359f0861d8"
+        "07ca0dbf500d6a6156a38e088a22b65e52bc514d16ccf806818ce91ab7793736"
+        "5af90bbf74a35be6b40b8eedf2785e42874d"};
+
+    ChaCha20Cipher cc{rfcKey + ",000000000000004a00000000,1"};
+    const std::string cipherText{
+        cc.applyCipher(plainText, CipherMode::Encrypt)};
+    REQUIRE(toHex(cipherText) == cipherHex);
+    REQUIRE(cc.applyCipher(cipherText, CipherMode::Decrypt) == plainText);
+}
+
+TEST_CASE("ChaCha20 implementations agree", "[chacha20]")
+{
+    // Long enough to be split between threads, and not a whole number of
+    // blocks, so that every implementation has a ragged end to deal with
+    std::string data(1000003, '\0');
+    for (std::size_t i{0}; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 131 + i / 256);
+    }
+
+    ChaCha20Cipher cc{rfcKey + ",000000000000004a00000000,7"};
+    const std::string expected{cc.applyCipherWith(
+        data, ChaCha20Cipher::Implementation::Scalar, 1)};
+
+    for (const auto implementation : {ChaCha20Cipher::Implementation::Scalar,
+                                      ChaCha20Cipher::Implementation::SSE2,
+                                      ChaCha20Cipher::Implementation::AVX2}) {
+        if (!ChaCha20Cipher::isSupported(implementation)) {
+            continue;
+        }
+        for (const std::size_t length :
+             {0, 1, 63, 64, 65, 255, 257, 511, 513, 1000}) {
+            REQUIRE(cc.applyCipherWith(data.substr(0, length),
+                                       implementation) ==
+                    expected.substr(0, length));
+        }
+        REQUIRE(cc.applyCipherWith(data, implementation) == expected);
+    }
+    REQUIRE(cc.applyCipher(expected, CipherMode::Decrypt) == data);
+}
+
+TEST_CASE("ChaCha20 counter limit", "[chacha20]")
+{
+    // The last block counter can be used, but not go past it
+    ChaCha20Cipher cc{rfcKey + ",000000000000004a00000000,4294967295"};
+    REQUIRE(cc.applyCipher(std::string(64, 'x'), CipherMode::Encrypt).size() ==
+            64);
+    REQUIRE_THROWS_AS(cc.applyCipher(std::string(65, 'x'), CipherMode::Encrypt),
+                      std::length_error);
+}
+
+TEST_CASE("ChaCha20 key validation", "[chacha20]")
+{
+    REQUIRE_THROWS_AS(ChaCha20Cipher{""}, InvalidKey);
+    REQUIRE_THROWS_AS(ChaCha20Cipher{rfcKey}, InvalidKey);
+    REQUIRE_THROWS_AS(ChaCha20Cipher{rfcKey + ",0000"}, InvalidKey);
+    REQUIRE_THROWS_AS(ChaCha20Cipher{"00" + rfcKey.substr(2) + "z," +
+                                     std::string(24, '0')},
+                      InvalidKey);
+    REQUIRE_THROWS_AS(
+        ChaCha20Cipher{rfcKey + "," + std::string(24, '0') + ",4294967296"},
+        InvalidKey);
+    REQUIRE_THROWS_AS(
+        ChaCha20Cipher{rfcKey + "," + std::string(24, '0') + ",-1"},
+        InvalidKey);
+}
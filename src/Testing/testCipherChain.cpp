@@ -0,0 +1,126 @@
+//! Unit Tests for MPAGSCipher CipherChain functions
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CaesarCipher.hpp"
+#include "CipherChain.hpp"
+#include "EnigmaCipher.hpp"
+#include "PlayfairCipher.hpp"
+#include "SubstitutionCipher.hpp"
+#include "VigenereCipher.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    std::vector<std::unique_ptr<Cipher>> makeChain()
+    {
+        std::vector<std::unique_ptr<Cipher>> ciphers;
+        ciphers.push_back(std::make_unique<CaesarCipher>(3));
+        ciphers.push_back(std::make_unique<SubstitutionCipher>("zebras"));
+        ciphers.push_back(std::make_unique<VigenereCipher>("hello"));
+        ciphers.push_back(std::make_unique<CaesarCipher>(7));
+        return ciphers;
+    }
+
+    std::string applyChain(const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                           std::string text, const CipherMode mode)
+    {
+        for (const auto& cipher : ciphers) {
+            text = cipher->applyCipher(text, mode);
+        }
+        return text;
+    }
+}    // namespace
+
+TEST_CASE("Runs of substitutions are collapsed", "[cipherchain]")
+{
+    auto ciphers = makeChain();
+    CipherChain::collapse(ciphers, CipherMode::Encrypt);
+
+    REQUIRE(ciphers.size() == 3);
+    REQUIRE(ciphers[0]->type() == CipherType::Substitution);
+    REQUIRE(ciphers[1]->type() == CipherType::Vigenere);
+    REQUIRE(ciphers[2]->type() == CipherType::Substitution);
+}
+
+TEST_CASE("Collapsed chain gives the same encryption", "[cipherchain]")
+{
+    const std::string plainText{"THISISQUITEALONGMESSAGEFORTHECHAIN"};
+    const auto ciphers = makeChain();
+    auto collapsed = makeChain();
+    CipherChain::collapse(collapsed, CipherMode::Encrypt);
+
+    REQUIRE(applyChain(collapsed, plainText, CipherMode::Encrypt) ==
+            applyChain(ciphers, plainText, CipherMode::Encrypt));
+}
+
+TEST_CASE("Collapsed chain gives the same decryption", "[cipherchain]")
+{
+    const std::string cipherText{"QNOMCBPKSRGGZAUXWIQPAFIJORKYESEQNT"};
+    auto ciphers = makeChain();
+    std::reverse(ciphers.begin(), ciphers.end());
+    auto collapsed = makeChain();
+    std::reverse(collapsed.begin(), collapsed.end());
+    CipherChain::collapse(collapsed, CipherMode::Decrypt);
+
+    REQUIRE(applyChain(collapsed, cipherText, CipherMode::Decrypt) ==
+            applyChain(ciphers, cipherText, CipherMode::Decrypt));
+}
+
+TEST_CASE("Only ChaCha20 and AES operate on bytes", "[cipherchain]")
+{
+    REQUIRE(CipherChain::operatesOnBytes(CipherType::ChaCha20));
+    REQUIRE(CipherChain::operatesOnBytes(CipherType::AesCtr));
+    REQUIRE_FALSE(CipherChain::operatesOnBytes(CipherType::Caesar));
+    REQUIRE_FALSE(CipherChain::operatesOnBytes(CipherType::Vigenere));
+    REQUIRE_FALSE(CipherChain::operatesOnBytes(CipherType::Enigma));
+}
+
+TEST_CASE("Reversible ciphers are identified", "[cipherchain]")
+{
+    REQUIRE(CipherChain::isReversible(CipherType::Caesar));
+    REQUIRE(CipherChain::isReversible(CipherType::Vigenere));
+    REQUIRE(CipherChain::isReversible(CipherType::ColumnarTransposition));
+    REQUIRE(CipherChain::isReversible(CipherType::Enigma));
+    REQUIRE_FALSE(CipherChain::isReversible(CipherType::Playfair));
+    REQUIRE_FALSE(CipherChain::isReversible(CipherType::Hill));
+    REQUIRE_FALSE(CipherChain::isReversible(CipherType::Bifid));
+    REQUIRE_FALSE(CipherChain::isReversible(CipherType::ChaCha20));
+}
+
+TEST_CASE("Seekable ciphers can start part way into a text", "[cipherchain]")
+{
+    REQUIRE(CipherChain::isSeekable(CipherType::Caesar));
+    REQUIRE(CipherChain::isSeekable(CipherType::Vigenere));
+    REQUIRE(CipherChain::isSeekable(CipherType::Enigma));
+    REQUIRE_FALSE(CipherChain::isSeekable(CipherType::Playfair));
+    REQUIRE_FALSE(CipherChain::isSeekable(CipherType::Autokey));
+
+    std::string plainText;
+    for (std::size_t i{0}; i < 1000; ++i) {
+        plainText += static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+
+    std::vector<std::unique_ptr<Cipher>> ciphers{makeChain()};
+    ciphers.push_back(std::make_unique<EnigmaCipher>("I II III,B,AAA,AAA"));
+    for (const auto& cipher : ciphers) {
+        const std::string cipherText{
+            cipher->applyCipher(plainText, CipherMode::Encrypt)};
+        for (const std::size_t offset : {0, 1, 4, 5, 677, 999}) {
+            const std::size_t length{std::min<std::size_t>(50, 1000 - offset)};
+            REQUIRE(CipherChain::applyCipherAt(
+                        *cipher, cipherText.substr(offset, length),
+                        CipherMode::Decrypt,
+                        offset) == plainText.substr(offset, length));
+        }
+    }
+
+    const PlayfairCipher playfair{"key"};
+    REQUIRE_THROWS_AS(CipherChain::applyCipherAt(playfair, "ABCD",
+                                                 CipherMode::Encrypt, 2),
+                      std::invalid_argument);
+}
@@ -0,0 +1,95 @@
+//! Unit Tests for MPAGSCipher CipherSearch functions
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CipherFactory.hpp"
+#include "CipherSearch.hpp"
+#include "CipherType.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Find every (possibly overlapping) occurrence the slow way
+    std::vector<std::size_t> findAll(const std::string& text,
+                                     const std::string& phrase)
+    {
+        std::vector<std::size_t> offsets;
+        for (std::size_t pos{text.find(phrase)}; pos != std::string::npos;
+             pos = text.find(phrase, pos + 1)) {
+            offsets.push_back(pos);
+        }
+        return offsets;
+    }
+
+    /// Encrypt a text and check the search against the decrypted text
+    void checkSearch(const CipherType type, const std::string& key,
+                     const std::string& plainText, const std::string& phrase)
+    {
+        const std::string cipherText{
+            CipherFactory::makeCipher(type, key)->applyCipher(
+                plainText, CipherMode::Encrypt)};
+        REQUIRE(CipherSearch::findPhrase(type, key, cipherText, phrase) ==
+                findAll(plainText, phrase));
+    }
+}    // namespace
+
+TEST_CASE("Search encrypts the phrase for each alignment", "[search]")
+{
+    REQUIRE(CipherSearch::encryptPhrase(CipherType::Caesar, "3", "HELLO") ==
+            std::vector<std::string>{"KHOOR"});
+    REQUIRE(CipherSearch::encryptPhrase(CipherType::Vigenere, "abc", "AAAA") ==
+            std::vector<std::string>{"ABCA", "BCAB", "CABC"});
+}
+
+TEST_CASE("Search Caesar cipher text", "[search]")
+{
+    const std::string text{"THEQUICKBROWNFOXJUMPSOVERTHELAZYDOGTHETHE"};
+    checkSearch(CipherType::Caesar, "7", text, "THE");
+    checkSearch(CipherType::Caesar, "7", text, "Q");
+    checkSearch(CipherType::Caesar, "7", text, "CAT");
+    checkSearch(CipherType::Caesar, "7", text, text);
+}
+
+TEST_CASE("Search Vigenere cipher text", "[search]")
+{
+    const std::string text{"ATTACKATDAWNATTACKATDUSKATTACKATONCEATTACK"};
+    checkSearch(CipherType::Vigenere, "lemon", text, "ATTACK");
+    checkSearch(CipherType::Vigenere, "lemon", text, "A");
+    checkSearch(CipherType::Vigenere, "lemon", text, "TT");
+    checkSearch(CipherType::Vigenere, "lemon", text, "RETREAT");
+    checkSearch(CipherType::Vigenere, "lemon", "ATT", "ATTACK");
+}
+
+TEST_CASE("Search long text across chunks", "[search]")
+{
+    // Long enough to be split into several chunks, with the phrase placed
+    // at every alignment and across the boundaries between chunks
+    std::string text;
+    for (std::size_t i{0}; i < 3000017; ++i) {
+        text += static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+    for (std::size_t pos{(1 << 20) - 5}; pos < text.size(); pos += 99991) {
+        text.replace(pos, 8, "NEEDLEXX");
+    }
+    text.replace(text.size() - 6, 6, "NEEDLE");
+
+    checkSearch(CipherType::Vigenere, "somewhatlongerkey", text, "NEEDLE");
+    checkSearch(CipherType::Caesar, "11", text, "NEEDLEXX");
+    checkSearch(CipherType::Caesar, "11", text, "AHO");
+}
+
+TEST_CASE("Search rejects unsupported ciphers and empty needles", "[search]")
+{
+    REQUIRE(CipherSearch::isSupported(CipherType::Vigenere));
+    REQUIRE_FALSE(CipherSearch::isSupported(CipherType::Playfair));
+    REQUIRE_THROWS_AS(CipherSearch::findPhrase(CipherType::Playfair, "key",
+                                               "ABC", "A"),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(CipherSearch::findPhrase(CipherType::Caesar, "1",
+                                               "ABC", ""),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(CipherSearch::findAligned("ABC", {"A", "AB"}),
+                      std::invalid_argument);
+}
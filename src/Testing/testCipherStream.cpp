@@ -0,0 +1,117 @@
+//! Unit Tests for MPAGSCipher CipherStream Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CaesarCipher.hpp"
+#include "CipherStream.hpp"
+#include "EnigmaCipher.hpp"
+#include "HillCipher.hpp"
+#include "PlayfairCipher.hpp"
+#include "VigenereCipher.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Apply a chain of ciphers to a whole text at once
+    std::string applyAll(const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                         const std::string& text, const CipherMode cipherMode)
+    {
+        std::string output{text};
+        for (const auto& cipher : ciphers) {
+            output = cipher->applyCipher(output, cipherMode);
+        }
+        return output;
+    }
+
+    /// Stream a text through a chain of ciphers in pieces of varying sizes
+    std::string applyInPieces(
+        const std::vector<std::unique_ptr<Cipher>>& ciphers,
+        const std::string& text, const CipherMode cipherMode)
+    {
+        CipherStream stream{ciphers, cipherMode};
+        std::string output;
+        std::size_t start{0};
+        for (std::size_t length{0}; start < text.size(); ++length) {
+            const std::size_t n{std::min(length % 7, text.size() - start)};
+            output += stream.push(text.substr(start, n));
+            start += n;
+        }
+        return output + stream.finish();
+    }
+}    // namespace
+
+TEST_CASE("Streaming keeps the key phase across pieces", "[cipherstream]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<VigenereCipher>("lemon"));
+    ciphers.push_back(std::make_unique<CaesarCipher>(5));
+    ciphers.push_back(
+        std::make_unique<EnigmaCipher>("IV II V,C,BUL,XYZ,AZ BY CX"));
+
+    const std::string text{"ATTACKATDAWNTHENRETREATTOTHEHILLSBEFOREDUSK"};
+    for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+        REQUIRE(applyInPieces(ciphers, text, mode) ==
+                applyAll(ciphers, text, mode));
+    }
+}
+
+TEST_CASE("Playfair holds back a letter until its pair arrives",
+          "[cipherstream]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<PlayfairCipher>("playfair example"));
+
+    // A letter with nothing to pair with yet comes out with the next piece
+    CipherStream stream{ciphers, CipherMode::Encrypt};
+    const PlayfairCipher playfair{"playfair example"};
+    REQUIRE(stream.push("HID").size() == 2);
+    REQUIRE(stream.push("ETHEGOLD") ==
+            playfair.applyCipher("HIDETHEGOLD", CipherMode::Encrypt)
+                .substr(2, 8));
+    REQUIRE(stream.finish() ==
+            playfair.applyCipher("HIDETHEGOLD", CipherMode::Encrypt)
+                .substr(10));
+}
+
+TEST_CASE("Streaming Playfair matches the whole text", "[cipherstream]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<VigenereCipher>("key"));
+    ciphers.push_back(std::make_unique<PlayfairCipher>("playfair example"));
+    ciphers.push_back(std::make_unique<CaesarCipher>(3));
+
+    // Repeated letters (including X's and a J next to an I) are split
+    // across the pieces, and the text has an odd length
+    for (const std::string text :
+         {"BALLOONXXXTOOOIJIJSEEKKEEPERZ", "HELLOWORLD", "A", "",
+          "BOOKKEEPERSMISSISSIPPIJIGSAWWZZZ"}) {
+        REQUIRE(applyInPieces(ciphers, text, CipherMode::Encrypt) ==
+                applyAll(ciphers, text, CipherMode::Encrypt));
+    }
+
+    std::vector<std::unique_ptr<Cipher>> decrypt;
+    decrypt.push_back(std::make_unique<CaesarCipher>(3));
+    decrypt.push_back(std::make_unique<PlayfairCipher>("playfair example"));
+    decrypt.push_back(std::make_unique<VigenereCipher>("key"));
+    const std::string cipherText{applyAll(
+        ciphers, "BALLOONXXXTOOOIJIJSEEKKEEPERZ", CipherMode::Encrypt)};
+    REQUIRE(applyInPieces(decrypt, cipherText, CipherMode::Decrypt) ==
+            applyAll(decrypt, cipherText, CipherMode::Decrypt));
+}
+
+TEST_CASE("Ciphers that need the whole text cannot be streamed",
+          "[cipherstream]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<CaesarCipher>(3));
+    ciphers.push_back(std::make_unique<HillCipher>("GYBNQKURP"));
+    REQUIRE_THROWS_AS(CipherStream(ciphers, CipherMode::Encrypt),
+                      std::invalid_argument);
+    REQUIRE(CipherStream::isSupported(CipherType::Playfair));
+    REQUIRE_FALSE(CipherStream::isSupported(CipherType::Hill));
+}
@@ -5,11 +5,20 @@
 #include <map>
 #include <string>
 
+#include "AffineCipher.hpp"
+#include "AutokeyCipher.hpp"
+#include "BifidCipher.hpp"
 #include "CaesarCipher.hpp"
 #include "Cipher.hpp"
 #include "CipherMode.hpp"
 #include "CipherType.hpp"
+#include "ColumnarTranspositionCipher.hpp"
+#include "EnigmaCipher.hpp"
+#include "FourSquareCipher.hpp"
+#include "HillCipher.hpp"
 #include "PlayfairCipher.hpp"
+#include "RailFenceCipher.hpp"
+#include "SubstitutionCipher.hpp"
 #include "VigenereCipher.hpp"
 
 std::map<CipherType, std::string> plainText{
@@ -17,14 +26,32 @@ std::map<CipherType, std::string> plainText{
     {CipherType::Playfair,
      "BOBISXSOMESORTOFIUNIORCOMPLEXQXENOPHONEONEZEROTHINGZ"},
     {CipherType::Vigenere,
-     "THISISQUITEALONGMESSAGESOTHEKEYWILLNEEDTOREPEATAFEWTIMES"}};
+     "THISISQUITEALONGMESSAGESOTHEKEYWILLNEEDTOREPEATAFEWTIMES"},
+    {CipherType::Substitution, "HELLOWORLD"},
+    {CipherType::Affine, "AFFINECIPHER"},
+    {CipherType::Hill, "ACTCAT"},
+    {CipherType::ColumnarTransposition, "WEAREDISCOVEREDFLEEATONCE"},
+    {CipherType::RailFence, "WEAREDISCOVEREDFLEEATONCE"},
+    {CipherType::Enigma, "WEAREDISCOVEREDFLEEATONCE"},
+    {CipherType::Bifid, "WEAREDISCOVEREDFLEEATONCE"},
+    {CipherType::FourSquare, "HELPMEOBIWANKENOBI"},
+    {CipherType::Autokey, "ATTACKATDAWN"}};
 
 std::map<CipherType, std::string> cipherText{
     {CipherType::Caesar, "ROVVYGYBVN"},
     {CipherType::Playfair,
      "FHIQXLTLKLTLSUFNPQPKETFENIOLVSWLTFIAFTLAKOWATEQOKPPA"},
     {CipherType::Vigenere,
-     "ALTDWZUFTHLEWZBNQPDGHKPDCALPVSFATWZUIPOHVVPASHXLQSDXTXSZ"}};
+     "ALTDWZUFTHLEWZBNQPDGHKPDCALPVSFATWZUIPOHVVPASHXLQSDXTXSZ"},
+    {CipherType::Substitution, "SVOOLDLIOW"},
+    {CipherType::Affine, "IHHWVCSWFRCP"},
+    {CipherType::Hill, "POHFIN"},
+    {CipherType::ColumnarTransposition, "EVLNACDTESEAROFODEECWIREE"},
+    {CipherType::RailFence, "WECRLTEERDSOEEFEAOCAIVDEN"},
+    {CipherType::Enigma, "NYQYQTJMNTSQOAUMXXDLJXULV"},
+    {CipherType::Bifid, "WLHAIROTYOWBRLFPHFIASOMIN"},
+    {CipherType::FourSquare, "FYNFNEHWBXAFFOKHMD"},
+    {CipherType::Autokey, "QNXEPVYTWTWP"}};
 
 bool testCipher(const Cipher& cipher, const CipherMode mode,
                 const std::string& inputText, const std::string& outputText)
@@ -37,6 +64,15 @@ TEST_CASE("Cipher encryption", "[ciphers]")
     CaesarCipher cc{10};
     PlayfairCipher pc{"hello"};
     VigenereCipher vc{"hello"};
+    SubstitutionCipher sc{"ZYXWVUTSRQPONMLKJIHGFEDCBA"};
+    AffineCipher ac{5, 8};
+    HillCipher hc{"GYBNQKURP"};
+    ColumnarTranspositionCipher ct{"zebras"};
+    RailFenceCipher rf{3};
+    EnigmaCipher ec{"IV II V,C,BUL,XYZ,AZ BY CX"};
+    BifidCipher bc{"playfair,5"};
+    FourSquareCipher fs{"example,keyword"};
+    AutokeyCipher ak{"queenly"};
 
     REQUIRE(testCipher(cc, CipherMode::Encrypt, plainText[CipherType::Caesar],
                        cipherText[CipherType::Caesar]));
@@ -44,6 +80,28 @@ TEST_CASE("Cipher encryption", "[ciphers]")
                        cipherText[CipherType::Playfair]));
     REQUIRE(testCipher(vc, CipherMode::Encrypt, plainText[CipherType::Vigenere],
                        cipherText[CipherType::Vigenere]));
+    REQUIRE(testCipher(sc, CipherMode::Encrypt,
+                       plainText[CipherType::Substitution],
+                       cipherText[CipherType::Substitution]));
+    REQUIRE(testCipher(ac, CipherMode::Encrypt, plainText[CipherType::Affine],
+                       cipherText[CipherType::Affine]));
+    REQUIRE(testCipher(hc, CipherMode::Encrypt, plainText[CipherType::Hill],
+                       cipherText[CipherType::Hill]));
+    REQUIRE(testCipher(ct, CipherMode::Encrypt,
+                       plainText[CipherType::ColumnarTransposition],
+                       cipherText[CipherType::ColumnarTransposition]));
+    REQUIRE(testCipher(rf, CipherMode::Encrypt,
+                       plainText[CipherType::RailFence],
+                       cipherText[CipherType::RailFence]));
+    REQUIRE(testCipher(ec, CipherMode::Encrypt, plainText[CipherType::Enigma],
+                       cipherText[CipherType::Enigma]));
+    REQUIRE(testCipher(bc, CipherMode::Encrypt, plainText[CipherType::Bifid],
+                       cipherText[CipherType::Bifid]));
+    REQUIRE(testCipher(fs, CipherMode::Encrypt,
+                       plainText[CipherType::FourSquare],
+                       cipherText[CipherType::FourSquare]));
+    REQUIRE(testCipher(ak, CipherMode::Encrypt, plainText[CipherType::Autokey],
+                       cipherText[CipherType::Autokey]));
 }
 
 TEST_CASE("Cipher decryption", "[ciphers]")
@@ -51,6 +109,15 @@ TEST_CASE("Cipher decryption", "[ciphers]")
     CaesarCipher cc{10};
     PlayfairCipher pc{"hello"};
     VigenereCipher vc{"hello"};
+    SubstitutionCipher sc{"ZYXWVUTSRQPONMLKJIHGFEDCBA"};
+    AffineCipher ac{5, 8};
+    HillCipher hc{"GYBNQKURP"};
+    ColumnarTranspositionCipher ct{"zebras"};
+    RailFenceCipher rf{3};
+    EnigmaCipher ec{"IV II V,C,BUL,XYZ,AZ BY CX"};
+    BifidCipher bc{"playfair,5"};
+    FourSquareCipher fs{"example,keyword"};
+    AutokeyCipher ak{"queenly"};
 
     REQUIRE(testCipher(cc, CipherMode::Decrypt, cipherText[CipherType::Caesar],
                        plainText[CipherType::Caesar]));
@@ -60,4 +127,26 @@ TEST_CASE("Cipher decryption", "[ciphers]")
     REQUIRE(testCipher(vc, CipherMode::Decrypt,
                        cipherText[CipherType::Vigenere],
                        plainText[CipherType::Vigenere]));
+    REQUIRE(testCipher(sc, CipherMode::Decrypt,
+                       cipherText[CipherType::Substitution],
+                       plainText[CipherType::Substitution]));
+    REQUIRE(testCipher(ac, CipherMode::Decrypt, cipherText[CipherType::Affine],
+                       plainText[CipherType::Affine]));
+    REQUIRE(testCipher(hc, CipherMode::Decrypt, cipherText[CipherType::Hill],
+                       plainText[CipherType::Hill]));
+    REQUIRE(testCipher(ct, CipherMode::Decrypt,
+                       cipherText[CipherType::ColumnarTransposition],
+                       plainText[CipherType::ColumnarTransposition]));
+    REQUIRE(testCipher(rf, CipherMode::Decrypt,
+                       cipherText[CipherType::RailFence],
+                       plainText[CipherType::RailFence]));
+    REQUIRE(testCipher(ec, CipherMode::Decrypt, cipherText[CipherType::Enigma],
+                       plainText[CipherType::Enigma]));
+    REQUIRE(testCipher(bc, CipherMode::Decrypt, cipherText[CipherType::Bifid],
+                       plainText[CipherType::Bifid]));
+    REQUIRE(testCipher(fs, CipherMode::Decrypt,
+                       cipherText[CipherType::FourSquare],
+                       plainText[CipherType::FourSquare]));
+    REQUIRE(testCipher(ak, CipherMode::Decrypt, cipherText[CipherType::Autokey],
+                       plainText[CipherType::Autokey]));
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+//! Unit Tests for MPAGSCipher ColumnarTranspositionCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "ColumnarTranspositionCipher.hpp"
+
+#include <string>
+
+TEST_CASE("Columnar Transposition Cipher encryption", "[columnar]")
+{
+    ColumnarTranspositionCipher ct{"zebras"};
+    REQUIRE(ct.applyCipher("WEAREDISCOVEREDFLEEATONCE", CipherMode::Encrypt) ==
+            "EVLNACDTESEAROFODEECWIREE");
+}
+
+TEST_CASE("Columnar Transposition Cipher decryption", "[columnar]")
+{
+    ColumnarTranspositionCipher ct{"zebras"};
+    REQUIRE(ct.applyCipher("EVLNACDTESEAROFODEECWIREE", CipherMode::Decrypt) ==
+            "WEAREDISCOVEREDFLEEATONCE");
+}
+
+TEST_CASE("Columnar Transposition Cipher double transposition", "[columnar]")
+{
+    ColumnarTranspositionCipher ct{"zebras,tiger"};
+    REQUIRE(ct.applyCipher("WEAREDISCOVEREDFLEEATONCE", CipherMode::Encrypt) ==
+            "NEOEELTRERVDADIASFCEECEOW");
+    REQUIRE(ct.applyCipher("NEOEELTRERVDADIASFCEECEOW", CipherMode::Decrypt) ==
+            "WEAREDISCOVEREDFLEEATONCE");
+}
+
+TEST_CASE("Columnar Transposition Cipher long text", "[columnar]")
+{
+    // Long enough to be split into many tiles, with an incomplete last row
+    std::string plainText;
+    for (std::size_t i{0}; i < 1000003; ++i) {
+        plainText += static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+    ColumnarTranspositionCipher ct{"transposition,columns"};
+    const std::string cipherText{
+        ct.applyCipher(plainText, CipherMode::Encrypt)};
+    REQUIRE(cipherText != plainText);
+    REQUIRE(ct.applyCipher(cipherText, CipherMode::Decrypt) == plainText);
+}
+
+TEST_CASE("Columnar Transposition Cipher key validation", "[columnar]")
+{
+    REQUIRE_THROWS_AS(ColumnarTranspositionCipher{""}, InvalidKey);
+    REQUIRE_THROWS_AS(ColumnarTranspositionCipher{"a,"}, InvalidKey);
+    REQUIRE_THROWS_AS(ColumnarTranspositionCipher{"a,b,c"}, InvalidKey);
+}
@@ -0,0 +1,59 @@
+//! Unit Tests for MPAGSCipher Crc32c functions
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "Crc32c.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+TEST_CASE("CRC32C check values", "[crc32c]")
+{
+    // From RFC 3720 (iSCSI), appendix B.4
+    const std::string digits{"123456789"};
+    const std::string zeros(32, '\x00');
+    const std::string ones(32, '\xff');
+    std::string ascending(32, '\x00');
+    for (std::size_t i{0}; i < ascending.size(); ++i) {
+        ascending[i] = static_cast<char>(i);
+    }
+
+    for (const auto checksum : {Crc32c::checksum, Crc32c::checksumSoftware}) {
+        REQUIRE(checksum(digits.data(), digits.size(), 0) == 0xE3069283);
+        REQUIRE(checksum(zeros.data(), zeros.size(), 0) == 0x8A9136AA);
+        REQUIRE(checksum(ones.data(), ones.size(), 0) == 0x62A8AB43);
+        REQUIRE(checksum(ascending.data(), ascending.size(), 0) ==
+                0x46DD794E);
+        REQUIRE(checksum(digits.data(), 0, 0) == 0);
+    }
+}
+
+TEST_CASE("CRC32C can be extended", "[crc32c]")
+{
+    const std::string text{"THEQUICKBROWNFOXJUMPSOVERTHELAZYDOG"};
+    const std::uint32_t whole{Crc32c::checksum(text.data(), text.size())};
+    for (std::size_t split{0}; split <= text.size(); ++split) {
+        const std::uint32_t first{Crc32c::checksum(text.data(), split)};
+        REQUIRE(Crc32c::checksum(text.data() + split, text.size() - split,
+                                 first) == whole);
+    }
+}
+
+TEST_CASE("CRC32C software and hardware agree", "[crc32c]")
+{
+    std::string text(300, 'A');
+    std::uint32_t seed{12345};
+    for (auto& c : text) {
+        seed = seed * 1103515245 + 12345;
+        c = static_cast<char>(seed >> 16);
+    }
+
+    // Every length and starting alignment up to a few words
+    for (std::size_t start{0}; start < 8; ++start) {
+        for (std::size_t n{0}; n + start <= text.size(); n += 7) {
+            REQUIRE(Crc32c::checksum(text.data() + start, n) ==
+                    Crc32c::checksumSoftware(text.data() + start, n));
+        }
+    }
+}
@@ -0,0 +1,180 @@
+//! Unit Tests for MPAGSCipher Csv functions and Scanner/Splitter classes
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CaesarCipher.hpp"
+#include "Csv.hpp"
+#include "PlayfairCipher.hpp"
+#include "VigenereCipher.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Find the separators a character at a time, to check the scanner against
+    std::vector<std::uint32_t> findSeparators(const std::string& text,
+                                              const char delimiter)
+    {
+        std::vector<std::uint32_t> separators;
+        bool quoted{false};
+        for (std::size_t i{0}; i < text.size(); ++i) {
+            if (text[i] == '"') {
+                quoted = !quoted;
+            } else if (!quoted && (text[i] == delimiter || text[i] == '\n')) {
+                separators.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        return separators;
+    }
+
+    /// Make some random text that is mostly delimiters, quotes and newlines
+    std::string randomText(const std::size_t n, std::size_t seed)
+    {
+        const std::string characters{",,\"\n\tabcdefgh"};
+        std::string text(n, ' ');
+        for (auto& c : text) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            c = characters[(seed >> 33) % characters.size()];
+        }
+        return text;
+    }
+}    // namespace
+
+TEST_CASE("Scanner skips separators inside quotes", "[csv]")
+{
+    const std::string text{"a,\"b,c\",d\n\"x\ny\",z"};
+    Csv::Scanner scanner;
+    std::vector<std::uint32_t> separators;
+    scanner.scan(text.data(), text.size(), separators);
+    REQUIRE(separators == std::vector<std::uint32_t>{1, 7, 9, 15});
+    REQUIRE_FALSE(scanner.inQuotes());
+}
+
+TEST_CASE("Scanner carries the quotes from one piece to the next", "[csv]")
+{
+    Csv::Scanner scanner{'\t'};
+    std::vector<std::uint32_t> separators;
+    scanner.scan("a\t\"b\tc", 6, separators);
+    REQUIRE(separators == std::vector<std::uint32_t>{1});
+    REQUIRE(scanner.inQuotes());
+
+    separators.clear();
+    scanner.scan("\nd\"\te\n", 6, separators);
+    REQUIRE(separators == std::vector<std::uint32_t>{3, 5});
+    REQUIRE_FALSE(scanner.inQuotes());
+}
+
+TEST_CASE("Scanner agrees with a character at a time", "[csv]")
+{
+    for (const char delimiter : {',', '\t'}) {
+        for (const std::size_t n : {0, 1, 63, 64, 65, 1000, 4099}) {
+            const std::string text{randomText(n, n + 7)};
+            const auto expected = findSeparators(text, delimiter);
+
+            Csv::Scanner scanner{delimiter};
+            std::vector<std::uint32_t> separators;
+            scanner.scan(text.data(), text.size(), separators);
+            REQUIRE(separators == expected);
+
+            Csv::Scanner portable{delimiter};
+            separators.clear();
+            portable.scanPortable(text.data(), text.size(), separators);
+            REQUIRE(separators == expected);
+
+            // Scanning in uneven pieces gives the same separators
+            Csv::Scanner pieces{delimiter};
+            std::vector<std::uint32_t> all;
+            for (std::size_t start{0}; start < n; start += 97) {
+                const std::size_t length{std::min<std::size_t>(97, n - start)};
+                separators.clear();
+                pieces.scan(text.data() + start, length, separators);
+                for (const std::uint32_t offset : separators) {
+                    all.push_back(static_cast<std::uint32_t>(start + offset));
+                }
+            }
+            REQUIRE(all == expected);
+        }
+    }
+}
+
+TEST_CASE("Scanner rejects delimiters it cannot tell apart", "[csv]")
+{
+    for (const char delimiter : {'"', '\n', '\r', '\0'}) {
+        REQUIRE_THROWS_AS(Csv::Scanner{delimiter}, std::invalid_argument);
+    }
+}
+
+TEST_CASE("Splitter keeps quoted newlines within their record", "[csv]")
+{
+    Csv::Splitter splitter;
+    std::string block;
+
+    REQUIRE_FALSE(splitter.add("1,\"two\nli", 9, block));
+    REQUIRE(splitter.add("nes\"\n2,b\n3,\"c", 13, block));
+    REQUIRE(block == "1,\"two\nlines\"\n2,b\n");
+
+    block.clear();
+    REQUIRE_FALSE(splitter.add("\n\"", 2, block));
+    REQUIRE(splitter.finish(block));
+    REQUIRE(block == "3,\"c\n\"");
+    REQUIRE_FALSE(splitter.finish(block));
+}
+
+TEST_CASE("Only the letters of the chosen fields are encrypted", "[csv]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<CaesarCipher>(1));
+
+    std::string block{
+        "id,name,city\n"
+        "1,\"Smith, Jo\",Leeds\n"
+        "2,O'Neil 3rd,\"New\nYork\"\r\n"
+        "3,,Zurich"};
+    Csv::apply(block, ',', {false, true, true}, ciphers, CipherMode::Encrypt);
+    REQUIRE(block ==
+            "id,obnf,djuz\n"
+            "1,\"Tnjui, Kp\",Mffet\n"
+            "2,P'Ofjm 3se,\"Ofx\nZpsl\"\r\n"
+            "3,,Avsjdi");
+
+    Csv::apply(block, ',', {false, true, true}, ciphers, CipherMode::Decrypt);
+    REQUIRE(block ==
+            "id,name,city\n"
+            "1,\"Smith, Jo\",Leeds\n"
+            "2,O'Neil 3rd,\"New\nYork\"\r\n"
+            "3,,Zurich");
+}
+
+TEST_CASE("Each field is a message of its own", "[csv]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<VigenereCipher>("key"));
+
+    std::string block{"hello\tworld\thello\nhello\tworld\thello\n"};
+    Csv::apply(block, '\t', {true, false, true}, ciphers,
+               CipherMode::Encrypt);
+
+    const VigenereCipher vigenere{"key"};
+    std::string hello{vigenere.applyCipher("HELLO", CipherMode::Encrypt)};
+    for (auto& c : hello) {
+        c = static_cast<char>(c | 0x20);
+    }
+    REQUIRE(block == hello + "\tworld\t" + hello + "\n" + hello + "\tworld\t" +
+                         hello + "\n");
+}
+
+TEST_CASE("Ciphers that change the number of letters are rejected", "[csv]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<PlayfairCipher>("playfair example"));
+
+    std::string block{"a,odd\n"};
+    REQUIRE_THROWS_AS(Csv::apply(block, ',', {false, true}, ciphers,
+                                 CipherMode::Encrypt),
+                      std::invalid_argument);
+}
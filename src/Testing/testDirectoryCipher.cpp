@@ -0,0 +1,161 @@
+//! Unit Tests for MPAGSCipher DirectoryCipher functions
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CaesarCipher.hpp"
+#include "DirectoryCipher.hpp"
+#include "PlayfairCipher.hpp"
+#include "TransformChar.hpp"
+#include "VigenereCipher.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    /// Write a file, creating its directory if need be
+    void writeFile(const fs::path& path, const std::string& contents)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream file{path, std::ios::binary};
+        file << contents;
+    }
+
+    /// Read the whole of a file
+    std::string readFile(const fs::path& path)
+    {
+        std::ifstream file{path, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{file},
+                           std::istreambuf_iterator<char>{}};
+    }
+
+    /// Make some text of mixed letters, digits, spaces and punctuation
+    std::string makeText(const std::size_t n, std::size_t seed)
+    {
+        const std::string characters{"abcdefghijklmnopqrstuvwxyz ,.12\n"};
+        std::string text(n, ' ');
+        for (auto& c : text) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            c = characters[(seed >> 33) % characters.size()];
+        }
+        return text;
+    }
+
+    /// Encrypt a file's contents as mpags-cipher would on its own
+    std::string encrypt(const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                        const std::string& contents)
+    {
+        std::string text;
+        for (const char c : contents) {
+            text += transformChar(c);
+        }
+        for (const auto& cipher : ciphers) {
+            text = cipher->applyCipher(text, CipherMode::Encrypt);
+        }
+        return text + "\n";
+    }
+
+    /// Make a tree of small files, an empty file and a large one
+    std::vector<std::pair<fs::path, std::string>> makeTree(const fs::path& top)
+    {
+        fs::remove_all(top);
+        std::vector<std::pair<fs::path, std::string>> files;
+        files.emplace_back("empty.txt", "");
+        files.emplace_back("large.txt", makeText(10000, 1));
+        for (std::size_t i{0}; i < 30; ++i) {
+            files.emplace_back("a/b" + std::to_string(i % 3) + "/small" +
+                                   std::to_string(i) + ".txt",
+                               makeText(50 + i * 13, i + 2));
+        }
+        fs::create_directories(top / "a" / "nothing");
+        for (const auto& [name, contents] : files) {
+            writeFile(top / name, contents);
+        }
+        return files;
+    }
+}    // namespace
+
+TEST_CASE("Every file in the tree is encrypted into a copy of it",
+          "[directorycipher]")
+{
+    const fs::path input{"testDirectoryCipher.in"};
+    const fs::path output{"testDirectoryCipher.out"};
+    const auto files = makeTree(input);
+    fs::remove_all(output);
+
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<VigenereCipher>("directory"));
+    ciphers.push_back(std::make_unique<CaesarCipher>(7));
+
+    // Small chunks, so that the large file is split and the small ones are
+    // packed several to a task
+    const DirectoryCipher::Stats stats{DirectoryCipher::apply(
+        input.string(), output.string(), ciphers, CipherMode::Encrypt, 4,
+        1000)};
+    REQUIRE(stats.files == files.size());
+    REQUIRE(stats.directories == 6);
+    REQUIRE(stats.threads == 4);
+    REQUIRE(stats.tasks > stats.directories);
+
+    std::size_t bytesIn{0};
+    for (const auto& [name, contents] : files) {
+        const bool same{readFile(output / name) == encrypt(ciphers, contents)};
+        REQUIRE(same);
+        bytesIn += contents.size();
+    }
+    REQUIRE(stats.bytesIn == bytesIn);
+    REQUIRE(fs::is_directory(output / "a" / "nothing"));
+
+    fs::remove_all(input);
+    fs::remove_all(output);
+}
+
+TEST_CASE("Files are not split for ciphers that need the whole text",
+          "[directorycipher]")
+{
+    const fs::path input{"testDirectoryCipher.whole.in"};
+    const fs::path output{"testDirectoryCipher.whole.out"};
+    const auto files = makeTree(input);
+
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<PlayfairCipher>("playfair example"));
+    DirectoryCipher::apply(input.string(), output.string(), ciphers,
+                           CipherMode::Encrypt, 3, 1000);
+    for (const auto& [name, contents] : files) {
+        const bool same{readFile(output / name) == encrypt(ciphers, contents)};
+        REQUIRE(same);
+    }
+
+    fs::remove_all(input);
+    fs::remove_all(output);
+}
+
+TEST_CASE("Directories that cannot be used are rejected", "[directorycipher]")
+{
+    const fs::path input{"testDirectoryCipher.bad.in"};
+    makeTree(input);
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<CaesarCipher>(1));
+
+    REQUIRE_THROWS_AS(DirectoryCipher::apply((input / "large.txt").string(),
+                                             "testDirectoryCipher.bad.out",
+                                             ciphers, CipherMode::Encrypt),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        DirectoryCipher::apply(input.string(), (input / "a" / "out").string(),
+                               ciphers, CipherMode::Encrypt),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        DirectoryCipher::apply(input.string(), input.string(), ciphers,
+                               CipherMode::Encrypt),
+        std::invalid_argument);
+
+    fs::remove_all(input);
+}
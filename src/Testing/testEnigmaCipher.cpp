@@ -0,0 +1,89 @@
+//! Unit Tests for MPAGSCipher EnigmaCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "EnigmaCipher.hpp"
+
+#include <string>
+
+TEST_CASE("Enigma Cipher encryption", "[enigma]")
+{
+    EnigmaCipher ec{"I II III,B,AAA,AAA"};
+    REQUIRE(ec.applyCipher("AAAAA", CipherMode::Encrypt) == "BDZGO");
+}
+
+TEST_CASE("Enigma Cipher decryption", "[enigma]")
+{
+    EnigmaCipher ec{"I II III,B,AAA,AAA"};
+    REQUIRE(ec.applyCipher("BDZGO", CipherMode::Decrypt) == "AAAAA");
+}
+
+TEST_CASE("Enigma Cipher ring settings and plugboard", "[enigma]")
+{
+    EnigmaCipher ec{"I II III,B,BBB,AAA"};
+    REQUIRE(ec.applyCipher("AAAAA", CipherMode::Encrypt) == "EWTYX");
+
+    EnigmaCipher plugged{"iv ii v,c,bul,xyz,az by cx"};
+    const std::string cipherText{plugged.applyCipher(
+        "WEAREDISCOVEREDFLEEATONCE", CipherMode::Encrypt)};
+    REQUIRE(cipherText == "NYQYQTJMNTSQOAUMXXDLJXULV");
+    REQUIRE(plugged.applyCipher(cipherText, CipherMode::Decrypt) ==
+            "WEAREDISCOVEREDFLEEATONCE");
+}
+
+TEST_CASE("Enigma Cipher double step", "[enigma]")
+{
+    EnigmaCipher ec{"I II III,B,AAA,ADU"};
+    REQUIRE(ec.rotorPositions(0) == "ADU");
+    REQUIRE(ec.rotorPositions(1) == "ADV");
+    REQUIRE(ec.rotorPositions(2) == "AEW");
+    REQUIRE(ec.rotorPositions(3) == "BFX");
+}
+
+TEST_CASE("Enigma Cipher long text", "[enigma]")
+{
+    // Longer than a full cycle of the rotors (26 * 25 * 26 steps)
+    const std::string plainText(40000, 'A');
+
+    EnigmaCipher ec{"I II III,B,AAA,AAA"};
+    const std::string cipherText{
+        ec.applyCipher(plainText, CipherMode::Encrypt)};
+    REQUIRE(cipherText.substr(39990) == "CCKMYSGTHS");
+    REQUIRE(ec.rotorPositions(40000) == "KOM");
+
+    EnigmaCipher twoNotches{"VI VII VIII,C,ZZZ,QMY,QW ER"};
+    REQUIRE(twoNotches.applyCipher(plainText, CipherMode::Encrypt)
+                .substr(39990) == "MTBKVMVSIF");
+    REQUIRE(twoNotches.rotorPositions(40000) == "NSK");
+}
+
+TEST_CASE("Enigma Cipher starting part way into the text", "[enigma]")
+{
+    std::string plainText;
+    for (std::size_t i{0}; i < 200000; ++i) {
+        plainText += static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+
+    EnigmaCipher ec{"II IV I,B,QRS,XYZ,AB CD EF"};
+    const std::string cipherText{
+        ec.applyCipher(plainText, CipherMode::Encrypt)};
+    for (const std::size_t offset : {1, 17, 16900, 123457}) {
+        REQUIRE(ec.applyCipherAt(plainText.substr(offset), offset) ==
+                cipherText.substr(offset));
+    }
+    REQUIRE(ec.applyCipherAt(plainText, 0, 1) == cipherText);
+    REQUIRE(ec.applyCipher(cipherText, CipherMode::Decrypt) == plainText);
+}
+
+TEST_CASE("Enigma Cipher key validation", "[enigma]")
+{
+    REQUIRE_THROWS_AS(EnigmaCipher{""}, InvalidKey);
+    REQUIRE_THROWS_AS(EnigmaCipher{"I II,B,AAA,AAA"}, InvalidKey);
+    REQUIRE_THROWS_AS(EnigmaCipher{"I II IX,B,AAA,AAA"}, InvalidKey);
+    REQUIRE_THROWS_AS(EnigmaCipher{"I II I,B,AAA,AAA"}, InvalidKey);
+    REQUIRE_THROWS_AS(EnigmaCipher{"I II III,D,AAA,AAA"}, InvalidKey);
+    REQUIRE_THROWS_AS(EnigmaCipher{"I II III,B,AA,AAA"}, InvalidKey);
+    REQUIRE_THROWS_AS(EnigmaCipher{"I II III,B,AAA,A1A"}, InvalidKey);
+    REQUIRE_THROWS_AS(EnigmaCipher{"I II III,B,AAA,AAA,AB BC"}, InvalidKey);
+    REQUIRE_THROWS_AS(EnigmaCipher{"I II III,B,AAA,AAA,ABC"}, InvalidKey);
+}
@@ -0,0 +1,191 @@
+//! Unit Tests for MPAGSCipher FdReader and FdWriter Classes
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "FdIo.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    std::string makeContents(const std::size_t n)
+    {
+        std::string contents(n, 'A');
+        for (std::size_t i{0}; i < n; ++i) {
+            contents[i] = static_cast<char>('A' + (i * 7 + i / 13) % 26);
+        }
+        return contents;
+    }
+
+    /// Read everything from a file descriptor with plain read() calls
+    std::string readFd(const int fd)
+    {
+        std::string contents;
+        char buffer[4096];
+        ssize_t n{0};
+        while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) {
+            contents.append(buffer, static_cast<std::size_t>(n));
+        }
+        return contents;
+    }
+}    // namespace
+
+TEST_CASE("FdReader gives back full blocks of a file", "[fdio]")
+{
+    const std::string fileName{"testFdIo.read.txt"};
+    const std::string contents{makeContents(10007)};
+    {
+        std::ofstream file{fileName, std::ios::binary};
+        file << contents;
+    }
+
+    const int fd{::open(fileName.c_str(), O_RDONLY)};
+    REQUIRE(fd >= 0);
+    FdReader reader{fd, 1000};
+    std::string read;
+    const char* data{nullptr};
+    std::size_t n{0};
+    std::size_t nBlocks{0};
+    while (reader.next(data, n)) {
+        read.append(data, n);
+        ++nBlocks;
+    }
+    ::close(fd);
+    std::remove(fileName.c_str());
+
+    REQUIRE(read == contents);
+    REQUIRE(nBlocks == 11);
+    REQUIRE_FALSE(reader.next(data, n));
+    REQUIRE_THROWS_AS(FdReader(0, 0), std::invalid_argument);
+}
+
+TEST_CASE("FdReader fills blocks from a pipe written in small pieces",
+          "[fdio]")
+{
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    const std::string contents{makeContents(100003)};
+
+    std::thread producer{[&]() {
+        for (std::size_t i{0}; i < contents.size(); i += 100) {
+            const std::size_t n{
+                std::min<std::size_t>(100, contents.size() - i)};
+            if (::write(fds[1], contents.data() + i, n) < 0) {
+                break;
+            }
+        }
+        ::close(fds[1]);
+    }};
+
+    FdReader reader{fds[0], 10000};
+    std::string read;
+    const char* data{nullptr};
+    std::size_t n{0};
+    bool allFull{true};
+    while (reader.next(data, n)) {
+        read.append(data, n);
+        allFull = allFull && (n == 10000 || read.size() == contents.size());
+    }
+    producer.join();
+    ::close(fds[0]);
+
+    REQUIRE(read == contents);
+    REQUIRE(allFull);
+}
+
+TEST_CASE("FdReader can give back each read as it arrives", "[fdio]")
+{
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    FdReader reader{fds[0], 10000, false};
+    const char* data{nullptr};
+    std::size_t n{0};
+
+    // Each line is given back without waiting for the block to fill
+    for (const std::string line : {"first line\n", "second\n"}) {
+        REQUIRE(::write(fds[1], line.data(), line.size()) ==
+                static_cast<ssize_t>(line.size()));
+        REQUIRE(reader.next(data, n));
+        REQUIRE(std::string(data, n) == line);
+    }
+    ::close(fds[1]);
+    REQUIRE_FALSE(reader.next(data, n));
+    ::close(fds[0]);
+}
+
+TEST_CASE("FdWriter writes everything to a file", "[fdio]")
+{
+    const std::string fileName{"testFdIo.write.txt"};
+    const std::string contents{makeContents(100003)};
+
+    // Small and large pieces, with a block size that does not divide them
+    for (const std::size_t pieceSize : {1, 77, 5000, 100003}) {
+        const int fd{::open(fileName.c_str(),
+                            O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+        REQUIRE(fd >= 0);
+        {
+            FdWriter writer{fd, 4096};
+            REQUIRE_FALSE(writer.usesVmsplice());
+            for (std::size_t i{0}; i < contents.size(); i += pieceSize) {
+                writer.write(contents.substr(i, pieceSize));
+            }
+        }
+        ::close(fd);
+
+        std::ifstream file{fileName, std::ios::binary};
+        const std::string written{std::istreambuf_iterator<char>{file},
+                                  std::istreambuf_iterator<char>{}};
+        REQUIRE(written == contents);
+    }
+    std::remove(fileName.c_str());
+
+    REQUIRE_THROWS_AS(FdWriter(1, 0), std::invalid_argument);
+}
+
+TEST_CASE("FdWriter splices into a pipe without corrupting it", "[fdio]")
+{
+    for (const bool allowVmsplice : {true, false}) {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+
+        // Much more than the pipe holds, changing the text as it goes, so
+        // that reusing a block too soon would show up in what is read
+        std::string expected;
+        std::string read;
+        std::thread consumer{[&]() { read = readFd(fds[0]); }};
+        {
+            FdWriter writer{fds[1], 1 << 16, allowVmsplice};
+#if defined(__linux__)
+            REQUIRE(writer.usesVmsplice() == allowVmsplice);
+#endif
+            for (std::size_t i{0}; i < 400; ++i) {
+                std::string piece{makeContents(10000 + i)};
+                std::rotate(piece.begin(), piece.begin() + i, piece.end());
+                expected += piece;
+                writer.write(piece);
+                if (i % 97 == 0) {
+                    writer.flush();
+                    expected += "-";
+                    writer.write("-");
+                }
+            }
+            writer.flush();
+        }
+        ::close(fds[1]);
+        consumer.join();
+        ::close(fds[0]);
+
+        // Compare outside REQUIRE, so a failure does not print the text
+        const bool same{read == expected};
+        REQUIRE(same);
+    }
+}
@@ -0,0 +1,120 @@
+//! Unit Tests for MPAGSCipher FileFollower Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "FileFollower.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace {
+    /// Append some text to a file, as a program writing a log would
+    void append(const std::string& fileName, const std::string& text)
+    {
+        std::ofstream file{fileName, std::ios::binary | std::ios::app};
+        file << text;
+    }
+
+    /// Read what has been written to a file, waiting at most a second for it
+    std::string readAvailable(FileFollower& follower)
+    {
+        const char* data{nullptr};
+        std::size_t n{0};
+        REQUIRE(follower.next(data, n, 1000));
+        return std::string(data, n);
+    }
+}    // namespace
+
+TEST_CASE("Follower reads what is appended to a growing file", "[filefollower]")
+{
+    const std::string fileName{"testFileFollower.grow.txt"};
+    std::remove(fileName.c_str());
+    append(fileName, "first line\n");
+
+    FileFollower follower{fileName, 64};
+    REQUIRE(readAvailable(follower) == "first line\n");
+
+    // Nothing more has been written yet
+    const char* data{nullptr};
+    std::size_t n{1};
+    REQUIRE(follower.next(data, n, 20));
+    REQUIRE(n == 0);
+
+    // Something written while waiting is picked up as soon as it arrives
+    std::thread writer{[&]() {
+        for (std::size_t i{0}; i < 20; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{2});
+            append(fileName, "line " + std::to_string(i) + "\n");
+        }
+    }};
+    std::string expected;
+    for (std::size_t i{0}; i < 20; ++i) {
+        expected += "line " + std::to_string(i) + "\n";
+    }
+    std::string received;
+    while (received.size() < expected.size()) {
+        received += readAvailable(follower);
+    }
+    writer.join();
+    REQUIRE(received == expected);
+
+    // Once the file has been removed, whatever is left is read and then
+    // the follower stops
+    append(fileName, "last line");
+    std::remove(fileName.c_str());
+    REQUIRE(readAvailable(follower) == "last line");
+    REQUIRE_FALSE(follower.next(data, n, 1000));
+}
+
+TEST_CASE("Follower stops when the file is renamed", "[filefollower]")
+{
+    const std::string fileName{"testFileFollower.rotate.txt"};
+    const std::string rotatedName{"testFileFollower.rotate.txt.1"};
+    std::remove(fileName.c_str());
+    append(fileName, "old log");
+
+    FileFollower follower{fileName};
+    REQUIRE(readAvailable(follower) == "old log");
+
+    // A new file with the old name is not followed
+    std::rename(fileName.c_str(), rotatedName.c_str());
+    append(fileName, "new log");
+    const char* data{nullptr};
+    std::size_t n{0};
+    REQUIRE_FALSE(follower.next(data, n, 1000));
+
+    std::remove(fileName.c_str());
+    std::remove(rotatedName.c_str());
+}
+
+TEST_CASE("Follower starts again when the file is truncated", "[filefollower]")
+{
+    const std::string fileName{"testFileFollower.truncate.txt"};
+    std::remove(fileName.c_str());
+    append(fileName, "a longer first version");
+
+    FileFollower follower{fileName};
+    REQUIRE(readAvailable(follower) == "a longer first version");
+
+    {
+        std::ofstream file{fileName, std::ios::binary | std::ios::trunc};
+        file << "short";
+    }
+    REQUIRE(readAvailable(follower) == "short");
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Following a file that does not exist throws", "[filefollower]")
+{
+    REQUIRE_THROWS_AS(FileFollower{"testFileFollower.missing.txt"},
+                      std::system_error);
+    REQUIRE_THROWS_AS((FileFollower{"testFileFollower.missing.txt", 0}),
+                      std::invalid_argument);
+}
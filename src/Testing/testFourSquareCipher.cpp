@@ -0,0 +1,50 @@
+//! Unit Tests for MPAGSCipher FourSquareCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "FourSquareCipher.hpp"
+
+#include <string>
+
+TEST_CASE("Four-square Cipher encryption", "[foursquare]")
+{
+    FourSquareCipher fs{"example,keyword"};
+    REQUIRE(fs.applyCipher("HELPMEOBIWANKENOBI", CipherMode::Encrypt) ==
+            "FYNFNEHWBXAFFOKHMD");
+}
+
+TEST_CASE("Four-square Cipher decryption", "[foursquare]")
+{
+    FourSquareCipher fs{"example,keyword"};
+    REQUIRE(fs.applyCipher("FYNFNEHWBXAFFOKHMD", CipherMode::Decrypt) ==
+            "HELPMEOBIWANKENOBI");
+}
+
+TEST_CASE("Four-square Cipher odd length", "[foursquare]")
+{
+    FourSquareCipher fs{"zebras,tiger"};
+    REQUIRE(fs.applyCipher("WEAREDISCOVEREDFLEEATONCE", CipherMode::Encrypt) ==
+            "YIEORRDSRLYTTIZDMTZRQMKGBZ");
+    REQUIRE(fs.applyCipher("YIEORRDSRLYTTIZDMTZRQMKGBZ", CipherMode::Decrypt) ==
+            "WEAREDISCOVEREDFLEEATONCEX");
+}
+
+TEST_CASE("Four-square Cipher long text", "[foursquare]")
+{
+    const std::string letters{"ABCDEFGHIKLMNOPQRSTUVWXYZ"};
+    std::string plainText;
+    for (std::size_t i{0}; i < 1000000; ++i) {
+        // Only use letters that are in the grid, i.e. no J
+        plainText += letters[(i * 7 + i / 25) % 25];
+    }
+    FourSquareCipher fs{"first,second"};
+    const std::string cipherText{
+        fs.applyCipher(plainText, CipherMode::Encrypt)};
+    REQUIRE(fs.applyCipher(cipherText, CipherMode::Decrypt) == plainText);
+}
+
+TEST_CASE("Four-square Cipher key validation", "[foursquare]")
+{
+    REQUIRE_THROWS_AS(FourSquareCipher{"example"}, InvalidKey);
+    REQUIRE_THROWS_AS(FourSquareCipher{"a,b,c"}, InvalidKey);
+}
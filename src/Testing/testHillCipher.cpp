@@ -0,0 +1,64 @@
+//! Unit Tests for MPAGSCipher HillCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "HillCipher.hpp"
+
+#include <string>
+
+TEST_CASE("Hill Cipher encryption", "[hill]")
+{
+    HillCipher hc{"GYBNQKURP"};
+    REQUIRE(hc.applyCipher("ACT", CipherMode::Encrypt) == "POH");
+}
+
+TEST_CASE("Hill Cipher decryption", "[hill]")
+{
+    HillCipher hc{"GYBNQKURP"};
+    REQUIRE(hc.applyCipher("POH", CipherMode::Decrypt) == "ACT");
+}
+
+TEST_CASE("Hill Cipher pads to a whole number of blocks", "[hill]")
+{
+    HillCipher hc{"HILL"};
+    const std::string cipherText{hc.applyCipher("SHORT", CipherMode::Encrypt)};
+    REQUIRE(cipherText.size() == 6);
+    REQUIRE(hc.applyCipher(cipherText, CipherMode::Decrypt) == "SHORTX");
+}
+
+TEST_CASE("Hill Cipher key matrix inverse", "[hill]")
+{
+    HillCipher hc{"GYBNQKURP"};
+    const HillCipher::Matrix expected{8, 5, 10, 21, 8, 21, 21, 12, 8};
+    REQUIRE(hc.decryptionMatrix() == expected);
+}
+
+TEST_CASE("Hill Cipher large matrix round trip", "[hill]")
+{
+    // An 8x8 upper triangular matrix with odd diagonal entries is invertible
+    std::string key;
+    for (std::size_t row{0}; row < 8; ++row) {
+        for (std::size_t col{0}; col < 8; ++col) {
+            key += (col < row) ? 'A' : (col == row) ? 'D' : 'K';
+        }
+    }
+    HillCipher hc{key};
+
+    // Enough blocks to be shared between several threads
+    std::string plainText;
+    for (std::size_t i{0}; i < 200000; ++i) {
+        plainText += static_cast<char>('A' + (i * 11) % 26);
+    }
+    const std::string cipherText{
+        hc.applyCipher(plainText, CipherMode::Encrypt)};
+    REQUIRE(cipherText != plainText);
+    REQUIRE(hc.applyCipher(cipherText, CipherMode::Decrypt) == plainText);
+}
+
+TEST_CASE("Hill Cipher key validation", "[hill]")
+{
+    REQUIRE_THROWS_AS(HillCipher{"ABCDE"}, InvalidKey);
+    REQUIRE_THROWS_AS(HillCipher{"AAAA"}, InvalidKey);
+    REQUIRE_THROWS_AS(HillCipher{""}, InvalidKey);
+    REQUIRE_THROWS_AS(HillCipher{std::string(81, 'B')}, InvalidKey);
+}
@@ -0,0 +1,98 @@
+//! Unit Tests for MPAGSCipher KeywordScanner Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CipherFactory.hpp"
+#include "CipherType.hpp"
+#include "KeywordScanner.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// Type definition for a match as an (offset, keyword) pair
+    using Found = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    /// Scan a text in pieces of the given size
+    Found scanInPieces(KeywordScanner& scanner, const std::string& text,
+                       const std::size_t pieceSize)
+    {
+        Found found;
+        const auto record = [&found](const KeywordScanner::Match& match) {
+            found.emplace_back(match.offset, match.keyword);
+        };
+        scanner.reset();
+        for (std::size_t begin{0}; begin < text.size(); begin += pieceSize) {
+            scanner.scan(text.data() + begin,
+                         std::min(pieceSize, text.size() - begin), record);
+        }
+        std::sort(std::begin(found), std::end(found));
+        return found;
+    }
+
+    /// Find every occurrence of every keyword the slow way
+    Found findAll(const std::string& text,
+                  const std::vector<std::string>& keywords)
+    {
+        Found found;
+        for (std::size_t k{0}; k < keywords.size(); ++k) {
+            for (std::size_t pos{text.find(keywords[k])};
+                 pos != std::string::npos;
+                 pos = text.find(keywords[k], pos + 1)) {
+                found.emplace_back(pos, k);
+            }
+        }
+        std::sort(std::begin(found), std::end(found));
+        return found;
+    }
+}    // namespace
+
+TEST_CASE("Keyword scanner finds overlapping keywords", "[keywordscanner]")
+{
+    const std::vector<std::string> keywords{"HE", "SHE", "HIS", "HERS"};
+    KeywordScanner scanner{keywords, CipherType::Caesar, "0"};
+    REQUIRE(scanner.nStates() == 10);
+    REQUIRE(scanInPieces(scanner, "USHERS", 6) ==
+            Found{{1, 1}, {2, 0}, {2, 3}});
+}
+
+TEST_CASE("Keyword scanner on Vigenere cipher text", "[keywordscanner]")
+{
+    std::string plainText;
+    for (std::size_t i{0}; i < 5003; ++i) {
+        plainText += static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+    plainText += "ATTACKATDAWNRETREATATDUSK";
+    const std::vector<std::string> keywords{
+        "ATTACK", "DAWN", "RETREAT", "AT", "HIJ", "NOTTHERE", "A", "AT"};
+    const std::string cipherText{
+        CipherFactory::makeCipher(CipherType::Vigenere, "lemon")
+            ->applyCipher(plainText, CipherMode::Encrypt)};
+
+    KeywordScanner scanner{keywords, CipherType::Vigenere, "lemon"};
+    const Found expected{findAll(plainText, keywords)};
+    for (const std::size_t pieceSize : {1, 3, 7, 64, 10000}) {
+        REQUIRE(scanInPieces(scanner, cipherText, pieceSize) == expected);
+    }
+}
+
+TEST_CASE("Keyword scanner breaks matches at other characters",
+          "[keywordscanner]")
+{
+    KeywordScanner scanner{{"ABC", "BC"}, CipherType::Caesar, "1"};
+    REQUIRE(scanInPieces(scanner, "BC.DBCD", 2) == Found{{4, 0}, {5, 1}});
+}
+
+TEST_CASE("Keyword scanner rejects bad keywords and ciphers",
+          "[keywordscanner]")
+{
+    REQUIRE_THROWS_AS((KeywordScanner{{"ABC", ""}, CipherType::Caesar, "1"}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS((KeywordScanner{{"abc"}, CipherType::Caesar, "1"}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS((KeywordScanner{{"ABC"}, CipherType::Playfair, "key"}),
+                      std::invalid_argument);
+}
@@ -0,0 +1,95 @@
+//! Unit Tests for MPAGSCipher LetterCompressor functions
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "LetterCompressor.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    bool isLetters(const std::string& text)
+    {
+        return std::all_of(std::begin(text), std::end(text),
+                           [](const char c) { return c >= 'A' && c <= 'Z'; });
+    }
+
+    std::string randomLetters(const std::size_t n, std::size_t seed)
+    {
+        std::string text(n, 'A');
+        for (auto& c : text) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            c = static_cast<char>('A' + (seed >> 33) % 26);
+        }
+        return text;
+    }
+}    // namespace
+
+TEST_CASE("Empty and short texts", "[lettercompressor]")
+{
+    for (const std::string text : {"", "A", "HELLO", "HELLOWORLD"}) {
+        const std::string compressed{LetterCompressor::compress(text)};
+        REQUIRE(isLetters(compressed));
+        REQUIRE(compressed.size() <= text.size() + 1);
+        REQUIRE(LetterCompressor::decompress(compressed) == text);
+    }
+}
+
+TEST_CASE("Repetitive text compresses", "[lettercompressor]")
+{
+    std::string text;
+    for (std::size_t i{0}; i < 2000; ++i) {
+        text += "THEQUICKBROWNFOXJUMPSOVERTHELAZYDOG";
+    }
+    const std::string compressed{LetterCompressor::compress(text)};
+    REQUIRE(isLetters(compressed));
+    REQUIRE(compressed.size() < text.size() / 50);
+    REQUIRE(LetterCompressor::decompress(compressed, text.size()) == text);
+}
+
+TEST_CASE("Runs of one letter", "[lettercompressor]")
+{
+    // The match overlaps the text it copies from
+    const std::string text(100000, 'Q');
+    const std::string compressed{LetterCompressor::compress(text)};
+    REQUIRE(compressed.size() < 20);
+    REQUIRE(LetterCompressor::decompress(compressed) == text);
+}
+
+TEST_CASE("Random and mixed texts round trip", "[lettercompressor]")
+{
+    for (std::size_t n : {7, 100, 5000, 200000}) {
+        std::string text{randomLetters(n, n)};
+        // Copy some pieces to give matches, including near the ends
+        if (n > 1000) {
+            text.replace(n - 300, 200, text, 17, 200);
+            text.replace(n / 2, 500, text, n / 3, 500);
+        }
+        const std::string compressed{LetterCompressor::compress(text)};
+        REQUIRE(isLetters(compressed));
+        REQUIRE(LetterCompressor::decompress(compressed) == text);
+    }
+}
+
+TEST_CASE("Malformed compressed text", "[lettercompressor]")
+{
+    // No literal count
+    REQUIRE_THROWS_AS(LetterCompressor::decompress(""),
+                      std::invalid_argument);
+    // Not a letter
+    REQUIRE_THROWS_AS(LetterCompressor::decompress("a"),
+                      std::invalid_argument);
+    // More literals than there are
+    REQUIRE_THROWS_AS(LetterCompressor::decompress("FABC"),
+                      std::invalid_argument);
+    // Offset before the start of the text
+    REQUIRE_THROWS_AS(LetterCompressor::decompress("CABDA"),
+                      std::invalid_argument);
+    // Longer than expected
+    const std::string compressed{
+        LetterCompressor::compress(std::string(50, 'Z'))};
+    REQUIRE_THROWS_AS(LetterCompressor::decompress(compressed, 40),
+                      std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+//! Unit Tests for MPAGSCipher MappedFile Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+TEST_CASE("Mapped file contents", "[mappedfile]")
+{
+    const std::string fileName{"testMappedFile.txt"};
+    {
+        std::ofstream file{fileName};
+        file << "Hello, World!\n";
+    }
+
+    MappedFile mapped{fileName};
+    REQUIRE(mapped.size() == 14);
+    REQUIRE(std::string(mapped.data(), mapped.size()) == "Hello, World!\n");
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Mapped file that is empty", "[mappedfile]")
+{
+    const std::string fileName{"testMappedFile.empty.txt"};
+    {
+        std::ofstream file{fileName};
+    }
+
+    MappedFile mapped{fileName};
+    REQUIRE(mapped.size() == 0);
+    REQUIRE(mapped.data() == nullptr);
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Mapped file that does not exist", "[mappedfile]")
+{
+    REQUIRE_THROWS_AS(MappedFile{"no-such-file.txt"}, std::system_error);
+}
+
+TEST_CASE("Mapped part of a file", "[mappedfile]")
+{
+    const std::string fileName{"testMappedFile.part.txt"};
+    std::string contents;
+    for (std::size_t i{0}; i < 20000; ++i) {
+        contents += static_cast<char>('a' + i % 26);
+    }
+    {
+        std::ofstream file{fileName};
+        file << contents;
+    }
+
+    // Parts that start on, and off, a page boundary
+    for (const std::size_t offset : {0, 1, 4095, 4096, 12345}) {
+        MappedFile mapped{fileName, offset, 5000};
+        REQUIRE(mapped.size() == 5000);
+        REQUIRE(std::string(mapped.data(), mapped.size()) ==
+                contents.substr(offset, 5000));
+    }
+
+    // A part that runs past the end stops there, and one after it is empty
+    MappedFile end{fileName, 19000, 5000};
+    REQUIRE(std::string(end.data(), end.size()) == contents.substr(19000));
+    MappedFile after{fileName, 25000, 10};
+    REQUIRE(after.size() == 0);
+    REQUIRE(after.data() == nullptr);
+    std::remove(fileName.c_str());
+}
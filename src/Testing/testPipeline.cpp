@@ -0,0 +1,150 @@
+//! Unit Tests for MPAGSCipher Pipeline functions
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "Pipeline.hpp"
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    std::string makeText(const std::size_t n)
+    {
+        std::string text(n, 'a');
+        for (std::size_t i{0}; i < n; ++i) {
+            text[i] = static_cast<char>('a' + (i * 7 + i / 13) % 26);
+        }
+        return text;
+    }
+}    // namespace
+
+TEST_CASE("Pipeline gives back every block in order", "[pipeline]")
+{
+    const std::string text{makeText(100003)};
+    const std::size_t blockSize{1000};
+
+    for (const std::size_t nWorkers : {1, 2, 3}) {
+        for (const std::size_t depth : {1, 2, 8}) {
+            // Give each block its offset, and check it comes back with it
+            std::size_t position{0};
+            const auto source = [&](Pipeline::Block& block) {
+                if (position == text.size()) {
+                    return false;
+                }
+                block.input = text.substr(position, blockSize);
+                block.offset = position;
+                position += block.input.size();
+                return true;
+            };
+            const auto transform = [](Pipeline::Block& block) {
+                for (const char c : block.input) {
+                    block.output += static_cast<char>(std::toupper(c));
+                }
+                block.output += std::to_string(block.offset);
+            };
+            std::string result;
+            std::string expected;
+            const auto sink = [&](const Pipeline::Block& block) {
+                result += block.output;
+            };
+
+            const Pipeline::Stats stats{
+                Pipeline::run(source, transform, sink, nWorkers, depth)};
+
+            for (std::size_t i{0}; i < text.size(); i += blockSize) {
+                for (const char c : text.substr(i, blockSize)) {
+                    expected += static_cast<char>(std::toupper(c));
+                }
+                expected += std::to_string(i);
+            }
+            REQUIRE(result == expected);
+            REQUIRE(stats.blocks == 101);
+            REQUIRE(stats.workers == nWorkers);
+            REQUIRE(stats.toWorkers.pushes == 101);
+            REQUIRE(stats.toWriter.pushes == 101);
+        }
+    }
+}
+
+TEST_CASE("Pipeline copes with an empty source", "[pipeline]")
+{
+    std::size_t nSunk{0};
+    const Pipeline::Stats stats{Pipeline::run(
+        [](Pipeline::Block&) { return false; },
+        [](Pipeline::Block&) {}, [&](const Pipeline::Block&) { ++nSunk; },
+        2, 2)};
+    REQUIRE(nSunk == 0);
+    REQUIRE(stats.blocks == 0);
+}
+
+TEST_CASE("Pipeline reuses its blocks", "[pipeline]")
+{
+    // With one worker and a depth of one there are only two blocks, so
+    // their buffers keep their size from one use to the next
+    std::size_t nBlocks{0};
+    std::size_t nGrown{0};
+    const auto source = [&](Pipeline::Block& block) {
+        if (block.input.capacity() < 4096) {
+            ++nGrown;
+        }
+        block.input.assign(4096, 'A');
+        return ++nBlocks <= 100;
+    };
+    const auto transform = [](Pipeline::Block& block) {
+        block.output = block.input;
+    };
+    Pipeline::run(source, transform, [](const Pipeline::Block&) {}, 1, 1);
+    REQUIRE(nGrown == 2);
+}
+
+TEST_CASE("Pipeline passes on exceptions from any stage", "[pipeline]")
+{
+    std::size_t nBlocks{0};
+    const auto source = [&](Pipeline::Block& block) {
+        block.input = "ABC";
+        return ++nBlocks <= 1000;
+    };
+    const auto transform = [](Pipeline::Block& block) {
+        block.output = block.input;
+    };
+    const auto sink = [](const Pipeline::Block&) {};
+
+    const auto badSource = [&](Pipeline::Block& block) {
+        if (nBlocks == 500) {
+            throw std::runtime_error{"source"};
+        }
+        return source(block);
+    };
+    nBlocks = 0;
+    REQUIRE_THROWS_WITH(Pipeline::run(badSource, transform, sink, 2, 2),
+                        "source");
+
+    std::size_t nTransformed{0};
+    const auto badTransform = [&](Pipeline::Block& block) {
+        if (nTransformed++ == 500) {
+            throw std::runtime_error{"transform"};
+        }
+        transform(block);
+    };
+    nBlocks = 0;
+    REQUIRE_THROWS_WITH(Pipeline::run(source, badTransform, sink, 1, 2),
+                        "transform");
+
+    std::size_t nSunk{0};
+    const auto badSink = [&](const Pipeline::Block&) {
+        if (nSunk++ == 500) {
+            throw std::runtime_error{"sink"};
+        }
+    };
+    nBlocks = 0;
+    REQUIRE_THROWS_WITH(Pipeline::run(source, transform, badSink, 3, 1),
+                        "sink");
+
+    REQUIRE_THROWS_AS(Pipeline::run(source, transform, sink, 0, 1),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(Pipeline::run(source, transform, sink, 1, 0),
+                      std::invalid_argument);
+}
@@ -0,0 +1,28 @@
+//! Unit Tests for MPAGSCipher PolybiusGrid Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "PolybiusGrid.hpp"
+
+TEST_CASE("Polybius grid filled from key", "[polybius]")
+{
+    PolybiusGrid grid{"Playfair example"};
+    REQUIRE(grid.letters() == "PLAYFIREXMBCDGHKNOQSTUVWZ");
+
+    grid.setKey("");
+    REQUIRE(grid.letters() == "ABCDEFGHIKLMNOPQRSTUVWXYZ");
+}
+
+TEST_CASE("Polybius grid lookups", "[polybius]")
+{
+    const PolybiusGrid grid{"Playfair example"};
+    for (std::size_t cell{0}; cell < PolybiusGrid::nCells; ++cell) {
+        REQUIRE(grid.cell(grid.letter(cell)) == cell);
+    }
+    REQUIRE(grid.cell('P') == 0);
+    REQUIRE(grid.cell('E') == 7);
+    REQUIRE(grid.letter(1, 2) == 'E');
+    REQUIRE(grid.cell('J') == grid.cell('I'));
+    REQUIRE(grid.cell('a') == PolybiusGrid::noCell);
+    REQUIRE(grid.cell('4') == PolybiusGrid::noCell);
+}
@@ -205,3 +205,337 @@ TEST_CASE("Multi-cipher with matching number of cipher-type/keys specified")
     REQUIRE(settings.cipherKey[0] == "23");
     REQUIRE(settings.cipherKey[1] == "playfairexample");
 }
+
+TEST_CASE("Cipher type declared with Substitution cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "substitution"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::Substitution);
+}
+
+TEST_CASE("Cipher type declared with Affine cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "affine"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::Affine);
+}
+
+TEST_CASE("Cipher type declared with Hill cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "hill"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::Hill);
+}
+
+TEST_CASE("Cipher type declared with Columnar Transposition cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "columnar"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::ColumnarTransposition);
+}
+
+TEST_CASE("Cipher type declared with Rail Fence cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "railfence"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::RailFence);
+}
+
+TEST_CASE("Cipher type declared with Enigma cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "enigma"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::Enigma);
+}
+
+TEST_CASE("Cipher type declared with Bifid cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "bifid"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::Bifid);
+}
+
+TEST_CASE("Cipher type declared with Four-square cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "foursquare"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::FourSquare);
+}
+
+TEST_CASE("Cipher type declared with Autokey cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "autokey"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::Autokey);
+}
+
+TEST_CASE("Cipher type declared with running key cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "runningkey"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::RunningKey);
+}
+
+TEST_CASE("Cipher type declared with ChaCha20 cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "chacha20"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::ChaCha20);
+}
+
+TEST_CASE("Cipher type declared with AES-CTR cipher")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "aesctr"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.cipherType.size() == 1);
+    REQUIRE(settings.cipherType[0] == CipherType::AesCtr);
+}
+
+TEST_CASE("Search phrase declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "vigenere",
+                                           "-k", "key", "--search", "attack"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.searchPhrase == "attack");
+}
+
+TEST_CASE("Search phrase missing")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--search"};
+    REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings), MissingArgument);
+}
+
+TEST_CASE("Watchlist file declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--watchlist",
+                                           "words.txt"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.watchlistFile == "words.txt");
+}
+
+TEST_CASE("Range declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--range",
+                                           "1000:64"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.rangeRequested);
+    REQUIRE(settings.rangeStart == 1000);
+    REQUIRE(settings.rangeLength == 64);
+}
+
+TEST_CASE("Range with an invalid argument")
+{
+    for (const char* range : {"1000", "1000:", ":64", "a:64", "1000:-1"}) {
+        ProgramSettings settings{false, false, "", "", {},
+                                 {}, CipherMode::Encrypt};
+        const std::vector<std::string> cmdLine{"mpags-cipher", "--range",
+                                               range};
+        REQUIRE_FALSE(processCommandLine(cmdLine, settings));
+    }
+}
+
+TEST_CASE("Container declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--container"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.container);
+}
+
+TEST_CASE("Compression declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--container",
+                                           "--compress"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.container);
+    REQUIRE(settings.compress);
+}
+
+TEST_CASE("I/O options declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    REQUIRE(settings.ioQueueDepth == 4);
+    REQUIRE(settings.ioBufferSize == 1 << 20);
+
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--io-depth", "16",
+                                           "--io-buffer", "256"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.ioQueueDepth == 16);
+    REQUIRE(settings.ioBufferSize == 256 * 1024);
+}
+
+TEST_CASE("I/O options with an invalid argument")
+{
+    for (const char* option : {"--io-depth", "--io-buffer"}) {
+        for (const char* value : {"0", "-1", "four", "", "9999999999"}) {
+            ProgramSettings settings{false, false, "", "", {},
+                                     {}, CipherMode::Encrypt};
+            const std::vector<std::string> cmdLine{"mpags-cipher", option,
+                                                   value};
+            REQUIRE_FALSE(processCommandLine(cmdLine, settings));
+        }
+    }
+}
+
+TEST_CASE("Pipeline stats declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    REQUIRE_FALSE(settings.pipelineStats);
+
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--pipeline-stats"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.pipelineStats);
+}
+
+TEST_CASE("Record mode declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    REQUIRE_FALSE(settings.records);
+
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--records"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.records);
+}
+
+TEST_CASE("CSV fields declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    REQUIRE(settings.csvFields.empty());
+    REQUIRE(settings.csvDelimiter == ',');
+
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--csv-fields",
+                                           "2,5,3", "--csv-delimiter", "tab"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.csvFields == std::vector<std::size_t>{1, 4, 2});
+    REQUIRE(settings.csvDelimiter == '\t');
+}
+
+TEST_CASE("CSV options with an invalid argument")
+{
+    for (const char* value : {"0", "1,", ",2", "1,,2", "two", ""}) {
+        ProgramSettings settings{false, false, "", "", {},
+                                 {}, CipherMode::Encrypt};
+        const std::vector<std::string> cmdLine{"mpags-cipher", "--csv-fields",
+                                               value};
+        REQUIRE_FALSE(processCommandLine(cmdLine, settings));
+    }
+    for (const char* value : {"\"", ";;", ""}) {
+        ProgramSettings settings{false, false, "", "", {},
+                                 {}, CipherMode::Encrypt};
+        const std::vector<std::string> cmdLine{"mpags-cipher",
+                                               "--csv-delimiter", value};
+        REQUIRE_FALSE(processCommandLine(cmdLine, settings));
+    }
+}
+
+TEST_CASE("Follow mode declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    REQUIRE_FALSE(settings.follow);
+
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--follow"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.follow);
+}
+
+TEST_CASE("Recursive mode declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    REQUIRE_FALSE(settings.recursive);
+
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--recursive"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.recursive);
+}
+
+TEST_CASE("Shards declared")
+{
+    ProgramSettings settings{false, false, "", "", {}, {}, CipherMode::Encrypt};
+    REQUIRE(settings.shards == 0);
+
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--shards", "8"};
+    const bool res{processCommandLine(cmdLine, settings)};
+
+    REQUIRE(res);
+    REQUIRE(settings.shards == 8);
+
+    for (const char* value : {"0", "-1", "eight", ""}) {
+        const std::vector<std::string> badCmdLine{"mpags-cipher", "--shards",
+                                                  value};
+        REQUIRE_FALSE(processCommandLine(badCmdLine, settings));
+    }
+}
@@ -0,0 +1,87 @@
+//! Unit Tests for MPAGSCipher RailFenceCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "RailFenceCipher.hpp"
+
+#include <string>
+
+namespace {
+    /// Reference implementation that traces out the zig-zag
+    std::string zigZag(const std::string& text, const std::size_t nRails)
+    {
+        std::vector<std::string> rails(nRails);
+        std::size_t rail{0};
+        int direction{1};
+        for (const char c : text) {
+            rails[rail] += c;
+            if (nRails > 1) {
+                if (rail == 0) {
+                    direction = 1;
+                } else if (rail == nRails - 1) {
+                    direction = -1;
+                }
+                rail += direction;
+            }
+        }
+        std::string result;
+        for (const auto& r : rails) {
+            result += r;
+        }
+        return result;
+    }
+}    // namespace
+
+TEST_CASE("Rail Fence Cipher encryption", "[railfence]")
+{
+    RailFenceCipher rf{3};
+    REQUIRE(rf.applyCipher("WEAREDISCOVEREDFLEEATONCE", CipherMode::Encrypt) ==
+            "WECRLTEERDSOEEFEAOCAIVDEN");
+}
+
+TEST_CASE("Rail Fence Cipher decryption", "[railfence]")
+{
+    RailFenceCipher rf{"3"};
+    REQUIRE(rf.applyCipher("WECRLTEERDSOEEFEAOCAIVDEN", CipherMode::Decrypt) ==
+            "WEAREDISCOVEREDFLEEATONCE");
+}
+
+TEST_CASE("Rail Fence Cipher matches the zig-zag", "[railfence]")
+{
+    std::string plainText;
+    for (std::size_t i{0}; i < 1000; ++i) {
+        plainText += static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+
+    for (std::size_t nRails{1}; nRails < 12; ++nRails) {
+        for (const std::size_t length : {0, 1, 2, 5, 17, 1000}) {
+            const std::string text{plainText.substr(0, length)};
+            RailFenceCipher rf{nRails};
+            const std::string cipherText{
+                rf.applyCipher(text, CipherMode::Encrypt)};
+            REQUIRE(cipherText == zigZag(text, nRails));
+            REQUIRE(rf.applyCipher(cipherText, CipherMode::Decrypt) == text);
+        }
+    }
+}
+
+TEST_CASE("Rail Fence Cipher long text", "[railfence]")
+{
+    // Long enough to be split into several chunks that start mid-rail
+    std::string plainText;
+    for (std::size_t i{0}; i < 1000003; ++i) {
+        plainText += static_cast<char>('A' + (i * 7 + i / 26) % 26);
+    }
+    RailFenceCipher rf{7};
+    const std::string cipherText{
+        rf.applyCipher(plainText, CipherMode::Encrypt)};
+    REQUIRE(cipherText == zigZag(plainText, 7));
+    REQUIRE(rf.applyCipher(cipherText, CipherMode::Decrypt) == plainText);
+}
+
+TEST_CASE("Rail Fence Cipher key validation", "[railfence]")
+{
+    REQUIRE_THROWS_AS(RailFenceCipher{""}, InvalidKey);
+    REQUIRE_THROWS_AS(RailFenceCipher{"0"}, InvalidKey);
+    REQUIRE_THROWS_AS(RailFenceCipher{"three"}, InvalidKey);
+}
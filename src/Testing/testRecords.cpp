@@ -0,0 +1,77 @@
+//! Unit Tests for MPAGSCipher Records functions and Splitter class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CaesarCipher.hpp"
+#include "PlayfairCipher.hpp"
+#include "Records.hpp"
+#include "VigenereCipher.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE("Splitter only gives back whole records", "[records]")
+{
+    Records::Splitter splitter;
+    std::string block;
+
+    REQUIRE_FALSE(splitter.add("first li", 8, block));
+    REQUIRE(block.empty());
+    REQUIRE(splitter.add("ne\nsecond\nthi", 13, block));
+    REQUIRE(block == "first line\nsecond\n");
+
+    block.clear();
+    REQUIRE(splitter.add("rd\n", 3, block));
+    REQUIRE(block == "third\n");
+
+    block.clear();
+    REQUIRE_FALSE(splitter.add("last", 4, block));
+    REQUIRE(splitter.finish(block));
+    REQUIRE(block == "last");
+    REQUIRE_FALSE(splitter.finish(block));
+}
+
+TEST_CASE("Each record is encrypted on its own", "[records]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<VigenereCipher>("key"));
+    ciphers.push_back(std::make_unique<CaesarCipher>(3));
+
+    const auto encryptLine = [&](const std::string& line) {
+        std::string text{line};
+        for (const auto& cipher : ciphers) {
+            text = cipher->applyCipher(text, CipherMode::Encrypt);
+        }
+        return text;
+    };
+
+    // The key starts again on every line, and blank lines are kept
+    std::string output;
+    Records::apply("Hello world\n\n2 lines, same text\nHELLO WORLD", ciphers,
+                   CipherMode::Encrypt, output);
+    REQUIRE(output == encryptLine("HELLOWORLD") + "\n\n" +
+                          encryptLine("TWOLINESSAMETEXT") + "\n" +
+                          encryptLine("HELLOWORLD") + "\n");
+
+    // And decrypting gives back the transliterated lines
+    std::string decrypted;
+    Records::apply(output, ciphers, CipherMode::Decrypt, decrypted);
+    REQUIRE(decrypted == "HELLOWORLD\n\nTWOLINESSAMETEXT\nHELLOWORLD\n");
+}
+
+TEST_CASE("Records work with ciphers that need the whole text", "[records]")
+{
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<PlayfairCipher>("playfair example"));
+
+    std::string output;
+    Records::apply("hide the gold\nin the tree stump\n", ciphers,
+                   CipherMode::Encrypt, output);
+
+    const PlayfairCipher playfair{"playfair example"};
+    REQUIRE(output ==
+            playfair.applyCipher("HIDETHEGOLD", CipherMode::Encrypt) + "\n" +
+                playfair.applyCipher("INTHETREESTUMP", CipherMode::Encrypt) +
+                "\n");
+}
@@ -0,0 +1,72 @@
+//! Unit Tests for MPAGSCipher RunningKeyCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "RunningKeyCipher.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+    /**
+     * \brief Write a book for the tests to use as the key
+     *
+     * \param fileName the name of the file to write
+     * \param contents the text of the book
+     */
+    void writeBook(const std::string& fileName, const std::string& contents)
+    {
+        std::ofstream book{fileName};
+        book << contents;
+    }
+}    // namespace
+
+TEST_CASE("Running Key Cipher encryption and decryption", "[runningkey]")
+{
+    const std::string fileName{"testRunningKeyCipher.book"};
+    writeBook(fileName,
+              "It was the best of times, it was the worst of times.\n");
+    RunningKeyCipher rk{fileName};
+
+    // The book is shorter than the text, so it is used again from the start
+    REQUIRE(rk.applyCipher("FLEEATONCEWEAREDISCOVEREDSAVEYOURSELF",
+                           CipherMode::Encrypt) ==
+            "NEAESMVRDIOXOWXLUWUWOARWWZERSPGNFXXTR");
+    REQUIRE(rk.applyCipher("NEAESMVRDIOXOWXLUWUWOARWWZERSPGNFXXTR",
+                           CipherMode::Decrypt) ==
+            "FLEEATONCEWEAREDISCOVEREDSAVEYOURSELF");
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Running Key Cipher long text", "[runningkey]")
+{
+    const std::string fileName{"testRunningKeyCipher.long.book"};
+    writeBook(fileName, "a-b-c, d!");
+    RunningKeyCipher rk{fileName};
+
+    std::string plainText;
+    std::string expected;
+    for (std::size_t i{0}; i < 200003; ++i) {
+        const char letter{static_cast<char>('A' + (i * 7 + i / 26) % 26)};
+        plainText += letter;
+        expected += static_cast<char>('A' + (letter - 'A' + i % 4) % 26);
+    }
+
+    const std::string cipherText{
+        rk.applyCipher(plainText, CipherMode::Encrypt)};
+    REQUIRE(cipherText == expected);
+    REQUIRE(rk.applyCipher(cipherText, CipherMode::Decrypt) == plainText);
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Running Key Cipher key validation", "[runningkey]")
+{
+    REQUIRE_THROWS_AS(RunningKeyCipher{""}, InvalidKey);
+    REQUIRE_THROWS_AS(RunningKeyCipher{"no-such-book.txt"}, InvalidKey);
+
+    const std::string fileName{"testRunningKeyCipher.empty.book"};
+    writeBook(fileName, "1234 ...\n");
+    REQUIRE_THROWS_AS(RunningKeyCipher{fileName}, InvalidKey);
+    std::remove(fileName.c_str());
+}
@@ -0,0 +1,168 @@
+//! Unit Tests for MPAGSCipher ShardedCipher functions
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "AffineCipher.hpp"
+#include "EnigmaCipher.hpp"
+#include "PlayfairCipher.hpp"
+#include "ShardedCipher.hpp"
+#include "TransformChar.hpp"
+#include "VigenereCipher.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+    /// Write a file
+    void writeFile(const std::string& fileName, const std::string& contents)
+    {
+        std::ofstream file{fileName, std::ios::binary};
+        file << contents;
+    }
+
+    /// Read the whole of a file
+    std::string readFile(const std::string& fileName)
+    {
+        std::ifstream file{fileName, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{file},
+                           std::istreambuf_iterator<char>{}};
+    }
+
+    /// Make some text of mixed letters, digits, spaces and punctuation
+    std::string makeText(const std::size_t n)
+    {
+        const std::string characters{"abcdefghijklmnopqrstuvwxyz ,.12\n"};
+        std::string text(n, ' ');
+        std::uint64_t seed{7};
+        for (auto& c : text) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            c = characters[(seed >> 33) % characters.size()];
+        }
+        return text;
+    }
+
+    /// Encrypt a whole text at once, as mpags-cipher would
+    std::string encrypt(const std::vector<std::unique_ptr<Cipher>>& ciphers,
+                        const std::string& contents)
+    {
+        std::string text;
+        for (const char c : contents) {
+            text += transformChar(c);
+        }
+        for (const auto& cipher : ciphers) {
+            text = cipher->applyCipher(text, CipherMode::Encrypt);
+        }
+        return text + "\n";
+    }
+}    // namespace
+
+TEST_CASE("The split plan covers the file", "[shardedcipher]")
+{
+    const std::string fileName{"testShardedCipher.plan.txt"};
+    const std::string contents{makeText(100000)};
+    writeFile(fileName, contents);
+
+    const std::vector<ShardedCipher::Shard> shards{
+        ShardedCipher::plan(fileName, 7)};
+    REQUIRE(shards.size() == 7);
+    std::uint64_t begin{0};
+    std::uint64_t offset{0};
+    for (const auto& shard : shards) {
+        REQUIRE(shard.begin == begin);
+        REQUIRE(shard.begin % 4096 == 0);
+        REQUIRE(shard.offset == offset);
+        std::string letters;
+        for (std::uint64_t i{shard.begin}; i < shard.end; ++i) {
+            letters += transformChar(contents[i]);
+        }
+        REQUIRE(shard.nLetters == letters.size());
+        begin = shard.end;
+        offset += shard.nLetters;
+    }
+    REQUIRE(begin == contents.size());
+
+    // A small file is not split into shards of less than a page, and an
+    // empty one has none
+    writeFile(fileName, "Hello, World!");
+    REQUIRE(ShardedCipher::plan(fileName, 4).size() == 1);
+    writeFile(fileName, "");
+    REQUIRE(ShardedCipher::plan(fileName, 4).empty());
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Sharded encryption matches encrypting the whole file",
+          "[shardedcipher]")
+{
+    const std::string inputFile{"testShardedCipher.in.txt"};
+    const std::string outputFile{"testShardedCipher.out.txt"};
+    const std::string contents{makeText(300000)};
+    writeFile(inputFile, contents);
+
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<VigenereCipher>("shards"));
+    ciphers.push_back(std::make_unique<AffineCipher>(5, 8));
+    ciphers.push_back(
+        std::make_unique<EnigmaCipher>("IV II V,C,BUL,XYZ,AZ BY CX"));
+    const std::string expected{encrypt(ciphers, contents)};
+
+    for (const std::size_t nWorkers : {1, 3, 8}) {
+        std::uint64_t lastDone{0};
+        std::uint64_t lastTotal{0};
+        const ShardedCipher::Stats stats{ShardedCipher::apply(
+            inputFile, outputFile, ciphers, CipherMode::Encrypt, nWorkers,
+            [&](const std::uint64_t done, const std::uint64_t total) {
+                lastDone = done;
+                lastTotal = total;
+            })};
+        REQUIRE(stats.workers == nWorkers);
+        REQUIRE(stats.bytesIn == contents.size());
+        REQUIRE(stats.bytesOut == expected.size());
+        REQUIRE(lastDone == contents.size());
+        REQUIRE(lastTotal == contents.size());
+
+        const bool same{readFile(outputFile) == expected};
+        REQUIRE(same);
+    }
+
+    // An empty file still gives a newline
+    writeFile(inputFile, "");
+    REQUIRE(ShardedCipher::apply(inputFile, outputFile, ciphers,
+                                 CipherMode::Encrypt, 4)
+                .workers == 0);
+    REQUIRE(readFile(outputFile) == "\n");
+
+    std::remove(inputFile.c_str());
+    std::remove(outputFile.c_str());
+}
+
+TEST_CASE("Sharding needs ciphers that can start part way into a text",
+          "[shardedcipher]")
+{
+    const std::string inputFile{"testShardedCipher.bad.txt"};
+    writeFile(inputFile, "Hello, World!");
+
+    std::vector<std::unique_ptr<Cipher>> ciphers;
+    ciphers.push_back(std::make_unique<PlayfairCipher>("playfair example"));
+    REQUIRE_THROWS_AS(ShardedCipher::apply(inputFile, "unused.txt", ciphers,
+                                           CipherMode::Encrypt),
+                      std::invalid_argument);
+
+    ciphers.clear();
+    ciphers.push_back(std::make_unique<VigenereCipher>("key"));
+    REQUIRE_THROWS_AS(ShardedCipher::apply(inputFile,
+                                           "no-such-directory/out.txt",
+                                           ciphers, CipherMode::Encrypt),
+                      std::system_error);
+    REQUIRE_THROWS_AS(ShardedCipher::apply("no-such-file.txt", "unused.txt",
+                                           ciphers, CipherMode::Encrypt),
+                      std::system_error);
+    std::remove(inputFile.c_str());
+}
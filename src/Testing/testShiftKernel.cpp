@@ -0,0 +1,67 @@
+//! Unit Tests for MPAGSCipher ShiftKernel
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "ShiftKernel.hpp"
+
+#include <string>
+
+namespace {
+    /**
+     * \brief Apply the key stream one character at a time
+     *
+     * \param text the text to shift
+     * \param key the key stream
+     * \param cipherMode whether to shift forward or back
+     * \return the shifted text
+     */
+    std::string referenceShift(const std::string& text, const std::string& key,
+                               const CipherMode cipherMode)
+    {
+        std::string out{text};
+        for (std::size_t i{0}; i < text.size(); ++i) {
+            if (text[i] < 'A' || text[i] > 'Z') {
+                continue;
+            }
+            const int shift{cipherMode == CipherMode::Encrypt
+                                ? key[i] - 'A'
+                                : 26 - (key[i] - 'A')};
+            out[i] = static_cast<char>('A' + (text[i] - 'A' + shift) % 26);
+        }
+        return out;
+    }
+}    // namespace
+
+TEST_CASE("Shift kernel single letters", "[shiftkernel]")
+{
+    char out[1];
+    const char text{'H'};
+    const char key{'C'};
+    ShiftKernel::applyKeyStream(&text, &key, out, 1, CipherMode::Encrypt);
+    REQUIRE(out[0] == 'J');
+    ShiftKernel::applyKeyStream(out, &key, out, 1, CipherMode::Decrypt);
+    REQUIRE(out[0] == 'H');
+}
+
+TEST_CASE("Shift kernel matches the reference at all lengths", "[shiftkernel]")
+{
+    // Cover every letter/key combination, a few non-letters, and lengths
+    // either side of whole vector widths
+    std::string text;
+    std::string key;
+    for (std::size_t i{0}; i < 26 * 26 + 40; ++i) {
+        text += (i % 29 == 28) ? ' ' : static_cast<char>('A' + i % 26);
+        key += static_cast<char>('A' + (i / 26) % 26);
+    }
+
+    for (std::size_t n{0}; n <= text.size(); n += 7) {
+        const std::string subText{text.substr(0, n)};
+        for (const CipherMode mode :
+             {CipherMode::Encrypt, CipherMode::Decrypt}) {
+            std::string out(n, ' ');
+            ShiftKernel::applyKeyStream(subText.data(), key.data(), out.data(),
+                                        n, mode);
+            REQUIRE(out == referenceShift(subText, key, mode));
+        }
+    }
+}
@@ -0,0 +1,96 @@
+//! Unit Tests for MPAGSCipher SpscRing Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "SpscRing.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+
+TEST_CASE("SpscRing rounds its capacity up to a power of two", "[spscring]")
+{
+    REQUIRE(SpscRing<int>{1}.capacity() == 1);
+    REQUIRE(SpscRing<int>{5}.capacity() == 8);
+    REQUIRE(SpscRing<int>{64}.capacity() == 64);
+    REQUIRE_THROWS_AS(SpscRing<int>{0}, std::invalid_argument);
+}
+
+TEST_CASE("SpscRing gives values back in order until it is full",
+          "[spscring]")
+{
+    SpscRing<int> ring{4};
+    int value{0};
+    REQUIRE_FALSE(ring.tryPop(value));
+
+    for (int i{0}; i < 4; ++i) {
+        REQUIRE(ring.tryPush(i));
+    }
+    REQUIRE_FALSE(ring.tryPush(4));
+
+    // Keep going round the ring several times
+    for (int i{0}; i < 20; ++i) {
+        REQUIRE(ring.tryPop(value));
+        REQUIRE(value == i);
+        REQUIRE(ring.tryPush(i + 4));
+    }
+
+    const RingStats stats{ring.stats()};
+    REQUIRE(stats.capacity == 4);
+    REQUIRE(stats.pushes == 24);
+    REQUIRE(stats.maxOccupancy == 4);
+    REQUIRE(stats.meanOccupancy() > 3.0);
+    REQUIRE(stats.pushStalls == 0);
+    REQUIRE(stats.popStalls == 0);
+}
+
+TEST_CASE("SpscRing stops once it is closed and empty", "[spscring]")
+{
+    SpscRing<int> ring{2};
+    REQUIRE(ring.push(1));
+    REQUIRE(ring.push(2));
+    ring.close();
+
+    // Values pushed before closing are still taken, then pop gives up
+    int value{0};
+    REQUIRE(ring.pop(value));
+    REQUIRE(value == 1);
+    REQUIRE(ring.pop(value));
+    REQUIRE(value == 2);
+    REQUIRE_FALSE(ring.pop(value));
+
+    // A full ring that is closed makes a waiting push give up
+    SpscRing<int> full{1};
+    REQUIRE(full.push(1));
+    full.close();
+    REQUIRE_FALSE(full.push(2));
+    REQUIRE(full.stats().pushStalls == 1);
+}
+
+TEST_CASE("SpscRing passes values between two threads", "[spscring]")
+{
+    // A small ring makes both ends wait for each other many times
+    SpscRing<std::size_t> ring{2};
+    const std::size_t n{100000};
+
+    std::thread producer{[&]() {
+        for (std::size_t i{0}; i < n; ++i) {
+            ring.push(i);
+        }
+        ring.close();
+    }};
+
+    std::size_t expected{0};
+    std::size_t value{0};
+    bool inOrder{true};
+    while (ring.pop(value)) {
+        inOrder = inOrder && value == expected;
+        ++expected;
+    }
+    producer.join();
+
+    REQUIRE(inOrder);
+    REQUIRE(expected == n);
+    REQUIRE(ring.stats().pushes == n);
+    REQUIRE(ring.stats().maxOccupancy <= 2);
+}
@@ -0,0 +1,38 @@
+//! Unit Tests for MPAGSCipher SubstitutionCipher Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "SubstitutionCipher.hpp"
+
+TEST_CASE("Substitution Cipher encryption", "[substitution]")
+{
+    SubstitutionCipher sc{"ZYXWVUTSRQPONMLKJIHGFEDCBA"};
+    REQUIRE(sc.applyCipher("HELLOWORLD", CipherMode::Encrypt) == "SVOOLDLIOW");
+}
+
+TEST_CASE("Substitution Cipher decryption", "[substitution]")
+{
+    SubstitutionCipher sc{"ZYXWVUTSRQPONMLKJIHGFEDCBA"};
+    REQUIRE(sc.applyCipher("SVOOLDLIOW", CipherMode::Decrypt) == "HELLOWORLD");
+}
+
+TEST_CASE("Substitution Cipher keyword alphabet", "[substitution]")
+{
+    SubstitutionCipher sc{"zebras"};
+    REQUIRE(sc.cipherAlphabet() == "ZEBRASCDFGHIJKLMNOPQTUVWXY");
+    REQUIRE(sc.applyCipher("FLEEATONCE", CipherMode::Encrypt) == "SIAAZQLKBA");
+}
+
+TEST_CASE("Substitution Cipher long text", "[substitution]")
+{
+    // Long enough to exercise any vectorised kernel, plus a ragged tail
+    std::string plainText;
+    std::string expected;
+    for (std::size_t i{0}; i < 1001; ++i) {
+        plainText += static_cast<char>('A' + i % 26);
+        expected += static_cast<char>('Z' - i % 26);
+    }
+    SubstitutionCipher sc{"ZYXWVUTSRQPONMLKJIHGFEDCBA"};
+    REQUIRE(sc.applyCipher(plainText, CipherMode::Encrypt) == expected);
+    REQUIRE(sc.applyCipher(expected, CipherMode::Decrypt) == plainText);
+}
@@ -0,0 +1,60 @@
+//! Unit Tests for MPAGSCipher ThreadPool Class and parallelFor function
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("parallelFor visits every element once", "[threadpool]")
+{
+    std::vector<int> counts(10007, 0);
+    parallelFor(counts.size(), 100, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i) {
+            ++counts[i];
+        }
+    });
+
+    for (const auto count : counts) {
+        REQUIRE(count == 1);
+    }
+}
+
+TEST_CASE("parallelFor can be nested", "[threadpool]")
+{
+    std::atomic<std::size_t> total{0};
+    parallelFor(16, 1, [&](std::size_t, std::size_t) {
+        parallelFor(100, 10, [&](std::size_t begin, std::size_t end) {
+            total += end - begin;
+        });
+    });
+
+    REQUIRE(total == 1600);
+}
+
+TEST_CASE("parallelFor passes on exceptions", "[threadpool]")
+{
+    REQUIRE_THROWS_AS(parallelFor(100, 1,
+                                  [](std::size_t begin, std::size_t) {
+                                      if (begin == 42) {
+                                          throw std::runtime_error{"42"};
+                                      }
+                                  }),
+                      std::runtime_error);
+}
+
+TEST_CASE("ThreadPool runs submitted tasks", "[threadpool]")
+{
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool{3};
+        REQUIRE(pool.size() == 3);
+        for (int i{0}; i < 50; ++i) {
+            pool.submit([&count]() { ++count; });
+        }
+    }
+    REQUIRE(count == 50);
+}
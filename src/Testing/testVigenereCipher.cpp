@@ -12,4 +12,34 @@ TEST_CASE("Vigenere Cipher encryption", "[vigenere]") {
 TEST_CASE("Vigenere Cipher decryption", "[vigenere]") {
   VigenereCipher cc{"hello"};
   REQUIRE( cc.applyCipher("ALTDWZUFTHLEWZBNQPDGHKPDCALPVSFATWZUIPOHVVPASHXLQSDXTXSZ", CipherMode::Decrypt) == "THISISQUITEALONGMESSAGESOTHEKEYWILLNEEDTOREPEATAFEWTIMES");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Vigenere Cipher long text", "[vigenere]") {
+  // Long enough to be split between threads, with a key length that does not
+  // divide the size of each chunk
+  std::string plainText;
+  std::string expected;
+  const std::string key{"LEMON"};
+  for (std::size_t i{0}; i < 1000003; ++i) {
+    const char letter{static_cast<char>('A' + (i * 7 + i / 26) % 26)};
+    plainText += letter;
+    expected += static_cast<char>('A' + (letter - 'A' + key[i % 5] - 'A') % 26);
+  }
+
+  VigenereCipher cc{key};
+  const std::string cipherText{cc.applyCipher(plainText, CipherMode::Encrypt)};
+  REQUIRE( cipherText == expected );
+  REQUIRE( cc.applyCipher(cipherText, CipherMode::Decrypt) == plainText );
+}
+
+TEST_CASE("Vigenere Cipher part way into a text", "[vigenere]") {
+  VigenereCipher cc{"hello"};
+  const std::string plainText{"THISISQUITEALONGMESSAGESOTHEKEYWILLNEEDTOREPEATAFEWTIMES"};
+  const std::string cipherText{cc.applyCipher(plainText, CipherMode::Encrypt)};
+  for (std::size_t offset{0}; offset < plainText.size(); ++offset) {
+    REQUIRE( cc.applyCipherAt(cipherText.substr(offset), CipherMode::Decrypt,
+                              offset) == plainText.substr(offset) );
+    REQUIRE( cc.applyCipherAt(plainText.substr(offset, 7), CipherMode::Encrypt,
+                              offset) == cipherText.substr(offset, 7) );
+  }
+}
@@ -0,0 +1,74 @@
+//! Unit Tests for MPAGSCipher WorkStealingPool Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "WorkStealingPool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+    /// Spawn a binary tree of tasks of the given depth, counting the leaves
+    void spawnTree(WorkStealingPool& pool, const std::size_t depth,
+                   std::atomic<std::size_t>& nLeaves)
+    {
+        if (depth == 0) {
+            ++nLeaves;
+            return;
+        }
+        for (std::size_t i{0}; i < 2; ++i) {
+            pool.spawn([&pool, depth, &nLeaves]() {
+                spawnTree(pool, depth - 1, nLeaves);
+            });
+        }
+    }
+}    // namespace
+
+TEST_CASE("Every task spawned is run", "[workstealingpool]")
+{
+    for (const std::size_t nThreads : {1, 2, 4}) {
+        WorkStealingPool pool{nThreads};
+        std::atomic<std::size_t> nLeaves{0};
+        pool.spawn([&]() { spawnTree(pool, 10, nLeaves); });
+        const WorkStealingPool::Stats stats{pool.run()};
+
+        REQUIRE(nLeaves == 1024);
+        REQUIRE(stats.threads == nThreads);
+        REQUIRE(stats.tasks == 2047);
+        REQUIRE(stats.steals <= stats.tasks);
+    }
+}
+
+TEST_CASE("Tasks spawned before running are shared out", "[workstealingpool]")
+{
+    WorkStealingPool pool{3};
+    std::atomic<std::size_t> sum{0};
+    for (std::size_t i{1}; i <= 100; ++i) {
+        pool.spawn([&sum, i]() { sum += i; });
+    }
+    REQUIRE(pool.run().tasks == 100);
+    REQUIRE(sum == 5050);
+
+    // The pool can be run again, and with nothing to do returns at once
+    REQUIRE(pool.run().tasks == 0);
+}
+
+TEST_CASE("The first exception from a task is rethrown", "[workstealingpool]")
+{
+    WorkStealingPool pool{2};
+    pool.spawn([&pool]() {
+        for (std::size_t i{0}; i < 50; ++i) {
+            pool.spawn([]() {});
+        }
+        throw std::runtime_error{"task failed"};
+    });
+    REQUIRE_THROWS_AS(pool.run(), std::runtime_error);
+
+    // And the pool can be used again afterwards
+    std::atomic<std::size_t> nRun{0};
+    pool.spawn([&nRun]() { ++nRun; });
+    pool.run();
+    REQUIRE(nRun == 1);
+}
@@ -1,19 +1,41 @@
+#include "AsyncFile.hpp"
+#include "BlockContainer.hpp"
+#include "CipherChain.hpp"
 #include "CipherFactory.hpp"
 #include "CipherMode.hpp"
+#include "CipherSearch.hpp"
+#include "CipherStream.hpp"
 #include "CipherType.hpp"
+#include "Csv.hpp"
+#include "DirectoryCipher.hpp"
+#include "FdIo.hpp"
+#include "FileFollower.hpp"
+#include "KeywordScanner.hpp"
+#include "Pipeline.hpp"
 #include "ProcessCommandLine.hpp"
+#include "Records.hpp"
+#include "ShardedCipher.hpp"
 #include "TransformChar.hpp"
 #include "VigenereCipher.hpp"
 #include <algorithm>
+#include <array>
+#include <cctype>
 #include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <future>
+#include <ios>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <thread>
 #include <vector>
 
+#include <unistd.h>
+
 int main(int argc, char* argv[])
 {
     // Convert the command-line arguments into a more easily usable form
@@ -24,7 +46,9 @@ int main(int argc, char* argv[])
 
     // Process command line arguments
     try {
-        processCommandLine(cmdLineArgs, settings);
+        if (!processCommandLine(cmdLineArgs, settings)) {
+            return 1;
+        }
     } catch (const MissingArgument& e) {
         std::cerr << "[error] Missing argument: " << e.what() << std::endl;
         return 1;
@@ -40,7 +64,7 @@ int main(int argc, char* argv[])
     if (settings.helpRequested) {
         // Line splitting for readability
         std::cout
-            << "Usage: mpags-cipher [-h/--help] [--version] [-i <file>] [-o <file>] [-c <cipher>] [-k <key>] [--encrypt/--decrypt]\n\n"
+            << "Usage: mpags-cipher [-h/--help] [--version] [-i <file>] [-o <file>] [-c <cipher>] [-k <key>] [--encrypt/--decrypt] [--search <phrase>] [--watchlist <file>] [--range <start:len>] [--container] [--compress] [--io-depth <n>] [--io-buffer <kB>] [--records] [--csv-fields <list>] [--csv-delimiter <c>] [--follow] [--recursive] [--shards <n>] [--pipeline-stats]\n\n"
             << "Encrypts/Decrypts input alphanumeric text using classical ciphers\n\n"
             << "Available options:\n\n"
             << "  -h|--help        Print this help message and exit\n\n"
@@ -53,11 +77,69 @@ int main(int argc, char* argv[])
             << "  --multi-cipher N Specify the number of ciphers to be used in sequence\n"
             << "                   N should be a positive integer - defaults to 1"
             << "  -c CIPHER        Specify the cipher to be used to perform the encryption/decryption\n"
-            << "                   CIPHER can be caesar, playfair, or vigenere - caesar is the default\n\n"
+            << "                   CIPHER can be caesar, playfair, vigenere, substitution, affine, hill,\n"
+            << "                   columnar, railfence, enigma, bifid, foursquare, autokey,\n"
+            << "                   runningkey, chacha20, or aesctr - caesar is the default\n"
+            << "                   chacha20 and aesctr work on the raw bytes of the input\n"
+            << "                   and cannot be combined with the other ciphers\n\n"
             << "  -k KEY           Specify the cipher KEY\n"
             << "                   A null key, i.e. no encryption, is used if not supplied\n\n"
             << "  --encrypt        Will use the cipher to encrypt the input text (default behaviour)\n\n"
             << "  --decrypt        Will use the cipher to decrypt the input text\n\n"
+            << "  --search PHRASE  Print the offset of each place where PHRASE appears in\n"
+            << "                   the input text once decrypted, without decrypting it\n"
+            << "                   Only a single caesar or vigenere cipher can be searched\n\n"
+            << "  --watchlist FILE Print the offset and keyword of each place where one of\n"
+            << "                   the keywords in FILE (one per line) appears in the input\n"
+            << "                   text once decrypted, without decrypting it\n"
+            << "                   Only a single caesar or vigenere cipher can be scanned\n\n"
+            << "  --range START:LEN Only process the LEN characters of the input FILE\n"
+            << "                   that start at offset START, without reading the rest\n"
+            << "                   Only caesar, substitution, affine, vigenere and enigma\n"
+            << "                   ciphers can start part way into a file\n\n"
+            << "  --container      Write the encrypted text as (or read the text to be\n"
+            << "                   decrypted from) a container of blocks that are each\n"
+            << "                   encrypted on their own, so that they can be decrypted\n"
+            << "                   in parallel and --range works with any classical cipher\n\n"
+            << "  --compress       With --container, compress each block before encrypting it\n"
+            << "                   (the container records this, so it is not needed to\n"
+            << "                   decrypt) - playfair, hill, bifid and foursquare cannot\n"
+            << "                   be used, as they do not give back exactly what they encrypt\n\n"
+            << "  --io-depth N     Keep N reads/writes of the input/output FILE in flight\n"
+            << "                   at once (using io_uring where available) - defaults to 4\n\n"
+            << "  --io-buffer KB   Read/write the input/output FILE KB kilobytes at a time\n"
+            << "                   - defaults to 1024\n\n"
+            << "  --records        Encrypt/decrypt each line of the input on its own,\n"
+            << "                   writing one line of output for each (with any cipher\n"
+            << "                   other than chacha20 and aesctr)\n\n"
+            << "  --csv-fields LIST Encrypt/decrypt only the letters of the given fields\n"
+            << "                   (e.g. 2,4 - counting from 1) of each CSV record, in\n"
+            << "                   place, leaving everything else as it is - playfair,\n"
+            << "                   hill, bifid and foursquare cannot be used, as they\n"
+            << "                   change the number of letters\n\n"
+            << "  --csv-delimiter C Use C (or tab) to separate the fields of each CSV\n"
+            << "                   record - defaults to ,\n\n"
+            << "  --follow         Keep reading the input FILE as it grows (e.g. a log),\n"
+            << "                   writing out what is appended as soon as it has been\n"
+            << "                   encrypted/decrypted, until FILE is removed or renamed\n"
+            << "                   Only caesar, substitution, affine, vigenere, enigma and\n"
+            << "                   playfair ciphers (or any cipher other than chacha20\n"
+            << "                   and aesctr with --records) can be followed\n\n"
+            << "  --recursive      Treat the input FILE and output FILE as directories, and\n"
+            << "                   encrypt/decrypt every file in the input tree into the\n"
+            << "                   same place in the output tree, in parallel, printing\n"
+            << "                   the MB/s and files/s to stderr\n\n"
+            << "  --shards N       Split the input FILE between N worker processes, each\n"
+            << "                   of which encrypts/decrypts its own part and writes it\n"
+            << "                   into place in the output FILE, printing the MB/s to\n"
+            << "                   stderr - only caesar, substitution, affine, vigenere\n"
+            << "                   and enigma ciphers can be used\n\n"
+            << "  --pipeline-stats Print how often each stage of the reader/cipher/writer\n"
+            << "                   pipeline had to wait for the others, and how full the\n"
+            << "                   queues between them were, to stderr\n"
+            << "                   Only caesar, substitution, affine, vigenere and enigma\n"
+            << "                   ciphers (or any cipher with --records or\n"
+            << "                   --csv-fields) are run in the pipeline\n\n"
             << std::endl;
         // Help requires no further action, so return from main
         // with 0 used to indicate success
@@ -72,33 +154,447 @@ int main(int argc, char* argv[])
         return 0;
     }
 
+    // Ciphers that operate on bytes (e.g. ChaCha20 and AES) take the input exactly
+    // as it is, so they cannot be mixed with the classical ciphers
+    const auto nByteCiphers =
+        std::count_if(settings.cipherType.begin(), settings.cipherType.end(),
+                      CipherChain::operatesOnBytes);
+    const bool byteMode{nByteCiphers > 0};
+    if (byteMode && static_cast<std::size_t>(nByteCiphers) !=
+                        settings.cipherType.size()) {
+        std::cerr << "[error] chacha20 and aesctr cannot be used together "
+                     "with the classical ciphers"
+                  << std::endl;
+        return 1;
+    }
+
+    // Searching relies on each letter always being encrypted the same way at
+    // the same position in the key
+    const bool searchMode{!settings.searchPhrase.empty()};
+    const bool watchMode{!settings.watchlistFile.empty()};
+    if (searchMode && watchMode) {
+        std::cerr << "[error] --search and --watchlist cannot be used together"
+                  << std::endl;
+        return 1;
+    }
+    if ((searchMode || watchMode) &&
+        (settings.cipherType.size() != 1 ||
+         !CipherSearch::isSupported(settings.cipherType[0]))) {
+        std::cerr << "[error] --search and --watchlist need a single caesar or "
+                     "vigenere cipher"
+                  << std::endl;
+        return 1;
+    }
+
+    // A container holds blocks that were each encrypted on their own, so
+    // works with any classical cipher and finds a range from its index
+    const bool containerDecode{settings.container &&
+                               settings.cipherMode == CipherMode::Decrypt};
+    if (settings.container) {
+        if (byteMode) {
+            std::cerr << "[error] --container cannot be used with chacha20 "
+                         "or aesctr"
+                      << std::endl;
+            return 1;
+        }
+        if (searchMode || watchMode) {
+            std::cerr << "[error] --container cannot be used together with "
+                         "--search or --watchlist"
+                      << std::endl;
+            return 1;
+        }
+        if (settings.compress && !containerDecode &&
+            !std::all_of(settings.cipherType.begin(),
+                         settings.cipherType.end(),
+                         CipherChain::isReversible)) {
+            std::cerr << "[error] --compress cannot be used with the playfair, "
+                         "hill, bifid or foursquare ciphers"
+                      << std::endl;
+            return 1;
+        }
+        if (settings.rangeRequested && !containerDecode) {
+            std::cerr << "[error] --range can only be used with --container "
+                         "when decrypting"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    if (settings.compress && !settings.container) {
+        std::cerr << "[error] --compress can only be used with --container"
+                  << std::endl;
+        return 1;
+    }
+
+    // Processing a range means seeking straight to it in the input file,
+    // which needs every cipher to be able to start part way into a text
+    if (settings.rangeRequested && !settings.container) {
+        if (settings.inputFile.empty()) {
+            std::cerr << "[error] --range needs an input file" << std::endl;
+            return 1;
+        }
+        if (searchMode || watchMode) {
+            std::cerr << "[error] --range cannot be used together with "
+                         "--search or --watchlist"
+                      << std::endl;
+            return 1;
+        }
+        if (!std::all_of(settings.cipherType.begin(),
+                         settings.cipherType.end(), CipherChain::isSeekable)) {
+            std::cerr << "[error] --range can only be used with the caesar, "
+                         "substitution, affine, vigenere and enigma ciphers"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    // In record mode each line is a message of its own, so any classical
+    // cipher can be used, but nothing that works on the text as a whole
+    if (settings.records &&
+        (byteMode || searchMode || watchMode || settings.rangeRequested ||
+         settings.container)) {
+        std::cerr << "[error] --records cannot be used with chacha20 or "
+                     "aesctr, or together with --search, --watchlist, "
+                     "--range or --container"
+                  << std::endl;
+        return 1;
+    }
+
+    // In CSV mode the letters of each chosen field are encrypted in place,
+    // so the ciphers must give back as many letters as they are given
+    const bool csvMode{!settings.csvFields.empty()};
+    if (csvMode) {
+        if (byteMode || searchMode || watchMode || settings.rangeRequested ||
+            settings.container || settings.records) {
+            std::cerr << "[error] --csv-fields cannot be used with chacha20 or "
+                         "aesctr, or together with --search, --watchlist, "
+                         "--range, --container or --records"
+                      << std::endl;
+            return 1;
+        }
+        if (!std::all_of(settings.cipherType.begin(),
+                         settings.cipherType.end(),
+                         CipherChain::isReversible)) {
+            std::cerr << "[error] --csv-fields cannot be used with the "
+                         "playfair, hill, bifid or foursquare ciphers"
+                      << std::endl;
+            return 1;
+        }
+    } else if (settings.csvDelimiter != ',') {
+        std::cerr << "[error] --csv-delimiter can only be used with "
+                     "--csv-fields"
+                  << std::endl;
+        return 1;
+    }
+
+    // Following a file needs each cipher to carry on from where it left off
+    // with each piece that is appended, unless each line is on its own
+    if (settings.follow) {
+        if (settings.inputFile.empty()) {
+            std::cerr << "[error] --follow needs an input file" << std::endl;
+            return 1;
+        }
+        if (byteMode || searchMode || watchMode || settings.rangeRequested ||
+            settings.container || csvMode) {
+            std::cerr << "[error] --follow cannot be used with chacha20 or "
+                         "aesctr, or together with --search, --watchlist, "
+                         "--range, --container or --csv-fields"
+                      << std::endl;
+            return 1;
+        }
+        if (!settings.records &&
+            !std::all_of(settings.cipherType.begin(),
+                         settings.cipherType.end(),
+                         CipherStream::isSupported)) {
+            std::cerr << "[error] --follow can only be used with the caesar, "
+                         "substitution, affine, vigenere, enigma and playfair "
+                         "ciphers, unless --records is used too"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    // In recursive mode the input and output are directories, and each file
+    // in the tree is encrypted as a whole, so none of the other modes apply
+    if (settings.recursive) {
+        if (settings.inputFile.empty() || settings.outputFile.empty()) {
+            std::cerr << "[error] --recursive needs an input and an output "
+                         "directory"
+                      << std::endl;
+            return 1;
+        }
+        if (byteMode || searchMode || watchMode || settings.rangeRequested ||
+            settings.container || settings.records || csvMode ||
+            settings.follow || settings.pipelineStats) {
+            std::cerr << "[error] --recursive cannot be used with chacha20 or "
+                         "aesctr, or together with --search, --watchlist, "
+                         "--range, --container, --records, --csv-fields, "
+                         "--follow or --pipeline-stats"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    // In sharded mode the input file is split between worker processes,
+    // each of which starts part way into the text and writes its part of the
+    // output file in place, so both must be files and the ciphers seekable
+    if (settings.shards > 0) {
+        if (settings.inputFile.empty() || settings.outputFile.empty()) {
+            std::cerr << "[error] --shards needs an input and an output file"
+                      << std::endl;
+            return 1;
+        }
+        if (byteMode || searchMode || watchMode || settings.rangeRequested ||
+            settings.container || settings.records || csvMode ||
+            settings.follow || settings.recursive || settings.pipelineStats) {
+            std::cerr << "[error] --shards cannot be used with chacha20 or "
+                         "aesctr, or together with --search, --watchlist, "
+                         "--range, --container, --records, --csv-fields, "
+                         "--follow, --recursive or --pipeline-stats"
+                      << std::endl;
+            return 1;
+        }
+        if (!std::all_of(settings.cipherType.begin(),
+                         settings.cipherType.end(), CipherChain::isSeekable)) {
+            std::cerr << "[error] --shards can only be used with the caesar, "
+                         "substitution, affine, vigenere and enigma ciphers"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    // Records, CSV, and chains of ciphers that can start part way into a
+    // text, are run on blocks of the input in a pipeline, so that reading,
+    // encrypting and writing all go on at once
+    const bool pipelineMode{
+        !settings.follow && !settings.recursive && settings.shards == 0 &&
+        (settings.records || csvMode ||
+         (!byteMode && !searchMode && !watchMode &&
+          !settings.rangeRequested && !settings.container &&
+          std::all_of(settings.cipherType.begin(), settings.cipherType.end(),
+                      CipherChain::isSeekable)))};
+    if (settings.pipelineStats && !pipelineMode) {
+        std::cerr << "[error] --pipeline-stats can only be used with the "
+                     "caesar, substitution, affine, vigenere and enigma "
+                     "ciphers, --records or --csv-fields, without --search, "
+                     "--watchlist, "
+                     "--range or --container"
+                  << std::endl;
+        return 1;
+    }
+
+    // In watchlist mode, stream the input through the keyword scanner a
+    // buffer at a time rather than reading it all in
+    if (watchMode) {
+        // Read the keywords, one per line
+        std::ifstream watchlistStream{settings.watchlistFile};
+        if (!watchlistStream.good()) {
+            std::cerr << "[error] failed to create istream on file '"
+                      << settings.watchlistFile << "'" << std::endl;
+            return 1;
+        }
+        std::vector<std::string> keywords;
+        std::string line;
+        while (std::getline(watchlistStream, line)) {
+            std::string keyword;
+            for (const char c : line) {
+                keyword += transformChar(c);
+            }
+            if (!keyword.empty()) {
+                keywords.push_back(keyword);
+            }
+        }
+
+        std::unique_ptr<KeywordScanner> scanner;
+        try {
+            scanner = std::make_unique<KeywordScanner>(
+                keywords, settings.cipherType[0], settings.cipherKey[0]);
+        } catch (const InvalidKey& e) {
+            std::cerr << "[error] Invalid Key: " << e.what() << std::endl;
+            return 1;
+        } catch (const std::logic_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        }
+
+        std::ifstream inputStream;
+        if (!settings.inputFile.empty()) {
+            inputStream.open(settings.inputFile);
+            if (!inputStream.good()) {
+                std::cerr << "[error] failed to create istream on file '"
+                          << settings.inputFile << "'" << std::endl;
+                return 1;
+            }
+        }
+        std::istream& in{settings.inputFile.empty() ? std::cin : inputStream};
+
+        std::ofstream outputStream;
+        if (!settings.outputFile.empty()) {
+            outputStream.open(settings.outputFile);
+            if (!outputStream.good()) {
+                std::cerr << "[error] failed to create ostream on file '"
+                          << settings.outputFile << "'" << std::endl;
+                return 1;
+            }
+        }
+        std::ostream& out{settings.outputFile.empty() ? std::cout
+                                                      : outputStream};
+
+        // Print the offset and keyword of each match, one per line
+        const auto printMatch = [&](const KeywordScanner::Match& match) {
+            out << match.offset << ' ' << keywords[match.keyword] << '\n';
+        };
+
+        const std::size_t bufferSize{1 << 16};
+        std::string buffer;
+        buffer.reserve(bufferSize + 8);
+        char watchChar{'x'};
+        while (in >> watchChar) {
+            buffer += transformChar(watchChar);
+            if (buffer.size() >= bufferSize) {
+                scanner->scan(buffer.data(), buffer.size(), printMatch);
+                buffer.clear();
+            }
+        }
+        scanner->scan(buffer.data(), buffer.size(), printMatch);
+        return 0;
+    }
+
     // Initialise variables
-    char inputChar{'x'};
     std::string cipherText;
 
+    // Add each buffer of input to the text, skipping whitespace as reading
+    // with >> would
+    const auto addInput = [&](const char* data, const std::size_t n) {
+        if (byteMode || containerDecode) {
+            // Keep the input as it is
+            cipherText.append(data, n);
+            return;
+        }
+        for (std::size_t i{0}; i < n; ++i) {
+            if (!std::isspace(static_cast<unsigned char>(data[i]))) {
+                cipherText += transformChar(data[i]);
+            }
+        }
+    };
+
     // Read in user input from stdin/file
-    if (!settings.inputFile.empty()) {
+    if (pipelineMode || settings.follow || settings.recursive ||
+        settings.shards > 0) {
+        // The input is read a block at a time by the pipeline (or as it is
+        // appended to, a file of the tree at a time, or a shard per worker),
+        // once the ciphers are ready
+
+    } else if (containerDecode && !settings.inputFile.empty()) {
+        // The container file is only read once the ciphers are ready, and
+        // then only the blocks that are needed
+
+    } else if (settings.rangeRequested && !settings.container) {
         // Open the file and check that we can read from it
-        std::ifstream inputStream{settings.inputFile};
+        std::ifstream inputStream{settings.inputFile, std::ios::binary};
         if (!inputStream.good()) {
             std::cerr << "[error] failed to create istream on file '"
                       << settings.inputFile << "'" << std::endl;
             return 1;
         }
 
-        // Loop over each character from the file
-        while (inputStream >> inputChar) {
-            cipherText += transformChar(inputChar);
+        // The file is expected to be the output of mpags-cipher, so each
+        // character is a letter of the text - seek straight to the first
+        // one and read just the range (which may be cut short by the end of
+        // the file)
+        inputStream.seekg(0, std::ios::end);
+        const std::streamoff endPosition{inputStream.tellg()};
+        if (endPosition < 0) {
+            std::cerr << "[error] cannot seek in file '" << settings.inputFile
+                      << "'" << std::endl;
+            return 1;
+        }
+        const std::size_t fileSize{static_cast<std::size_t>(endPosition)};
+        const std::size_t start{std::min(settings.rangeStart, fileSize)};
+        cipherText.resize(std::min(settings.rangeLength, fileSize - start));
+        inputStream.seekg(static_cast<std::streamoff>(start));
+        inputStream.read(&cipherText[0],
+                         static_cast<std::streamsize>(cipherText.size()));
+
+        // Drop the newline at the end of the file if the range includes it
+        while (!cipherText.empty() &&
+               (cipherText.back() == '\n' || cipherText.back() == '\r')) {
+            cipherText.pop_back();
+        }
+
+    } else if (!settings.inputFile.empty()) {
+        // Read the file with several large reads in flight at once, dealing
+        // with each buffer while the following ones are being read
+        try {
+            AsyncReader reader{settings.inputFile, settings.ioBufferSize,
+                               settings.ioQueueDepth};
+            const char* data{nullptr};
+            std::size_t n{0};
+            while (reader.next(data, n)) {
+                addInput(data, n);
+            }
+        } catch (const std::system_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
         }
 
     } else {
-        // Loop over each character from user input
+        // Read user input in large blocks straight from stdin
         // (until Return then CTRL-D (EOF) pressed)
-        while (std::cin >> inputChar) {
-            cipherText += transformChar(inputChar);
+        try {
+            FdReader reader{STDIN_FILENO, settings.ioBufferSize};
+            const char* data{nullptr};
+            std::size_t n{0};
+            while (reader.next(data, n)) {
+                addInput(data, n);
+            }
+        } catch (const std::system_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
         }
     }
 
+    // In search mode, report where the phrase is rather than decrypting
+    if (searchMode) {
+        std::string phrase;
+        for (const char c : settings.searchPhrase) {
+            phrase += transformChar(c);
+        }
+
+        std::vector<std::size_t> offsets;
+        try {
+            offsets = CipherSearch::findPhrase(settings.cipherType[0],
+                                               settings.cipherKey[0],
+                                               cipherText, phrase);
+        } catch (const InvalidKey& e) {
+            std::cerr << "[error] Invalid Key: " << e.what() << std::endl;
+            return 1;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        }
+
+        // Print one offset per line to stdout/file
+        std::ofstream outputStream;
+        if (!settings.outputFile.empty()) {
+            outputStream.open(settings.outputFile);
+            if (!outputStream.good()) {
+                std::cerr << "[error] failed to create ostream on file '"
+                          << settings.outputFile << "'" << std::endl;
+                return 1;
+            }
+        }
+        std::ostream& out{settings.outputFile.empty() ? std::cout
+                                                      : outputStream};
+        for (const std::size_t offset : offsets) {
+            out << offset << '\n';
+        }
+        return 0;
+    }
+
     // Request construction of the appropriate cipher(s)
     std::vector<std::unique_ptr<Cipher>> ciphers;
     std::size_t nCiphers{settings.cipherType.size()};
@@ -127,10 +623,415 @@ int main(int argc, char* argv[])
         std::reverse(ciphers.begin(), ciphers.end());
     }
 
+    // Merge any consecutive simple substitutions (e.g. Caesar) into a single
+    // lookup table so that each run only needs one pass over the text
+    CipherChain::collapse(ciphers, settings.cipherMode);
+
+    // In recursive mode, every file in the input tree is encrypted into the
+    // output tree by a pool of threads that steal work from each other
+    if (settings.recursive) {
+        try {
+            using Clock = std::chrono::steady_clock;
+            const Clock::time_point start{Clock::now()};
+            const DirectoryCipher::Stats stats{DirectoryCipher::apply(
+                settings.inputFile, settings.outputFile, ciphers,
+                settings.cipherMode)};
+            const std::chrono::duration<double> elapsed{Clock::now() - start};
+            const double seconds{std::max(elapsed.count(), 1e-9)};
+
+            std::cerr << "[directory] " << stats.files << " files in "
+                      << stats.directories << " directories, "
+                      << stats.bytesIn / 1.0e6 << " MB in " << seconds
+                      << " s: " << stats.bytesIn / 1.0e6 / seconds
+                      << " MB/s, " << stats.files / seconds << " files/s ("
+                      << stats.tasks << " tasks, " << stats.steals
+                      << " stolen, on " << stats.threads << " threads)\n";
+        } catch (const std::system_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // In sharded mode, the input file is split between worker processes that
+    // each write their part of the output in place, while this one waits for
+    // them and reports how far they have got
+    if (settings.shards > 0) {
+        try {
+            using Clock = std::chrono::steady_clock;
+            const Clock::time_point start{Clock::now()};
+            const bool showProgress{::isatty(STDERR_FILENO) != 0};
+            int lastPercent{-1};
+            const auto progress = [&](const std::uint64_t done,
+                                      const std::uint64_t total) {
+                const int percent{
+                    total > 0 ? static_cast<int>(done * 100 / total) : 100};
+                if (showProgress && percent != lastPercent) {
+                    std::cerr << "\r[shards] " << percent << "%" << std::flush;
+                    lastPercent = percent;
+                }
+            };
+            const ShardedCipher::Stats stats{ShardedCipher::apply(
+                settings.inputFile, settings.outputFile, ciphers,
+                settings.cipherMode, settings.shards, progress)};
+            const std::chrono::duration<double> elapsed{Clock::now() - start};
+            const double seconds{std::max(elapsed.count(), 1e-9)};
+
+            if (showProgress) {
+                std::cerr << "\r";
+            }
+            std::cerr << "[shards] " << stats.bytesIn / 1.0e6 << " MB in "
+                      << seconds << " s on " << stats.workers
+                      << " workers: " << stats.bytesIn / 1.0e6 / seconds
+                      << " MB/s\n";
+        } catch (const std::system_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        } catch (const std::runtime_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // In follow mode, whatever is appended to the input file is encrypted
+    // and written out (and flushed) as soon as it arrives, with each cipher
+    // carrying on from where it left off - or in record mode, each line as
+    // soon as it is complete - until the file is removed or renamed
+    if (settings.follow) {
+        std::array<std::string, 256> letters;
+        for (std::size_t c{0}; c < letters.size(); ++c) {
+            letters[c] = transformChar(static_cast<char>(c));
+        }
+
+        std::ofstream outputStream;
+        if (!settings.outputFile.empty()) {
+            outputStream.open(settings.outputFile, std::ios::binary);
+            if (!outputStream.good()) {
+                std::cerr << "[error] failed to create ostream on file '"
+                          << settings.outputFile << "'" << std::endl;
+                return 1;
+            }
+        }
+
+        try {
+            FileFollower follower{settings.inputFile, settings.ioBufferSize};
+            std::unique_ptr<FdWriter> stdoutWriter;
+            if (settings.outputFile.empty()) {
+                stdoutWriter = std::make_unique<FdWriter>(
+                    STDOUT_FILENO, settings.ioBufferSize);
+            }
+            const auto emit = [&](const std::string& text) {
+                if (stdoutWriter) {
+                    stdoutWriter->write(text);
+                    stdoutWriter->flush();
+                } else {
+                    outputStream << text << std::flush;
+                }
+            };
+
+            std::unique_ptr<CipherStream> stream;
+            if (!settings.records) {
+                stream = std::make_unique<CipherStream>(ciphers,
+                                                        settings.cipherMode);
+            }
+            Records::Splitter splitter;
+            std::string block;
+            std::string output;
+            const char* data{nullptr};
+            std::size_t n{0};
+            while (follower.next(data, n)) {
+                block.clear();
+                output.clear();
+                if (settings.records) {
+                    if (splitter.add(data, n, block)) {
+                        Records::apply(block, ciphers, settings.cipherMode,
+                                       output);
+                    }
+                } else {
+                    for (std::size_t i{0}; i < n; ++i) {
+                        block += letters[static_cast<unsigned char>(data[i])];
+                    }
+                    output = stream->push(block);
+                }
+                if (!output.empty()) {
+                    emit(output);
+                }
+            }
+
+            // The file has gone, so finish off whatever was held back
+            block.clear();
+            output.clear();
+            if (settings.records) {
+                if (splitter.finish(block)) {
+                    Records::apply(block, ciphers, settings.cipherMode,
+                                   output);
+                }
+            } else {
+                output = stream->finish() + "\n";
+            }
+            emit(output);
+        } catch (const std::system_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // In pipeline mode, a reader thread reads the input a block at a time,
+    // the workers transliterate and encrypt/decrypt the blocks, and this
+    // thread writes them out in order - in record and CSV mode each block
+    // holds whole lines, each of which is encrypted/decrypted on its own
+    if (pipelineMode) {
+        // Transliterate through a table, which also gives the number of
+        // letters each character becomes, so that the reader can count
+        // where each block starts in the text without transliterating it
+        std::array<std::string, 256> letters;
+        for (std::size_t c{0}; c < letters.size(); ++c) {
+            letters[c] = transformChar(static_cast<char>(c));
+        }
+
+        std::unique_ptr<AsyncReader> reader;
+        std::unique_ptr<FdReader> stdinReader;
+        std::unique_ptr<AsyncWriter> writer;
+        std::unique_ptr<FdWriter> stdoutWriter;
+        Pipeline::Stats stats;
+        try {
+            if (!settings.inputFile.empty()) {
+                reader = std::make_unique<AsyncReader>(settings.inputFile,
+                                                       settings.ioBufferSize,
+                                                       settings.ioQueueDepth);
+            } else {
+                // Records are passed on as soon as they arrive, rather than
+                // waiting for a whole block of them
+                stdinReader = std::make_unique<FdReader>(
+                    STDIN_FILENO, settings.ioBufferSize, !settings.records);
+            }
+            if (!settings.outputFile.empty()) {
+                writer = std::make_unique<AsyncWriter>(settings.outputFile,
+                                                       settings.ioBufferSize,
+                                                       settings.ioQueueDepth);
+            } else {
+                stdoutWriter = std::make_unique<FdWriter>(
+                    STDOUT_FILENO, settings.ioBufferSize);
+            }
+
+            // Mark which fields of each CSV record are to be encrypted
+            std::vector<bool> csvColumns;
+            for (const std::size_t field : settings.csvFields) {
+                csvColumns.resize(std::max(csvColumns.size(), field + 1));
+                csvColumns[field] = true;
+            }
+
+            std::uint64_t nLetters{0};
+            Records::Splitter splitter;
+            Csv::Splitter csvSplitter{settings.csvDelimiter};
+            const auto source = [&](Pipeline::Block& block) {
+                const char* data{nullptr};
+                std::size_t n{0};
+                const auto next = [&]() {
+                    return reader ? reader->next(data, n)
+                                  : stdinReader->next(data, n);
+                };
+                if (settings.records) {
+                    // Hold back any record that is not complete yet
+                    while (next()) {
+                        if (splitter.add(data, n, block.input)) {
+                            return true;
+                        }
+                    }
+                    return splitter.finish(block.input);
+                }
+                if (csvMode) {
+                    // Likewise, but a quoted field can hold newlines
+                    while (next()) {
+                        if (csvSplitter.add(data, n, block.input)) {
+                            return true;
+                        }
+                    }
+                    return csvSplitter.finish(block.input);
+                }
+                if (!next()) {
+                    return false;
+                }
+                block.input.assign(data, n);
+                block.offset = nLetters;
+                for (const char c : block.input) {
+                    nLetters += letters[static_cast<unsigned char>(c)].size();
+                }
+                return true;
+            };
+
+            const auto transform = [&](Pipeline::Block& block) {
+                if (settings.records) {
+                    Records::apply(block.input, ciphers, settings.cipherMode,
+                                   block.output);
+                    return;
+                }
+                if (csvMode) {
+                    block.output.swap(block.input);
+                    Csv::apply(block.output, settings.csvDelimiter,
+                               csvColumns, ciphers, settings.cipherMode);
+                    return;
+                }
+                for (const char c : block.input) {
+                    block.output += letters[static_cast<unsigned char>(c)];
+                }
+                for (const auto& cipher : ciphers) {
+                    block.output = CipherChain::applyCipherAt(
+                        *cipher, block.output, settings.cipherMode,
+                        block.offset);
+                }
+            };
+
+            const auto sink = [&](const Pipeline::Block& block) {
+                if (writer) {
+                    writer->write(block.output);
+                } else {
+                    stdoutWriter->write(block.output);
+                    if (settings.records) {
+                        stdoutWriter->flush();
+                    }
+                }
+            };
+
+            // Leave a hardware thread each for the reader and the writer
+            const std::size_t nWorkers{
+                std::max(std::thread::hardware_concurrency(), 3u) - 2};
+            const std::size_t depth{4};
+            stats = Pipeline::run(source, transform, sink, nWorkers, depth);
+
+            // Each record already ends with a newline, and CSV is written
+            // exactly as it was read
+            const std::string end{(settings.records || csvMode) ? "" : "\n"};
+            if (writer) {
+                writer->write(end);
+                writer->close();
+            } else {
+                stdoutWriter->write(end);
+                stdoutWriter->flush();
+            }
+        } catch (const std::system_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        }
+
+        if (settings.pipelineStats) {
+            const auto printRing = [](const std::string& name,
+                                      const RingStats& ring) {
+                std::cerr << "[pipeline] " << name << ": capacity "
+                          << ring.capacity << ", mean occupancy "
+                          << ring.meanOccupancy() << ", max occupancy "
+                          << ring.maxOccupancy << ", producer stalls "
+                          << ring.pushStalls << ", consumer stalls "
+                          << ring.popStalls << '\n';
+            };
+            std::cerr << "[pipeline] " << stats.blocks << " blocks, "
+                      << stats.workers << " workers\n";
+            printRing("reader -> workers", stats.toWorkers);
+            printRing("workers -> writer", stats.toWriter);
+            printRing("writer -> reader", stats.recycled);
+        }
+        return 0;
+    }
+
+    // In container mode, each block is encrypted or decrypted on its own
+    if (settings.container) {
+        std::string result;
+        try {
+            if (!containerDecode) {
+                result = BlockContainer::encode(
+                    cipherText, ciphers, settings.cipherType,
+                    settings.cipherKey, BlockContainer::defaultBlockSize,
+                    settings.compress);
+            } else {
+                std::ifstream inputStream;
+                std::istringstream stdinStream{cipherText};
+                if (!settings.inputFile.empty()) {
+                    inputStream.open(settings.inputFile, std::ios::binary);
+                    if (!inputStream.good()) {
+                        std::cerr << "[error] failed to create istream on file '"
+                                  << settings.inputFile << "'" << std::endl;
+                        return 1;
+                    }
+                }
+                std::istream& in{settings.inputFile.empty()
+                                     ? static_cast<std::istream&>(stdinStream)
+                                     : inputStream};
+
+                // Check that the same ciphers and keys are being used to
+                // decrypt it as were used to encrypt it
+                BlockContainer::Reader reader{in};
+                if (reader.cipherTypes() != settings.cipherType) {
+                    std::cerr << "[error] the container was encrypted with a "
+                                 "different sequence of ciphers"
+                              << std::endl;
+                    return 1;
+                }
+                if (reader.keyFingerprint() !=
+                    BlockContainer::keyFingerprint(settings.cipherType,
+                                                   settings.cipherKey)) {
+                    std::cerr << "[error] the container was encrypted with a "
+                                 "different key"
+                              << std::endl;
+                    return 1;
+                }
+                result = settings.rangeRequested
+                             ? reader.decode(ciphers, settings.rangeStart,
+                                             settings.rangeLength)
+                             : reader.decode(ciphers);
+            }
+        } catch (const InvalidContainer& e) {
+            std::cerr << "[error] Invalid container: " << e.what()
+                      << std::endl;
+            return 1;
+        }
+
+        // The container itself is written as it is, and the text decrypted
+        // from it with a newline
+        if (containerDecode) {
+            result += '\n';
+        }
+        if (settings.outputFile.empty()) {
+            try {
+                FdWriter out{STDOUT_FILENO, settings.ioBufferSize};
+                out.write(result);
+                out.flush();
+            } catch (const std::system_error& e) {
+                std::cerr << "[error] " << e.what() << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+        std::ofstream outputStream{settings.outputFile, std::ios::binary};
+        if (!outputStream.good()) {
+            std::cerr << "[error] failed to create ostream on file '"
+                      << settings.outputFile << "'" << std::endl;
+            return 1;
+        }
+        outputStream << result;
+        return 0;
+    }
+
     // Run the cipher(s) on the input text, specifying whether to encrypt/decrypt
     for (const auto& cipher : ciphers) {
-        if (std::find(settings.cipherType.begin(), settings.cipherType.end(),
-                      CipherType::Caesar) != settings.cipherType.end()) {
+        if (settings.rangeRequested) {
+            // Start each cipher at the position of the range in the text
+            cipherText = CipherChain::applyCipherAt(
+                *cipher, cipherText, settings.cipherMode, settings.rangeStart);
+        } else if (CipherChain::isMonoalphabetic(cipher->type())) {
             // numThreads can be set to any value here
             const std::size_t numThreads{4};
 
@@ -144,13 +1045,13 @@ int main(int argc, char* argv[])
                                                         : (i + 1) * chunkSize;
 
                 futures.push_back(
-                    std::async(std::launch::async, [&ciphers, &cipherText,
+                    std::async(std::launch::async, [&cipher, &cipherText,
                                                     &settings, start, end]() {
                         std::string chunk =
                             cipherText.substr(start, end - start);
-                        // Send each chunk of caesar to applyCipher
-                        chunk = ciphers.front()->applyCipher(
-                            chunk, settings.cipherMode);
+                        // Send each chunk of the substitution to applyCipher
+                        chunk =
+                            cipher->applyCipher(chunk, settings.cipherMode);
                         return chunk;
                     }));
             }
@@ -168,27 +1069,45 @@ int main(int argc, char* argv[])
                 cipherText += future.get();
             }
         } else {
-            // For Vigenere and Playfair
+            // For Vigenere and Playfair, which depend on the position in the text
             cipherText = cipher->applyCipher(cipherText, settings.cipherMode);
         }
     }
 
     // Output the encrypted/decrypted text to stdout/file
     if (!settings.outputFile.empty()) {
-        // Open the file and check that we can write to it
-        std::ofstream outputStream{settings.outputFile};
-        if (!outputStream.good()) {
-            std::cerr << "[error] failed to create ostream on file '"
-                      << settings.outputFile << "'" << std::endl;
+        // Write the encrypted/decrypted text to the file with several large
+        // writes in flight at once, only adding a newline if it is text
+        try {
+            AsyncWriter writer{settings.outputFile, settings.ioBufferSize,
+                               settings.ioQueueDepth};
+            writer.write(cipherText);
+            if (!byteMode) {
+                writer.write("\n");
+            }
+            writer.close();
+        } catch (const std::system_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
             return 1;
         }
 
-        // Print the encrypted/decrypted text to the file
-        outputStream << cipherText << std::endl;
-
     } else {
-        // Print the encrypted/decrypted text to the screen
-        std::cout << cipherText << std::endl;
+        // Print the encrypted/decrypted text to the screen, writing straight
+        // to stdout (and splicing into it if it is a pipe)
+        try {
+            FdWriter writer{STDOUT_FILENO, settings.ioBufferSize};
+            writer.write(cipherText);
+            if (!byteMode) {
+                writer.write("\n");
+            }
+            writer.flush();
+        } catch (const std::system_error& e) {
+            std::cerr << "[error] " << e.what() << std::endl;
+            return 1;
+        }
     }
 
     // No requirement to return from main, but we do so for clarity